@@ -0,0 +1,70 @@
+/**
+ * @file ab_api.h
+ * @author Gajavelly Sai Suraj
+ * @brief Prompt-free API for embedding the address book: no stdin, no output, status codes only.
+ *
+ * These functions apply the same validation and uniqueness rules as the interactive menu
+ * (which is built on them), but never print or read anything, so services and bulk loaders
+ * can call them at memory speed. Values longer than the Contact fields are rejected with
+ * INVALID_LENGTH rather than truncated.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef AB_API_H
+#define AB_API_H
+
+#include "address_book.h"
+#include "contact_helper.h"
+
+/**
+ * @brief Validates and adds a new contact with the next free ID.
+ * @param book A pointer to the AddressBook.
+ * @param name Contact name (letters and spaces).
+ * @param phone Contact phone (10 digits, unique in the book).
+ * @param email Contact email (unique in the book).
+ * @param id Output: the new contact's ID (may be NULL).
+ * @return VALID on success, the first failing check otherwise, or INVALID_NO_MEMORY.
+ */
+ValidationStatus ab_add(AddressBook *book, const char *name, const char *phone,
+                        const char *email, int *id);
+
+/**
+ * @brief Validates and adds a contact under the ID it already has (for reloads and imports).
+ * @param book A pointer to the AddressBook.
+ * @param values The contact's ID, name, phone, and email (its link is ignored).
+ * @return VALID on success, INVALID_FORMAT for an ID below 1, INVALID_DUPLICATE if the ID is
+ * taken, the first failing check, or INVALID_NO_MEMORY.
+ */
+ValidationStatus ab_insert(AddressBook *book, const Contact *values);
+
+/**
+ * @brief Validates and applies new values to a contact; a NULL value keeps the current one.
+ * @param book A pointer to the AddressBook.
+ * @param id ID of the contact to change.
+ * @param name New name, or NULL.
+ * @param phone New phone, or NULL. Keeping the contact's own phone is not a duplicate.
+ * @param email New email, or NULL. Keeping the contact's own email is not a duplicate.
+ * @return VALID on success, INVALID_NOT_FOUND, the first failing check, or INVALID_NO_MEMORY.
+ */
+ValidationStatus ab_update(AddressBook *book, int id, const char *name, const char *phone,
+                           const char *email);
+
+/**
+ * @brief Removes a contact by ID.
+ * @param book A pointer to the AddressBook.
+ * @param id The contact ID.
+ * @return VALID on success, INVALID_NOT_FOUND if no contact has that ID.
+ */
+ValidationStatus ab_remove(AddressBook *book, int id);
+
+/**
+ * @brief Finds a contact by ID (through the ID index when it is available).
+ * @param book A const pointer to the AddressBook.
+ * @param id The contact ID.
+ * @param contact Output: the contact, or NULL if not found (may be NULL).
+ * @return VALID if found, INVALID_NOT_FOUND otherwise.
+ */
+ValidationStatus ab_find(const AddressBook *book, int id, Contact **contact);
+
+#endif // AB_API_H
@@ -16,9 +16,17 @@
 #define MAX_EMAIL_LENGTH 50
 
 /**
- * @brief Options for searching for a contact.
+ * @brief Options for searching for a contact. Numbers 1-4 keep their original meaning, so
+ * scripted input still works; newer searches follow Cancel with fixed numbers of their own.
  */
-typedef enum { SEARCH_BY_NAME = 1, SEARCH_BY_PHONE, SEARCH_BY_EMAIL, SEARCH_CANCEL } SearchOption;
+typedef enum {
+    SEARCH_BY_NAME = 1,
+    SEARCH_BY_PHONE,
+    SEARCH_BY_EMAIL,
+    SEARCH_CANCEL = 4,
+    SEARCH_SOUNDS_LIKE = 5,
+    SEARCH_PHONE_ENDS_WITH = 6
+} SearchOption;
 
 /**
  * @brief Options for modifying a contact.
@@ -41,8 +49,16 @@ typedef struct ContactNode {
  */
 typedef struct {
     Contact *head;     /**< Pointer to the first node in the linked list. */
+    Contact *tail;     /**< Pointer to the last node, for constant-time appends. */
     int contact_count; /**< The total number of contacts currently in the address book. */
     int next_id;       /**< The next available ID for a new contact. */
+    struct ContactAggregates *aggregates; /**< Group-by counts kept in step with the list. */
+    struct BookIndexes *indexes;          /**< Hash indexes kept in step with the list. */
+    int indexing_suspended;               /**< Non-zero while a bulk change defers indexing. */
+    struct SnapshotManager *snapshots;    /**< Versioning state, or NULL if snapshots are off. */
+    struct Autocomplete *autocomplete;    /**< Prefix suggestions, or NULL if not enabled. */
+    struct ChangeFeed *feed;              /**< Change records for consumers, or NULL if off. */
+    struct TagSet *tags;                  /**< Contact tags, or NULL if nothing is tagged. */
 } AddressBook;
 
 // --- Menu Functions ---
@@ -97,6 +113,107 @@ void save_contacts_to_file(const AddressBook *book);
  */
 void load_contacts_from_file(AddressBook *book);
 
+// --- Library Functions ---
+/**
+ * @brief Appends an already-validated contact to the end of the book and indexes it.
+ *
+ * Keeps @c next_id ahead of the contact's ID so that loaded contacts never collide
+ * with newly created ones.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param contact A heap-allocated contact; the book takes ownership.
+ */
+void book_append_contact(AddressBook *book, Contact *contact);
+
+/**
+ * @brief Replaces a contact's name, phone, and email, keeping every index in step.
+ *
+ * No validation is done here; callers check the new values first. While a snapshot is open
+ * the contact is copied instead of changed in place, so use the returned pointer afterwards.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to change (must belong to @p book).
+ * @param values Source of the new name, phone, and email (its ID and link are ignored).
+ * @return The contact now holding the new values, or NULL if memory ran out (book unchanged).
+ */
+Contact *book_update_contact(AddressBook *book, Contact *contact, const Contact *values);
+
+/**
+ * @brief Links a prepared node into a contact's place in the list and indexes, retiring the old
+ * node (see snapshot.h).
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to replace.
+ * @param replacement The new node; the book takes ownership.
+ * @return 0 on success, -1 if @p contact is not in the book.
+ */
+int book_replace_contact(AddressBook *book, Contact *contact, Contact *replacement);
+
+/**
+ * @brief Frees a contact taken out with book_extract_contacts, deferring the free while a
+ * snapshot may still see it.
+ * @param book A pointer to the AddressBook the contact came from.
+ * @param contact The unlinked contact.
+ */
+void book_release_contact(AddressBook *book, Contact *contact);
+
+/**
+ * @brief Unlinks a contact from the book, removes it from every index, and frees it (once no
+ * snapshot can still see it).
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to remove.
+ * @return 0 on success, -1 if the contact is not in the book.
+ */
+int book_remove_contact(AddressBook *book, Contact *contact);
+
+/**
+ * @brief Unlinks every contact a predicate selects in a single pass, without freeing them.
+ *
+ * Removing a contact from a large index bucket is linear in the bucket, so callers moving many
+ * contacts should wrap this in book_suspend_indexing / book_resume_indexing.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param select Returns non-zero for contacts to take out.
+ * @param context Passed through to @p select.
+ * @return The removed contacts chained through @c next (release each with
+ * book_release_contact), or NULL.
+ */
+Contact *book_extract_contacts(AddressBook *book, int (*select)(const Contact *, void *),
+                               void *context);
+
+/**
+ * @brief Drops the indexes and stops maintaining them until book_resume_indexing.
+ *
+ * For bulk changes: per-contact index updates are skipped and the indexes are rebuilt once at
+ * the end. Readers fall back to list scans in between.
+ *
+ * @param book A pointer to the AddressBook.
+ */
+void book_suspend_indexing(AddressBook *book);
+
+/**
+ * @brief Rebuilds the indexes in one pass over the list and resumes maintaining them.
+ * @param book A pointer to the AddressBook.
+ */
+void book_resume_indexing(AddressBook *book);
+
+/**
+ * @brief Appends every contact from a CSV file to the book, without printing anything.
+ * @param book A pointer to the AddressBook.
+ * @param path Path of the CSV file.
+ * @param skipped Output: number of damaged records that were skipped (may be NULL).
+ * @return Number of contacts loaded, -1 if the file could not be opened, or -2 if its
+ * header is damaged.
+ */
+int load_contacts_csv(AddressBook *book, const char *path, int *skipped);
+
+/**
+ * @brief Writes every contact to a CSV file, without printing anything.
+ * @param book A const pointer to the AddressBook.
+ * @param path Path of the CSV file.
+ * @return Number of contacts written, or -1 if the file could not be written.
+ */
+int save_contacts_csv(const AddressBook *book, const char *path);
+
 // --- Utility Functions ---
 /**
  * @brief Initializes an AddressBook to a safe, empty state.
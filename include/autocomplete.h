@@ -0,0 +1,138 @@
+/**
+ * @file autocomplete.h
+ * @author Gajavelly Sai Suraj
+ * @brief Prefix autocomplete over names, phones, and emails with top-K ranked suggestions.
+ *
+ * Each field keeps its contacts in an array sorted by (case-folded) value, so every
+ * completion of a prefix is one contiguous range found by binary search. Every block of
+ * AUTOCOMPLETE_BLOCK_SIZE entries records the highest score inside it, and the top-K search
+ * skips whole blocks that cannot beat the K-th best suggestion found so far.
+ *
+ * A suggestion's score is how often the contact was picked (autocomplete_record_use), with
+ * newer contacts (higher IDs) first among equals. Contacts added after the arrays were built
+ * wait in a small sorted pending list; when it fills up, or after many removals, the arrays
+ * are dropped and rebuilt on the next suggestion.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef AUTOCOMPLETE_H
+#define AUTOCOMPLETE_H
+
+#include <stddef.h>
+#include "address_book.h"
+
+#define AUTOCOMPLETE_BLOCK_SIZE 64
+#define AUTOCOMPLETE_PENDING_LIMIT 1024
+#define AUTOCOMPLETE_MAX_REMOVALS 256
+#define AUTOCOMPLETE_MAX_SUGGESTIONS 64
+#define AUTOCOMPLETE_DEFAULT_SUGGESTIONS 8
+
+/**
+ * @brief Fields that can be completed.
+ */
+typedef enum {
+    AUTOCOMPLETE_NAME,
+    AUTOCOMPLETE_PHONE,
+    AUTOCOMPLETE_EMAIL,
+    AUTOCOMPLETE_FIELD_COUNT
+} AutocompleteField;
+
+/**
+ * @brief Turns on autocomplete for a book. The sorted arrays are built on the first suggestion,
+ * so enabling it before a bulk load costs nothing.
+ * @param book A pointer to the AddressBook.
+ * @return 0 on success (or if already enabled), -1 if memory could not be allocated.
+ */
+int book_enable_autocomplete(AddressBook *book);
+
+/**
+ * @brief Finds the best-scored contacts whose field starts with a prefix.
+ * @param book A const pointer to the AddressBook (autocomplete must be enabled).
+ * @param field The field to complete.
+ * @param prefix The typed prefix (names and emails match case-insensitively; may be empty).
+ * @param suggestions Output array with room for @p limit contacts, best first.
+ * @param limit Maximum number of suggestions (at most AUTOCOMPLETE_MAX_SUGGESTIONS).
+ * @return Number of suggestions written, or -1 if autocomplete is off or memory ran out.
+ */
+int autocomplete_suggest(const AddressBook *book, AutocompleteField field, const char *prefix,
+                         const Contact **suggestions, int limit);
+
+/**
+ * @brief Counts every contact whose field starts with a prefix (the query planner's estimate).
+ * @param book A const pointer to the AddressBook (autocomplete must be enabled).
+ * @param field The field to match.
+ * @param prefix The prefix (names and emails match case-insensitively; may be empty).
+ * @return Number of matching contacts, or -1 if autocomplete is off or memory ran out.
+ */
+long autocomplete_prefix_count(const AddressBook *book, AutocompleteField field,
+                               const char *prefix);
+
+/**
+ * @brief Visits every contact whose field starts with a prefix, in no particular order.
+ * @param book A const pointer to the AddressBook (autocomplete must be enabled).
+ * @param field The field to match.
+ * @param prefix The prefix (names and emails match case-insensitively; may be empty).
+ * @param visit Called once per contact; a non-zero return stops the walk.
+ * @param context Passed through to @p visit.
+ * @return 0 after a full walk, @p visit's non-zero value if it stopped early, or -1 if
+ * autocomplete is off or memory ran out.
+ */
+int autocomplete_prefix_each(const AddressBook *book, AutocompleteField field, const char *prefix,
+                             int (*visit)(const Contact *contact, void *context), void *context);
+
+/**
+ * @brief Records that a suggested contact was picked, raising it in later suggestions.
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact that was picked.
+ */
+void autocomplete_record_use(AddressBook *book, const Contact *contact);
+
+/**
+ * @brief Guesses the field a typed prefix refers to: digits mean a phone, '@' an email.
+ * @param prefix The typed prefix.
+ * @return The field to complete.
+ */
+AutocompleteField autocomplete_guess_field(const char *prefix);
+
+/**
+ * @brief Adds a contact that just entered the book (called by the book itself).
+ * @param autocomplete The book's autocomplete state (may be NULL).
+ * @param contact The contact.
+ */
+void autocomplete_add_contact(struct Autocomplete *autocomplete, Contact *contact);
+
+/**
+ * @brief Removes a contact before it leaves or changes (called by the book itself).
+ * @param autocomplete The book's autocomplete state (may be NULL).
+ * @param contact The contact, still holding the values it was added under.
+ */
+void autocomplete_remove_contact(struct Autocomplete *autocomplete, const Contact *contact);
+
+/**
+ * @brief Drops the sorted arrays so the next suggestion rebuilds them (before bulk changes).
+ * @param autocomplete The book's autocomplete state (may be NULL).
+ */
+void autocomplete_invalidate(struct Autocomplete *autocomplete);
+
+/**
+ * @brief Frees the autocomplete state.
+ * @param autocomplete The state to free (may be NULL).
+ */
+void autocomplete_free(struct Autocomplete *autocomplete);
+
+/**
+ * @brief Interactive quick find: suggests contacts as prefixes are typed.
+ * @param book A pointer to the AddressBook.
+ */
+void run_autocomplete(AddressBook *book);
+
+/**
+ * @brief Runs `addressbook suggest [--limit N] <prefix>...` against contacts.csv.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_suggest_command(int argc, char *argv[]);
+
+#endif // AUTOCOMPLETE_H
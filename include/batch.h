@@ -0,0 +1,133 @@
+/**
+ * @file batch.h
+ * @author Gajavelly Sai Suraj
+ * @brief Atomic batches of create, update, and delete operations.
+ *
+ * Operations are staged in a Batch, validated together, and applied all-or-nothing. Phone and
+ * email uniqueness is judged on the book as it will look after the whole batch, so a batch may
+ * swap two contacts' phones or re-use the email of a contact it deletes, but may not add the
+ * same phone twice. A committed batch rebuilds the indexes once and writes the book once.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "contact_helper.h"
+
+/**
+ * @brief Kinds of staged operation.
+ */
+typedef enum { BATCH_ADD, BATCH_UPDATE, BATCH_REMOVE } BatchOpType;
+
+/**
+ * @brief One staged operation.
+ */
+typedef struct {
+    BatchOpType type;              /**< Add, update, or remove. */
+    int id;                        /**< Target ID (update/remove), or the assigned ID after an add commits. */
+    char name[MAX_NAME_LENGTH];    /**< New name (add/update). */
+    char phone[MAX_PHONE_LENGTH];  /**< New phone (add/update). */
+    char email[MAX_EMAIL_LENGTH];  /**< New email (add/update). */
+} BatchOp;
+
+/**
+ * @brief A growable list of staged operations.
+ */
+typedef struct {
+    BatchOp *ops;     /**< Staged operations, in staging order. */
+    size_t count;     /**< Number of staged operations. */
+    size_t capacity;  /**< Allocated length of @c ops. */
+} Batch;
+
+/**
+ * @brief Why a batch was rejected.
+ */
+typedef struct {
+    size_t op_index;          /**< Index of the first offending operation. */
+    ValidationStatus status;  /**< What was wrong with it. */
+} BatchError;
+
+/**
+ * @brief Outcomes of batch_commit.
+ */
+typedef enum {
+    BATCH_OK = 0,         /**< Every operation was applied. */
+    BATCH_REJECTED = -1,  /**< Validation failed; see the BatchError. Nothing was applied. */
+    BATCH_FAILED = -2     /**< Out of memory or the save failed. Nothing was applied. */
+} BatchStatus;
+
+/**
+ * @brief Initializes an empty batch.
+ * @param batch The batch.
+ */
+void batch_init(Batch *batch);
+
+/**
+ * @brief Frees a batch's staged operations.
+ * @param batch The batch.
+ */
+void batch_free(Batch *batch);
+
+/**
+ * @brief Stages a new contact (its ID is assigned on commit).
+ * @param batch The batch.
+ * @param name Contact name.
+ * @param phone Contact phone.
+ * @param email Contact email.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int batch_add(Batch *batch, const char *name, const char *phone, const char *email);
+
+/**
+ * @brief Stages new name, phone, and email values for an existing contact.
+ * @param batch The batch.
+ * @param id ID of the contact to change.
+ * @param name New name.
+ * @param phone New phone.
+ * @param email New email.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int batch_update(Batch *batch, int id, const char *name, const char *phone, const char *email);
+
+/**
+ * @brief Stages the removal of a contact.
+ * @param batch The batch.
+ * @param id ID of the contact to remove.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int batch_remove(Batch *batch, int id);
+
+/**
+ * @brief Validates every staged operation against the book and against each other.
+ *
+ * Checks field formats, that update/remove targets exist and are each named only once, and
+ * that no phone or email would be held twice once the batch is applied.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param batch The staged operations.
+ * @param error Output: the first offending operation (may be NULL).
+ * @return BATCH_OK, BATCH_REJECTED, or BATCH_FAILED if memory ran out.
+ */
+BatchStatus batch_validate(const AddressBook *book, const Batch *batch, BatchError *error);
+
+/**
+ * @brief Validates and applies a batch all-or-nothing.
+ *
+ * When @p save_path is given, the resulting book is written to a temporary file and renamed
+ * over @p save_path before memory is touched, so a failed write leaves both unchanged. Added
+ * contacts receive consecutive IDs, written back into their operations.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param batch The staged operations.
+ * @param save_path CSV file to write the result to, or NULL to skip saving.
+ * @param error Output: the first offending operation when rejected (may be NULL).
+ * @return BATCH_OK, BATCH_REJECTED, or BATCH_FAILED.
+ */
+BatchStatus batch_commit(AddressBook *book, Batch *batch, const char *save_path,
+                         BatchError *error);
+
+#endif // BATCH_H
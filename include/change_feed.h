@@ -0,0 +1,168 @@
+/**
+ * @file change_feed.h
+ * @author Gajavelly Sai Suraj
+ * @brief Change-data-capture feed: every create, edit, and delete as a sequenced record.
+ *
+ * Once enabled on a book, every change made through the library (book_append_contact,
+ * book_update_contact, book_replace_contact, book_remove_contact, book_extract_contacts, and
+ * everything built on them) produces one ChangeRecord with the values before and after. Records
+ * are numbered from 1 without gaps, and go to:
+ *  - in-process subscribers, called synchronously in sequence order;
+ *  - an append-only log file, one line per record, flushed as it is written so other processes
+ *    can tail it with a ChangeCursor and resume from the last sequence number they applied.
+ * Reopening an existing log continues its numbering.
+ *
+ * Log lines are "sequence,op,id,before name,before phone,before email,after name,after phone,
+ * after email,time", with the missing side left empty and the time in milliseconds since the
+ * epoch (lines written before times were recorded end at the email). Contact fields never
+ * contain commas.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include "address_book.h"
+
+#define CHANGE_FEED_FILE_NAME "contacts.changes"
+#define CHANGE_FEED_MAX_SUBSCRIBERS 8
+#define CHANGE_FEED_FOLLOW_INTERVAL_MS 200
+
+/**
+ * @brief Kinds of change.
+ */
+typedef enum {
+    CHANGE_CREATE,
+    CHANGE_UPDATE,
+    CHANGE_DELETE
+} ChangeOp;
+
+/**
+ * @brief One change to one contact.
+ */
+typedef struct {
+    unsigned long long sequence; /**< Position in the feed, starting at 1. */
+    ChangeOp op;                 /**< What happened. */
+    int id;                      /**< ID of the contact. */
+    Contact before;              /**< Values before the change (empty strings for a create). */
+    Contact after;               /**< Values after the change (empty strings for a delete). */
+    long long time_ms;           /**< When the change was made, in ms since the epoch (or 0). */
+} ChangeRecord;
+
+/**
+ * @brief Called for every change, right after it is applied to the book.
+ * Subscribers must not change the book from inside the callback.
+ */
+typedef void (*ChangeSubscriber)(const ChangeRecord *change, void *context);
+
+/**
+ * @brief A reader of a change log, for consumers in other processes.
+ */
+typedef struct ChangeCursor ChangeCursor;
+
+/**
+ * @brief Starts recording changes to a book. Contacts already in the book are not reported, so
+ * enable the feed after loading.
+ * @param book A pointer to the AddressBook.
+ * @param log_path Log file to append to (created if missing), or NULL for subscribers only.
+ * @return 0 on success (or if already enabled), -1 if the log could not be opened or memory
+ * ran out.
+ */
+int book_enable_change_feed(AddressBook *book, const char *log_path);
+
+/**
+ * @brief Stops recording changes, dropping every subscriber and closing the log.
+ * @param book A pointer to the AddressBook.
+ * @return 0 on success, -1 if any log write failed while the feed was on.
+ */
+int book_disable_change_feed(AddressBook *book);
+
+/**
+ * @brief Registers a callback for every later change.
+ * @param book A pointer to the AddressBook (the feed must be enabled).
+ * @param subscriber The callback.
+ * @param context Passed through to @p subscriber.
+ * @return A handle for change_feed_unsubscribe, or -1 if the feed is off or full.
+ */
+int change_feed_subscribe(AddressBook *book, ChangeSubscriber subscriber, void *context);
+
+/**
+ * @brief Removes a callback.
+ * @param book A pointer to the AddressBook.
+ * @param handle The handle returned by change_feed_subscribe.
+ */
+void change_feed_unsubscribe(AddressBook *book, int handle);
+
+/**
+ * @brief Reads the sequence number of the latest change.
+ * @param book A const pointer to the AddressBook.
+ * @return The last sequence number issued, or 0 if there is none or the feed is off.
+ */
+unsigned long long change_feed_sequence(const AddressBook *book);
+
+/**
+ * @brief Reports a change to the feed (called by the book itself).
+ * @param feed The book's feed (may be NULL).
+ * @param op What happened.
+ * @param before Values before the change (NULL for a create).
+ * @param after Values after the change (NULL for a delete).
+ */
+void change_feed_emit(struct ChangeFeed *feed, ChangeOp op, const Contact *before,
+                      const Contact *after);
+
+/**
+ * @brief Frees a feed, closing its log.
+ * @param feed The feed to free (may be NULL).
+ * @return 0 on success, -1 if any log write failed.
+ */
+int change_feed_free(struct ChangeFeed *feed);
+
+/**
+ * @brief Opens a change log for reading, positioned after a sequence number.
+ * @param path The log file.
+ * @param after_sequence Records up to and including this number are skipped (0 for all).
+ * @return The cursor, or NULL if the log could not be opened.
+ */
+ChangeCursor *change_cursor_open(const char *path, unsigned long long after_sequence);
+
+/**
+ * @brief Reads the next complete record. At the end of the log it returns 0; calling it again
+ * later picks up records appended in the meantime.
+ * @param cursor The cursor.
+ * @param change Output record.
+ * @return 1 if a record was read, 0 if there is none yet, -1 on a read error.
+ */
+int change_cursor_next(ChangeCursor *cursor, ChangeRecord *change);
+
+/**
+ * @brief Bytes of the log past the cursor: records appended but not yet read, for lag reports.
+ * @param cursor The cursor.
+ * @return The byte count, or -1 if the log could not be examined.
+ */
+long change_cursor_backlog(ChangeCursor *cursor);
+
+/**
+ * @brief Reads the sequence number of the last record in a log, from the log's tail only.
+ * @param path The log file.
+ * @param sequence Output: the last sequence number, or 0 for an empty log.
+ * @return 0 on success, -1 if the log could not be read.
+ */
+int change_log_last_sequence(const char *path, unsigned long long *sequence);
+
+/**
+ * @brief Closes a cursor.
+ * @param cursor The cursor (may be NULL).
+ */
+void change_cursor_close(ChangeCursor *cursor);
+
+/**
+ * @brief Runs `addressbook changes [--from <sequence>] [--follow] [<log>]`, printing records
+ * as JSON lines.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_changes_command(int argc, char *argv[]);
+
+#endif // CHANGE_FEED_H
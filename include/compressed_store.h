@@ -0,0 +1,138 @@
+/**
+ * @file compressed_store.h
+ * @author Gajavelly Sai Suraj
+ * @brief Compressed, block-based on-disk format for the address book (contacts.abz).
+ *
+ * Contacts are written in blocks of COMPRESSED_BLOCK_RECORDS. Within a block every field is
+ * stored column by column with an encoding suited to it:
+ *  - IDs: zig-zag varint deltas from the previous ID.
+ *  - Phones: ten-digit numbers frame-of-reference bit-packed; anything else kept verbatim.
+ *  - Email domains: a per-block dictionary, one varint code per contact.
+ *  - Names and email local parts: a built-in LZ77 block compressor.
+ * Blocks are self-contained, so files can be written and read as a stream.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef COMPRESSED_STORE_H
+#define COMPRESSED_STORE_H
+
+#include <stddef.h>
+#include "address_book.h"
+
+#define COMPRESSED_FILE_NAME "contacts.abz"
+#define COMPRESSED_BLOCK_RECORDS 4096
+
+/**
+ * @brief Streaming writer for the compressed format.
+ */
+typedef struct CompressedWriter CompressedWriter;
+
+/**
+ * @brief Streaming reader for the compressed format.
+ */
+typedef struct CompressedReader CompressedReader;
+
+/**
+ * @brief Creates (or truncates) a compressed file for writing.
+ * @param path Path of the file.
+ * @return The writer, or NULL if the file could not be opened.
+ */
+CompressedWriter *compressed_writer_open(const char *path);
+
+/**
+ * @brief Appends a contact; a block is encoded and written each time one fills up.
+ * @param writer The writer.
+ * @param contact The contact to append.
+ * @return 0 on success, -1 on an I/O or memory error.
+ */
+int compressed_writer_add(CompressedWriter *writer, const Contact *contact);
+
+/**
+ * @brief Flushes the last block, writes the end marker, and closes the file.
+ * @param writer The writer (always freed).
+ * @param next_id The book's next available ID, restored on load.
+ * @return 0 on success, -1 on an I/O or memory error.
+ */
+int compressed_writer_close(CompressedWriter *writer, int next_id);
+
+/**
+ * @brief Opens a compressed file for reading.
+ * @param path Path of the file.
+ * @return The reader, or NULL if the file is missing or not in the compressed format.
+ */
+CompressedReader *compressed_reader_open(const char *path);
+
+/**
+ * @brief Reads the next contact (its @c next pointer is set to NULL).
+ * @param reader The reader.
+ * @param contact Output contact.
+ * @return 1 if a contact was read, 0 at the end of the file, -1 if the file is damaged.
+ */
+int compressed_reader_next(CompressedReader *reader, Contact *contact);
+
+/**
+ * @brief The next available ID recorded in the file (valid once the end was reached).
+ * @param reader The reader.
+ * @return The recorded next ID.
+ */
+int compressed_reader_next_id(const CompressedReader *reader);
+
+/**
+ * @brief Closes a reader.
+ * @param reader The reader to close (may be NULL).
+ */
+void compressed_reader_close(CompressedReader *reader);
+
+/**
+ * @brief Saves the whole book in the compressed format.
+ * @param book A const pointer to the AddressBook.
+ * @param path Path of the file.
+ * @return Number of contacts written, or -1 on error.
+ */
+int save_contacts_compressed(const AddressBook *book, const char *path);
+
+/**
+ * @brief Appends every contact from a compressed file to the book.
+ * @param book A pointer to the AddressBook.
+ * @param path Path of the file.
+ * @return Number of contacts loaded, or -1 if the file is missing or damaged.
+ */
+int load_contacts_compressed(AddressBook *book, const char *path);
+
+/**
+ * @brief Interactive load from COMPRESSED_FILE_NAME, falling back to contacts.csv when the
+ * compressed file does not exist yet.
+ * @param book A pointer to the AddressBook.
+ */
+void load_contacts_from_compressed_file(AddressBook *book);
+
+/**
+ * @brief Interactive save to COMPRESSED_FILE_NAME.
+ * @param book A const pointer to the AddressBook.
+ */
+void save_contacts_to_compressed_file(const AddressBook *book);
+
+/**
+ * @brief Compresses a buffer with the built-in LZ77 codec.
+ * @param input Data to compress.
+ * @param length Length of @p input.
+ * @param output Output: heap-allocated compressed bytes (caller frees).
+ * @param output_length Output: length of @p output.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int lz_compress(const unsigned char *input, size_t length, unsigned char **output,
+                size_t *output_length);
+
+/**
+ * @brief Decompresses a buffer produced by lz_compress.
+ * @param input Compressed data.
+ * @param length Length of @p input.
+ * @param output Buffer receiving exactly @p output_length bytes.
+ * @param output_length Expected decompressed length.
+ * @return 0 on success, -1 if the data is damaged.
+ */
+int lz_decompress(const unsigned char *input, size_t length, unsigned char *output,
+                  size_t output_length);
+
+#endif // COMPRESSED_STORE_H
@@ -20,7 +20,9 @@ typedef enum {
     INVALID_CHARACTERS, /**< Contains invalid characters. */
     INVALID_FORMAT,     /**< Format does not match expected pattern. */
     INVALID_LENGTH,     /**< Length is outside allowed range. */
-    INVALID_DUPLICATE   /**< Value already exists in the address book. */
+    INVALID_DUPLICATE,  /**< Value already exists in the address book. */
+    INVALID_NOT_FOUND,  /**< No contact has the given ID. */
+    INVALID_NO_MEMORY   /**< Memory could not be allocated for the change. */
 } ValidationStatus;
 
 /**
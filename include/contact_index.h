@@ -0,0 +1,162 @@
+/**
+ * @file contact_index.h
+ * @author Gajavelly Sai Suraj
+ * @brief Hash indexes over contact fields, kept in step with the address book's linked list.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef CONTACT_INDEX_H
+#define CONTACT_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+// Trailing phone digits that key the suffix index; partial-number lookups need at least this many.
+#define PHONE_SUFFIX_DIGITS 7
+
+/**
+ * @brief One key of a ContactIndex and every contact stored under it.
+ */
+typedef struct {
+    char *key;          /**< Heap-allocated key, or NULL for an unused slot. */
+    Contact **contacts; /**< Contacts sharing this key, in insertion order. */
+    size_t count;       /**< Number of contacts under this key. */
+    size_t capacity;    /**< Allocated length of @c contacts. */
+} IndexBucket;
+
+/**
+ * @brief Open-addressing hash multimap from a string key to contacts.
+ */
+typedef struct {
+    IndexBucket *slots; /**< Slot array (capacity is a power of two). */
+    size_t capacity;    /**< Number of slots. */
+    size_t used;        /**< Slots holding a key, including keys with no contacts left. */
+} ContactIndex;
+
+/**
+ * @brief Open-addressing hash map from contact ID to contact.
+ */
+typedef struct {
+    Contact **slots; /**< Slot array; NULL marks an unused slot. */
+    size_t capacity; /**< Number of slots (a power of two). */
+    size_t count;    /**< Number of stored contacts. */
+} IdIndex;
+
+/**
+ * @brief One contact of a PhoneTailIndex.
+ */
+typedef struct {
+    Contact *contact; /**< The contact, or NULL for an unused slot. */
+    int tail;         /**< Last PHONE_SUFFIX_DIGITS digits of its phone, as a number. */
+} PhoneTailSlot;
+
+/**
+ * @brief Open-addressing hash multimap from the trailing digits of a phone number to contacts,
+ * one slot per contact, so indexing a contact allocates nothing.
+ */
+typedef struct {
+    PhoneTailSlot *slots; /**< Slot array (capacity is a power of two). */
+    size_t capacity;      /**< Number of slots. */
+    size_t count;         /**< Number of stored contacts. */
+} PhoneTailIndex;
+
+/**
+ * @brief Every secondary index the address book maintains.
+ */
+typedef struct BookIndexes {
+    IdIndex by_id;                /**< Contact ID. */
+    ContactIndex by_name;         /**< Name, folded to lowercase. */
+    ContactIndex by_phone;        /**< Phone number, exact. */
+    PhoneTailIndex by_phone_tail; /**< Last PHONE_SUFFIX_DIGITS digits of the phone number. */
+    ContactIndex by_email;        /**< Email address, folded to lowercase. */
+    ContactIndex by_domain;       /**< Email domain, folded to lowercase. */
+    ContactIndex by_sound;        /**< Soundex code of each distinct name token. */
+} BookIndexes;
+
+/**
+ * @brief Allocates an empty set of indexes.
+ * @return Pointer to the indexes, or NULL if memory could not be allocated.
+ */
+BookIndexes *book_indexes_create(void);
+
+/**
+ * @brief Frees a set of indexes (the contacts themselves are not freed).
+ * @param indexes The indexes to free (may be NULL).
+ */
+void book_indexes_free(BookIndexes *indexes);
+
+/**
+ * @brief Adds a contact to every index under its current field values.
+ * @param indexes The indexes to update.
+ * @param contact The contact to add.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int book_indexes_add(BookIndexes *indexes, Contact *contact);
+
+/**
+ * @brief Removes a contact from every index, using the field values it was added under.
+ * @param indexes The indexes to update.
+ * @param contact The contact to remove.
+ */
+void book_indexes_remove(BookIndexes *indexes, const Contact *contact);
+
+/**
+ * @brief Looks up the contacts stored under a key.
+ * @param index The index to search.
+ * @param key The (already normalized) key.
+ * @return The bucket for the key, or NULL if no contact has that key.
+ */
+const IndexBucket *contact_index_lookup(const ContactIndex *index, const char *key);
+
+/**
+ * @brief Looks up a contact by ID.
+ * @param index The ID index.
+ * @param id The contact ID.
+ * @return The contact, or NULL if no contact has that ID.
+ */
+Contact *id_index_lookup(const IdIndex *index, int id);
+
+/**
+ * @brief Steps through the contacts whose phone ends in the given trailing digits.
+ * @param index The suffix index.
+ * @param tail Trailing digits, from phone_tail_key.
+ * @param position In/out: 0 to start, then passed back unchanged between calls.
+ * @return The next contact stored under @p tail, or NULL when there are no more.
+ */
+Contact *phone_tail_index_next(const PhoneTailIndex *index, int tail, size_t *position);
+
+/**
+ * @brief Copies @p value into @p key folded to lowercase (keys of name/email indexes).
+ * @param value The field value.
+ * @param key Output buffer of at least MAX_EMAIL_LENGTH bytes.
+ */
+void index_fold_key(const char *value, char *key);
+
+/**
+ * @brief Copies the digits of a phone number, dropping spaces, dashes, '+', and brackets.
+ * @param value The phone number as written.
+ * @param digits Output buffer.
+ * @param size Size of @p digits (extra digits are dropped).
+ * @return Number of digits written.
+ */
+size_t phone_digits(const char *value, char *digits, size_t size);
+
+/**
+ * @brief The key of a phone number in the suffix index: its last PHONE_SUFFIX_DIGITS digits as
+ * a number (other characters are skipped).
+ * @param value The phone number, or its digits.
+ * @return The key, or -1 if it has fewer than PHONE_SUFFIX_DIGITS digits.
+ */
+int phone_tail_key(const char *value);
+
+/**
+ * @brief Whether two digit strings are the same number seen with and without a prefix: the
+ * shorter is a suffix of the longer and is at least PHONE_SUFFIX_DIGITS long. This covers both
+ * the last digits of a number and a number with a country code in front.
+ * @param a Digits of one number.
+ * @param b Digits of the other.
+ */
+bool phone_suffix_matches(const char *a, const char *b);
+
+#endif // CONTACT_INDEX_H
@@ -0,0 +1,111 @@
+/**
+ * @file contact_report.h
+ * @author Gajavelly Sai Suraj
+ * @brief Incrementally maintained group-by counts (email domain, phone prefix) for reports.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef CONTACT_REPORT_H
+#define CONTACT_REPORT_H
+
+#include <stddef.h>
+#include "address_book.h"
+
+// Number of leading phone digits that identify an operator/area code.
+#define REPORT_PHONE_PREFIX_LENGTH 4
+
+/**
+ * @brief Options for choosing how contacts are grouped in a report.
+ */
+typedef enum { REPORT_BY_EMAIL_DOMAIN = 1, REPORT_BY_PHONE_PREFIX, REPORT_CANCEL } ReportOption;
+
+/**
+ * @brief A single group in a report: the group key and how many contacts fall into it.
+ */
+typedef struct {
+    char key[MAX_EMAIL_LENGTH]; /**< Group key (email domain or phone prefix). */
+    int count;                  /**< Number of contacts in the group. */
+} ReportRow;
+
+/**
+ * @brief Open-addressing hash table mapping a group key to its contact count.
+ */
+typedef struct {
+    ReportRow *slots; /**< Slot array; an empty key marks an unused slot. */
+    size_t capacity;  /**< Number of slots (always a power of two). */
+    size_t used;      /**< Number of slots holding a key; every held key has a positive count. */
+} CountTable;
+
+/**
+ * @brief Running group-by counts kept in step with every create, edit, and delete.
+ */
+typedef struct ContactAggregates {
+    CountTable by_domain;       /**< Contacts per email domain. */
+    CountTable by_phone_prefix; /**< Contacts per phone-number prefix. */
+} ContactAggregates;
+
+/**
+ * @brief Allocates an empty set of aggregates.
+ * @return Pointer to the new aggregates, or NULL if memory could not be allocated.
+ */
+ContactAggregates *aggregates_create(void);
+
+/**
+ * @brief Frees a set of aggregates.
+ * @param aggregates The aggregates to free (may be NULL).
+ */
+void aggregates_free(ContactAggregates *aggregates);
+
+/**
+ * @brief Counts a contact into every group it belongs to.
+ *
+ * On failure the aggregates are left partly updated; the caller must free them and fall
+ * back to a full scan (aggregates_report does this when the book's aggregates are NULL).
+ *
+ * @param aggregates The aggregates to update.
+ * @param contact The contact being added.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int aggregates_add_contact(ContactAggregates *aggregates, const Contact *contact);
+
+/**
+ * @brief Removes a contact's contribution from every group it belongs to.
+ * @param aggregates The aggregates to update.
+ * @param contact The contact being removed, with the field values it was counted under.
+ */
+void aggregates_remove_contact(ContactAggregates *aggregates, const Contact *contact);
+
+/**
+ * @brief Extracts the email-domain group key of a contact.
+ * @param email The email address.
+ * @param key Output buffer of at least MAX_EMAIL_LENGTH bytes.
+ */
+void report_domain_key(const char *email, char *key);
+
+/**
+ * @brief Extracts the phone-prefix group key of a contact.
+ * @param phone The phone number.
+ * @param key Output buffer of at least MAX_EMAIL_LENGTH bytes.
+ */
+void report_phone_prefix_key(const char *phone, char *key);
+
+/**
+ * @brief Builds a report of non-empty groups, sorted by count (descending) then key.
+ *
+ * Uses the book's maintained aggregates, so the cost is proportional to the number of
+ * groups rather than the number of contacts.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param group Which field to group by.
+ * @param rows Output: heap-allocated array of rows (caller frees), or NULL when empty.
+ * @return Number of rows written to @p rows.
+ */
+size_t aggregates_report(const AddressBook *book, ReportOption group, ReportRow **rows);
+
+/**
+ * @brief Interactive menu that prints group-by reports for the address book.
+ * @param book A const pointer to the AddressBook.
+ */
+void show_reports(const AddressBook *book);
+
+#endif // CONTACT_REPORT_H
@@ -0,0 +1,120 @@
+/**
+ * @file convert.h
+ * @author Gajavelly Sai Suraj
+ * @brief Bounded-memory streaming conversion of contacts.csv into other formats.
+ *
+ * The converter never loads the whole file. A reader thread pulls fixed-size chunks from the
+ * input, a parser thread turns them into batches of validated records, and the calling thread
+ * writes each batch out, so reading, parsing, and writing overlap. All buffers come from fixed
+ * pools sized from a memory limit. Sorted output uses an external merge sort: sorted runs that
+ * fit the limit are spilled to temporary files and merged at the end.
+ *
+ * Records are checked with the same is_valid_* rules as the interactive menu; invalid ones are
+ * skipped and reported. Duplicate phones and emails are not checked, since that would need the
+ * whole book in memory.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef CONVERT_H
+#define CONVERT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "address_book.h"
+#include "contact_helper.h"
+
+#define CONVERT_CHUNK_SIZE (64 * 1024)
+#define CONVERT_CHUNK_BUFFERS 3
+#define CONVERT_BATCH_BUFFERS 3
+#define CONVERT_DEFAULT_BATCH 1024
+#define CONVERT_DEFAULT_MEMORY (16 * 1024 * 1024)
+#define CONVERT_MIN_MEMORY (512 * 1024)
+#define CONVERT_REPORT_LIMIT 10
+
+/**
+ * @brief Output formats.
+ */
+typedef enum {
+    CONVERT_CSV,        /**< contacts.csv layout (count line, then id,name,phone,email). */
+    CONVERT_JSONL,      /**< One JSON object per line. */
+    CONVERT_COMPRESSED  /**< The compressed block format of compressed_store.h. */
+} ConvertFormat;
+
+/**
+ * @brief Output orderings.
+ */
+typedef enum {
+    CONVERT_SORT_NONE,  /**< Keep input order. */
+    CONVERT_SORT_ID,
+    CONVERT_SORT_NAME,  /**< Case-insensitive, ties broken by ID. */
+    CONVERT_SORT_PHONE,
+    CONVERT_SORT_EMAIL
+} ConvertSort;
+
+/**
+ * @brief Conversion settings.
+ */
+typedef struct {
+    ConvertFormat format;   /**< Output format. */
+    ConvertSort sort;       /**< Output order. */
+    size_t memory_limit;    /**< Upper bound on buffer memory, in bytes. */
+    size_t batch_records;   /**< Records per parsed batch (shrunk to fit the limit). */
+    FILE *report;           /**< Where invalid records are described (NULL for silence). */
+    size_t report_limit;    /**< Invalid records described before only counting them. */
+} ConvertOptions;
+
+/**
+ * @brief What a conversion did.
+ */
+typedef struct {
+    size_t records_read;     /**< Data lines seen. */
+    size_t records_written;  /**< Valid records written. */
+    size_t records_invalid;  /**< Records skipped by validation. */
+    size_t sorted_runs;      /**< Runs spilled to disk by the external sort. */
+    size_t memory_used;      /**< Bytes of pipeline and sort buffers allocated. */
+} ConvertStats;
+
+/**
+ * @brief Fills in the default options (CSV, input order, 16 MB, report to stdout).
+ * @param options The options to fill.
+ */
+void convert_default_options(ConvertOptions *options);
+
+/**
+ * @brief Streams a contacts.csv file into another file.
+ * @param input_path CSV file to read (with or without its leading count line).
+ * @param output_path File to create.
+ * @param options Conversion settings.
+ * @param stats Output: counts and memory use (may be NULL).
+ * @return 0 on success, -1 if a file could not be opened, written, or the memory limit is too
+ * small to run the pipeline.
+ */
+int convert_contacts(const char *input_path, const char *output_path,
+                     const ConvertOptions *options, ConvertStats *stats);
+
+/**
+ * @brief Parses one "id,name,phone,email" line (email is the rest of the line) and validates it.
+ * @param line Start of the line.
+ * @param end End of the line, excluding the newline.
+ * @param contact Output contact (its @c next pointer is set to NULL).
+ * @return VALID, or why the line was rejected (too-long fields give INVALID_LENGTH).
+ */
+ValidationStatus convert_parse_record(const char *line, const char *end, Contact *contact);
+
+/**
+ * @brief Describes why convert_parse_record rejected a line, for reports.
+ * @param status The status returned by convert_parse_record.
+ * @return A short lowercase phrase.
+ */
+const char *convert_status_reason(ValidationStatus status);
+
+/**
+ * @brief Entry point for `addressbook convert <input> <output> [options]`.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_convert_command(int argc, char *argv[]);
+
+#endif // CONVERT_H
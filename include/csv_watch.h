@@ -0,0 +1,106 @@
+/**
+ * @file csv_watch.h
+ * @author Gajavelly Sai Suraj
+ * @brief Hot reload of contacts.csv: notices when another program changes the file and applies
+ * only the records that changed, flagging those that were also changed in the running app.
+ *
+ * The watch remembers the file as it was last loaded, saved, or reloaded (the base): one
+ * fingerprint of each record's "name,phone,email" text, sorted by ID. An inotify watch on the
+ * file's directory reports writes to it and renames onto it. A reload then reads the file once,
+ * fingerprinting each line without parsing it, and walks it against the base by ID:
+ *  - records whose fingerprint matches the base are skipped without being parsed;
+ *  - a record edited, added, or deleted on disk is applied to the book through ab_update,
+ *    ab_insert, or ab_remove, so every index is updated incrementally and the values are
+ *    validated as if they were typed in;
+ *  - if the running book has also changed that contact since the base and does not already
+ *    hold the same values, the change is a conflict: the book keeps its version, and the
+ *    conflict is reported once.
+ * Deletions are applied first and additions last, so a phone or email moving from one contact
+ * to another is not rejected as a duplicate on the way.
+ *
+ * The interactive app turns this on with --watch, checking for changes each time a menu choice
+ * is made and before acting on it, so a SAVE never silently overwrites someone else's edit.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef CSV_WATCH_H
+#define CSV_WATCH_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "address_book.h"
+
+/**
+ * @brief A watched contacts file.
+ */
+typedef struct CsvWatch CsvWatch;
+
+/**
+ * @brief What a reload did.
+ */
+typedef struct {
+    size_t examined;  /**< Records read from the file. */
+    size_t added;     /**< Contacts added to the book from the file. */
+    size_t updated;   /**< Contacts changed in the book from the file. */
+    size_t deleted;   /**< Contacts removed from the book because the file dropped them. */
+    size_t conflicts; /**< Changes left unapplied because the book changed the same contact. */
+    size_t rejected;  /**< Records that were malformed, repeated, or failed validation. */
+} CsvWatchStats;
+
+/**
+ * @brief Starts watching a contacts file. Call csv_watch_reset once the book is loaded.
+ * @param path Path of the CSV file (it need not exist yet).
+ * @return The watch, or NULL if inotify is unavailable or memory ran out.
+ */
+CsvWatch *csv_watch_open(const char *path);
+
+/**
+ * @brief Makes the book's current contacts the base, after loading or saving the file.
+ * @param watch The watch.
+ * @param book A const pointer to the AddressBook, which now matches the file.
+ * @return 0 on success, -1 if memory ran out.
+ */
+int csv_watch_reset(CsvWatch *watch, const AddressBook *book);
+
+/**
+ * @brief Reloads the file if inotify reported a change to it since the last call. Never blocks.
+ * @param watch The watch.
+ * @param book A pointer to the AddressBook.
+ * @param report Where conflicts and rejected records are described (may be NULL).
+ * @param stats Output: what the reload did (zeroed when there was nothing to do; may be NULL).
+ * @return 1 if the file was reloaded, 0 if it had not changed, -1 if it could not be read.
+ */
+int csv_watch_poll(CsvWatch *watch, AddressBook *book, FILE *report, CsvWatchStats *stats);
+
+/**
+ * @brief Compares the file with the base now and applies its changes to the book.
+ * @param watch The watch.
+ * @param book A pointer to the AddressBook.
+ * @param report Where conflicts and rejected records are described (may be NULL).
+ * @param stats Output: what the reload did (may be NULL).
+ * @return 0 on success, -1 if the file could not be read or memory ran out (book unchanged).
+ */
+int csv_watch_reload(CsvWatch *watch, AddressBook *book, FILE *report, CsvWatchStats *stats);
+
+/**
+ * @brief The inotify descriptor, readable when the directory changed (for poll or select).
+ * @param watch The watch.
+ */
+int csv_watch_fd(const CsvWatch *watch);
+
+/**
+ * @brief Stops watching.
+ * @param watch The watch (may be NULL).
+ */
+void csv_watch_close(CsvWatch *watch);
+
+/**
+ * @brief Interactive check for the app's --watch mode: reloads the file if it changed and tells
+ * the user what was picked up and what conflicted.
+ * @param watch The watch.
+ * @param book A pointer to the AddressBook.
+ */
+void check_contacts_file(CsvWatch *watch, AddressBook *book);
+
+#endif // CSV_WATCH_H
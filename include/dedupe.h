@@ -0,0 +1,104 @@
+/**
+ * @file dedupe.h
+ * @author Gajavelly Sai Suraj
+ * @brief Near-duplicate contact detection using normalization, blocking keys, and sorted
+ * neighbourhoods.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef DEDUPE_H
+#define DEDUPE_H
+
+#include <stddef.h>
+#include "address_book.h"
+
+// Default number of neighbours each record is compared with in every sorted pass.
+#define DEDUPE_DEFAULT_WINDOW 8
+
+// Default Jaro-Winkler similarity above which two names need only a matching phone suffix or
+// email local part to be considered the same person (a name alone never is).
+#define DEDUPE_DEFAULT_NAME_THRESHOLD 0.94
+
+/**
+ * @brief Tuning knobs for the dedupe job.
+ */
+typedef struct {
+    int window;            /**< Sliding window size for each sorted-neighbourhood pass. */
+    double name_threshold; /**< Name similarity (0..1) that needs only a weak second signal. */
+} DedupeOptions;
+
+/**
+ * @brief A group of contacts that are likely the same person.
+ */
+typedef struct {
+    const Contact **members; /**< Members sorted by ID; members[0] is the proposed survivor. */
+    size_t member_count;     /**< Number of members (always at least two). */
+} DuplicateCluster;
+
+/**
+ * @brief The result of a dedupe run: merge proposals plus some work statistics.
+ */
+typedef struct {
+    DuplicateCluster *clusters; /**< Clusters ordered by survivor ID. */
+    size_t cluster_count;       /**< Number of clusters. */
+    size_t record_count;        /**< Number of contacts examined. */
+    size_t comparisons;         /**< Number of pairwise comparisons performed. */
+} DedupeReport;
+
+/**
+ * @brief Fills in the default dedupe options.
+ * @param options The options to initialize.
+ */
+void dedupe_default_options(DedupeOptions *options);
+
+/**
+ * @brief Normalizes a name for comparison: lowercase, letters only, tokens sorted.
+ *
+ * "Ravi  Kumar", "ravi kumar" and "Kumar, Ravi" all normalize to "kumar ravi".
+ *
+ * @param name The name to normalize.
+ * @param out Output buffer of at least MAX_NAME_LENGTH bytes.
+ */
+void normalize_name(const char *name, char *out);
+
+/**
+ * @brief Jaro-Winkler similarity of two strings.
+ * @return A score between 0 (nothing in common) and 1 (identical).
+ */
+double jaro_winkler(const char *a, const char *b);
+
+/**
+ * @brief Finds clusters of likely duplicate contacts across the whole book.
+ *
+ * Two contacts pair only when their names are similar and a phone or email signal agrees,
+ * so people who merely share a common name are never proposed for merging.
+ *
+ * Each contact is reduced to a set of blocking keys. The records are sorted once per key
+ * and only records within @c window of each other are compared, so the job runs in
+ * O(N log N + N * window) rather than O(N^2).
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param options Tuning options, or NULL for the defaults.
+ * @return A heap-allocated report (free with free_dedupe_report), or NULL on allocation failure.
+ */
+DedupeReport *find_duplicate_clusters(const AddressBook *book, const DedupeOptions *options);
+
+/**
+ * @brief Prints the merge proposals of a dedupe report.
+ * @param report The report to print.
+ */
+void print_dedupe_report(const DedupeReport *report);
+
+/**
+ * @brief Runs the dedupe job with default options and prints its merge proposals.
+ * @param book A const pointer to the AddressBook.
+ */
+void show_duplicates(const AddressBook *book);
+
+/**
+ * @brief Frees a dedupe report.
+ * @param report The report to free (may be NULL).
+ */
+void free_dedupe_report(DedupeReport *report);
+
+#endif // DEDUPE_H
@@ -0,0 +1,98 @@
+/**
+ * @file lookup_index.h
+ * @author Gajavelly Sai Suraj
+ * @brief Read-only lookup file (contacts.idx) for one-shot lookups without loading the book.
+ *
+ * The file is a sorted snapshot of contacts.csv laid out to be used straight from a read-only
+ * memory mapping, with no parsing at open:
+ *  - a header with the record count and the size and modification time of the CSV it was
+ *    built from, so a stale file is noticed;
+ *  - one (id, string offset) entry per contact, sorted by ID;
+ *  - two arrays of entry numbers, sorted by phone and by email;
+ *  - the strings, each contact's "name\0phone\0email\0" stored back to back.
+ * A lookup is a binary search over one of these arrays, so it touches about log2(n) pages
+ * and its cost barely depends on the size of the book. `addressbook lookup` rebuilds the file
+ * when it finds it stale (or missing), so saving contacts.csv costs nothing extra.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef LOOKUP_INDEX_H
+#define LOOKUP_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+#define LOOKUP_INDEX_FILE_NAME "contacts.idx"
+#define LOOKUP_MAX_MATCHES 16
+
+/**
+ * @brief Fields a lookup can be answered by.
+ */
+typedef enum { LOOKUP_BY_ID, LOOKUP_BY_PHONE, LOOKUP_BY_EMAIL } LookupField;
+
+/**
+ * @brief An open, memory-mapped lookup file.
+ */
+typedef struct LookupIndex LookupIndex;
+
+/**
+ * @brief Builds a lookup file from a CSV file written by save_contacts_csv. The new file
+ * replaces the old one in a single rename, so concurrent lookups never see it half written.
+ * @param csv_path Path of the CSV file.
+ * @param index_path Path of the lookup file.
+ * @param skipped Output: number of damaged records left out (may be NULL).
+ * @return Number of contacts indexed, or -1 on an I/O or memory error.
+ */
+int lookup_index_build(const char *csv_path, const char *index_path, int *skipped);
+
+/**
+ * @brief Maps a lookup file.
+ * @param index_path Path of the lookup file.
+ * @return The index, or NULL if the file is missing, damaged, or could not be mapped.
+ */
+LookupIndex *lookup_index_open(const char *index_path);
+
+/**
+ * @brief Checks whether a lookup file still matches the CSV file it was built from.
+ * @param index The index.
+ * @param csv_path Path of the CSV file.
+ * @return true if the CSV file has the recorded size and modification time.
+ */
+bool lookup_index_is_current(const LookupIndex *index, const char *csv_path);
+
+/**
+ * @brief Number of contacts in a lookup file.
+ * @param index The index.
+ */
+size_t lookup_index_count(const LookupIndex *index);
+
+/**
+ * @brief Finds the contacts with a given ID, phone, or email.
+ * @param index The index.
+ * @param field Field to search.
+ * @param value Value to find (emails match in any case).
+ * @param matches Output: up to @p max contacts, copied out of the file.
+ * @param max Room in @p matches.
+ * @return The number of matching contacts (which may be more than @p max).
+ */
+int lookup_index_find(const LookupIndex *index, LookupField field, const char *value,
+                      Contact *matches, int max);
+
+/**
+ * @brief Unmaps a lookup file.
+ * @param index The index (may be NULL).
+ */
+void lookup_index_close(LookupIndex *index);
+
+/**
+ * @brief Runs `addressbook lookup --phone <number> | --email <address> | --id <id>`, printing
+ * each match as an "id,name,phone,email" line, or `addressbook lookup --build`.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status (1 when nothing matched).
+ */
+int run_lookup_command(int argc, char *argv[]);
+
+#endif // LOOKUP_INDEX_H
@@ -0,0 +1,98 @@
+/**
+ * @file merge.h
+ * @author Gajavelly Sai Suraj
+ * @brief Streaming two- and three-way merge of contacts.csv files (base, ours, theirs).
+ *
+ * The merge never loads a whole book. Inputs that are not already in ID order are first sorted
+ * by the converter's external sort; then one pass walks all of them by ID at once, holding a
+ * single record per input. For each ID:
+ *  - a side that matches the base takes the other side's change (edit, addition, or deletion);
+ *  - when both sides edited the same contact, each field is merged on its own, so an edit of
+ *    the phone in ours and of the email in theirs both apply;
+ *  - anything else (the same field changed differently, an edit against a deletion, or two
+ *    different contacts added under one ID) is a conflict, resolved in favour of the preferred
+ *    side and written to the report.
+ * Without a base, every contact present on only one side is kept.
+ *
+ * The same pass records a hash of every merged phone and email in fixed-size bitsets. Different
+ * contacts that ended up sharing a phone or email must repeat a hash, so:
+ *  - if no hash repeats (the usual case), the merged file is the result, after a single pass;
+ *  - otherwise the records with a repeated hash are gathered and checked in memory, and the
+ *    merged file is copied without the real duplicates;
+ *  - only if those records do not fit in memory is the book sorted by phone and by email
+ *    (external sorts again) to find them.
+ * Of contacts sharing a phone or email, the one with the lowest ID is kept and the others are
+ * reported and dropped, so the result always loads. They are not folded into one contact: a
+ * shared phone or email (a family landline, a team inbox) does not show that two records are
+ * the same person, so the report leaves that call to a human. Memory stays at the converter's
+ * memory limit whatever the size of the books.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef MERGE_H
+#define MERGE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @brief Which side wins a conflict.
+ */
+typedef enum {
+    MERGE_PREFER_OURS,
+    MERGE_PREFER_THEIRS
+} MergePreference;
+
+/**
+ * @brief Merge settings.
+ */
+typedef struct {
+    MergePreference prefer; /**< Side kept when a change conflicts. */
+    size_t memory_limit;    /**< Memory limit of each external sort, in bytes. */
+    FILE *report;           /**< Where conflicts and skipped records are described (may be NULL). */
+} MergeOptions;
+
+/**
+ * @brief What a merge did.
+ */
+typedef struct {
+    size_t records_written; /**< Contacts in the merged book. */
+    size_t from_ours;       /**< Contacts whose result includes a change made only in ours. */
+    size_t from_theirs;     /**< Contacts whose result includes a change made only in theirs. */
+    size_t deleted;         /**< Contacts removed because one side deleted them. */
+    size_t conflicts;       /**< IDs whose changes conflicted. */
+    size_t duplicates;      /**< Contacts dropped for reusing another contact's phone or email. */
+    size_t invalid;         /**< Input records skipped as malformed, invalid, or repeated IDs. */
+} MergeStats;
+
+/**
+ * @brief Fills in the default options (prefer ours, converter's default memory, report to stdout).
+ * @param options The options to fill.
+ */
+void merge_default_options(MergeOptions *options);
+
+/**
+ * @brief Merges two or three contacts.csv files into a new one.
+ * @param base_path The common ancestor, or NULL for a two-way merge.
+ * @param ours_path Our version of the book.
+ * @param theirs_path Their version of the book.
+ * @param output_path File to create (temporary files are created next to it and removed).
+ * @param options Merge settings.
+ * @param stats Output: what the merge did (may be NULL).
+ * @return 0 on success (even with conflicts), -1 if a file could not be read or written or the
+ * memory limit is too small.
+ */
+int merge_books(const char *base_path, const char *ours_path, const char *theirs_path,
+                const char *output_path, const MergeOptions *options, MergeStats *stats);
+
+/**
+ * @brief Runs `addressbook merge [--base <file>] [--prefer ours|theirs] [--memory <MB>]
+ * [--report <file>] <ours> <theirs> <output>`.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return 0 for a clean merge, 1 if there were conflicts or the merge failed.
+ */
+int run_merge_command(int argc, char *argv[]);
+
+#endif // MERGE_H
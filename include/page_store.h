@@ -0,0 +1,184 @@
+/**
+ * @file page_store.h
+ * @author Gajavelly Sai Suraj
+ * @brief Disk-backed contact storage in fixed-size pages, for books larger than memory.
+ *
+ * Everything lives in one data file (contacts.db) of PAGE_SIZE pages. Page 0 holds the file
+ * header; every other page belongs to one of four B+trees:
+ *  - the primary tree, keyed by ID, whose leaves hold the contact records;
+ *  - secondary trees on the folded name, the phone, and the email, whose keys are the value
+ *    followed by the ID (so every key is unique) and point back into the primary tree.
+ * Leaves are chained left to right for range and prefix scans. Deleting never merges pages;
+ * an emptied leaf simply stays in its chain.
+ *
+ * Pages are only touched through a buffer pool with a fixed number of frames. The pool uses
+ * CLOCK (second-chance) eviction and writes dirty pages back when they are evicted or flushed,
+ * so memory use stays at pool_pages * PAGE_SIZE however large the file grows. The file is
+ * consistent after page_store_flush or page_store_close; there is no journal for crashes.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef PAGE_STORE_H
+#define PAGE_STORE_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "contact_helper.h"
+
+#define PAGE_STORE_FILE_NAME "contacts.db"
+#define PAGE_SIZE 4096
+#define PAGE_STORE_MIN_POOL 16
+#define PAGE_STORE_DEFAULT_POOL 256
+
+/**
+ * @brief An open page store.
+ */
+typedef struct PageStore PageStore;
+
+/**
+ * @brief Buffer pool and file counters.
+ */
+typedef struct {
+    size_t contact_count; /**< Contacts in the store. */
+    size_t page_count;    /**< Pages in the data file, including the header. */
+    size_t pool_pages;    /**< Frames in the buffer pool. */
+    size_t hits;          /**< Page requests served from the pool. */
+    size_t misses;        /**< Page requests that had to read the file. */
+    size_t evictions;     /**< Frames reused for another page. */
+    size_t writes;        /**< Pages written back to the file. */
+} PageStoreStats;
+
+/**
+ * @brief Called for each contact of a scan.
+ * @return 0 to continue, non-zero to stop the scan.
+ */
+typedef int (*PageStoreVisitor)(const Contact *contact, void *context);
+
+/**
+ * @brief Opens a data file, creating an empty store if it does not exist.
+ * @param path Path of the data file.
+ * @param pool_pages Frames in the buffer pool (at least PAGE_STORE_MIN_POOL).
+ * @return The store, or NULL if the file could not be opened or is not a page store.
+ */
+PageStore *page_store_open(const char *path, size_t pool_pages);
+
+/**
+ * @brief Writes every dirty page and the header back to the file.
+ * @param store The store.
+ * @return 0 on success, -1 on an I/O error.
+ */
+int page_store_flush(PageStore *store);
+
+/**
+ * @brief Flushes and closes a store.
+ * @param store The store (always freed; may be NULL).
+ * @return 0 on success, -1 if the final flush failed.
+ */
+int page_store_close(PageStore *store);
+
+/**
+ * @brief Validates a new contact, checks phone and email for duplicates, and stores it.
+ * @param store The store.
+ * @param name Contact name.
+ * @param phone Contact phone.
+ * @param email Contact email.
+ * @param status Output: why the contact was rejected (VALID on success or I/O error).
+ * @return The new contact's ID, or -1 if it was rejected or an I/O error occurred.
+ */
+int page_store_add(PageStore *store, const char *name, const char *phone, const char *email,
+                   ValidationStatus *status);
+
+/**
+ * @brief Stores a contact under its own ID (for imports). The values are not validated.
+ * @param store The store.
+ * @param contact The contact to store.
+ * @return 0 on success, -1 if the ID, phone, or email is taken or an I/O error occurred.
+ */
+int page_store_insert(PageStore *store, const Contact *contact);
+
+/**
+ * @brief Reads a contact by ID through the primary tree.
+ * @param store The store.
+ * @param id The contact ID.
+ * @param contact Output contact (its @c next pointer is set to NULL).
+ * @return 1 if found, 0 if not, -1 on an I/O error.
+ */
+int page_store_get(PageStore *store, int id, Contact *contact);
+
+/**
+ * @brief Finds a contact by exact phone number through the phone index.
+ * @return 1 if found, 0 if not, -1 on an I/O error.
+ */
+int page_store_find_phone(PageStore *store, const char *phone, Contact *contact);
+
+/**
+ * @brief Finds a contact by email (case-insensitive) through the email index.
+ * @return 1 if found, 0 if not, -1 on an I/O error.
+ */
+int page_store_find_email(PageStore *store, const char *email, Contact *contact);
+
+/**
+ * @brief Changes a contact's name, phone, and email after validating them.
+ * @param store The store.
+ * @param id ID of the contact to change.
+ * @param values The new name, phone, and email.
+ * @param status Output: why the change was rejected (VALID on success or I/O error).
+ * @return 0 on success, -1 if it was rejected or an I/O error occurred.
+ */
+int page_store_update(PageStore *store, int id, const Contact *values, ValidationStatus *status);
+
+/**
+ * @brief Removes a contact by ID.
+ * @param store The store.
+ * @param id The contact ID.
+ * @return 0 on success, -1 if there is no such contact or an I/O error occurred.
+ */
+int page_store_remove(PageStore *store, int id);
+
+/**
+ * @brief Visits every contact in ID order.
+ * @return 0 when the scan completes or is stopped by @p visit, -1 on an I/O error.
+ */
+int page_store_scan(PageStore *store, PageStoreVisitor visit, void *context);
+
+/**
+ * @brief Visits, in name order, every contact whose name starts with @p prefix (ignoring case).
+ * @return 0 when the scan completes or is stopped by @p visit, -1 on an I/O error.
+ */
+int page_store_scan_name(PageStore *store, const char *prefix, PageStoreVisitor visit,
+                         void *context);
+
+/**
+ * @brief Reads the store's counters.
+ * @param store The store.
+ * @param stats Output counters.
+ */
+void page_store_stats(const PageStore *store, PageStoreStats *stats);
+
+/**
+ * @brief Streams a CSV file written by save_contacts_csv into the store, keeping IDs.
+ * @param store The store.
+ * @param path Path of the CSV file.
+ * @param skipped Output: records that were malformed, invalid, or duplicates (may be NULL).
+ * @return Number of contacts imported, or -1 if the file could not be read or on I/O error.
+ */
+int page_store_import_csv(PageStore *store, const char *path, int *skipped);
+
+/**
+ * @brief Writes every contact to a CSV file readable by load_contacts_csv.
+ * @param store The store.
+ * @param path Path of the CSV file.
+ * @return Number of contacts written, or -1 on error.
+ */
+int page_store_export_csv(PageStore *store, const char *path);
+
+/**
+ * @brief Runs `addressbook pages [--pool <pages>] <action> ...` against contacts.db.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_pages_command(int argc, char *argv[]);
+
+#endif // PAGE_STORE_H
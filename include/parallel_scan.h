@@ -0,0 +1,90 @@
+/**
+ * @file parallel_scan.h
+ * @author Gajavelly Sai Suraj
+ * @brief Multi-threaded full scans for searches no index can answer.
+ *
+ * The contacts are laid out as an array of pointers (taken from a snapshot when snapshots are
+ * enabled, so writers can keep going) and cut into chunks of PARALLEL_SCAN_CHUNK contacts.
+ * Each worker starts with an equal run of chunks and, once its own run is done, steals the
+ * back half of another worker's remaining run, so a slow stretch of the book does not leave
+ * the other cores idle. Every chunk writes its matches into its own slot range of the output,
+ * and the ranges are packed together afterwards, so matches come out in list order.
+ *
+ * The workers are one pool started by the first parallel scan and kept until the process exits
+ * (restarted larger if a scan asks for more threads than it has), so a scan does not pay for
+ * starting and joining threads. Scans from several threads take turns on it.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+#define PARALLEL_SCAN_CHUNK 4096         // contacts per unit of work
+#define PARALLEL_SCAN_MIN_CONTACTS 32768 // smaller books are scanned on the calling thread
+
+/**
+ * @brief Decides whether a contact matches. Called from several threads at once, so it must
+ * only read the contact and @p context.
+ */
+typedef bool (*ScanPredicate)(const Contact *contact, void *context);
+
+/**
+ * @brief How a scan was run.
+ */
+typedef struct {
+    int threads;   /**< Workers used (1 when scanned on the calling thread). */
+    size_t chunks; /**< Units of work the contacts were cut into. */
+    size_t steals; /**< Times an idle worker took chunks from another. */
+} ScanStats;
+
+/**
+ * @brief The matches of a scan, sized from the contacts the scan actually read. With snapshots
+ * enabled, the scan's snapshot stays open until parallel_scan_free, so the pointers stay valid
+ * while writers replace or remove those contacts.
+ */
+typedef struct {
+    Contact **matches;             /**< Matching contacts in list order (heap-allocated). */
+    size_t count;                  /**< Number of matches. */
+    size_t scanned;                /**< Number of contacts the predicate was run on. */
+    struct BookSnapshot *snapshot; /**< Snapshot the scan read, or NULL (private). */
+} ScanResult;
+
+/**
+ * @brief Reports how many workers a scan of @p contact_count contacts would use.
+ * @param contact_count Number of contacts to scan.
+ * @param thread_count Requested workers, or 0 for one per online processor.
+ * @return The worker count (1 means the scan runs on the calling thread).
+ */
+int parallel_scan_threads(size_t contact_count, int thread_count);
+
+/**
+ * @brief Collects every contact that satisfies a predicate, in list order.
+ *
+ * With snapshots enabled the scan reads one snapshot, even on the calling thread. Without
+ * them it reads the live list, so the book must not change until the scan returns, and the
+ * pointers stay valid until it next changes.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param match The predicate.
+ * @param context Passed through to @p match.
+ * @param thread_count Workers to use, or 0 for one per online processor.
+ * @param result Output: the matches (free with parallel_scan_free).
+ * @param stats Output: how the scan was run (may be NULL).
+ * @return 0 on success, -1 if memory could not be allocated (@p result is left empty). If the
+ * workers cannot be started, the scan runs on the calling thread instead.
+ */
+int parallel_scan(const AddressBook *book, ScanPredicate match, void *context, int thread_count,
+                  ScanResult *result, ScanStats *stats);
+
+/**
+ * @brief Frees a scan's matches and closes its snapshot.
+ * @param result The result to free (may be empty).
+ */
+void parallel_scan_free(ScanResult *result);
+
+#endif // PARALLEL_SCAN_H
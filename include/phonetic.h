@@ -0,0 +1,51 @@
+/**
+ * @file phonetic.h
+ * @author Gajavelly Sai Suraj
+ * @brief Soundex codes for name tokens, backing the "sounds like" search.
+ *
+ * Every alphabetic token of a name gets a four-character American Soundex code
+ * ("Srinivas" and "Shrinivas" are both S651, "Mohammed" and "Muhammad" both M530).
+ * The codes are kept in the book's phonetic hash index, so a query token is answered
+ * with one lookup instead of a scan.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef PHONETIC_H
+#define PHONETIC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+// Length of a Soundex code including its terminator (a letter and three digits).
+#define PHONETIC_CODE_LENGTH 5
+// A name can hold at most one token per two characters ("a b c ...").
+#define PHONETIC_MAX_TOKENS (MAX_NAME_LENGTH / 2)
+
+/**
+ * @brief Computes the Soundex code of the leading alphabetic run of @p token.
+ * @param token The token (case does not matter; scanning stops at the first non-letter).
+ * @param code Output buffer of PHONETIC_CODE_LENGTH bytes.
+ * @return 0 on success, -1 if @p token does not start with a letter.
+ */
+int soundex_code(const char *token, char code[PHONETIC_CODE_LENGTH]);
+
+/**
+ * @brief Computes the distinct Soundex codes of every token of a name.
+ * @param name The name.
+ * @param codes Output array of PHONETIC_MAX_TOKENS codes, in token order.
+ * @return Number of distinct codes written.
+ */
+int phonetic_name_codes(const char *name, char codes[][PHONETIC_CODE_LENGTH]);
+
+/**
+ * @brief Whether every query code is among the codes of @p name's tokens.
+ * @param name The contact name.
+ * @param query Codes from phonetic_name_codes of the query.
+ * @param query_count Number of query codes.
+ */
+bool phonetic_name_matches(const char *name, char query[][PHONETIC_CODE_LENGTH],
+                           int query_count);
+
+#endif // PHONETIC_H
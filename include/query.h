@@ -0,0 +1,161 @@
+/**
+ * @file query.h
+ * @author Gajavelly Sai Suraj
+ * @brief A small multi-predicate query language with an index-aware planner.
+ *
+ * Queries combine field predicates with AND / OR (AND binds tighter) and parentheses:
+ *
+ *     name ^= 'Sa' AND domain = 'corp.com' AND phone ^= '98'
+ *     (email = 'a@b.com' OR phone = '9845012345') AND name ~= 'kumar'
+ *
+ * Fields: id, name, phone, email, domain. Operators: `=` (equals), `^=` or `prefix`
+ * (starts with), `~=` or `contains`. Name, email, and domain compare case-insensitively.
+ *
+ * The planner answers equality from the hash indexes and a prefix on name, phone, or email
+ * from the autocomplete module's sorted arrays (when the book has autocomplete enabled).
+ * Contains, and prefixes on id or domain, always take a full scan.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+#define QUERY_MAX_LENGTH 256
+#define QUERY_ERROR_LENGTH 128
+
+struct QueryCache; // query_cache.h
+
+/**
+ * @brief Contact fields a predicate can test.
+ */
+typedef enum { FIELD_ID, FIELD_NAME, FIELD_PHONE, FIELD_EMAIL, FIELD_DOMAIN } QueryField;
+
+/**
+ * @brief Comparison applied by a predicate.
+ */
+typedef enum { OP_EQUALS, OP_PREFIX, OP_CONTAINS } QueryOperator;
+
+/**
+ * @brief Kinds of node in a parsed query tree.
+ */
+typedef enum { NODE_PREDICATE, NODE_AND, NODE_OR } QueryNodeType;
+
+/**
+ * @brief A node of a parsed query: either a predicate or an AND/OR of two sub-queries.
+ */
+typedef struct QueryNode {
+    QueryNodeType type;             /**< Predicate, AND, or OR. */
+    QueryField field;               /**< Field tested (predicates only). */
+    QueryOperator op;               /**< Comparison (predicates only). */
+    char value[MAX_EMAIL_LENGTH];   /**< Normalized comparison value (predicates only). */
+    struct QueryNode *left;         /**< Left operand (AND/OR only). */
+    struct QueryNode *right;        /**< Right operand (AND/OR only). */
+} QueryNode;
+
+/**
+ * @brief A parsed query.
+ */
+typedef struct {
+    QueryNode *root; /**< Root of the query tree. */
+} Query;
+
+/**
+ * @brief The contacts matched by a query, ordered by ID.
+ */
+typedef struct {
+    const Contact **contacts; /**< Matching contacts (heap-allocated). */
+    size_t count;             /**< Number of matches. */
+    size_t examined;          /**< Number of candidate contacts the predicates were run on. */
+} QueryResult;
+
+/**
+ * @brief Parses query text into a query tree.
+ * @param text The query text.
+ * @param error Buffer receiving a message when parsing fails (may be NULL).
+ * @param error_size Size of @p error.
+ * @return The parsed query (free with query_free), or NULL on a syntax or memory error.
+ */
+Query *query_parse(const char *text, char *error, size_t error_size);
+
+/**
+ * @brief Frees a parsed query.
+ * @param query The query to free (may be NULL).
+ */
+void query_free(Query *query);
+
+/**
+ * @brief Makes an independent copy of a parsed query.
+ * @param query The query to copy.
+ * @return The copy (free with query_free), or NULL if memory could not be allocated.
+ */
+Query *query_copy(const Query *query);
+
+/**
+ * @brief Evaluates a query against a single contact.
+ * @param query The query.
+ * @param contact The contact.
+ * @return true if the contact satisfies the query.
+ */
+bool query_matches(const Query *query, const Contact *contact);
+
+/**
+ * @brief Writes the canonical text form of a query (normalized values, explicit grouping).
+ * @param query The query.
+ * @param buffer Output buffer.
+ * @param size Size of @p buffer.
+ */
+void query_to_string(const Query *query, char *buffer, size_t size);
+
+/**
+ * @brief Plans and runs a query against the address book.
+ *
+ * The planner fetches candidates through the most selective index it can use and runs the
+ * full predicate tree only on those candidates; it falls back to a list scan otherwise.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param query The query to run.
+ * @param result Output: the matches (release with query_result_free).
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int query_execute(const AddressBook *book, const Query *query, QueryResult *result);
+
+/**
+ * @brief Like query_execute, with a limit on the threads a full scan may use.
+ * @param book A const pointer to the AddressBook.
+ * @param query The query to run.
+ * @param thread_count Scan workers, or 0 for one per online processor (1 scans on the calling
+ * thread, for callers that are already one of several workers).
+ * @param result Output: the matches (release with query_result_free).
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int query_execute_threads(const AddressBook *book, const Query *query, int thread_count,
+                          QueryResult *result);
+
+/**
+ * @brief Frees the contact array held by a query result.
+ * @param result The result to release.
+ */
+void query_result_free(QueryResult *result);
+
+/**
+ * @brief Prints the plan the planner would choose for a query, with row estimates.
+ * @param book A const pointer to the AddressBook.
+ * @param query The query to explain.
+ * @param out Stream to print to.
+ */
+void query_explain(const AddressBook *book, const Query *query, FILE *out);
+
+/**
+ * @brief Interactive prompt that reads a query, explains its plan, and lists the matches.
+ * @param book A const pointer to the AddressBook.
+ * @param cache Cache to answer repeated queries from (see query_cache.h), or NULL.
+ */
+void run_query(const AddressBook *book, struct QueryCache *cache);
+
+#endif // QUERY_H
@@ -0,0 +1,89 @@
+/**
+ * @file query_cache.h
+ * @author Gajavelly Sai Suraj
+ * @brief Bounded LRU cache of query results, invalidated precisely by the book's change feed.
+ *
+ * Results are keyed by the query's canonical text (query_to_string), so queries that differ
+ * only in case, spacing, or operator spelling share an entry. Each entry keeps its own copy of
+ * the query, and the cache subscribes to the book's change feed: for every create, edit, or
+ * delete it runs the entry queries on the contact's values before and after the change, and
+ * drops only the entries whose results that contact was or now would be part of. Every other
+ * entry stays valid, since none of its contacts changed and no new contact joined it.
+ *
+ * The cache holds at most a set number of entries and of contacts across all entries, evicting
+ * the least recently used entries to stay within both.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "query.h"
+
+#define QUERY_CACHE_DEFAULT_ENTRIES 64
+#define QUERY_CACHE_DEFAULT_CONTACTS 1000000 // contacts held across all entries
+
+/**
+ * @brief A cache of query results for one book.
+ */
+typedef struct QueryCache QueryCache;
+
+/**
+ * @brief Query cache counters.
+ */
+typedef struct {
+    size_t lookups;       /**< Queries run through the cache. */
+    size_t hits;          /**< Queries answered from a cached result. */
+    size_t invalidations; /**< Entries dropped because a change touched their results. */
+    size_t evictions;     /**< Entries dropped to stay within the bounds. */
+    size_t entries;       /**< Entries held now. */
+    size_t contacts;      /**< Contacts held across all entries now. */
+} QueryCacheStats;
+
+/**
+ * @brief Creates an empty cache. Attach it to a book before using it.
+ * @param max_entries Most results held at once (at least 1).
+ * @param max_contacts Most contacts held across all results; larger results are not cached.
+ * @return The cache, or NULL if memory could not be allocated.
+ */
+QueryCache *query_cache_create(size_t max_entries, size_t max_contacts);
+
+/**
+ * @brief Ties the cache to a book, turning on its change feed (without a log) to follow it.
+ * @param cache The cache.
+ * @param book A pointer to the AddressBook.
+ * @return 0 on success, -1 if already attached or the feed could not be enabled or joined.
+ */
+int query_cache_attach(QueryCache *cache, AddressBook *book);
+
+/**
+ * @brief Answers a query from the cache, or runs it with query_execute and caches the result.
+ *
+ * A cache that is NULL or not attached to @p book just runs the query.
+ *
+ * @param cache The cache (may be NULL).
+ * @param book A const pointer to the AddressBook.
+ * @param query The query to run.
+ * @param result Output: the matches (release with query_result_free); @c examined is 0 on a hit.
+ * @return 1 if answered from the cache, 0 if the query was run, -1 if memory ran out.
+ */
+int query_cache_execute(QueryCache *cache, const AddressBook *book, const Query *query,
+                        QueryResult *result);
+
+/**
+ * @brief Reads the cache's counters.
+ * @param cache The cache.
+ * @param stats Output counters.
+ */
+void query_cache_stats(const QueryCache *cache, QueryCacheStats *stats);
+
+/**
+ * @brief Detaches the cache from its book and frees it.
+ * @param cache The cache (may be NULL).
+ */
+void query_cache_free(QueryCache *cache);
+
+#endif // QUERY_CACHE_H
@@ -0,0 +1,105 @@
+/**
+ * @file replica.h
+ * @author Gajavelly Sai Suraj
+ * @brief Read replicas: other processes on the same host that follow the primary's change log
+ * into their own in-memory book and answer read-only queries from it.
+ *
+ * The primary is the interactive app run with --feed, which appends every committed change to
+ * the change log (change_feed.h) and flushes it as it goes. A replica loads the same starting
+ * CSV, then tails the log with a ChangeCursor and applies each record to its own book through
+ * the library, so its indexes (and its query cache) stay in step incrementally. Records carry
+ * absolute values, so applying them is idempotent: a create or update of a contact sets it to
+ * the record's values whether or not it exists yet, and a delete of a missing contact does
+ * nothing. That lets a replica start from a CSV saved at any point covered by the log and replay
+ * the log from its start (or from --from) to converge on the primary's book. Values were
+ * validated on the primary and are not validated again.
+ *
+ * Lag is reported in changes (the log's last sequence against the last one applied), in bytes
+ * of log not yet read, and in time (how long after the primary made a change it was applied).
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef REPLICA_H
+#define REPLICA_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "change_feed.h"
+#include "query.h"
+
+/**
+ * @brief A replica of the primary's book.
+ */
+typedef struct Replica Replica;
+
+/**
+ * @brief How far a replica has got.
+ */
+typedef struct {
+    unsigned long long applied_sequence; /**< Last change applied (0 for none). */
+    unsigned long long log_sequence;     /**< Last change in the log. */
+    unsigned long long behind;           /**< Changes in the log not yet applied. */
+    long backlog_bytes;                  /**< Bytes of log not yet read (-1 if unknown). */
+    long long apply_lag_ms;              /**< How long after it was made the last change was
+                                              applied (-1 if none carried a time). */
+    size_t applied;                      /**< Changes applied since the replica started. */
+    size_t contacts;                     /**< Contacts in the replica's book. */
+} ReplicaStatus;
+
+/**
+ * @brief Starts a replica from a CSV and a change log.
+ * @param csv_path Starting contacts (a missing file starts an empty book).
+ * @param log_path The primary's change log (it need not exist yet).
+ * @param from_sequence Changes up to and including this number are already in the CSV (0 to
+ * replay the whole log).
+ * @return The replica, or NULL if the CSV is damaged or memory ran out.
+ */
+Replica *replica_open(const char *csv_path, const char *log_path,
+                      unsigned long long from_sequence);
+
+/**
+ * @brief Applies every complete change the log holds beyond what was already applied.
+ * @param replica The replica.
+ * @return Number of changes applied, or -1 if the log could not be read or memory ran out.
+ */
+int replica_catch_up(Replica *replica);
+
+/**
+ * @brief The replica's book, for read-only queries (valid until the next replica_catch_up).
+ * @param replica The replica.
+ */
+const AddressBook *replica_book(const Replica *replica);
+
+/**
+ * @brief Runs a query against the replica's book through its own query cache.
+ * @param replica The replica.
+ * @param query The query to run.
+ * @param result Output: the matches (release with query_result_free).
+ * @return 1 if answered from the cache, 0 if the query was run, -1 if memory ran out.
+ */
+int replica_query(Replica *replica, const Query *query, QueryResult *result);
+
+/**
+ * @brief Reads the replica's progress and lag.
+ * @param replica The replica.
+ * @param status Output status.
+ */
+void replica_status(Replica *replica, ReplicaStatus *status);
+
+/**
+ * @brief Stops following the log and frees the replica's book.
+ * @param replica The replica (may be NULL).
+ */
+void replica_close(Replica *replica);
+
+/**
+ * @brief Runs `addressbook replica [--csv <file>] [--log <file>] [--from <sequence>]`, answering
+ * read-only commands from standard input while following the log.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_replica_command(int argc, char *argv[]);
+
+#endif // REPLICA_H
@@ -0,0 +1,86 @@
+/**
+ * @file search_cursor.h
+ * @author Gajavelly Sai Suraj
+ * @brief Cursor over the contacts matching a search, yielding one match at a time.
+ *
+ * A cursor lives wherever the caller puts it (usually the stack) and allocates nothing, however
+ * many contacts match. Each call to search_cursor_next finds the next match and returns it
+ * straight away, so the first result is ready before the rest of the book is looked at, and a
+ * caller that has seen enough simply stops calling. Searches are answered from the book's hash
+ * indexes when they are available: an exact name, phone, or email walks the one bucket for the
+ * value, "sounds like" walks the smallest bucket among the query's Soundex codes, and a partial
+ * phone number walks the bucket of its last PHONE_SUFFIX_DIGITS digits. With indexing suspended
+ * the cursor walks the list instead.
+ *
+ * Matches are yielded in index order (the order contacts were indexed), or list order when
+ * walking the list. The book must not change while a cursor is open on it.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef SEARCH_CURSOR_H
+#define SEARCH_CURSOR_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "contact_index.h"
+#include "phonetic.h"
+
+/**
+ * @brief Outcomes of search_cursor_open.
+ */
+typedef enum {
+    SEARCH_CURSOR_OK = 0,              /**< The cursor is open. */
+    SEARCH_CURSOR_BAD_FIELD = -1,      /**< The option is not a search (e.g. SEARCH_CANCEL). */
+    SEARCH_CURSOR_TOO_FEW_DIGITS = -2  /**< Phone suffix shorter than PHONE_SUFFIX_DIGITS. */
+} SearchCursorStatus;
+
+/**
+ * @brief Position of a search in progress. Fields are private to search_cursor.c.
+ */
+typedef struct {
+    const AddressBook *book;
+    SearchOption field;
+    char value[MAX_EMAIL_LENGTH];  /**< Exact value, or the digits of a partial phone. */
+    char codes[PHONETIC_MAX_TOKENS][PHONETIC_CODE_LENGTH]; /**< Codes, for sounds-like. */
+    int code_count;                /**< Number of @c codes. */
+    const IndexBucket *bucket;     /**< Index bucket being walked, or NULL. */
+    const PhoneTailIndex *tails;   /**< Phone suffix index being walked, or NULL. */
+    int tail;                      /**< Trailing digits looked up in @c tails. */
+    size_t position;               /**< Next entry of @c bucket (or probe of @c tails). */
+    const Contact *node;           /**< Next contact of the list, when walking the list. */
+    size_t limit;                  /**< Most matches to yield, 0 for no limit. */
+    size_t yielded;                /**< Matches yielded so far. */
+    size_t examined;               /**< Contacts examined so far. */
+    int done;
+} SearchCursor;
+
+/**
+ * @brief Starts a search. Nothing is examined until the first search_cursor_next.
+ * @param cursor The cursor to set up.
+ * @param book A const pointer to the AddressBook.
+ * @param field SEARCH_BY_NAME, SEARCH_BY_PHONE, SEARCH_BY_EMAIL (exact matches),
+ * SEARCH_SOUNDS_LIKE (every query token sounds like a token of the name), or
+ * SEARCH_PHONE_ENDS_WITH (the phone ends in the value's digits, or the value's digits end in the
+ * phone, as with a country code; see phone_suffix_matches).
+ * @param value The value to find.
+ * @param limit Most matches to yield, 0 for no limit.
+ * @return SEARCH_CURSOR_OK, or the reason the search cannot start.
+ */
+SearchCursorStatus search_cursor_open(SearchCursor *cursor, const AddressBook *book,
+                                      SearchOption field, const char *value, size_t limit);
+
+/**
+ * @brief Finds the next match.
+ * @param cursor An open cursor.
+ * @return The next matching contact, or NULL once there are no more or the limit is reached.
+ */
+Contact *search_cursor_next(SearchCursor *cursor);
+
+/**
+ * @brief Contacts the cursor has looked at so far (for comparing index walks with scans).
+ * @param cursor An open cursor.
+ */
+size_t search_cursor_examined(const SearchCursor *cursor);
+
+#endif // SEARCH_CURSOR_H
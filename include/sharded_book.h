@@ -0,0 +1,152 @@
+/**
+ * @file sharded_book.h
+ * @author Gajavelly Sai Suraj
+ * @brief Address books hash-partitioned by phone across N shard files.
+ *
+ * Every shard is an ordinary AddressBook with its own indexes, stored in its own CSV file.
+ * Shards are loaded, saved, and queried in parallel on a thread pool. Because contacts are
+ * partitioned by phone, a phone number can only ever live in one shard; email uniqueness is
+ * checked against the email index of every shard. IDs are allocated from one global counter.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef SHARDED_BOOK_H
+#define SHARDED_BOOK_H
+
+#include "address_book.h"
+#include "contact_helper.h"
+#include "query.h"
+#include "thread_pool.h"
+
+#define SHARD_FILE_PATTERN "contacts.shard%d.csv"
+#define SHARD_MAX_COUNT 64
+#define SHARD_PATH_LENGTH 256
+
+/**
+ * @brief A set of shard books plus the pool that works on them.
+ */
+typedef struct {
+    AddressBook *shards; /**< One book per shard. */
+    int shard_count;     /**< Number of shards. */
+    int next_id;         /**< Next ID handed out across all shards. */
+    ThreadPool *pool;    /**< Workers used for loads, saves, and queries. */
+} ShardedBook;
+
+/**
+ * @brief Creates empty shards and starts the worker pool.
+ * @param sharded The sharded book to initialize.
+ * @param shard_count Number of shards (1 to SHARD_MAX_COUNT).
+ * @param thread_count Number of worker threads (values below 1 use one per shard).
+ * @return 0 on success, -1 on a bad count or memory error.
+ */
+int sharded_book_init(ShardedBook *sharded, int shard_count, int thread_count);
+
+/**
+ * @brief Frees every shard and stops the worker pool.
+ * @param sharded The sharded book.
+ */
+void sharded_book_free(ShardedBook *sharded);
+
+/**
+ * @brief The shard that owns a phone number.
+ * @param sharded The sharded book.
+ * @param phone The phone number.
+ * @return The shard number.
+ */
+int shard_for_phone(const ShardedBook *sharded, const char *phone);
+
+/**
+ * @brief Total number of contacts across all shards.
+ * @param sharded The sharded book.
+ * @return The contact count.
+ */
+int sharded_book_count(const ShardedBook *sharded);
+
+/**
+ * @brief Loads every shard file in parallel.
+ *
+ * Missing shard files count as empty shards. Files numbered past the last shard (left by a
+ * larger shard count) are read too, and contacts found in the wrong shard are moved to the
+ * shard that owns their phone, so the shard count can change between runs.
+ *
+ * @param sharded The sharded book (its shards should be empty).
+ * @param pattern printf pattern with one %d for the shard number (e.g. SHARD_FILE_PATTERN).
+ * @return Number of contacts loaded, or -1 if a shard file is damaged.
+ */
+int sharded_book_load(ShardedBook *sharded, const char *pattern);
+
+/**
+ * @brief Saves every shard to its own file in parallel, removing files numbered past the last
+ * shard.
+ * @param sharded The sharded book.
+ * @param pattern printf pattern with one %d for the shard number.
+ * @return Number of contacts written, or -1 if any shard could not be written.
+ */
+int sharded_book_save(const ShardedBook *sharded, const char *pattern);
+
+/**
+ * @brief Validates a new contact, checks phone and email across all shards, and adds it.
+ * @param sharded The sharded book.
+ * @param name Contact name.
+ * @param phone Contact phone.
+ * @param email Contact email.
+ * @param status Output: why the contact was rejected (VALID on success, INVALID_NO_MEMORY if
+ * memory ran out).
+ * @return The new contact's ID, or -1 if it was rejected or memory ran out.
+ */
+int sharded_book_add(ShardedBook *sharded, const char *name, const char *phone,
+                     const char *email, ValidationStatus *status);
+
+/**
+ * @brief Copies every contact of a single book into the shards, keeping their IDs.
+ * @param sharded The sharded book.
+ * @param book The book to distribute.
+ * @return Number of contacts copied, or -1 if memory ran out.
+ */
+int sharded_book_import(ShardedBook *sharded, const AddressBook *book);
+
+/**
+ * @brief Finds a contact by ID in whichever shard holds it.
+ * @param sharded The sharded book.
+ * @param id The contact ID.
+ * @return The contact, or NULL if no shard holds it.
+ */
+Contact *sharded_book_find(const ShardedBook *sharded, int id);
+
+/**
+ * @brief Changes a contact's name, phone, and email, moving it if its phone changes shard.
+ * @param sharded The sharded book.
+ * @param id ID of the contact to change.
+ * @param values The new name, phone, and email.
+ * @return VALID on success, INVALID_NOT_FOUND if @p id is unknown, INVALID_NO_MEMORY if memory
+ * ran out, or the first failing check.
+ */
+ValidationStatus sharded_book_update(ShardedBook *sharded, int id, const Contact *values);
+
+/**
+ * @brief Removes a contact by ID.
+ * @param sharded The sharded book.
+ * @param id The contact ID.
+ * @return 0 on success, -1 if no shard holds it.
+ */
+int sharded_book_remove(ShardedBook *sharded, int id);
+
+/**
+ * @brief Runs a query on every shard in parallel and merges the matches by ID.
+ * @param sharded The sharded book.
+ * @param query The query.
+ * @param result Output: the merged matches (release with query_result_free).
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int sharded_book_query(const ShardedBook *sharded, const Query *query, QueryResult *result);
+
+/**
+ * @brief Entry point for `addressbook shards <count> split|stats|query "<query>"`.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_shards_command(int argc, char *argv[]);
+
+#endif // SHARDED_BOOK_H
@@ -0,0 +1,202 @@
+/**
+ * @file shared_book.h
+ * @author Gajavelly Sai Suraj
+ * @brief A book in POSIX shared memory, used by several processes at once.
+ *
+ * Every process maps the same region, so all of them read one copy of the contacts in place and
+ * see each other's changes as soon as they are made; there is nothing to load or save between
+ * them. Since each process maps the region at its own address, nothing in it is a pointer:
+ * records are numbered 1..capacity and linked by record number. The region holds
+ *  - a header with the counts, the list ends, the free-record chain, and a change counter;
+ *  - three hash tables (ID, phone, email folded to lowercase) of chain heads;
+ *  - one link entry per record: its place in the list and in each hash chain;
+ *  - the records themselves (SharedContact), which readers are handed directly.
+ * The capacity is fixed when the region is created, so it never has to be remapped.
+ *
+ * Access is coordinated by a process-shared read-write lock in the header: lookups and scans
+ * share it, changes take it exclusively, so readers never see a half-made change. A change is
+ * validated and applied under one lock, so two processes cannot both claim a phone or email.
+ * The lock is not robust: a process killed while changing the book leaves it held, and the
+ * region must then be destroyed and recreated (from a CSV written with `shared save`).
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef SHARED_BOOK_H
+#define SHARED_BOOK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "address_book.h"
+#include "contact_helper.h"
+
+#define SHARED_BOOK_DEFAULT_NAME "/addressbook"
+#define SHARED_BOOK_DEFAULT_CAPACITY 100000
+#define SHARED_BOOK_MAX_CAPACITY 50000000
+
+/**
+ * @brief A contact as stored in the shared region.
+ */
+typedef struct {
+    int32_t id;                   /**< Contact ID (0 for a free record). */
+    char name[MAX_NAME_LENGTH];   /**< Name of the contact. */
+    char phone[MAX_PHONE_LENGTH]; /**< Phone number of the contact. */
+    char email[MAX_EMAIL_LENGTH]; /**< Email address of the contact. */
+} SharedContact;
+
+/**
+ * @brief Fields with an index in the region.
+ */
+typedef enum { SHARED_BY_ID, SHARED_BY_PHONE, SHARED_BY_EMAIL } SharedField;
+
+/**
+ * @brief A process's handle on a shared book.
+ */
+typedef struct SharedBook SharedBook;
+
+/**
+ * @brief Shared book counters.
+ */
+typedef struct {
+    size_t contacts;       /**< Contacts in the book. */
+    size_t capacity;       /**< Contacts the region can hold. */
+    size_t region_bytes;   /**< Size of the mapping. */
+    int next_id;           /**< ID the next new contact gets. */
+    uint64_t changes;      /**< Changes made since the region was created, by any process. */
+} SharedBookStats;
+
+/**
+ * @brief Called for each contact of a scan or lookup, with the record in the shared region (it
+ * must not be kept after returning, since the lock is released then).
+ * @return 0 to continue, non-zero to stop.
+ */
+typedef int (*SharedBookVisitor)(const SharedContact *contact, void *context);
+
+/**
+ * @brief Creates a new, empty shared book.
+ * @param name Shared memory object name ("/addressbook").
+ * @param capacity Most contacts it will hold (1..SHARED_BOOK_MAX_CAPACITY).
+ * @return The book, or NULL if it already exists, the capacity is out of range, or the region
+ * could not be created.
+ */
+SharedBook *shared_book_create(const char *name, size_t capacity);
+
+/**
+ * @brief Maps an existing shared book (waiting briefly if it is still being created).
+ * @param name Shared memory object name.
+ * @return The book, or NULL if it does not exist or is not a shared book.
+ */
+SharedBook *shared_book_open(const char *name);
+
+/**
+ * @brief Unmaps the book from this process. The region lives on for the others.
+ * @param book The book (may be NULL).
+ */
+void shared_book_close(SharedBook *book);
+
+/**
+ * @brief Removes a shared book's name; its memory is freed once every process has closed it.
+ * @param name Shared memory object name.
+ * @return 0 on success, -1 if there was no such book.
+ */
+int shared_book_destroy(const char *name);
+
+/**
+ * @brief Validates and adds a new contact with the next free ID.
+ * @param book The book.
+ * @param name Contact name.
+ * @param phone Contact phone (unique in the book).
+ * @param email Contact email (unique in the book, ignoring case).
+ * @param id Output: the new contact's ID (may be NULL).
+ * @return VALID, the first failing check, or INVALID_NO_MEMORY when the region is full.
+ */
+ValidationStatus shared_book_add(SharedBook *book, const char *name, const char *phone,
+                                 const char *email, int *id);
+
+/**
+ * @brief Validates and applies new values to a contact; a NULL value keeps the current one.
+ * @param book The book.
+ * @param id ID of the contact to change.
+ * @param name New name, or NULL.
+ * @param phone New phone, or NULL.
+ * @param email New email, or NULL.
+ * @return VALID, INVALID_NOT_FOUND, or the first failing check.
+ */
+ValidationStatus shared_book_update(SharedBook *book, int id, const char *name,
+                                    const char *phone, const char *email);
+
+/**
+ * @brief Removes a contact by ID.
+ * @param book The book.
+ * @param id The contact ID.
+ * @return VALID, or INVALID_NOT_FOUND.
+ */
+ValidationStatus shared_book_remove(SharedBook *book, int id);
+
+/**
+ * @brief Finds the contact with a given ID, phone, or email (ignoring case) through the
+ * region's hash tables, and shows it to @p visit in place.
+ * @param book The book.
+ * @param field Field to search.
+ * @param value Value to find.
+ * @param visit Called with the contact, under the read lock.
+ * @param context Passed through to @p visit.
+ * @return 1 if found, 0 if not.
+ */
+int shared_book_lookup(SharedBook *book, SharedField field, const char *value,
+                       SharedBookVisitor visit, void *context);
+
+/**
+ * @brief Copies out the contact with a given ID.
+ * @param book The book.
+ * @param id The contact ID.
+ * @param contact Output contact (its @c next pointer is set to NULL).
+ * @return 1 if found, 0 if not.
+ */
+int shared_book_get(SharedBook *book, int id, Contact *contact);
+
+/**
+ * @brief Visits every contact in the order they were added, in place and under the read lock.
+ * @param book The book.
+ * @param visit Called for each contact.
+ * @param context Passed through to @p visit.
+ * @return Number of contacts visited.
+ */
+size_t shared_book_scan(SharedBook *book, SharedBookVisitor visit, void *context);
+
+/**
+ * @brief Reads the book's counters.
+ * @param book The book.
+ * @param stats Output counters.
+ */
+void shared_book_stats(SharedBook *book, SharedBookStats *stats);
+
+/**
+ * @brief Adds every contact from a CSV file written by save_contacts_csv, keeping IDs.
+ * @param book The book.
+ * @param path Path of the CSV file.
+ * @param skipped Output: records that were malformed, invalid, repeated, or did not fit (may be
+ * NULL).
+ * @return Number of contacts added, or -1 if the file could not be read.
+ */
+int shared_book_import_csv(SharedBook *book, const char *path, int *skipped);
+
+/**
+ * @brief Writes every contact to a CSV file readable by load_contacts_csv, from one consistent
+ * view of the book.
+ * @param book The book.
+ * @param path Path of the CSV file.
+ * @return Number of contacts written, or -1 if the file could not be written.
+ */
+int shared_book_export_csv(SharedBook *book, const char *path);
+
+/**
+ * @brief Runs `addressbook shared [--name <name>] <action> ...`.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_shared_command(int argc, char *argv[]);
+
+#endif // SHARED_BOOK_H
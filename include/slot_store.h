@@ -0,0 +1,133 @@
+/**
+ * @file slot_store.h
+ * @author Gajavelly Sai Suraj
+ * @brief Record-addressable data file (contacts.slots) where every contact lives in a fixed-size
+ * slot, so an edit or delete is persisted with one positioned write of one record.
+ *
+ * The file is an array of SLOT_SIZE-byte slots. Slot 0 is the header; every other slot holds
+ * one contact (ID, name, phone, email, and a checksum) or is free (ID 0). A slot never straddles
+ * a 4 KiB page, and each one carries its own checksum, so a torn write is noticed on the next
+ * open and only that one record is lost.
+ *
+ * The store keeps two small maps in memory, rebuilt by a scan when the file is opened:
+ *  - contact ID to slot number, so an edit knows where to write;
+ *  - the free-slot list, so a create reuses a deleted contact's slot before growing the file.
+ * A create, edit, or delete therefore costs one pwrite of SLOT_SIZE bytes (plus an fdatasync
+ * when opened with sync_writes), however many contacts the book holds. Once attached to a book
+ * the store follows it through the change feed, so every library change reaches the file.
+ *
+ * Slots are written in the machine's byte order; the file is not meant to move between
+ * machines (export it as CSV for that).
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef SLOT_STORE_H
+#define SLOT_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "address_book.h"
+
+#define SLOT_STORE_FILE_NAME "contacts.slots"
+#define SLOT_SIZE 128
+
+/**
+ * @brief An open slot file.
+ */
+typedef struct SlotStore SlotStore;
+
+/**
+ * @brief Slot file counters.
+ */
+typedef struct {
+    size_t slots;         /**< Record slots in the file (not counting the header). */
+    size_t contacts;      /**< Slots holding a contact. */
+    size_t free_slots;    /**< Slots waiting to be reused. */
+    size_t damaged;       /**< Slots found with a bad checksum or a repeated ID at open. */
+    size_t writes;        /**< Positioned record writes since the file was opened. */
+    size_t failed_writes; /**< Writes that failed (the book and file then disagree). */
+} SlotStoreStats;
+
+/**
+ * @brief Opens a slot file, creating an empty one if it does not exist, and scans it to build
+ * the ID and free-slot maps. Damaged slots are counted and reused as free slots.
+ * @param path Path of the slot file.
+ * @param sync_writes If true, every record write is followed by fdatasync.
+ * @return The store, or NULL if the file could not be opened or is not a slot file.
+ */
+SlotStore *slot_store_open(const char *path, bool sync_writes);
+
+/**
+ * @brief Appends every contact in the file to the book, keeping their IDs.
+ * @param store The store.
+ * @param book A pointer to the AddressBook.
+ * @return Number of contacts loaded, or -1 on a read or memory error.
+ */
+int slot_store_load(SlotStore *store, AddressBook *book);
+
+/**
+ * @brief Replaces the whole file with the book's contacts, one slot each, leaving no free
+ * slots (for moving a book over from CSV, or compacting).
+ * @param store The store.
+ * @param book A const pointer to the AddressBook.
+ * @return Number of contacts written, or -1 on an I/O or memory error.
+ */
+int slot_store_rewrite(SlotStore *store, const AddressBook *book);
+
+/**
+ * @brief Writes a contact into its slot, or into a free slot if it is new.
+ * @param store The store.
+ * @param contact The contact.
+ * @return 0 on success, -1 on an I/O or memory error.
+ */
+int slot_store_put(SlotStore *store, const Contact *contact);
+
+/**
+ * @brief Frees a contact's slot.
+ * @param store The store.
+ * @param id ID of the contact.
+ * @return 0 on success, -1 if the contact is not stored or on an I/O error.
+ */
+int slot_store_delete(SlotStore *store, int id);
+
+/**
+ * @brief Makes the store follow a book: every later create, edit, and delete made through the
+ * library is written to its slot as it happens (turning the book's change feed on if needed).
+ * @param store The store (attached to at most one book).
+ * @param book A pointer to the AddressBook, which must outlive the attachment.
+ * @return 0 on success, -1 if the feed could not be enabled or has no room for a subscriber.
+ */
+int slot_store_attach(SlotStore *store, AddressBook *book);
+
+/**
+ * @brief Flushes written slots to the disk.
+ * @param store The store.
+ * @return 0 on success, -1 if fdatasync failed or any write has failed since the store opened.
+ */
+int slot_store_sync(SlotStore *store);
+
+/**
+ * @brief Reads the store's counters.
+ * @param store The store.
+ * @param stats Output counters.
+ */
+void slot_store_stats(const SlotStore *store, SlotStoreStats *stats);
+
+/**
+ * @brief Detaches the store from its book, syncs, and closes the file.
+ * @param store The store (always freed; may be NULL).
+ * @return 0 on success, -1 if the final sync failed or any write has failed.
+ */
+int slot_store_close(SlotStore *store);
+
+/**
+ * @brief Interactive load from SLOT_STORE_FILE_NAME for the app's --slots mode. The first time,
+ * contacts.csv is loaded and moved into a new slot file; if the slot file cannot be used, the
+ * book is loaded from contacts.csv instead. Call slot_store_attach once loading is done.
+ * @param book A pointer to the (empty) AddressBook.
+ * @return The store, or NULL if the book should keep being saved to contacts.csv.
+ */
+SlotStore *open_contacts_slot_file(AddressBook *book);
+
+#endif // SLOT_STORE_H
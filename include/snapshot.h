@@ -0,0 +1,135 @@
+/**
+ * @file snapshot.h
+ * @author Gajavelly Sai Suraj
+ * @brief Multi-version snapshots: point-in-time read views that never block writers for long.
+ *
+ * Once snapshots are enabled, every mutation primitive in address_book.h commits a new book
+ * version under a short write lock. While any snapshot is open, writers stop changing
+ * contacts in place: an update links a fresh copy into the list and a removed contact is
+ * retired rather than freed. A snapshot is an array of the contacts that were live when it
+ * opened, so it stays valid and unchanged however long the reader takes. Retired contacts are
+ * freed as soon as no open snapshot is old enough to see them.
+ *
+ * The manager keeps that array up to date as writes commit, and snapshots share it: opening
+ * one only takes a reference, so readers hold the write lock for constant time. The first
+ * write after a snapshot opens copies the array (one memcpy) before changing it, leaving the
+ * snapshot's copy untouched. Only after a bulk extraction is the array rebuilt from the list,
+ * by the next snapshot to open.
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "address_book.h"
+
+/**
+ * @brief Per-book version counter, write lock, open-snapshot list, and retired contacts.
+ */
+typedef struct SnapshotManager SnapshotManager;
+
+/**
+ * @brief The shared array behind snapshots (private).
+ */
+typedef struct ContactArray ContactArray;
+
+/**
+ * @brief A consistent, read-only view of the book at one version.
+ */
+typedef struct BookSnapshot {
+    const Contact **contacts;          /**< Contacts in list order (do not follow @c next). */
+    size_t count;                      /**< Number of contacts. */
+    unsigned long version;             /**< Book version the view was taken at. */
+    int next_id;                       /**< The book's next ID at that version. */
+    SnapshotManager *manager;          /**< Owning manager (private). */
+    ContactArray *array;               /**< Array holding @c contacts (private). */
+    struct BookSnapshot *next_open;    /**< Next open snapshot (private). */
+} BookSnapshot;
+
+/**
+ * @brief Turns on versioning for a book. Call before other threads start using it.
+ * @param book A pointer to the AddressBook.
+ * @return 0 on success (or if already enabled), -1 if memory could not be allocated.
+ */
+int book_enable_snapshots(AddressBook *book);
+
+/**
+ * @brief Opens a snapshot of the book's current version.
+ * @param book A const pointer to the AddressBook.
+ * @return The snapshot, or NULL if snapshots are not enabled or memory ran out.
+ */
+BookSnapshot *snapshot_open(const AddressBook *book);
+
+/**
+ * @brief Closes a snapshot and frees any retired contacts no other snapshot can see.
+ * @param snapshot The snapshot (may be NULL).
+ */
+void snapshot_close(BookSnapshot *snapshot);
+
+/**
+ * @brief The book's current version (0 if snapshots are not enabled).
+ * @param book A const pointer to the AddressBook.
+ * @return The version number.
+ */
+unsigned long book_version(const AddressBook *book);
+
+/**
+ * @brief Number of retired contacts still held for open snapshots.
+ * @param book A const pointer to the AddressBook.
+ * @return The retired contact count.
+ */
+size_t snapshot_retired_count(const AddressBook *book);
+
+/**
+ * @brief Starts a write: takes the book's write lock. Writes nest; the outermost pair commits
+ * one version. A no-op when snapshots are not enabled.
+ * @param book A const pointer to the AddressBook.
+ */
+void snapshot_write_begin(const AddressBook *book);
+
+/**
+ * @brief Ends a write, publishing the new version when the outermost write ends.
+ * @param book A const pointer to the AddressBook.
+ */
+void snapshot_write_end(const AddressBook *book);
+
+/**
+ * @brief True if an open snapshot may still be reading the book's contacts.
+ * @param book A const pointer to the AddressBook.
+ * @return true while any snapshot is open.
+ */
+bool snapshots_active(const AddressBook *book);
+
+/**
+ * @brief Hands over a contact that left the book; it is freed once no snapshot can see it.
+ *
+ * Must be called inside a write.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param contact The unlinked contact.
+ */
+void snapshot_retire(const AddressBook *book, Contact *contact);
+
+/**
+ * @brief Keeps the snapshot array in step with the list: @p added appended (@p removed NULL),
+ * @p removed taken out (@p added NULL), or @p removed replaced in place by @p added. With both
+ * NULL, the array is dropped and rebuilt from the list when next needed.
+ *
+ * Must be called inside a write.
+ *
+ * @param book A const pointer to the AddressBook.
+ * @param removed The contact leaving the list, or NULL.
+ * @param added The contact joining the list, or NULL.
+ */
+void snapshot_note_change(const AddressBook *book, const Contact *removed, const Contact *added);
+
+/**
+ * @brief Frees a book's snapshot manager and every retired contact. No snapshot may be open.
+ * @param manager The manager (may be NULL).
+ */
+void snapshot_manager_free(SnapshotManager *manager);
+
+#endif // SNAPSHOT_H
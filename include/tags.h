@@ -0,0 +1,147 @@
+/**
+ * @file tags.h
+ * @author Gajavelly Sai Suraj
+ * @brief Tags ("vendors", "on-call", "vip") on contacts, each backed by a compressed bitmap.
+ *
+ * A tag is nothing but the set of IDs carrying it, stored as a TagBitmap, so counting a tag is
+ * a sum of container sizes and combining tags is a bitmap intersection, union, or difference,
+ * never a walk over the contacts. Tag names are letters, digits, '-' and '_', and are stored in
+ * lowercase. Deleting a contact removes it from every tag; edits keep its ID and its tags.
+ *
+ * Tag expressions combine tags with `&` (and), `|` (or), `& !` (and not), and parentheses,
+ * with `&` binding tighter:
+ *
+ *     vip & on-call
+ *     (vendors | partners) & !blocked
+ *
+ * Tags are saved next to the contacts in contacts.tags, one line per tag listing its IDs as
+ * ranges ("vip:1-4,9,12-20").
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef TAGS_H
+#define TAGS_H
+
+#include <stddef.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "tag_bitmap.h"
+
+#define TAGS_FILE_NAME "contacts.tags"
+#define MAX_TAG_LENGTH 32
+#define TAG_QUERY_MAX_LENGTH 256
+#define TAG_ERROR_LENGTH 128
+
+/**
+ * @brief Checks a tag name: 1 to MAX_TAG_LENGTH - 1 letters, digits, '-' or '_'.
+ * @param tag The tag name.
+ * @return VALID, INVALID_EMPTY, INVALID_LENGTH, or INVALID_CHARACTERS.
+ */
+ValidationStatus is_valid_tag(const char *tag);
+
+/**
+ * @brief Puts a tag on a contact (creating the tag on first use).
+ * @param book A pointer to the AddressBook.
+ * @param id ID of the contact.
+ * @param tag The tag name (any case).
+ * @return VALID (also if already tagged), INVALID_NOT_FOUND, a tag name error, or
+ * INVALID_NO_MEMORY.
+ */
+ValidationStatus book_tag_contact(AddressBook *book, int id, const char *tag);
+
+/**
+ * @brief Takes a tag off a contact. A tag left with no contacts disappears.
+ * @param book A pointer to the AddressBook.
+ * @param id ID of the contact.
+ * @param tag The tag name (any case).
+ * @return VALID, or INVALID_NOT_FOUND if the contact did not have the tag.
+ */
+ValidationStatus book_untag_contact(AddressBook *book, int id, const char *tag);
+
+/**
+ * @brief Looks up the contacts carrying a tag.
+ * @param book A const pointer to the AddressBook.
+ * @param tag The tag name (any case).
+ * @return The tag's bitmap of IDs (owned by the book), or NULL if no contact has the tag.
+ */
+const TagBitmap *book_tag_members(const AddressBook *book, const char *tag);
+
+/**
+ * @brief Lists the tags in name order with their sizes.
+ * @param book A const pointer to the AddressBook.
+ * @param names Output: up to @p max tag names (owned by the book).
+ * @param counts Output: the number of contacts per tag (may be NULL).
+ * @param max Room in the output arrays.
+ * @return The total number of tags (which may be more than @p max).
+ */
+int book_list_tags(const AddressBook *book, const char **names, size_t *counts, int max);
+
+/**
+ * @brief Lists the tags one contact carries, in name order.
+ * @param book A const pointer to the AddressBook.
+ * @param id ID of the contact.
+ * @param names Output: up to @p max tag names (owned by the book).
+ * @param max Room in @p names.
+ * @return The number of tags the contact carries (which may be more than @p max).
+ */
+int book_contact_tags(const AddressBook *book, int id, const char **names, int max);
+
+/**
+ * @brief Evaluates a tag expression.
+ * @param book A const pointer to the AddressBook.
+ * @param expression The expression, e.g. "(vendors | vip) & !blocked". Unknown tags are empty.
+ * @param error Buffer receiving a message when the expression is malformed (may be NULL).
+ * @param error_size Size of @p error.
+ * @return A new bitmap of matching IDs (free with tag_bitmap_free), or NULL on a syntax or
+ * memory error.
+ */
+TagBitmap *tag_query(const AddressBook *book, const char *expression, char *error,
+                     size_t error_size);
+
+/**
+ * @brief Writes every tag to a file.
+ * @param book A const pointer to the AddressBook.
+ * @param path Path of the tags file.
+ * @return Number of tags written, or -1 if the file could not be written.
+ */
+int save_tags(const AddressBook *book, const char *path);
+
+/**
+ * @brief Reads a tags file written by save_tags, for contacts already in the book.
+ * @param book A pointer to the AddressBook (load the contacts first).
+ * @param path Path of the tags file.
+ * @param skipped Output: malformed lines and IDs of contacts not in the book (may be NULL).
+ * @return Number of tags read, or -1 if the file could not be opened or memory ran out.
+ */
+int load_tags(AddressBook *book, const char *path, int *skipped);
+
+/**
+ * @brief Drops a deleted contact from every tag (called by the book itself).
+ * @param tags The book's tags (may be NULL).
+ * @param id ID of the deleted contact.
+ */
+void tags_remove_contact(struct TagSet *tags, int id);
+
+/**
+ * @brief Frees the tags.
+ * @param tags The tags to free (may be NULL).
+ */
+void tags_free(struct TagSet *tags);
+
+/**
+ * @brief Interactive menu to tag and untag contacts, list tags, and find contacts by tags.
+ * @param book A pointer to the AddressBook.
+ */
+void manage_tags(AddressBook *book);
+
+/**
+ * @brief Runs `addressbook tags list|count|show|add|remove ...` against contacts.csv and
+ * contacts.tags.
+ * @param argc Number of arguments after the subcommand name.
+ * @param argv The arguments after the subcommand name.
+ * @return Process exit status.
+ */
+int run_tags_command(int argc, char *argv[]);
+
+#endif // TAGS_H
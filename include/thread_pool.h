@@ -0,0 +1,56 @@
+/**
+ * @file thread_pool.h
+ * @author Gajavelly Sai Suraj
+ * @brief A fixed-size pool of worker threads that run queued tasks.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/**
+ * @brief A unit of work run on a pool thread.
+ */
+typedef void (*ThreadTask)(void *arg);
+
+/**
+ * @brief Opaque thread pool.
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief Starts a pool of worker threads.
+ * @param thread_count Number of workers (values below 1 start one worker).
+ * @return The pool, or NULL if it could not be created.
+ */
+ThreadPool *thread_pool_create(int thread_count);
+
+/**
+ * @brief Queues a task to run on the next free worker.
+ * @param pool The pool.
+ * @param task Function to run.
+ * @param arg Argument passed to @p task.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+int thread_pool_submit(ThreadPool *pool, ThreadTask task, void *arg);
+
+/**
+ * @brief Blocks until every queued task has finished.
+ * @param pool The pool.
+ */
+void thread_pool_wait(ThreadPool *pool);
+
+/**
+ * @brief Number of worker threads in the pool.
+ * @param pool The pool.
+ * @return The worker count.
+ */
+int thread_pool_size(const ThreadPool *pool);
+
+/**
+ * @brief Finishes queued tasks, stops the workers, and frees the pool.
+ * @param pool The pool (may be NULL).
+ */
+void thread_pool_destroy(ThreadPool *pool);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,105 @@
+/**
+ * @file trace.h
+ * @author Gajavelly Sai Suraj
+ * @brief Timeline tracing: spans around loading, saving, index builds, and searches, written
+ * in Chrome trace-event JSON (open the file in chrome://tracing or ui.perfetto.dev).
+ *
+ * Spans are compiled in when ADDRESSBOOK_TRACING is defined (the CMake option of the same
+ * name, on by default) and recorded only after trace_start, which the app calls when the
+ * AB_TRACE environment variable names an output file:
+ *
+ *     AB_TRACE=load.json ./addressbook
+ *
+ * While tracing is off a span costs one predictable branch; with the option off, the TRACE_
+ * macros expand to nothing. Span names must be string literals, since only the pointer is kept.
+ *
+ *     TraceSpan span = TRACE_BEGIN("load.parse");
+ *     ...
+ *     TRACE_END_COUNT(span, "records", parsed);
+ *
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRACE_ENV_VARIABLE "AB_TRACE"
+#define TRACE_MAX_EVENTS 1000000 // later spans are dropped (and counted) to bound memory
+
+/**
+ * @brief An open span: its name and start time (0 when tracing was off at the start).
+ */
+typedef struct {
+    const char *name;
+    uint64_t start;
+} TraceSpan;
+
+/**
+ * @brief True while spans are being recorded. Read without the lock by the inline helpers
+ * below, from any thread, while trace_start and trace_stop change it.
+ */
+extern atomic_bool trace_active;
+
+/**
+ * @brief Starts recording spans; the file is written by trace_stop or at exit.
+ * @param path Output file for the JSON trace.
+ * @return 0 on success, -1 if tracing is already on or memory ran out.
+ */
+int trace_start(const char *path);
+
+/**
+ * @brief Starts tracing if AB_TRACE is set.
+ * @return 1 if tracing started, 0 if AB_TRACE is unset, -1 if it could not start (including
+ * when tracing was compiled out).
+ */
+int trace_start_from_env(void);
+
+/**
+ * @brief Stops recording and writes the trace file.
+ * @return Number of spans written, or -1 if tracing was off or the file could not be written.
+ */
+int trace_stop(void);
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+uint64_t trace_now(void);
+
+/**
+ * @brief Records a finished span (use TRACE_END instead).
+ * @param span The span.
+ * @param arg_name Name of an integer argument shown with the span, or NULL.
+ * @param arg_value The argument's value.
+ */
+void trace_record(const TraceSpan *span, const char *arg_name, long long arg_value);
+
+static inline TraceSpan trace_span_begin(const char *name) {
+    TraceSpan span = {name, atomic_load_explicit(&trace_active, memory_order_relaxed)
+                                ? trace_now()
+                                : 0};
+    return span;
+}
+
+static inline void trace_span_end(const TraceSpan *span, const char *arg_name,
+                                  long long arg_value) {
+    if (span->start != 0) {
+        trace_record(span, arg_name, arg_value);
+    }
+}
+
+#ifdef ADDRESSBOOK_TRACING
+#define TRACE_BEGIN(name) trace_span_begin(name)
+#define TRACE_END(span) trace_span_end(&(span), NULL, 0)
+#define TRACE_END_COUNT(span, arg_name, arg_value) \
+    trace_span_end(&(span), (arg_name), (long long)(arg_value))
+#else
+#define TRACE_BEGIN(name) ((TraceSpan){NULL, 0})
+#define TRACE_END(span) ((void)(span))
+#define TRACE_END_COUNT(span, arg_name, arg_value) ((void)(span), (void)(arg_value))
+#endif
+
+#endif // TRACE_H
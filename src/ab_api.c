@@ -0,0 +1,175 @@
+/**
+ * @file ab_api.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the prompt-free embedding API.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "contact_index.h"
+#include "ab_api.h"
+
+/**
+ * @brief Checks that a value fits its Contact field, including the terminator.
+ */
+static ValidationStatus check_fits(const char *value, size_t size) {
+    return strlen(value) < size ? VALID : INVALID_LENGTH;
+}
+
+/**
+ * @brief Validates a name.
+ */
+static ValidationStatus check_name(const char *name) {
+    ValidationStatus status = check_fits(name, MAX_NAME_LENGTH);
+    return status == VALID ? is_valid_name(name) : status;
+}
+
+/**
+ * @brief Validates a phone and checks no other contact has it.
+ * @param current The phone the contact already has (NULL for a new contact).
+ */
+static ValidationStatus check_phone(const AddressBook *book, const char *phone,
+                                    const char *current) {
+    ValidationStatus status = check_fits(phone, MAX_PHONE_LENGTH);
+    if (status == VALID) {
+        status = is_valid_phone(phone);
+    }
+    if (status == VALID && (current == NULL || strcmp(phone, current) != 0)) {
+        status = is_phone_duplicate(phone, book);
+    }
+    return status;
+}
+
+/**
+ * @brief Validates an email and checks no other contact has it.
+ * @param current The email the contact already has (NULL for a new contact).
+ */
+static ValidationStatus check_email(const AddressBook *book, const char *email,
+                                    const char *current) {
+    ValidationStatus status = check_fits(email, MAX_EMAIL_LENGTH);
+    if (status == VALID) {
+        status = is_valid_email(email);
+    }
+    if (status == VALID && (current == NULL || strcmp(email, current) != 0)) {
+        status = is_email_duplicate(email, book);
+    }
+    return status;
+}
+
+ValidationStatus ab_add(AddressBook *book, const char *name, const char *phone,
+                        const char *email, int *id) {
+    ValidationStatus status = check_name(name);
+    if (status == VALID) {
+        status = check_phone(book, phone, NULL);
+    }
+    if (status == VALID) {
+        status = check_email(book, email, NULL);
+    }
+    if (status != VALID) {
+        return status;
+    }
+
+    Contact *contact = malloc(sizeof(Contact));
+    if (contact == NULL) {
+        return INVALID_NO_MEMORY;
+    }
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    contact->id = generate_new_id(book);
+    book_append_contact(book, contact);
+
+    if (id != NULL) {
+        *id = contact->id;
+    }
+    return VALID;
+}
+
+ValidationStatus ab_insert(AddressBook *book, const Contact *values) {
+    if (values->id <= 0) {
+        return INVALID_FORMAT;
+    }
+    if (ab_find(book, values->id, NULL) == VALID) {
+        return INVALID_DUPLICATE;
+    }
+    ValidationStatus status = check_name(values->name);
+    if (status == VALID) {
+        status = check_phone(book, values->phone, NULL);
+    }
+    if (status == VALID) {
+        status = check_email(book, values->email, NULL);
+    }
+    if (status != VALID) {
+        return status;
+    }
+
+    Contact *contact = malloc(sizeof(Contact));
+    if (contact == NULL) {
+        return INVALID_NO_MEMORY;
+    }
+    *contact = *values;
+    contact->next = NULL;
+    book_append_contact(book, contact);
+    return VALID;
+}
+
+ValidationStatus ab_update(AddressBook *book, int id, const char *name, const char *phone,
+                           const char *email) {
+    Contact *contact;
+    if (ab_find(book, id, &contact) != VALID) {
+        return INVALID_NOT_FOUND;
+    }
+
+    ValidationStatus status = VALID;
+    if (name != NULL) {
+        status = check_name(name);
+    }
+    if (status == VALID && phone != NULL) {
+        status = check_phone(book, phone, contact->phone);
+    }
+    if (status == VALID && email != NULL) {
+        status = check_email(book, email, contact->email);
+    }
+    if (status != VALID) {
+        return status;
+    }
+
+    Contact values = *contact;
+    if (name != NULL) {
+        strcpy(values.name, name);
+    }
+    if (phone != NULL) {
+        strcpy(values.phone, phone);
+    }
+    if (email != NULL) {
+        strcpy(values.email, email);
+    }
+    return book_update_contact(book, contact, &values) != NULL ? VALID : INVALID_NO_MEMORY;
+}
+
+ValidationStatus ab_remove(AddressBook *book, int id) {
+    Contact *contact;
+    if (ab_find(book, id, &contact) != VALID || book_remove_contact(book, contact) != 0) {
+        return INVALID_NOT_FOUND;
+    }
+    return VALID;
+}
+
+ValidationStatus ab_find(const AddressBook *book, int id, Contact **contact) {
+    Contact *found = NULL;
+    if (book->indexes != NULL) {
+        found = id_index_lookup(&book->indexes->by_id, id);
+    }
+    else {
+        for (found = book->head; found != NULL && found->id != id; found = found->next) {
+        }
+    }
+
+    if (contact != NULL) {
+        *contact = found;
+    }
+    return found != NULL ? VALID : INVALID_NOT_FOUND;
+}
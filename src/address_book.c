@@ -11,6 +11,336 @@
 #include <stdbool.h>
 #include "address_book.h"
 #include "contact_helper.h"
+#include "contact_report.h"
+#include "contact_index.h"
+#include "snapshot.h"
+#include "phonetic.h"
+#include "autocomplete.h"
+#include "change_feed.h"
+#include "tags.h"
+#include "ab_api.h"
+#include "search_cursor.h"
+#include "trace.h"
+
+#define LOAD_BATCH_RECORDS 4096 // records read, parsed, and inserted per batch
+#define LOAD_LINE_LENGTH 256    // longer than any valid record line
+#define SEARCH_PAGE_SIZE 20     // matches shown at a time when a search finds several
+
+/**
+ * @brief Builds the hash indexes from scratch over every contact in the list.
+ * @param book A pointer to the AddressBook.
+ * @return The new indexes, or NULL if memory could not be allocated.
+ */
+static BookIndexes *build_indexes(const AddressBook *book) {
+    BookIndexes *indexes = book_indexes_create();
+    if (indexes == NULL) {
+        return NULL;
+    }
+
+    TraceSpan span = TRACE_BEGIN("index.build");
+    for (Contact *current = book->head; current != NULL; current = current->next) {
+        if (book_indexes_add(indexes, current) != 0) {
+            book_indexes_free(indexes);
+            TRACE_END(span);
+            return NULL;
+        }
+    }
+    TRACE_END_COUNT(span, "contacts", book->contact_count);
+    return indexes;
+}
+
+/**
+ * @brief Updates every derived structure (aggregates, indexes) for a contact entering the book.
+ *
+ * A structure that is missing (never built, or dropped after an allocation failure) is
+ * rebuilt from the whole list, which already includes @p contact. Readers treat a missing
+ * structure as "scan the list", so dropping one is always safe.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact that was just linked into the list.
+ */
+static void index_contact(AddressBook *book, Contact *contact) {
+    if (book->aggregates == NULL) {
+        book->aggregates = aggregates_create();
+        for (const Contact *current = book->head; current != NULL && book->aggregates != NULL;
+             current = current->next) {
+            if (aggregates_add_contact(book->aggregates, current) != 0) {
+                aggregates_free(book->aggregates);
+                book->aggregates = NULL;
+            }
+        }
+    }
+    else if (aggregates_add_contact(book->aggregates, contact) != 0) {
+        aggregates_free(book->aggregates);
+        book->aggregates = NULL;
+    }
+    autocomplete_add_contact(book->autocomplete, contact);
+
+    if (book->indexing_suspended) {
+        return;
+    }
+    if (book->indexes == NULL) {
+        book->indexes = build_indexes(book);
+    }
+    else if (book_indexes_add(book->indexes, contact) != 0) {
+        book_indexes_free(book->indexes);
+        book->indexes = NULL;
+    }
+}
+
+/**
+ * @brief Removes a contact from every derived structure before it leaves or changes.
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact, still holding the values it was indexed under.
+ */
+static void unindex_contact(AddressBook *book, const Contact *contact) {
+    aggregates_remove_contact(book->aggregates, contact);
+    autocomplete_remove_contact(book->autocomplete, contact);
+    if (book->indexes != NULL) {
+        book_indexes_remove(book->indexes, contact);
+    }
+}
+
+/**
+ * @brief Appends a contact to the linked list in constant time and indexes it.
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to append; the book takes ownership.
+ */
+void book_append_contact(AddressBook *book, Contact *contact) {
+    contact->next = NULL;
+
+    snapshot_write_begin(book);
+    if (book->head == NULL) {
+        book->head = contact;
+    }
+    else {
+        book->tail->next = contact;
+    }
+    book->tail = contact;
+    book->contact_count++;
+
+    if (contact->id >= book->next_id) {
+        book->next_id = contact->id + 1;
+    }
+    index_contact(book, contact);
+    change_feed_emit(book->feed, CHANGE_CREATE, NULL, contact);
+    snapshot_note_change(book, NULL, contact);
+    snapshot_write_end(book);
+}
+
+/**
+ * @brief Finds the node before a contact (NULL for the head).
+ * @return 0 if the contact was found, -1 otherwise.
+ */
+static int find_previous(const AddressBook *book, const Contact *contact, Contact **prev) {
+    *prev = NULL;
+    for (Contact *current = book->head; current != NULL; current = current->next) {
+        if (current == contact) {
+            return 0;
+        }
+        *prev = current;
+    }
+    return -1;
+}
+
+/**
+ * @brief Links @p replacement into @p contact's place and retires the old node.
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact being replaced.
+ * @param replacement The new node, already holding its values.
+ * @return 0 on success, -1 if @p contact is not in the book.
+ */
+int book_replace_contact(AddressBook *book, Contact *contact, Contact *replacement) {
+    snapshot_write_begin(book);
+
+    Contact *prev;
+    if (find_previous(book, contact, &prev) != 0) {
+        snapshot_write_end(book);
+        return -1;
+    }
+
+    replacement->next = contact->next;
+    if (prev == NULL) {
+        book->head = replacement;
+    }
+    else {
+        prev->next = replacement;
+    }
+    if (book->tail == contact) {
+        book->tail = replacement;
+    }
+
+    unindex_contact(book, contact);
+    index_contact(book, replacement);
+    change_feed_emit(book->feed, CHANGE_UPDATE, contact, replacement);
+    snapshot_note_change(book, contact, replacement);
+    snapshot_retire(book, contact);
+    snapshot_write_end(book);
+    return 0;
+}
+
+/**
+ * @brief Replaces a contact's fields, moving it between index keys as needed.
+ *
+ * While a snapshot is open the contact is copied rather than changed in place.
+ *
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to change.
+ * @param values The new name, phone, and email.
+ * @return The contact now holding the values, or NULL if memory ran out.
+ */
+Contact *book_update_contact(AddressBook *book, Contact *contact, const Contact *values) {
+    snapshot_write_begin(book);
+
+    if (snapshots_active(book)) {
+        Contact *copy = malloc(sizeof(Contact));
+        if (copy != NULL) {
+            copy->id = contact->id;
+            strcpy(copy->name, values->name);
+            strcpy(copy->phone, values->phone);
+            strcpy(copy->email, values->email);
+            if (book_replace_contact(book, contact, copy) != 0) {
+                free(copy);
+                copy = NULL;
+            }
+        }
+        snapshot_write_end(book);
+        return copy;
+    }
+
+    Contact before = *contact;
+    unindex_contact(book, contact);
+    strcpy(contact->name, values->name);
+    strcpy(contact->phone, values->phone);
+    strcpy(contact->email, values->email);
+    index_contact(book, contact);
+    change_feed_emit(book->feed, CHANGE_UPDATE, &before, contact);
+    snapshot_write_end(book);
+    return contact;
+}
+
+/**
+ * @brief Unlinks, unindexes, and releases a contact.
+ * @param book A pointer to the AddressBook.
+ * @param contact The contact to remove.
+ * @return 0 on success, -1 if the contact is not in the book.
+ */
+int book_remove_contact(AddressBook *book, Contact *contact) {
+    snapshot_write_begin(book);
+
+    Contact *prev;
+    if (find_previous(book, contact, &prev) != 0) {
+        snapshot_write_end(book);
+        return -1;
+    }
+
+    if (prev == NULL) {
+        book->head = contact->next;
+    }
+    else {
+        prev->next = contact->next;
+    }
+    if (book->tail == contact) {
+        book->tail = prev;
+    }
+
+    unindex_contact(book, contact);
+    tags_remove_contact(book->tags, contact->id);
+    book->contact_count--;
+    change_feed_emit(book->feed, CHANGE_DELETE, contact, NULL);
+    snapshot_note_change(book, contact, NULL);
+    snapshot_retire(book, contact);
+    snapshot_write_end(book);
+    return 0;
+}
+
+/**
+ * @brief Frees a contact taken out of the book, once no snapshot can still see it.
+ * @param book A pointer to the AddressBook it came from.
+ * @param contact The unlinked contact.
+ */
+void book_release_contact(AddressBook *book, Contact *contact) {
+    snapshot_write_begin(book);
+    snapshot_retire(book, contact);
+    snapshot_write_end(book);
+}
+
+/**
+ * @brief Unlinks and unindexes the selected contacts, returning them as a chain.
+ * @param book A pointer to the AddressBook.
+ * @param select Predicate choosing the contacts to take out.
+ * @param context Passed through to @p select.
+ * @return The removed contacts in list order, or NULL if none matched.
+ */
+Contact *book_extract_contacts(AddressBook *book, int (*select)(const Contact *, void *),
+                               void *context) {
+    Contact *removed_head = NULL;
+    Contact *removed_tail = NULL;
+    Contact *prev = NULL;
+
+    snapshot_write_begin(book);
+    Contact *current = book->head;
+    while (current != NULL) {
+        Contact *next = current->next;
+        if (!select(current, context)) {
+            prev = current;
+            current = next;
+            continue;
+        }
+
+        if (prev == NULL) {
+            book->head = next;
+        }
+        else {
+            prev->next = next;
+        }
+        if (book->tail == current) {
+            book->tail = prev;
+        }
+        unindex_contact(book, current);
+        tags_remove_contact(book->tags, current->id);
+        book->contact_count--;
+        change_feed_emit(book->feed, CHANGE_DELETE, current, NULL);
+
+        // Snapshots never follow next, so the removed nodes can be rechained.
+        current->next = NULL;
+        if (removed_tail == NULL) {
+            removed_head = current;
+        }
+        else {
+            removed_tail->next = current;
+        }
+        removed_tail = current;
+        current = next;
+    }
+    if (removed_head != NULL) {
+        snapshot_note_change(book, NULL, NULL);
+    }
+    snapshot_write_end(book);
+    return removed_head;
+}
+
+/**
+ * @brief Drops the indexes for the duration of a bulk change.
+ * @param book A pointer to the AddressBook.
+ */
+void book_suspend_indexing(AddressBook *book) {
+    book_indexes_free(book->indexes);
+    book->indexes = NULL;
+    book->indexing_suspended = 1;
+    autocomplete_invalidate(book->autocomplete);
+}
+
+/**
+ * @brief Rebuilds the indexes once after a bulk change.
+ * @param book A pointer to the AddressBook.
+ */
+void book_resume_indexing(AddressBook *book) {
+    book->indexing_suspended = 0;
+    if (book->indexes == NULL) {
+        book->indexes = build_indexes(book);
+    }
+}
 
 /**
  * @brief Initializes an AddressBook to a safe, empty state.
@@ -25,8 +355,16 @@ void initialize(AddressBook *book)
     }
 
     book->head = NULL;
+    book->tail = NULL;
     book->contact_count = 0;
     book->next_id = 1;
+    book->aggregates = NULL;
+    book->indexes = NULL;
+    book->indexing_suspended = 0;
+    book->snapshots = NULL;
+    book->autocomplete = NULL;
+    book->feed = NULL;
+    book->tags = NULL;
 }
 
 /**
@@ -43,6 +381,20 @@ void free_address_book(AddressBook *book)
         return;
     }
 
+    // The aggregates and indexes may exist even when every contact has been deleted.
+    aggregates_free(book->aggregates);
+    book->aggregates = NULL;
+    book_indexes_free(book->indexes);
+    book->indexes = NULL;
+    snapshot_manager_free(book->snapshots);
+    book->snapshots = NULL;
+    autocomplete_free(book->autocomplete);
+    book->autocomplete = NULL;
+    change_feed_free(book->feed);
+    book->feed = NULL;
+    tags_free(book->tags);
+    book->tags = NULL;
+
     // Check if the address book is already empty
     if (book->head == NULL) {
         return;
@@ -61,6 +413,7 @@ void free_address_book(AddressBook *book)
 
     // Finally, reset the address book struct to its initial, safe state.
     book->head = NULL;
+    book->tail = NULL;
     book->contact_count = 0;
     book->next_id = 1;
 
@@ -75,13 +428,7 @@ void create_contact(AddressBook* book) {
 
     printf("\n<==============================| CREATE CONTACT |==============================>\n");
     //printf("\nEin: *Barks sadly.* The address book is full! Let's delete some old contacts to make space.\n");
-    Contact *new_contact = (Contact *)malloc(sizeof(Contact));
-    if(new_contact == NULL)
-    {
-        printf("Ein: *tilts head* Hmm... I couldn't fetch enough memory to store a new friend.\n");
-        return;
-    }
-    new_contact->next = NULL;
+    Contact draft; // Filled in field by field, then handed to ab_add.
 
     int attempts;
     ValidationStatus status;
@@ -92,13 +439,13 @@ void create_contact(AddressBook* book) {
     printf("\nEin: *Perks up ears* Oh! A new friend? Let's start with their name.\n");
     do {
         printf("Enter Name: ");
-        fgets(new_contact->name, MAX_NAME_LENGTH, stdin);
-        remove_newline(new_contact->name);
+        fgets(draft.name, MAX_NAME_LENGTH, stdin);
+        remove_newline(draft.name);
 
-        status = is_valid_name(new_contact->name);
+        status = is_valid_name(draft.name);
 
         if(status == VALID) {
-            printf("Ein: Got it! I will remember %s forever or at least until you delete them.\n", new_contact->name);
+            printf("Ein: Got it! I will remember %s forever or at least until you delete them.\n", draft.name);
             break;
         }
 
@@ -106,14 +453,12 @@ void create_contact(AddressBook* book) {
         // printf("Ein: Let's try that name again. It needs to be a little better, don't you think?\n");
 
         if(handle_attempt(&attempts) == CANCEL) {
-            free(new_contact);
             return;
         }
 
     } while(attempts < MAX_ATTEMPTS);
 
     if(attempts >= MAX_ATTEMPTS) {
-        free(new_contact);
         return;
     }
 
@@ -123,30 +468,28 @@ void create_contact(AddressBook* book) {
     {
         printf("\nEin: I've got my paws ready to dial!\n");
         printf("What's their phone number? : ");
-        fgets(new_contact->phone, MAX_PHONE_LENGTH, stdin);
-        remove_newline(new_contact->phone);
+        fgets(draft.phone, MAX_PHONE_LENGTH, stdin);
+        remove_newline(draft.phone);
 
-        status = is_valid_phone(new_contact->phone);
+        status = is_valid_phone(draft.phone);
 
         if(status == VALID) {
-            status = is_phone_duplicate(new_contact->phone, book);
+            status = is_phone_duplicate(draft.phone, book);
         }
 
         if(status == VALID) {
-            printf("Ein: Perfect! I can already imagine calling %s.\n", new_contact->phone);
+            printf("Ein: Perfect! I can already imagine calling %s.\n", draft.phone);
             break;
         }
 
         print_validation_error(status);
         if(handle_attempt(&attempts) == CANCEL) {
-            free(new_contact);
             return;
         }
 
     } while (attempts < MAX_ATTEMPTS);
 
     if(attempts >= MAX_ATTEMPTS) {
-        free(new_contact);
         return;
     }
     
@@ -156,13 +499,13 @@ void create_contact(AddressBook* book) {
     {
         printf("\nEin: Got any treats, or maybe an email address?\n");
         printf("What's their email? : ");
-        fgets(new_contact->email, MAX_EMAIL_LENGTH, stdin);
-        remove_newline(new_contact->email);
+        fgets(draft.email, MAX_EMAIL_LENGTH, stdin);
+        remove_newline(draft.email);
 
-        status = is_valid_email(new_contact->email);
+        status = is_valid_email(draft.email);
 
         if(status == VALID) {
-            status = is_email_duplicate(new_contact->email, book);
+            status = is_email_duplicate(draft.email, book);
         }
 
         if(status == VALID) {
@@ -173,35 +516,44 @@ void create_contact(AddressBook* book) {
         print_validation_error(status);
 
         if(handle_attempt(&attempts) == CANCEL) {
-            free(new_contact);
             return;
         }
 
     } while (attempts < MAX_ATTEMPTS);
 
     if(attempts >= MAX_ATTEMPTS) {
-        free(new_contact);
         return;
     }
 
-    // --- ID Generation --- //
-    new_contact->id = generate_new_id(book);
-
-    // --- Add Contact to Linked List --- //
-    if(book->head == NULL) {
-        book->head = new_contact;
-    }
-    else {
-        Contact *current = book->head;
-        while(current->next != NULL) {
-            current = current->next;
-        }
-        current->next = new_contact;
+    // --- Add Contact (ab_add assigns the ID) --- //
+    status = ab_add(book, draft.name, draft.phone, draft.email, NULL);
+    if(status != VALID) {
+        print_validation_error(status);
+        return;
     }
-    book->contact_count++; // Increment contact count.
 
-    printf("\nEin: *Tail wags furiously* Yay! Found a new friend! %s is in the book. Woof!\n", new_contact->name);
+    printf("\nEin: *Tail wags furiously* Yay! Found a new friend! %s is in the book. Woof!\n", draft.name);
+
+}
+
+/**
+ * @brief Prints one page of search matches, numbered from 1, for the user to pick from.
+ */
+static void print_match_page(Contact **page, int count) {
+    printf("--------------------------------------------------------------------------------\n");
+    printf(" No. | ID   | %-20s | %-15s | %-30s\n", "Name", "Phone", "Email");
+    printf("--------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < count; i++) {
+        printf(" %-3d | %-4d | %-20s | %-15s | %-30s\n",
+              i + 1,
+              page[i]->id,
+              page[i]->name,
+              page[i]->phone,
+              page[i]->email);
+    }
 
+    printf("--------------------------------------------------------------------------------\n");
 }
 
 /**
@@ -219,14 +571,6 @@ Contact* search_contact(const AddressBook *book) {
         return NULL;
     }
 
-    // The maximum possible matches is the total number of contacts.
-    // We allocate an array of POINTERS on the heap.
-    Contact** matched_nodes = (Contact**)malloc(sizeof(Contact*) * book->contact_count);
-    if (matched_nodes == NULL) {
-        printf("Ein: *Whines* I couldn't fetch the search results right now.\n");
-        return NULL;
-    }
-    
     int attempts = 0;
     char search_query[MAX_NAME_LENGTH];
     
@@ -238,6 +582,8 @@ Contact* search_contact(const AddressBook *book) {
         printf("  %d) Search by Phone\n", SEARCH_BY_PHONE);
         printf("  %d) Search by Email\n", SEARCH_BY_EMAIL);
         printf("  %d) Cancel\n",         SEARCH_CANCEL);
+        printf("  %d) Name Sounds Like\n", SEARCH_SOUNDS_LIKE);
+        printf("  %d) Phone Ends With (caller ID)\n", SEARCH_PHONE_ENDS_WITH);
         printf("---------------------------------------------------------\n");
 
         search_choice = get_int_input("Ein: How would you like to search? ");
@@ -245,7 +591,6 @@ Contact* search_contact(const AddressBook *book) {
         if (search_choice == -1) {
             printf("\nEin: That didn't look like a valid choice.\n");
             if (handle_attempt(&attempts) == CANCEL) {
-                free(matched_nodes);
                 return NULL;
             }
             continue;
@@ -253,11 +598,10 @@ Contact* search_contact(const AddressBook *book) {
 
         if(search_choice == SEARCH_CANCEL) {
             printf("Ein: Alright, search cancelled. Back to the main menu.\n");
-            free(matched_nodes);
             return NULL;
         }
 
-        if(search_choice >= SEARCH_BY_NAME && search_choice <= SEARCH_BY_EMAIL) {
+        if(search_choice >= SEARCH_BY_NAME && search_choice <= SEARCH_PHONE_ENDS_WITH) {
             switch(search_choice) {
                 case SEARCH_BY_NAME:
                     printf("Ein: Whose name should I sniff out for you?: ");
@@ -268,6 +612,13 @@ Contact* search_contact(const AddressBook *book) {
                 case SEARCH_BY_EMAIL:
                     printf("Ein: What email address should I hunt for?: ");
                     break;
+                case SEARCH_SOUNDS_LIKE:
+                    printf("Ein: Say the name the way it sounds, I'll sniff out the spellings: ");
+                    break;
+                case SEARCH_PHONE_ENDS_WITH:
+                    printf("Ein: Give me the last %d or more digits, or the number with its country code: ",
+                           PHONE_SUFFIX_DIGITS);
+                    break;
             }
             fgets(search_query, MAX_NAME_LENGTH, stdin);
             remove_newline(search_query);
@@ -275,89 +626,94 @@ Contact* search_contact(const AddressBook *book) {
         else {
             printf("Ein: That's not one of the options. Let's try again.\n");
             if(handle_attempt(&attempts) == CANCEL) {
-                free(matched_nodes);
                 return NULL;
             }
             continue;  // Skip to next iteration if the choice is invalid
         }
 
         
-        int matched_count = 0;
-        Contact *current = book->head;
-
-        while (current != NULL) {
-            if ((search_choice == SEARCH_BY_NAME && strcmp(search_query, current->name) == 0) ||
-                (search_choice == SEARCH_BY_PHONE && strcmp(search_query, current->phone) == 0) ||
-                (search_choice == SEARCH_BY_EMAIL && strcmp(search_query, current->email) == 0)) {
-                matched_nodes[matched_count++] = current;
+        // Matches stream from the cursor, so only one page of them is ever held.
+        SearchCursor cursor;
+        SearchCursorStatus opened =
+            search_cursor_open(&cursor, book, (SearchOption)search_choice, search_query, 0);
+        if (opened != SEARCH_CURSOR_OK) {
+            switch (opened) {
+                case SEARCH_CURSOR_TOO_FEW_DIGITS:
+                    printf("Ein: *Tilts head* I need at least %d digits to follow a number.\n",
+                           PHONE_SUFFIX_DIGITS);
+                    break;
+                case SEARCH_CURSOR_BAD_FIELD:
+                case SEARCH_CURSOR_OK:
+                    printf("Ein: *Tilts head* I don't know how to search that way.\n");
+                    break;
             }
-            current = current->next;
+            if(handle_attempt(&attempts) == CANCEL) {
+                return NULL;
+            }
+            continue;
         }
+        Contact *page[SEARCH_PAGE_SIZE];
+        page[0] = search_cursor_next(&cursor);
 
-        if (matched_count == 0) {
+        if (page[0] == NULL) {
             printf("Ein: *Sniffs around* Nope, I couldn't find anyone matching \"%s\".\n", search_query);
             if(handle_attempt(&attempts) == CANCEL) {
-                free(matched_nodes);
                 return NULL;
             }
             continue;
         }
-        else if (matched_count == 1) {
+
+        Contact *more = search_cursor_next(&cursor);
+        if (more == NULL) {
             printf("\nEin: Found them! Here's what I've got:\n");
             printf("--------------------------------\n");
-            printf("ID: %d\n", matched_nodes[0]->id);
-            printf("Name: %s\n", matched_nodes[0]->name);
-            printf("Phone: %s\n", matched_nodes[0]->phone);
-            printf("Email: %s\n", matched_nodes[0]->email);
+            printf("ID: %d\n", page[0]->id);
+            printf("Name: %s\n", page[0]->name);
+            printf("Phone: %s\n", page[0]->phone);
+            printf("Email: %s\n", page[0]->email);
             printf("\n");
-            Contact *result = matched_nodes[0];
-            free(matched_nodes);
-            return result;
+            return page[0];
         }
-        else {
-            printf("\nEin: I found %d matches. Take a look:\n", matched_count);
-
-            printf("--------------------------------------------------------------------------------\n");
-            printf(" No. | ID   | %-20s | %-15s | %-30s\n", "Name", "Phone", "Email");
-            printf("--------------------------------------------------------------------------------\n");
-
-            for (int i = 0; i < matched_count; i++) {
-                printf(" %-3d | %-4d | %-20s | %-15s | %-30s\n",
-                      i + 1,
-                      matched_nodes[i]->id,
-                      matched_nodes[i]->name,
-                      matched_nodes[i]->phone,
-                      matched_nodes[i]->email);
-            }
 
-            printf("--------------------------------------------------------------------------------\n");
-
-            int selection = get_int_input("Ein: Which one should I fetch for you?: ");\
-
-            if (selection < 1 || selection > matched_count) {
-                printf("Ein: *Tilts head* That's not a valid choice. Let's fetch again.\n");
-                if(handle_attempt(&attempts) == CANCEL) {
-                    free(matched_nodes);
-                    return NULL;
-                }
-                continue;
+        printf("\nEin: I found more than one match. Take a look:\n");
+        int page_count = 1;
+        int selection = 0;
+        do {
+            // Fill the page from the matches fetched so far; `more` then says if another follows.
+            while (page_count < SEARCH_PAGE_SIZE && more != NULL) {
+                page[page_count++] = more;
+                more = search_cursor_next(&cursor);
             }
+            print_match_page(page, page_count);
+            if (more == NULL) {
+                selection = get_int_input("Ein: Which one should I fetch for you?: ");
+                break;
+            }
+            selection = get_int_input("Ein: Which one should I fetch for you? (0 for more matches): ");
+            if (selection == 0) {
+                page_count = 0;
+            }
+        } while (selection == 0);
 
-            Contact *selected = matched_nodes[selection - 1];
-            printf("\nEin: Got it! Fetching the details for you now:\n\n");
-            printf("Name  : %s\n",  selected->name);
-            printf("Phone : %s\n",  selected->phone);
-            printf("Email : %s\n\n", selected->email);
-            printf("\n");
-            free(matched_nodes);
-            return selected;
+        if (selection < 1 || selection > page_count) {
+            printf("Ein: *Tilts head* That's not a valid choice. Let's fetch again.\n");
+            if(handle_attempt(&attempts) == CANCEL) {
+                return NULL;
+            }
+            continue;
         }
 
-        
+        Contact *selected = page[selection - 1];
+        printf("\nEin: Got it! Fetching the details for you now:\n\n");
+        printf("Name  : %s\n",  selected->name);
+        printf("Phone : %s\n",  selected->phone);
+        printf("Email : %s\n\n", selected->email);
+        printf("\n");
+        return selected;
+
     } while (attempts < MAX_ATTEMPTS);
 
     printf("Ein: I've tried my best, but we've reached the limit. Back to the menu.\n");
-    free(matched_nodes);
     return NULL;
     
 }
@@ -438,7 +794,7 @@ void edit_contact(AddressBook *book) {
 
                 status = is_valid_phone(temp_contact.phone);
 
-                if(status == VALID) {
+                if(status == VALID && strcmp(temp_contact.phone, target->phone) != 0) {
                     status = is_phone_duplicate(temp_contact.phone, book);
                 }
                 if(status == VALID) {
@@ -466,7 +822,7 @@ void edit_contact(AddressBook *book) {
 
                 status = is_valid_email(temp_contact.email);
 
-                if(status == VALID) {
+                if(status == VALID && strcmp(temp_contact.email, target->email) != 0) {
                     status = is_email_duplicate(temp_contact.email, book);
                 }
                 if(status == VALID) {
@@ -486,10 +842,13 @@ void edit_contact(AddressBook *book) {
 
             case EDIT_SAVE:
             if (has_changes) {
-                    // On "Save", copy the temporary data back to the original contact.
-                    strcpy(target->name, temp_contact.name);
-                    strcpy(target->phone, temp_contact.phone);
-                    strcpy(target->email, temp_contact.email);
+                    // On "Save", apply the edited values through the library API.
+                    status = ab_update(book, target->id, temp_contact.name, temp_contact.phone,
+                                       temp_contact.email);
+                    if (status != VALID) {
+                        print_validation_error(status);
+                        return;
+                    }
                     printf("\nEin: All set! I've updated the details and tucked them safely back into the address book.\n");
                 } 
                 else {
@@ -563,25 +922,10 @@ void delete_contact(AddressBook *book) {
 
         if (delete_confirm == 'y' || delete_confirm == 'Y') 
         {
-            Contact *current = book->head;
-            Contact *prev = NULL;
-
-            while (current != NULL) {
-                if (current == target) {
-                    if (prev == NULL) {
-                        book->head = current->next;
-                    }
-                    else {
-                        prev->next = current->next;
-                    }
-                    free(current);
-                    book->contact_count--;
-                    printf("\nEin: *Wags tail slowly* Alright, they're gone.\n");
-                    printf("Ein: I've cleaned up the record and your address book is nice and tidy now.\n");
-                    return;
-                }
-                prev = current;
-                current = current->next;
+            if (ab_remove(book, target->id) == VALID) {
+                printf("\nEin: *Wags tail slowly* Alright, they're gone.\n");
+                printf("Ein: I've cleaned up the record and your address book is nice and tidy now.\n");
+                return;
             }
         }
         else if (delete_confirm == 'n' || delete_confirm == 'N') {
@@ -621,20 +965,24 @@ void list_contacts(const AddressBook *book) {
     printf("| %-4s | %-20s | %-15s | %-25s |\n", "ID", "Name", "Phone", "Email");
     printf("-----------------------------------------------------------------------------\n");
 
-    const Contact *current = book->head;
+    // A snapshot (when enabled) keeps the listing consistent if the book changes meanwhile.
+    BookSnapshot *snapshot = snapshot_open(book);
+    int count = snapshot != NULL ? (int)snapshot->count : book->contact_count;
+    const Contact *current = NULL;
 
-    while (current != NULL) {
+    for (int i = 0; i < count; i++) {
+        current = snapshot != NULL ? snapshot->contacts[i]
+                                   : (current == NULL ? book->head : current->next);
         printf("| %-4d | %-20s | %-15s | %-25s |\n",
                current->id,
                current->name,
                current->phone,
                current->email);
-
-        current = current->next; // Move to the next node in the chain
     }
+    snapshot_close(snapshot);
 
     printf("-----------------------------------------------------------------------------\n");
-    printf("| Total contacts: %-57d |\n", book->contact_count);
+    printf("| Total contacts: %-57d |\n", count);
     printf("-----------------------------------------------------------------------------\n");
     printf("Ein: That's the full pack for now. All safe and sound.\n");
 }
@@ -648,27 +996,14 @@ void save_contacts_to_file(const AddressBook *book) {
 
     printf("\n<==========================| SAVE CONTACTS TO FILE |==========================>\n");
 
-    FILE *fptr = fopen("contacts.csv", "w");
-    if(fptr == NULL) {
+    TraceSpan span = TRACE_BEGIN("save");
+    if (save_contacts_csv(book, "contacts.csv") < 0) {
         printf("Ein: *Whines softly* I couldn't open the file to save your contacts.\n");
         printf("Ein: Let's check the file location and try again later.\n");
+        TRACE_END_COUNT(span, "contacts", 0);
         return;
     }
-
-    fprintf(fptr, "%d\n", book->contact_count);
-
-    const Contact *current = book->head;
-
-    while(current != NULL) {
-        fprintf(fptr, "%d,%s,%s,%s\n",
-                current->id,
-                current->name,
-                current->phone,
-                current->email);
-        current = current->next;
-    }
-
-    fclose(fptr);
+    TRACE_END_COUNT(span, "contacts", book->contact_count);
 
     printf("Ein: All contacts have been safely stored in my data vault.\n");
     printf("--------------------------------------------------\n");
@@ -686,60 +1021,20 @@ void load_contacts_from_file(AddressBook *book) {
 
     printf("\n<=========================| LOAD CONTACTS FROM FILE |===========================>\n\n");
 
-    FILE *fptr = fopen("contacts.csv", "r");
-    if(fptr == NULL) {
+    int skipped = 0;
+    int loaded = load_contacts_csv(book, "contacts.csv", &skipped);
+    if (loaded == -1) {
         printf("Ein: *Sniffs around the desk* Hmm I couldn't find or open 'contacts.csv'.\n");
         printf("Ein: Maybe it's not here yet, we can create it when you save your first contact.\n");
         return;
     }
-
-    int num_contacts;
-    if (fscanf(fptr, "%d\n", &num_contacts) != 1) {
+    if (loaded == -2) {
         printf("Ein: *Tilts head* I couldn't read the contact count, the file might be damaged.\n");
-        fclose(fptr);
         return;
     }
-    
-    //initialize(book);
-    Contact *tail = NULL;
-
-    // Step 4: Read each contact line
-    for (int i = 0; i < num_contacts; i++) 
-    {
-        Contact *new_contact = malloc(sizeof(Contact));
-        if (new_contact == NULL) {
-            printf("Ein: *Whines softly* I ran out of space to load more contacts.\n");
-            fclose(fptr);
-            return;
-        }
-
-        if (fscanf(fptr,"%d,%49[^,],%19[^,],%49[^\n]\n",
-                   &new_contact->id,
-                   new_contact->name,
-                   new_contact->phone,
-                   new_contact->email) != 4)
-        {
-            printf("Ein: Couldn't read contact #%d properly, skipping it.\n", i + 1);
-            free(new_contact);
-            continue;
-        }
-
-        new_contact->next = NULL;
-
-        // Append to the linked list
-        if (book->head == NULL) {
-            book->head = new_contact;
-            tail = new_contact;
-        }
-        else {
-            tail->next = new_contact;
-            tail = new_contact;
-        }
-
-        book->contact_count++;
-    } 
-
-    fclose(fptr);
+    if (skipped > 0) {
+        printf("Ein: Couldn't read %d contact(s) properly, skipped them.\n", skipped);
+    }
     printf("Ein: Successfully fetched %d contact(s) from my storage.\n", book->contact_count);
     if (book->contact_count == 0) {
         printf("Ein: Looks like the file was empty, let's get ready to start fresh!\n");
@@ -752,3 +1047,138 @@ void load_contacts_from_file(AddressBook *book) {
 
 
 
+
+/**
+ * @brief Writes the book as CSV: a count line, then one "id,name,phone,email" line per contact.
+ * @param book A const pointer to the AddressBook.
+ * @param path Path of the CSV file.
+ * @return Number of contacts written, or -1 on error.
+ */
+int save_contacts_csv(const AddressBook *book, const char *path) {
+    FILE *fptr = fopen(path, "w");
+    if (fptr == NULL) {
+        return -1;
+    }
+
+    // With snapshots enabled, write a consistent version while writers carry on.
+    TraceSpan span = TRACE_BEGIN("save.csv");
+    BookSnapshot *snapshot = snapshot_open(book);
+    int count = snapshot != NULL ? (int)snapshot->count : book->contact_count;
+    fprintf(fptr, "%d\n", count);
+
+    const Contact *current = NULL;
+    for (int i = 0; i < count; i++) {
+        current = snapshot != NULL ? snapshot->contacts[i]
+                                   : (current == NULL ? book->head : current->next);
+        fprintf(fptr, "%d,%s,%s,%s\n", current->id, current->name, current->phone, current->email);
+    }
+    snapshot_close(snapshot);
+    TRACE_END_COUNT(span, "records", count);
+
+    return fclose(fptr) == 0 ? count : -1;
+}
+
+/**
+ * @brief Reads a CSV file written by save_contacts_csv and appends its contacts.
+ * @param book A pointer to the AddressBook.
+ * @param path Path of the CSV file.
+ * @param skipped Output: number of damaged records skipped (may be NULL).
+ * @return Number of contacts loaded, -1 if the file could not be opened, -2 on a bad header.
+ */
+int load_contacts_csv(AddressBook *book, const char *path, int *skipped) {
+    if (skipped != NULL) {
+        *skipped = 0;
+    }
+
+    FILE *fptr = fopen(path, "r");
+    if (fptr == NULL) {
+        return -1;
+    }
+
+    int num_contacts;
+    if (fscanf(fptr, "%d\n", &num_contacts) != 1) {
+        fclose(fptr);
+        return -2;
+    }
+
+    char (*lines)[LOAD_LINE_LENGTH] = malloc(sizeof(*lines) * LOAD_BATCH_RECORDS);
+    Contact **batch = malloc(sizeof(Contact *) * LOAD_BATCH_RECORDS);
+    if (lines == NULL || batch == NULL) {
+        free(lines);
+        free(batch);
+        fclose(fptr);
+        return -1;
+    }
+
+    // Records go through in batches, one phase at a time, so each phase shows up in a trace.
+    TraceSpan load_span = TRACE_BEGIN("load");
+    int loaded = 0;
+    int bad = 0;
+    int remaining = num_contacts;
+    bool out_of_memory = false;
+    while (remaining > 0 && !out_of_memory) {
+        TraceSpan read_span = TRACE_BEGIN("load.read");
+        int line_count = 0;
+        while (line_count < LOAD_BATCH_RECORDS && line_count < remaining &&
+               fgets(lines[line_count], LOAD_LINE_LENGTH, fptr) != NULL) {
+            char *line = lines[line_count];
+            size_t length = strcspn(line, "\n");
+            bool overlong = line[length] != '\n' && !feof(fptr);
+            line[length] = '\0';
+            if (overlong) {
+                // Longer than any valid record: drop the rest and let parsing reject it.
+                int c;
+                while ((c = getc(fptr)) != '\n' && c != EOF) {
+                }
+                line[0] = '\0';
+            }
+            else if (line[strspn(line, " \t\r")] == '\0') {
+                continue; // blank lines between records are not records
+            }
+            line_count++;
+        }
+        TRACE_END_COUNT(read_span, "records", line_count);
+        if (line_count == 0) {
+            break;
+        }
+        remaining -= line_count;
+
+        TraceSpan parse_span = TRACE_BEGIN("load.parse");
+        int parsed = 0;
+        for (int i = 0; i < line_count; i++) {
+            Contact *new_contact = malloc(sizeof(Contact));
+            if (new_contact == NULL) {
+                out_of_memory = true;
+                break;
+            }
+            if (sscanf(lines[i], "%d,%49[^,],%19[^,],%49[^\n]", &new_contact->id,
+                       new_contact->name, new_contact->phone, new_contact->email) != 4) {
+                free(new_contact);
+                bad++;
+                continue;
+            }
+            batch[parsed++] = new_contact;
+        }
+        TRACE_END_COUNT(parse_span, "records", parsed);
+
+        TraceSpan insert_span = TRACE_BEGIN("load.insert");
+        for (int i = 0; i < parsed; i++) {
+            book_append_contact(book, batch[i]);
+        }
+        loaded += parsed;
+        TRACE_END_COUNT(insert_span, "records", parsed);
+    }
+    TRACE_END_COUNT(load_span, "records", loaded);
+
+    // Records the header promised but the file does not have count as damaged.
+    if (!out_of_memory) {
+        bad += remaining;
+    }
+    if (skipped != NULL) {
+        *skipped = bad;
+    }
+    free(lines);
+    free(batch);
+    fclose(fptr);
+    return loaded;
+}
@@ -0,0 +1,805 @@
+/**
+ * @file autocomplete.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of prefix autocomplete with block-max top-K search.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <time.h>
+#include "address_book.h"
+#include "autocomplete.h"
+#include "contact_helper.h"
+#include "trace.h"
+
+#define USES_INITIAL_CAPACITY 64
+
+/**
+ * @brief One contact in a field's sorted array.
+ */
+typedef struct {
+    uint64_t head;          /**< First eight folded key bytes, big-endian, for fast sorting. */
+    const char *key;        /**< The contact's value for this field. */
+    const Contact *contact; /**< The contact. */
+    uint64_t score;         /**< Pick count in the high half, ID in the low half. */
+} SuggestEntry;
+
+/**
+ * @brief The sorted array of one field, its block maxima, and contacts added since the build.
+ */
+typedef struct {
+    SuggestEntry *entries; /**< Entries sorted by folded key, then ID. */
+    size_t count;          /**< Number of entries. */
+    uint64_t *block_max;   /**< Highest score in each block (an upper bound after removals). */
+    SuggestEntry *pending; /**< Entries added since the build, also sorted. */
+    size_t pending_count;  /**< Number of pending entries. */
+} SuggestList;
+
+/**
+ * @brief How many times a contact was picked, keyed by ID so it survives edits and rebuilds.
+ */
+typedef struct {
+    int id;            /**< Contact ID, or 0 for an unused slot. */
+    unsigned int uses; /**< Number of picks. */
+} UseCount;
+
+struct Autocomplete {
+    SuggestList lists[AUTOCOMPLETE_FIELD_COUNT]; /**< One sorted array per field. */
+    bool built;                                  /**< Whether the arrays are current. */
+    size_t removals;                             /**< Removals from the arrays since the build. */
+    UseCount *uses;                              /**< Open-addressing map of pick counts. */
+    size_t uses_capacity;                        /**< Slots in @c uses (a power of two). */
+    size_t uses_count;                           /**< Contacts with at least one pick. */
+};
+
+/**
+ * @brief Top-K selection: a min-heap of the best entries seen so far.
+ */
+typedef struct {
+    const SuggestEntry *items[AUTOCOMPLETE_MAX_SUGGESTIONS];
+    int count;
+    int limit;
+} TopK;
+
+// ========================= Keys and Scores ========================= //
+
+static const char *field_value(const Contact *contact, AutocompleteField field) {
+    switch (field) {
+        case AUTOCOMPLETE_PHONE:
+            return contact->phone;
+        case AUTOCOMPLETE_EMAIL:
+            return contact->email;
+        default:
+            return contact->name;
+    }
+}
+
+/**
+ * @brief Compares two values case-insensitively (phones and emails have no case to fold).
+ */
+static int compare_folded(const char *a, const char *b) {
+    for (;; a++, b++) {
+        int left = tolower((unsigned char)*a);
+        int right = tolower((unsigned char)*b);
+        if (left != right || left == '\0') {
+            return left - right;
+        }
+    }
+}
+
+/**
+ * @brief Compares a value with a folded prefix: 0 if the value starts with it.
+ */
+static int compare_to_prefix(const char *key, const char *prefix) {
+    for (; *prefix != '\0'; key++, prefix++) {
+        int left = tolower((unsigned char)*key);
+        if (left != (unsigned char)*prefix) {
+            return left - (unsigned char)*prefix;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Packs the first eight folded bytes of a key so integer order matches key order.
+ */
+static uint64_t key_head(const char *key) {
+    uint64_t head = 0;
+    int i = 0;
+    for (; i < 8 && key[i] != '\0'; i++) {
+        head = (head << 8) | (unsigned char)tolower((unsigned char)key[i]);
+    }
+    return head << (8 * (8 - i));
+}
+
+static int compare_entries(const void *a, const void *b) {
+    const SuggestEntry *left = a;
+    const SuggestEntry *right = b;
+
+    if (left->head != right->head) {
+        return left->head < right->head ? -1 : 1;
+    }
+    // Equal heads of keys shorter than eight bytes mean equal keys; no need to compare.
+    int order = (left->head & 0xff) == 0 ? 0 : compare_folded(left->key + 8, right->key + 8);
+    if (order != 0) {
+        return order;
+    }
+    if (left->contact->id != right->contact->id) {
+        return left->contact->id < right->contact->id ? -1 : 1;
+    }
+    return (left->contact > right->contact) - (left->contact < right->contact);
+}
+
+/**
+ * @brief Integer mixer so sequential IDs spread over the use-count table.
+ */
+static size_t hash_id(int id) {
+    unsigned int h = (unsigned int)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static UseCount *use_slot(const struct Autocomplete *autocomplete, int id) {
+    size_t mask = autocomplete->uses_capacity - 1;
+    size_t i = hash_id(id) & mask;
+    while (autocomplete->uses[i].id != 0 && autocomplete->uses[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    return &autocomplete->uses[i];
+}
+
+static uint64_t contact_score(const struct Autocomplete *autocomplete, const Contact *contact) {
+    uint64_t uses = use_slot(autocomplete, contact->id)->uses;
+    return (uses << 32) | (uint32_t)contact->id;
+}
+
+/**
+ * @brief Adds one pick for an ID, growing the table when it passes 70% full.
+ * @return The new pick count, or 0 if memory could not be allocated.
+ */
+static unsigned int add_use(struct Autocomplete *autocomplete, int id) {
+    if ((autocomplete->uses_count + 1) * 10 > autocomplete->uses_capacity * 7) {
+        size_t old_capacity = autocomplete->uses_capacity;
+        UseCount *old = autocomplete->uses;
+        UseCount *grown = calloc(old_capacity * 2, sizeof(UseCount));
+        if (grown == NULL) {
+            return 0;
+        }
+        autocomplete->uses = grown;
+        autocomplete->uses_capacity = old_capacity * 2;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old[i].id != 0) {
+                *use_slot(autocomplete, old[i].id) = old[i];
+            }
+        }
+        free(old);
+    }
+
+    UseCount *slot = use_slot(autocomplete, id);
+    if (slot->id == 0) {
+        slot->id = id;
+        autocomplete->uses_count++;
+    }
+    return ++slot->uses;
+}
+
+// ========================= Sorted Arrays ========================= //
+
+/**
+ * @brief First entry whose key is not below @p key (exact comparison).
+ */
+static size_t lower_bound_key(const SuggestEntry *entries, size_t count, const char *key) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (compare_folded(entries[mid].key, key) < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief The range of entries starting with a folded prefix, as [*first, *last).
+ */
+static void prefix_range(const SuggestEntry *entries, size_t count, const char *prefix,
+                         size_t *first, size_t *last) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (compare_to_prefix(entries[mid].key, prefix) < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    *first = low;
+
+    high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (compare_to_prefix(entries[mid].key, prefix) <= 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    *last = low;
+}
+
+/**
+ * @brief Finds the entry of a contact, searching by the key it was added under.
+ * @return Its position, or @p count if it is not there.
+ */
+static size_t find_entry(const SuggestEntry *entries, size_t count, const Contact *contact,
+                         const char *key) {
+    for (size_t i = lower_bound_key(entries, count, key);
+         i < count && compare_folded(entries[i].key, key) == 0; i++) {
+        if (entries[i].contact == contact) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static void list_free(SuggestList *list) {
+    free(list->entries);
+    free(list->block_max);
+    free(list->pending);
+    memset(list, 0, sizeof(SuggestList));
+}
+
+static void compute_block_max(SuggestList *list) {
+    size_t blocks = (list->count + AUTOCOMPLETE_BLOCK_SIZE - 1) / AUTOCOMPLETE_BLOCK_SIZE;
+    for (size_t b = 0; b < blocks; b++) {
+        size_t end = (b + 1) * AUTOCOMPLETE_BLOCK_SIZE;
+        if (end > list->count) {
+            end = list->count;
+        }
+        uint64_t best = 0;
+        for (size_t i = b * AUTOCOMPLETE_BLOCK_SIZE; i < end; i++) {
+            if (list->entries[i].score > best) {
+                best = list->entries[i].score;
+            }
+        }
+        list->block_max[b] = best;
+    }
+}
+
+/**
+ * @brief Builds every field's sorted array from the book's list.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+static int autocomplete_build(struct Autocomplete *autocomplete, const AddressBook *book) {
+    size_t count = (size_t)book->contact_count;
+    size_t blocks = count / AUTOCOMPLETE_BLOCK_SIZE + 1;
+    TraceSpan span = TRACE_BEGIN("index.autocomplete");
+
+    for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+        SuggestList *list = &autocomplete->lists[field];
+        list->entries = malloc(sizeof(SuggestEntry) * (count + 1));
+        list->block_max = malloc(sizeof(uint64_t) * blocks);
+        list->pending = malloc(sizeof(SuggestEntry) * AUTOCOMPLETE_PENDING_LIMIT);
+        if (list->entries == NULL || list->block_max == NULL || list->pending == NULL) {
+            autocomplete_invalidate(autocomplete);
+            TRACE_END(span);
+            return -1;
+        }
+
+        list->count = 0;
+        for (const Contact *current = book->head; current != NULL; current = current->next) {
+            SuggestEntry *entry = &list->entries[list->count++];
+            entry->contact = current;
+            entry->key = field_value(current, (AutocompleteField)field);
+            entry->head = key_head(entry->key);
+            entry->score = contact_score(autocomplete, current);
+        }
+        qsort(list->entries, list->count, sizeof(SuggestEntry), compare_entries);
+        compute_block_max(list);
+    }
+
+    autocomplete->built = true;
+    autocomplete->removals = 0;
+    TRACE_END_COUNT(span, "contacts", count);
+    return 0;
+}
+
+// ========================= Top-K ========================= //
+
+static void topk_offer(TopK *top, const SuggestEntry *entry) {
+    const SuggestEntry **heap = top->items;
+    int i;
+
+    if (top->count < top->limit) {
+        // Sift the new entry up from the end.
+        for (i = top->count++; i > 0 && heap[(i - 1) / 2]->score > entry->score; i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        heap[i] = entry;
+        return;
+    }
+    if (entry->score <= heap[0]->score) {
+        return;
+    }
+
+    // Replace the worst and sift it down.
+    for (i = 0;;) {
+        int child = 2 * i + 1;
+        if (child >= top->count) {
+            break;
+        }
+        if (child + 1 < top->count && heap[child + 1]->score < heap[child]->score) {
+            child++;
+        }
+        if (heap[child]->score >= entry->score) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = entry;
+}
+
+static bool topk_beats(const TopK *top, uint64_t score) {
+    return top->count < top->limit || score > top->items[0]->score;
+}
+
+static int compare_by_score(const void *a, const void *b) {
+    const SuggestEntry *left = *(const SuggestEntry *const *)a;
+    const SuggestEntry *right = *(const SuggestEntry *const *)b;
+    return (left->score < right->score) - (left->score > right->score);
+}
+
+/**
+ * @brief Folds a typed prefix the way keys are compared.
+ */
+static void fold_prefix(const char *prefix, char *folded) {
+    int length = 0;
+    for (; prefix[length] != '\0' && length < MAX_EMAIL_LENGTH - 1; length++) {
+        folded[length] = (char)tolower((unsigned char)prefix[length]);
+    }
+    folded[length] = '\0';
+}
+
+/**
+ * @brief Builds the arrays if needed and returns a field's list, or NULL if that fails.
+ */
+static const SuggestList *ready_list(const AddressBook *book, AutocompleteField field) {
+    struct Autocomplete *autocomplete = book->autocomplete;
+    if (autocomplete == NULL || (unsigned)field >= AUTOCOMPLETE_FIELD_COUNT) {
+        return NULL;
+    }
+    if (!autocomplete->built && autocomplete_build(autocomplete, book) != 0) {
+        return NULL;
+    }
+    return &autocomplete->lists[field];
+}
+
+// ========================= Public API ========================= //
+
+int book_enable_autocomplete(AddressBook *book) {
+    if (book->autocomplete != NULL) {
+        return 0;
+    }
+
+    struct Autocomplete *autocomplete = calloc(1, sizeof(struct Autocomplete));
+    if (autocomplete == NULL) {
+        return -1;
+    }
+    autocomplete->uses_capacity = USES_INITIAL_CAPACITY;
+    autocomplete->uses = calloc(autocomplete->uses_capacity, sizeof(UseCount));
+    if (autocomplete->uses == NULL) {
+        free(autocomplete);
+        return -1;
+    }
+
+    book->autocomplete = autocomplete;
+    return 0;
+}
+
+int autocomplete_suggest(const AddressBook *book, AutocompleteField field, const char *prefix,
+                         const Contact **suggestions, int limit) {
+    const SuggestList *list = ready_list(book, field);
+    if (list == NULL) {
+        return -1;
+    }
+
+    char folded[MAX_EMAIL_LENGTH];
+    fold_prefix(prefix, folded);
+
+    TopK top;
+    top.count = 0;
+    top.limit = limit < AUTOCOMPLETE_MAX_SUGGESTIONS ? limit : AUTOCOMPLETE_MAX_SUGGESTIONS;
+    if (top.limit <= 0) {
+        return 0;
+    }
+
+    size_t first;
+    size_t last;
+    prefix_range(list->entries, list->count, folded, &first, &last);
+
+    // Walk the range a block at a time, opening only blocks that could improve the top K.
+    for (size_t i = first; i < last;) {
+        size_t block = i / AUTOCOMPLETE_BLOCK_SIZE;
+        size_t end = (block + 1) * AUTOCOMPLETE_BLOCK_SIZE;
+        if (end > last) {
+            end = last;
+        }
+        if (topk_beats(&top, list->block_max[block])) {
+            for (; i < end; i++) {
+                topk_offer(&top, &list->entries[i]);
+            }
+        }
+        i = end;
+    }
+
+    prefix_range(list->pending, list->pending_count, folded, &first, &last);
+    for (size_t i = first; i < last; i++) {
+        topk_offer(&top, &list->pending[i]);
+    }
+
+    qsort(top.items, (size_t)top.count, sizeof(top.items[0]), compare_by_score);
+    for (int i = 0; i < top.count; i++) {
+        suggestions[i] = top.items[i]->contact;
+    }
+    return top.count;
+}
+
+long autocomplete_prefix_count(const AddressBook *book, AutocompleteField field,
+                               const char *prefix) {
+    const SuggestList *list = ready_list(book, field);
+    if (list == NULL) {
+        return -1;
+    }
+
+    char folded[MAX_EMAIL_LENGTH];
+    fold_prefix(prefix, folded);
+
+    size_t first;
+    size_t last;
+    prefix_range(list->entries, list->count, folded, &first, &last);
+    size_t count = last - first;
+    prefix_range(list->pending, list->pending_count, folded, &first, &last);
+    return (long)(count + last - first);
+}
+
+int autocomplete_prefix_each(const AddressBook *book, AutocompleteField field, const char *prefix,
+                             int (*visit)(const Contact *contact, void *context), void *context) {
+    const SuggestList *list = ready_list(book, field);
+    if (list == NULL) {
+        return -1;
+    }
+
+    char folded[MAX_EMAIL_LENGTH];
+    fold_prefix(prefix, folded);
+
+    const SuggestEntry *runs[2] = {list->entries, list->pending};
+    size_t counts[2] = {list->count, list->pending_count};
+    for (int run = 0; run < 2; run++) {
+        size_t first;
+        size_t last;
+        prefix_range(runs[run], counts[run], folded, &first, &last);
+        for (size_t i = first; i < last; i++) {
+            int status = visit(runs[run][i].contact, context);
+            if (status != 0) {
+                return status;
+            }
+        }
+    }
+    return 0;
+}
+
+void autocomplete_record_use(AddressBook *book, const Contact *contact) {
+    struct Autocomplete *autocomplete = book->autocomplete;
+    if (autocomplete == NULL || add_use(autocomplete, contact->id) == 0 || !autocomplete->built) {
+        return;
+    }
+
+    uint64_t score = contact_score(autocomplete, contact);
+    for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+        SuggestList *list = &autocomplete->lists[field];
+        const char *key = field_value(contact, (AutocompleteField)field);
+
+        size_t i = find_entry(list->entries, list->count, contact, key);
+        if (i < list->count) {
+            list->entries[i].score = score;
+            if (score > list->block_max[i / AUTOCOMPLETE_BLOCK_SIZE]) {
+                list->block_max[i / AUTOCOMPLETE_BLOCK_SIZE] = score;
+            }
+            continue;
+        }
+        i = find_entry(list->pending, list->pending_count, contact, key);
+        if (i < list->pending_count) {
+            list->pending[i].score = score;
+        }
+    }
+}
+
+AutocompleteField autocomplete_guess_field(const char *prefix) {
+    if (strchr(prefix, '@') != NULL) {
+        return AUTOCOMPLETE_EMAIL;
+    }
+    if (isdigit((unsigned char)prefix[0])) {
+        return AUTOCOMPLETE_PHONE;
+    }
+    return AUTOCOMPLETE_NAME;
+}
+
+// ========================= Book Maintenance ========================= //
+
+void autocomplete_add_contact(struct Autocomplete *autocomplete, Contact *contact) {
+    if (autocomplete == NULL || !autocomplete->built) {
+        return;
+    }
+
+    // A full pending list means a bulk change is under way; rebuilding later is cheaper.
+    if (autocomplete->lists[0].pending_count == AUTOCOMPLETE_PENDING_LIMIT) {
+        autocomplete_invalidate(autocomplete);
+        return;
+    }
+
+    for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+        SuggestList *list = &autocomplete->lists[field];
+        const char *key = field_value(contact, (AutocompleteField)field);
+        SuggestEntry entry = {key_head(key), key, contact, contact_score(autocomplete, contact)};
+
+        size_t low = 0;
+        size_t high = list->pending_count;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (compare_entries(&list->pending[mid], &entry) < 0) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+        memmove(&list->pending[low + 1], &list->pending[low],
+                sizeof(SuggestEntry) * (list->pending_count - low));
+        list->pending[low] = entry;
+        list->pending_count++;
+    }
+}
+
+void autocomplete_remove_contact(struct Autocomplete *autocomplete, const Contact *contact) {
+    if (autocomplete == NULL || !autocomplete->built) {
+        return;
+    }
+    if (autocomplete->removals == AUTOCOMPLETE_MAX_REMOVALS) {
+        autocomplete_invalidate(autocomplete);
+        return;
+    }
+
+    for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+        SuggestList *list = &autocomplete->lists[field];
+        const char *key = field_value(contact, (AutocompleteField)field);
+
+        size_t i = find_entry(list->pending, list->pending_count, contact, key);
+        if (i < list->pending_count) {
+            memmove(&list->pending[i], &list->pending[i + 1],
+                    sizeof(SuggestEntry) * (list->pending_count - i - 1));
+            list->pending_count--;
+            continue;
+        }
+
+        i = find_entry(list->entries, list->count, contact, key);
+        if (i == list->count) {
+            continue;
+        }
+        size_t blocks = (list->count + AUTOCOMPLETE_BLOCK_SIZE - 1) / AUTOCOMPLETE_BLOCK_SIZE;
+        memmove(&list->entries[i], &list->entries[i + 1],
+                sizeof(SuggestEntry) * (list->count - i - 1));
+        list->count--;
+
+        // Entries shifted one place left, so a block now holds part of its successor.
+        for (size_t b = i / AUTOCOMPLETE_BLOCK_SIZE; b + 1 < blocks; b++) {
+            if (list->block_max[b + 1] > list->block_max[b]) {
+                list->block_max[b] = list->block_max[b + 1];
+            }
+        }
+        autocomplete->removals++;
+    }
+}
+
+void autocomplete_invalidate(struct Autocomplete *autocomplete) {
+    if (autocomplete == NULL) {
+        return;
+    }
+    for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+        list_free(&autocomplete->lists[field]);
+    }
+    autocomplete->built = false;
+}
+
+void autocomplete_free(struct Autocomplete *autocomplete) {
+    if (autocomplete == NULL) {
+        return;
+    }
+    autocomplete_invalidate(autocomplete);
+    free(autocomplete->uses);
+    free(autocomplete);
+}
+
+// ========================= Interactive and CLI ========================= //
+
+static const char *FIELD_NAMES[AUTOCOMPLETE_FIELD_COUNT] = {"name", "phone", "email"};
+
+static double elapsed_microseconds(const struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) * 1e6 + (double)(now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+static void print_suggestions(const Contact **suggestions, int count) {
+    printf("--------------------------------------------------------------------------------\n");
+    printf(" No. | ID   | %-20s | %-15s | %-30s\n", "Name", "Phone", "Email");
+    printf("--------------------------------------------------------------------------------\n");
+    for (int i = 0; i < count; i++) {
+        printf(" %-3d | %-4d | %-20s | %-15s | %-30s\n", i + 1, suggestions[i]->id,
+               suggestions[i]->name, suggestions[i]->phone, suggestions[i]->email);
+    }
+    printf("--------------------------------------------------------------------------------\n");
+}
+
+void run_autocomplete(AddressBook *book) {
+    printf("\n<===============================| QUICK FIND |=================================>\n");
+    printf("Ein: Start typing a name, phone, or email and I'll guess the rest.\n");
+
+    if (book->head == NULL) {
+        printf("\nEin: *Ears droop* Looks like your address book is empty. Nothing to sniff out yet!\n");
+        return;
+    }
+    if (book_enable_autocomplete(book) != 0) {
+        printf("Ein: *Whines* I couldn't get my nose ready for quick finds.\n");
+        return;
+    }
+
+    const Contact *suggestions[AUTOCOMPLETE_DEFAULT_SUGGESTIONS];
+    int count = 0;
+    char input[MAX_EMAIL_LENGTH];
+
+    for (;;) {
+        printf("\nEin: Type a few letters (#<n> picks a suggestion, Enter goes back): ");
+        if (fgets(input, sizeof(input), stdin) == NULL) {
+            return;
+        }
+        remove_newline(input);
+        if (input[0] == '\0') {
+            printf("Ein: Alright, back to the main menu.\n");
+            return;
+        }
+
+        if (input[0] == '#') {
+            int choice = atoi(input + 1);
+            if (choice < 1 || choice > count) {
+                printf("Ein: *Tilts head* That's not one of the suggestions.\n");
+                continue;
+            }
+            const Contact *picked = suggestions[choice - 1];
+            printf("\nEin: Got it! Fetching the details for you now:\n\n");
+            printf("Name  : %s\n", picked->name);
+            printf("Phone : %s\n", picked->phone);
+            printf("Email : %s\n", picked->email);
+            autocomplete_record_use(book, picked);
+            count = 0;
+            continue;
+        }
+
+        AutocompleteField field = autocomplete_guess_field(input);
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        count = autocomplete_suggest(book, field, input, suggestions,
+                                     AUTOCOMPLETE_DEFAULT_SUGGESTIONS);
+        double micros = elapsed_microseconds(&start);
+
+        if (count < 0) {
+            printf("Ein: *Whines* I couldn't fetch suggestions right now.\n");
+            count = 0;
+        }
+        else if (count == 0) {
+            printf("Ein: *Sniffs around* No %s starts with \"%s\".\n", FIELD_NAMES[field], input);
+        }
+        else {
+            printf("\nEin: Best %s matches for \"%s\" (%.0f us):\n", FIELD_NAMES[field], input,
+                   micros);
+            print_suggestions(suggestions, count);
+        }
+    }
+}
+
+static void print_suggest_usage(void) {
+    printf("Usage: addressbook suggest [--field name|phone|email] [--limit <count>] <prefix>...\n");
+    printf("  Suggests contacts from contacts.csv whose field starts with each prefix.\n");
+    printf("  Without --field, digits complete phones and an '@' completes emails.\n");
+}
+
+int run_suggest_command(int argc, char *argv[]) {
+    int limit = AUTOCOMPLETE_DEFAULT_SUGGESTIONS;
+    int forced_field = -1;
+    int first_prefix = 0;
+
+    for (; first_prefix < argc && strncmp(argv[first_prefix], "--", 2) == 0; first_prefix += 2) {
+        if (first_prefix + 1 >= argc) {
+            print_suggest_usage();
+            return 1;
+        }
+        const char *value = argv[first_prefix + 1];
+        if (strcmp(argv[first_prefix], "--limit") == 0) {
+            limit = atoi(value);
+            if (limit < 1 || limit > AUTOCOMPLETE_MAX_SUGGESTIONS) {
+                printf("Ein: The limit must be between 1 and %d.\n", AUTOCOMPLETE_MAX_SUGGESTIONS);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[first_prefix], "--field") == 0) {
+            for (int field = 0; field < AUTOCOMPLETE_FIELD_COUNT; field++) {
+                if (strcmp(value, FIELD_NAMES[field]) == 0) {
+                    forced_field = field;
+                }
+            }
+            if (forced_field < 0) {
+                print_suggest_usage();
+                return 1;
+            }
+        }
+        else {
+            print_suggest_usage();
+            return 1;
+        }
+    }
+    if (first_prefix >= argc) {
+        print_suggest_usage();
+        return 1;
+    }
+
+    AddressBook book;
+    initialize(&book);
+    if (load_contacts_csv(&book, "contacts.csv", NULL) < 0 || book_enable_autocomplete(&book) != 0) {
+        printf("Ein: *Whines* I couldn't read contacts.csv.\n");
+        free_address_book(&book);
+        return 1;
+    }
+
+    // The first suggestion builds the sorted arrays; time that separately.
+    const Contact *suggestions[AUTOCOMPLETE_MAX_SUGGESTIONS];
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    if (autocomplete_suggest(&book, AUTOCOMPLETE_NAME, "", suggestions, 1) < 0) {
+        printf("Ein: *Whines* I ran out of memory building the suggestions.\n");
+        free_address_book(&book);
+        return 1;
+    }
+    printf("Ein: Indexed %d contact(s) for quick find in %.1f ms.\n", book.contact_count,
+           elapsed_microseconds(&start) / 1e3);
+
+    for (int i = first_prefix; i < argc; i++) {
+        AutocompleteField field =
+            forced_field >= 0 ? (AutocompleteField)forced_field : autocomplete_guess_field(argv[i]);
+        timespec_get(&start, TIME_UTC);
+        int count = autocomplete_suggest(&book, field, argv[i], suggestions, limit);
+        double micros = elapsed_microseconds(&start);
+
+        printf("\nEin: %d %s suggestion(s) for \"%s\" in %.1f us:\n", count, FIELD_NAMES[field],
+               argv[i], micros);
+        print_suggestions(suggestions, count);
+    }
+
+    free_address_book(&book);
+    return 0;
+}
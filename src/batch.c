@@ -0,0 +1,479 @@
+/**
+ * @file batch.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of staged, all-or-nothing batches of mutations.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "address_book.h"
+#include "ab_api.h"
+#include "batch.h"
+#include "contact_helper.h"
+#include "contact_index.h"
+#include "snapshot.h"
+
+#define BATCH_INITIAL_CAPACITY 16
+#define BATCH_TEMP_SUFFIX ".tmp"
+
+/**
+ * @brief A value (phone or folded email) or ID tagged with the operation that introduced it.
+ */
+typedef struct {
+    char key[MAX_EMAIL_LENGTH];
+    size_t op;
+} KeyedOp;
+
+/**
+ * @brief An update/remove target ID tagged with its operation.
+ */
+typedef struct {
+    int id;
+    size_t op;
+} TargetOp;
+
+/**
+ * @brief Everything validation works out, kept so commit does not redo it.
+ */
+typedef struct {
+    Contact **targets;   // Per operation: the contact an update/remove acts on.
+    TargetOp *touched;   // Update/remove targets sorted by ID.
+    size_t touched_count;
+    size_t remove_count;
+    size_t add_count;
+} BatchPlan;
+
+// ========================= Staging ========================= //
+
+void batch_init(Batch *batch) {
+    batch->ops = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void batch_free(Batch *batch) {
+    free(batch->ops);
+    batch_init(batch);
+}
+
+static BatchOp *batch_push(Batch *batch, BatchOpType type, int id) {
+    if (batch->count == batch->capacity) {
+        size_t capacity = batch->capacity == 0 ? BATCH_INITIAL_CAPACITY : batch->capacity * 2;
+        BatchOp *grown = realloc(batch->ops, sizeof(BatchOp) * capacity);
+        if (grown == NULL) {
+            return NULL;
+        }
+        batch->ops = grown;
+        batch->capacity = capacity;
+    }
+
+    BatchOp *op = &batch->ops[batch->count++];
+    memset(op, 0, sizeof(BatchOp));
+    op->type = type;
+    op->id = id;
+    return op;
+}
+
+/**
+ * @brief Copies a field, truncating so an over-long value fails validation instead of overflowing.
+ */
+static void copy_field(char *dest, const char *src, size_t size) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+static int stage_values(Batch *batch, BatchOpType type, int id, const char *name,
+                        const char *phone, const char *email) {
+    BatchOp *op = batch_push(batch, type, id);
+    if (op == NULL) {
+        return -1;
+    }
+    copy_field(op->name, name, sizeof(op->name));
+    copy_field(op->phone, phone, sizeof(op->phone));
+    copy_field(op->email, email, sizeof(op->email));
+    return 0;
+}
+
+int batch_add(Batch *batch, const char *name, const char *phone, const char *email) {
+    return stage_values(batch, BATCH_ADD, 0, name, phone, email);
+}
+
+int batch_update(Batch *batch, int id, const char *name, const char *phone, const char *email) {
+    return stage_values(batch, BATCH_UPDATE, id, name, phone, email);
+}
+
+int batch_remove(Batch *batch, int id) {
+    return batch_push(batch, BATCH_REMOVE, id) == NULL ? -1 : 0;
+}
+
+// ========================= Validation ========================= //
+
+static int compare_keyed(const void *a, const void *b) {
+    const KeyedOp *left = a;
+    const KeyedOp *right = b;
+    int order = strcmp(left->key, right->key);
+    if (order != 0) {
+        return order;
+    }
+    return (left->op > right->op) - (left->op < right->op);
+}
+
+static int compare_target(const void *a, const void *b) {
+    const TargetOp *left = a;
+    const TargetOp *right = b;
+    if (left->id != right->id) {
+        return (left->id > right->id) - (left->id < right->id);
+    }
+    return (left->op > right->op) - (left->op < right->op);
+}
+
+static const TargetOp *find_touched(const BatchPlan *plan, int id) {
+    size_t low = 0;
+    size_t high = plan->touched_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (plan->touched[mid].id < id) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return (low < plan->touched_count && plan->touched[low].id == id) ? &plan->touched[low]
+                                                                      : NULL;
+}
+
+static const KeyedOp *find_key(const KeyedOp *keys, size_t count, const char *key) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(keys[mid].key, key) < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return (low < count && strcmp(keys[low].key, key) == 0) ? &keys[low] : NULL;
+}
+
+/**
+ * @brief Records an offending operation, keeping the earliest one.
+ */
+static void reject(BatchError *error, size_t op, ValidationStatus status) {
+    if (status != VALID && (error->status == VALID || op < error->op_index)) {
+        error->op_index = op;
+        error->status = status;
+    }
+}
+
+/**
+ * @brief True if @p holder will keep its current values (it is not updated or removed).
+ */
+static bool keeps_values(const BatchPlan *plan, const Contact *holder) {
+    return find_touched(plan, holder->id) == NULL;
+}
+
+/**
+ * @brief Flags staged values that the batch itself repeats or that a contact outside the batch
+ * already holds.
+ *
+ * @p keys must be sorted. Holders are found through @p index when the book has one, otherwise
+ * with one pass over the list.
+ */
+static void check_unique(const AddressBook *book, const BatchPlan *plan, const KeyedOp *keys,
+                         size_t count, const ContactIndex *index, bool fold, BatchError *error) {
+    for (size_t i = 1; i < count; i++) {
+        if (strcmp(keys[i].key, keys[i - 1].key) == 0) {
+            reject(error, keys[i].op, INVALID_DUPLICATE);
+        }
+    }
+
+    if (index != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            const IndexBucket *bucket = contact_index_lookup(index, keys[i].key);
+            for (size_t j = 0; bucket != NULL && j < bucket->count; j++) {
+                if (keeps_values(plan, bucket->contacts[j])) {
+                    reject(error, keys[i].op, INVALID_DUPLICATE);
+                }
+            }
+        }
+        return;
+    }
+
+    char key[MAX_EMAIL_LENGTH];
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        if (fold) {
+            index_fold_key(current->email, key);
+        }
+        else {
+            strcpy(key, current->phone);
+        }
+        const KeyedOp *hit = find_key(keys, count, key);
+        if (hit != NULL && keeps_values(plan, current)) {
+            reject(error, hit->op, INVALID_DUPLICATE);
+        }
+    }
+}
+
+static void free_plan(BatchPlan *plan) {
+    free(plan->targets);
+    free(plan->touched);
+}
+
+/**
+ * @brief Validates a batch and fills in the plan used to apply it.
+ * @return BATCH_OK, BATCH_REJECTED (with @p error set), or BATCH_FAILED.
+ */
+static BatchStatus plan_batch(const AddressBook *book, const Batch *batch, BatchPlan *plan,
+                              BatchError *error) {
+    memset(plan, 0, sizeof(BatchPlan));
+    error->op_index = 0;
+    error->status = VALID;
+
+    size_t count = batch->count == 0 ? 1 : batch->count;
+    plan->targets = calloc(count, sizeof(Contact *));
+    plan->touched = malloc(sizeof(TargetOp) * count);
+    KeyedOp *phones = malloc(sizeof(KeyedOp) * count);
+    KeyedOp *emails = malloc(sizeof(KeyedOp) * count);
+    if (plan->targets == NULL || plan->touched == NULL || phones == NULL || emails == NULL) {
+        free(phones);
+        free(emails);
+        free_plan(plan);
+        return BATCH_FAILED;
+    }
+
+    size_t value_count = 0;
+    for (size_t i = 0; i < batch->count; i++) {
+        const BatchOp *op = &batch->ops[i];
+
+        if (op->type != BATCH_ADD) {
+            if (ab_find(book, op->id, &plan->targets[i]) != VALID) {
+                reject(error, i, INVALID_NOT_FOUND);
+            }
+            plan->touched[plan->touched_count].id = op->id;
+            plan->touched[plan->touched_count].op = i;
+            plan->touched_count++;
+        }
+
+        if (op->type == BATCH_REMOVE) {
+            plan->remove_count++;
+            continue;
+        }
+        if (op->type == BATCH_ADD) {
+            plan->add_count++;
+        }
+
+        ValidationStatus status = is_valid_name(op->name);
+        if (status == VALID) {
+            status = is_valid_phone(op->phone);
+        }
+        if (status == VALID) {
+            status = is_valid_email(op->email);
+        }
+        reject(error, i, status);
+
+        strcpy(phones[value_count].key, op->phone);
+        phones[value_count].op = i;
+        index_fold_key(op->email, emails[value_count].key);
+        emails[value_count].op = i;
+        value_count++;
+    }
+
+    // Each contact may be the target of one operation only.
+    qsort(plan->touched, plan->touched_count, sizeof(TargetOp), compare_target);
+    for (size_t i = 1; i < plan->touched_count; i++) {
+        if (plan->touched[i].id == plan->touched[i - 1].id) {
+            reject(error, plan->touched[i].op, INVALID_DUPLICATE);
+        }
+    }
+
+    qsort(phones, value_count, sizeof(KeyedOp), compare_keyed);
+    qsort(emails, value_count, sizeof(KeyedOp), compare_keyed);
+    check_unique(book, plan, phones, value_count,
+                 book->indexes != NULL ? &book->indexes->by_phone : NULL, false, error);
+    check_unique(book, plan, emails, value_count,
+                 book->indexes != NULL ? &book->indexes->by_email : NULL, true, error);
+
+    free(phones);
+    free(emails);
+    if (error->status != VALID) {
+        free_plan(plan);
+        return BATCH_REJECTED;
+    }
+    return BATCH_OK;
+}
+
+BatchStatus batch_validate(const AddressBook *book, const Batch *batch, BatchError *error) {
+    BatchError ignored;
+    BatchPlan plan;
+    BatchStatus status = plan_batch(book, batch, &plan, error != NULL ? error : &ignored);
+    if (status == BATCH_OK) {
+        free_plan(&plan);
+    }
+    return status;
+}
+
+// ========================= Commit ========================= //
+
+/**
+ * @brief Writes the book as it will look after the batch, in the contacts.csv layout, then
+ * renames it into place.
+ */
+static int write_result(const AddressBook *book, const Batch *batch, const BatchPlan *plan,
+                        const char *path) {
+    size_t length = strlen(path);
+    char *temp_path = malloc(length + sizeof(BATCH_TEMP_SUFFIX));
+    if (temp_path == NULL) {
+        return -1;
+    }
+    memcpy(temp_path, path, length);
+    memcpy(temp_path + length, BATCH_TEMP_SUFFIX, sizeof(BATCH_TEMP_SUFFIX));
+
+    FILE *fptr = fopen(temp_path, "w");
+    if (fptr == NULL) {
+        free(temp_path);
+        return -1;
+    }
+
+    fprintf(fptr, "%d\n",
+            book->contact_count - (int)plan->remove_count + (int)plan->add_count);
+
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        const TargetOp *touched = find_touched(plan, current->id);
+        if (touched == NULL) {
+            fprintf(fptr, "%d,%s,%s,%s\n", current->id, current->name, current->phone,
+                    current->email);
+        }
+        else if (batch->ops[touched->op].type == BATCH_UPDATE) {
+            const BatchOp *op = &batch->ops[touched->op];
+            fprintf(fptr, "%d,%s,%s,%s\n", current->id, op->name, op->phone, op->email);
+        }
+    }
+
+    int next_id = book->next_id;
+    for (size_t i = 0; i < batch->count; i++) {
+        const BatchOp *op = &batch->ops[i];
+        if (op->type == BATCH_ADD) {
+            fprintf(fptr, "%d,%s,%s,%s\n", next_id++, op->name, op->phone, op->email);
+        }
+    }
+
+    int status = ferror(fptr) ? -1 : 0;
+    if (fclose(fptr) != 0) {
+        status = -1;
+    }
+    if (status == 0 && rename(temp_path, path) != 0) {
+        status = -1;
+    }
+    if (status != 0) {
+        remove(temp_path);
+    }
+    free(temp_path);
+    return status;
+}
+
+/**
+ * @brief Context for picking out the contacts a batch removes.
+ */
+typedef struct {
+    const BatchPlan *plan;
+    const Batch *batch;
+} RemoveScan;
+
+static int is_removed(const Contact *contact, void *context) {
+    const RemoveScan *scan = context;
+    const TargetOp *touched = find_touched(scan->plan, contact->id);
+    return touched != NULL && scan->batch->ops[touched->op].type == BATCH_REMOVE;
+}
+
+BatchStatus batch_commit(AddressBook *book, Batch *batch, const char *save_path,
+                         BatchError *error) {
+    BatchError ignored;
+    BatchPlan plan;
+    BatchStatus status = plan_batch(book, batch, &plan, error != NULL ? error : &ignored);
+    if (status != BATCH_OK) {
+        return status;
+    }
+
+    // Allocate every node the batch could need up front (adds, plus copies for updates made
+    // while a snapshot is open) so nothing can fail once the book starts changing.
+    size_t needed = batch->count - plan.remove_count;
+    Contact **spare = malloc(sizeof(Contact *) * (needed == 0 ? 1 : needed));
+    size_t allocated = 0;
+    while (spare != NULL && allocated < needed) {
+        spare[allocated] = malloc(sizeof(Contact));
+        if (spare[allocated] == NULL) {
+            break;
+        }
+        allocated++;
+    }
+    if (spare == NULL || allocated < needed ||
+        (save_path != NULL && write_result(book, batch, &plan, save_path) != 0)) {
+        for (size_t i = 0; i < allocated; i++) {
+            free(spare[i]);
+        }
+        free(spare);
+        free_plan(&plan);
+        return BATCH_FAILED;
+    }
+
+    // The whole batch commits as one version, so no snapshot sees half of it.
+    snapshot_write_begin(book);
+
+    // A batch that touches a sizeable share of the book rebuilds the indexes once instead.
+    bool bulk = batch->count * 8 >= (size_t)book->contact_count && !book->indexing_suspended;
+    if (bulk) {
+        book_suspend_indexing(book);
+    }
+
+    bool copy_on_write = snapshots_active(book);
+    size_t next_spare = 0;
+    for (size_t i = 0; i < batch->count; i++) {
+        BatchOp *op = &batch->ops[i];
+        if (op->type == BATCH_REMOVE) {
+            continue;
+        }
+
+        Contact *contact = spare[next_spare++];
+        contact->id = op->type == BATCH_ADD ? book->next_id : op->id;
+        strcpy(contact->name, op->name);
+        strcpy(contact->phone, op->phone);
+        strcpy(contact->email, op->email);
+
+        if (op->type == BATCH_ADD) {
+            book_append_contact(book, contact);
+            op->id = contact->id;
+        }
+        else if (copy_on_write) {
+            book_replace_contact(book, plan.targets[i], contact);
+        }
+        else {
+            book_update_contact(book, plan.targets[i], contact);
+            free(contact);
+        }
+    }
+
+    if (plan.remove_count > 0) {
+        RemoveScan scan = {&plan, batch};
+        Contact *removed = book_extract_contacts(book, is_removed, &scan);
+        while (removed != NULL) {
+            Contact *next = removed->next;
+            book_release_contact(book, removed);
+            removed = next;
+        }
+    }
+
+    if (bulk) {
+        book_resume_indexing(book);
+    }
+    snapshot_write_end(book);
+
+    free(spare);
+    free_plan(&plan);
+    return BATCH_OK;
+}
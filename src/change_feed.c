@@ -0,0 +1,415 @@
+/**
+ * @file change_feed.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the change feed: sequencing, subscribers, the log, and cursors.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // for nanosleep
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "address_book.h"
+#include "change_feed.h"
+
+#define CHANGE_LINE_SIZE 512 // longer than any record line
+#define CHANGE_TAIL_SIZE 1024 // bytes read from the end of a log to find its last sequence
+
+static const char *const op_names[] = {"create", "update", "delete"};
+
+/**
+ * @brief A book's feed state.
+ */
+struct ChangeFeed {
+    unsigned long long sequence;
+    FILE *log;
+    bool log_failed;
+    ChangeSubscriber subscribers[CHANGE_FEED_MAX_SUBSCRIBERS];
+    void *contexts[CHANGE_FEED_MAX_SUBSCRIBERS];
+};
+
+struct ChangeCursor {
+    FILE *file;
+    long offset;
+    unsigned long long after;
+};
+
+// ========================= Log Format ========================= //
+
+/**
+ * @brief Copies one comma-separated field, advancing @p cursor past it.
+ * @return 0 on success, -1 if the field is missing or too long.
+ */
+static int take_field(const char **cursor, char *dest, size_t size, bool last) {
+    const char *start = *cursor;
+    const char *end = last ? start + strcspn(start, ",\r\n") : strchr(start, ',');
+    if (end == NULL || (size_t)(end - start) >= size) {
+        return -1;
+    }
+    memcpy(dest, start, (size_t)(end - start));
+    dest[end - start] = '\0';
+    *cursor = last && *end != ',' ? end : end + 1;
+    return 0;
+}
+
+/**
+ * @brief Parses one log line.
+ * @return 0 on success, -1 if the line is malformed.
+ */
+static int parse_change(const char *line, ChangeRecord *change) {
+    char *end;
+    change->sequence = strtoull(line, &end, 10);
+    if (end == line || *end != ',' || change->sequence == 0) {
+        return -1;
+    }
+
+    const char *cursor = end + 1;
+    char op[8];
+    if (take_field(&cursor, op, sizeof(op), false) != 0) {
+        return -1;
+    }
+    int found = -1;
+    for (int i = 0; i < 3; i++) {
+        if (strcmp(op, op_names[i]) == 0) {
+            found = i;
+        }
+    }
+    if (found < 0) {
+        return -1;
+    }
+    change->op = (ChangeOp)found;
+
+    long id = strtol(cursor, &end, 10);
+    if (end == cursor || *end != ',' || id <= 0 || id > 2147483647L) {
+        return -1;
+    }
+    cursor = end + 1;
+    change->id = (int)id;
+
+    Contact *sides[2] = {&change->before, &change->after};
+    for (int i = 0; i < 2; i++) {
+        sides[i]->id = change->id;
+        sides[i]->next = NULL;
+        if (take_field(&cursor, sides[i]->name, sizeof(sides[i]->name), false) != 0 ||
+            take_field(&cursor, sides[i]->phone, sizeof(sides[i]->phone), false) != 0 ||
+            take_field(&cursor, sides[i]->email, sizeof(sides[i]->email), i == 1) != 0) {
+            return -1;
+        }
+    }
+    change->time_ms = strtoll(cursor, NULL, 10); // 0 when the line has no time
+    return 0;
+}
+
+/**
+ * @brief Finds the last sequence number in a log by reading only its tail.
+ * When @p repair is set, a torn last line (from a crash mid-write) is ended so the next record
+ * starts on its own line.
+ */
+static int read_last_sequence(FILE *log, unsigned long long *sequence, bool repair) {
+    *sequence = 0;
+    if (fseek(log, 0, SEEK_END) != 0) {
+        return -1;
+    }
+    long size = ftell(log);
+    if (size <= 0) {
+        return size < 0 ? -1 : 0;
+    }
+
+    char tail[CHANGE_TAIL_SIZE + 1];
+    long start = size > CHANGE_TAIL_SIZE ? size - CHANGE_TAIL_SIZE : 0;
+    if (fseek(log, start, SEEK_SET) != 0) {
+        return -1;
+    }
+    size_t length = fread(tail, 1, (size_t)(size - start), log);
+    tail[length] = '\0';
+    if (fseek(log, 0, SEEK_END) != 0) {
+        return -1;
+    }
+    if (repair && length > 0 && tail[length - 1] != '\n') {
+        fputc('\n', log);
+    }
+
+    // The first line in the buffer may be cut short unless the buffer starts the file.
+    char *line = start > 0 ? strchr(tail, '\n') : tail;
+    if (line != NULL && start > 0) {
+        line++;
+    }
+    char *newline;
+    while (line != NULL && (newline = strchr(line, '\n')) != NULL) {
+        *newline = '\0';
+        ChangeRecord change;
+        if (parse_change(line, &change) == 0) {
+            *sequence = change.sequence;
+        }
+        line = newline + 1;
+    }
+    return 0;
+}
+
+// ========================= Feed ========================= //
+
+int book_enable_change_feed(AddressBook *book, const char *log_path) {
+    if (book->feed != NULL) {
+        return 0;
+    }
+
+    struct ChangeFeed *feed = calloc(1, sizeof(struct ChangeFeed));
+    if (feed == NULL) {
+        return -1;
+    }
+    if (log_path != NULL) {
+        feed->log = fopen(log_path, "a+b");
+        if (feed->log == NULL || read_last_sequence(feed->log, &feed->sequence, true) != 0) {
+            if (feed->log != NULL) {
+                fclose(feed->log);
+            }
+            free(feed);
+            return -1;
+        }
+    }
+    book->feed = feed;
+    return 0;
+}
+
+int book_disable_change_feed(AddressBook *book) {
+    int status = change_feed_free(book->feed);
+    book->feed = NULL;
+    return status;
+}
+
+int change_feed_free(struct ChangeFeed *feed) {
+    if (feed == NULL) {
+        return 0;
+    }
+    bool ok = !feed->log_failed;
+    if (feed->log != NULL && fclose(feed->log) != 0) {
+        ok = false;
+    }
+    free(feed);
+    return ok ? 0 : -1;
+}
+
+int change_feed_subscribe(AddressBook *book, ChangeSubscriber subscriber, void *context) {
+    if (book->feed == NULL || subscriber == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < CHANGE_FEED_MAX_SUBSCRIBERS; i++) {
+        if (book->feed->subscribers[i] == NULL) {
+            book->feed->subscribers[i] = subscriber;
+            book->feed->contexts[i] = context;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void change_feed_unsubscribe(AddressBook *book, int handle) {
+    if (book->feed != NULL && handle >= 0 && handle < CHANGE_FEED_MAX_SUBSCRIBERS) {
+        book->feed->subscribers[handle] = NULL;
+        book->feed->contexts[handle] = NULL;
+    }
+}
+
+unsigned long long change_feed_sequence(const AddressBook *book) {
+    return book->feed != NULL ? book->feed->sequence : 0;
+}
+
+static void copy_side(Contact *dest, int id, const Contact *source) {
+    dest->id = id;
+    dest->next = NULL;
+    if (source == NULL) {
+        dest->name[0] = dest->phone[0] = dest->email[0] = '\0';
+        return;
+    }
+    strcpy(dest->name, source->name);
+    strcpy(dest->phone, source->phone);
+    strcpy(dest->email, source->email);
+}
+
+void change_feed_emit(struct ChangeFeed *feed, ChangeOp op, const Contact *before,
+                      const Contact *after) {
+    if (feed == NULL) {
+        return;
+    }
+
+    ChangeRecord change;
+    change.sequence = ++feed->sequence;
+    change.op = op;
+    change.id = after != NULL ? after->id : before->id;
+    copy_side(&change.before, change.id, before);
+    copy_side(&change.after, change.id, after);
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    change.time_ms = (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
+    if (feed->log != NULL && !feed->log_failed) {
+        // One flush per record keeps the log tailable; a failed write stops the log for good,
+        // since a gap in the sequence would mislead consumers.
+        int written = fprintf(feed->log, "%llu,%s,%d,%s,%s,%s,%s,%s,%s,%lld\n",
+                              change.sequence, op_names[op], change.id, change.before.name,
+                              change.before.phone, change.before.email, change.after.name,
+                              change.after.phone, change.after.email, change.time_ms);
+        if (written < 0 || fflush(feed->log) != 0) {
+            feed->log_failed = true;
+        }
+    }
+
+    for (int i = 0; i < CHANGE_FEED_MAX_SUBSCRIBERS; i++) {
+        if (feed->subscribers[i] != NULL) {
+            feed->subscribers[i](&change, feed->contexts[i]);
+        }
+    }
+}
+
+// ========================= Cursors ========================= //
+
+ChangeCursor *change_cursor_open(const char *path, unsigned long long after_sequence) {
+    ChangeCursor *cursor = malloc(sizeof(ChangeCursor));
+    if (cursor == NULL) {
+        return NULL;
+    }
+    cursor->file = fopen(path, "rb");
+    if (cursor->file == NULL) {
+        free(cursor);
+        return NULL;
+    }
+    cursor->offset = 0;
+    cursor->after = after_sequence;
+    return cursor;
+}
+
+int change_cursor_next(ChangeCursor *cursor, ChangeRecord *change) {
+    char line[CHANGE_LINE_SIZE];
+
+    for (;;) {
+        // Re-seek so data appended since the last end of file is seen.
+        if (fseek(cursor->file, cursor->offset, SEEK_SET) != 0) {
+            return -1;
+        }
+        if (fgets(line, sizeof(line), cursor->file) == NULL) {
+            return ferror(cursor->file) ? -1 : 0;
+        }
+        size_t length = strlen(line);
+        if (line[length - 1] != '\n') {
+            if (length < sizeof(line) - 1) {
+                return 0; // a record still being written
+            }
+            // Not a record the feed writes: skip to the end of the line.
+            int c;
+            while ((c = fgetc(cursor->file)) != EOF && c != '\n') {
+            }
+            if (c == EOF) {
+                return 0;
+            }
+            cursor->offset = ftell(cursor->file);
+            continue;
+        }
+        cursor->offset = ftell(cursor->file);
+
+        if (parse_change(line, change) == 0 && change->sequence > cursor->after) {
+            cursor->after = change->sequence;
+            return 1;
+        }
+    }
+}
+
+long change_cursor_backlog(ChangeCursor *cursor) {
+    if (fseek(cursor->file, 0, SEEK_END) != 0) {
+        return -1;
+    }
+    long size = ftell(cursor->file);
+    return size < 0 ? -1 : (size > cursor->offset ? size - cursor->offset : 0);
+}
+
+int change_log_last_sequence(const char *path, unsigned long long *sequence) {
+    FILE *log = fopen(path, "rb");
+    if (log == NULL) {
+        return -1;
+    }
+    int status = read_last_sequence(log, sequence, false);
+    fclose(log);
+    return status;
+}
+
+void change_cursor_close(ChangeCursor *cursor) {
+    if (cursor != NULL) {
+        fclose(cursor->file);
+        free(cursor);
+    }
+}
+
+// ========================= Command Line ========================= //
+
+static void print_side(const char *label, const Contact *contact) {
+    if (contact->name[0] == '\0') {
+        printf(",\"%s\":null", label);
+    }
+    else {
+        printf(",\"%s\":{\"name\":\"%s\",\"phone\":\"%s\",\"email\":\"%s\"}", label,
+               contact->name, contact->phone, contact->email);
+    }
+}
+
+static void print_changes_usage(void) {
+    printf("Usage: addressbook changes [--from <sequence>] [--follow] [<log>]\n");
+    printf("  --from <sequence>   Only print changes after this sequence number\n");
+    printf("  --follow            Keep waiting for new changes (Ctrl+C to stop)\n");
+    printf("  <log>               Change log to read (default: %s)\n", CHANGE_FEED_FILE_NAME);
+}
+
+int run_changes_command(int argc, char *argv[]) {
+    const char *path = CHANGE_FEED_FILE_NAME;
+    unsigned long long from = 0;
+    bool follow = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            from = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--follow") == 0) {
+            follow = true;
+        }
+        else if (strncmp(argv[i], "--", 2) != 0 && i == argc - 1) {
+            path = argv[i];
+        }
+        else {
+            print_changes_usage();
+            return 1;
+        }
+    }
+
+    ChangeCursor *cursor = change_cursor_open(path, from);
+    if (cursor == NULL) {
+        printf("Ein: *Sniffs around* There is no change log at '%s'.\n", path);
+        return 1;
+    }
+
+    const struct timespec interval = {0, CHANGE_FEED_FOLLOW_INTERVAL_MS * 1000000L};
+    ChangeRecord change;
+    int status;
+    while ((status = change_cursor_next(cursor, &change)) >= 0) {
+        if (status == 0) {
+            if (!follow) {
+                break;
+            }
+            fflush(stdout);
+            nanosleep(&interval, NULL);
+            continue;
+        }
+        printf("{\"seq\":%llu,\"op\":\"%s\",\"id\":%d,\"time_ms\":%lld", change.sequence,
+               op_names[change.op], change.id, change.time_ms);
+        print_side("before", &change.before);
+        print_side("after", &change.after);
+        printf("}\n");
+    }
+
+    change_cursor_close(cursor);
+    if (status < 0) {
+        printf("Ein: *Whines* Reading '%s' failed.\n", path);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,850 @@
+/**
+ * @file compressed_store.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the compressed, block-based contact file format.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <ctype.h>
+#include "address_book.h"
+#include "compressed_store.h"
+#include "snapshot.h"
+
+static const unsigned char FILE_MAGIC[4] = {'A', 'B', 'Z', '1'};
+
+#define BLOCK_HEADER_SIZE 8
+#define PHONE_DIGITS 10
+#define LZ_MIN_MATCH 4
+#define LZ_HASH_BITS 14
+#define LZ_MAX_OFFSET (1u << 20)
+
+// ========================= Byte Buffers & Varints ========================= //
+
+typedef struct {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+} ByteBuffer;
+
+static int buffer_reserve(ByteBuffer *buffer, size_t extra) {
+    if (buffer->size + extra <= buffer->capacity) {
+        return 0;
+    }
+    size_t capacity = buffer->capacity == 0 ? 4096 : buffer->capacity;
+    while (capacity < buffer->size + extra) {
+        capacity *= 2;
+    }
+    unsigned char *grown = realloc(buffer->data, capacity);
+    if (grown == NULL) {
+        return -1;
+    }
+    buffer->data = grown;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+static int buffer_put(ByteBuffer *buffer, const void *bytes, size_t length) {
+    if (buffer_reserve(buffer, length) != 0) {
+        return -1;
+    }
+    memcpy(buffer->data + buffer->size, bytes, length);
+    buffer->size += length;
+    return 0;
+}
+
+static int buffer_put_varint(ByteBuffer *buffer, uint64_t value) {
+    unsigned char bytes[10];
+    size_t length = 0;
+    do {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        bytes[length++] = byte | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+    return buffer_put(buffer, bytes, length);
+}
+
+static int read_varint(const unsigned char **cursor, const unsigned char *end, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *cursor < end; shift += 7) {
+        unsigned char byte = *(*cursor)++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static uint64_t zigzag_encode(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static void put_u32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char *in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 |
+           (uint32_t)in[3] << 24;
+}
+
+// ========================= LZ77 Block Codec ========================= //
+
+/*
+ * A stream of sequences, each: varint literal count, the literals, varint match offset,
+ * and (if the offset is non-zero) varint match length minus LZ_MIN_MATCH. An offset of
+ * zero ends the stream.
+ */
+
+static uint32_t lz_hash(const unsigned char *p) {
+    uint32_t v = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+                 (uint32_t)p[3] << 24;
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static int lz_emit(ByteBuffer *out, const unsigned char *literals, size_t literal_count,
+                   size_t offset, size_t match_length) {
+    if (buffer_put_varint(out, literal_count) != 0 || buffer_put(out, literals, literal_count) != 0 ||
+        buffer_put_varint(out, offset) != 0) {
+        return -1;
+    }
+    return offset != 0 ? buffer_put_varint(out, match_length - LZ_MIN_MATCH) : 0;
+}
+
+int lz_compress(const unsigned char *input, size_t length, unsigned char **output,
+                size_t *output_length) {
+    ByteBuffer out = {NULL, 0, 0};
+    size_t *table = calloc((size_t)1 << LZ_HASH_BITS, sizeof(size_t));
+    if (table == NULL || buffer_reserve(&out, length / 2 + 16) != 0) {
+        free(table);
+        free(out.data);
+        return -1;
+    }
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + LZ_MIN_MATCH <= length) {
+        uint32_t h = lz_hash(input + i);
+        size_t candidate = table[h]; // Positions are stored +1 so that 0 means "empty".
+        table[h] = i + 1;
+
+        if (candidate != 0 && i - (candidate - 1) <= LZ_MAX_OFFSET &&
+            memcmp(input + candidate - 1, input + i, LZ_MIN_MATCH) == 0) {
+            size_t match = candidate - 1;
+            size_t match_length = LZ_MIN_MATCH;
+            while (i + match_length < length && input[match + match_length] == input[i + match_length]) {
+                match_length++;
+            }
+
+            if (lz_emit(&out, input + anchor, i - anchor, i - match, match_length) != 0) {
+                free(table);
+                free(out.data);
+                return -1;
+            }
+            i += match_length;
+            anchor = i;
+        }
+        else {
+            i++;
+        }
+    }
+
+    int status = lz_emit(&out, input + anchor, length - anchor, 0, 0);
+    free(table);
+    if (status != 0) {
+        free(out.data);
+        return -1;
+    }
+
+    *output = out.data;
+    *output_length = out.size;
+    return 0;
+}
+
+int lz_decompress(const unsigned char *input, size_t length, unsigned char *output,
+                  size_t output_length) {
+    const unsigned char *cursor = input;
+    const unsigned char *end = input + length;
+    size_t written = 0;
+
+    for (;;) {
+        uint64_t literal_count;
+        uint64_t offset;
+        if (read_varint(&cursor, end, &literal_count) != 0 ||
+            literal_count > (uint64_t)(end - cursor) ||
+            literal_count > output_length - written) {
+            return -1;
+        }
+        memcpy(output + written, cursor, (size_t)literal_count);
+        cursor += literal_count;
+        written += (size_t)literal_count;
+
+        if (read_varint(&cursor, end, &offset) != 0) {
+            return -1;
+        }
+        if (offset == 0) {
+            return written == output_length ? 0 : -1;
+        }
+
+        uint64_t extra;
+        if (read_varint(&cursor, end, &extra) != 0 || offset > written ||
+            extra + LZ_MIN_MATCH > output_length - written) {
+            return -1;
+        }
+
+        // Byte by byte: a match may overlap the bytes it is producing.
+        size_t match_length = (size_t)extra + LZ_MIN_MATCH;
+        const unsigned char *source = output + written - offset;
+        for (size_t k = 0; k < match_length; k++) {
+            output[written + k] = source[k];
+        }
+        written += match_length;
+    }
+}
+
+// ========================= Block Encoding ========================= //
+
+static int is_ten_digit_phone(const char *phone) {
+    for (int i = 0; i < PHONE_DIGITS; i++) {
+        if (!isdigit((unsigned char)phone[i])) {
+            return 0;
+        }
+    }
+    return phone[PHONE_DIGITS] == '\0';
+}
+
+static int put_string(ByteBuffer *buffer, const char *text, size_t length) {
+    if (buffer_put_varint(buffer, length) != 0) {
+        return -1;
+    }
+    return buffer_put(buffer, text, length);
+}
+
+static int encode_ids(ByteBuffer *out, const Contact *contacts, size_t count) {
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (buffer_put_varint(out, zigzag_encode((int64_t)contacts[i].id - previous)) != 0) {
+            return -1;
+        }
+        previous = contacts[i].id;
+    }
+    return 0;
+}
+
+static int encode_phones(ByteBuffer *out, const Contact *contacts, size_t count) {
+    uint64_t minimum = UINT64_MAX;
+    uint64_t maximum = 0;
+    size_t exceptions = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (is_ten_digit_phone(contacts[i].phone)) {
+            uint64_t value = strtoull(contacts[i].phone, NULL, 10);
+            minimum = value < minimum ? value : minimum;
+            maximum = value > maximum ? value : maximum;
+        }
+        else {
+            exceptions++;
+        }
+    }
+    if (minimum == UINT64_MAX) {
+        minimum = maximum = 0;
+    }
+
+    unsigned char width = 0;
+    while (width < 64 && (maximum - minimum) >> width != 0) {
+        width++;
+    }
+
+    if (buffer_put_varint(out, minimum) != 0 || buffer_put(out, &width, 1) != 0) {
+        return -1;
+    }
+
+    // Frame-of-reference: every phone is stored as (value - minimum) in `width` bits.
+    size_t packed_bytes = (count * width + 7) / 8;
+    if (buffer_reserve(out, packed_bytes) != 0) {
+        return -1;
+    }
+    unsigned char *packed = out->data + out->size;
+    memset(packed, 0, packed_bytes);
+    size_t bit = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = is_ten_digit_phone(contacts[i].phone)
+                             ? strtoull(contacts[i].phone, NULL, 10) - minimum
+                             : 0;
+        for (unsigned char b = 0; b < width; b++, bit++) {
+            if ((value >> b) & 1) {
+                packed[bit / 8] |= (unsigned char)(1u << (bit % 8));
+            }
+        }
+    }
+    out->size += packed_bytes;
+
+    // Phones that are not exactly ten digits are kept verbatim.
+    if (buffer_put_varint(out, exceptions) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!is_ten_digit_phone(contacts[i].phone) &&
+            (buffer_put_varint(out, i) != 0 ||
+             put_string(out, contacts[i].phone, strlen(contacts[i].phone)) != 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int encode_domains(ByteBuffer *out, const Contact *contacts, size_t count) {
+    const char **dictionary = malloc(sizeof(char *) * count);
+    size_t *codes = malloc(sizeof(size_t) * count);
+    if (dictionary == NULL || codes == NULL) {
+        free(dictionary);
+        free(codes);
+        return -1;
+    }
+
+    // Code 0 means "no '@' in the address"; code k refers to dictionary entry k - 1.
+    // Blocks hold a few thousand contacts with few distinct domains, so a linear probe
+    // of the dictionary stays cheap.
+    size_t dictionary_size = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char *at = strrchr(contacts[i].email, '@');
+        codes[i] = 0;
+        if (at == NULL) {
+            continue;
+        }
+        size_t k = 0;
+        while (k < dictionary_size && strcmp(dictionary[k], at + 1) != 0) {
+            k++;
+        }
+        if (k == dictionary_size) {
+            dictionary[dictionary_size++] = at + 1;
+        }
+        codes[i] = k + 1;
+    }
+
+    int status = buffer_put_varint(out, dictionary_size);
+    for (size_t k = 0; status == 0 && k < dictionary_size; k++) {
+        status = put_string(out, dictionary[k], strlen(dictionary[k]));
+    }
+    for (size_t i = 0; status == 0 && i < count; i++) {
+        status = buffer_put_varint(out, codes[i]);
+    }
+
+    free(dictionary);
+    free(codes);
+    return status;
+}
+
+static int encode_strings(ByteBuffer *out, const Contact *contacts, size_t count) {
+    ByteBuffer raw = {NULL, 0, 0};
+    const char zero = '\0';
+    int status = 0;
+
+    // Names and email local parts, each null-terminated, compressed as one stream.
+    for (size_t i = 0; status == 0 && i < count; i++) {
+        const char *at = strrchr(contacts[i].email, '@');
+        size_t local_length = at != NULL ? (size_t)(at - contacts[i].email) : strlen(contacts[i].email);
+        status = buffer_put(&raw, contacts[i].name, strlen(contacts[i].name) + 1);
+        status |= buffer_put(&raw, contacts[i].email, local_length);
+        status |= buffer_put(&raw, &zero, 1);
+    }
+
+    unsigned char *compressed = NULL;
+    size_t compressed_length = 0;
+    if (status == 0) {
+        status = lz_compress(raw.data, raw.size, &compressed, &compressed_length);
+    }
+    if (status == 0) {
+        status = buffer_put_varint(out, raw.size);
+        status |= buffer_put_varint(out, compressed_length);
+        status |= buffer_put(out, compressed, compressed_length);
+    }
+
+    free(compressed);
+    free(raw.data);
+    return status == 0 ? 0 : -1;
+}
+
+static int write_block(FILE *file, uint32_t record_count, const ByteBuffer *payload) {
+    unsigned char header[BLOCK_HEADER_SIZE];
+    put_u32(header, record_count);
+    put_u32(header + 4, (uint32_t)payload->size);
+
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        return -1;
+    }
+    return fwrite(payload->data, 1, payload->size, file) == payload->size ? 0 : -1;
+}
+
+// ========================= Writer ========================= //
+
+struct CompressedWriter {
+    FILE *file;
+    Contact *pending;
+    size_t pending_count;
+    size_t total;
+    int failed;
+};
+
+CompressedWriter *compressed_writer_open(const char *path) {
+    CompressedWriter *writer = calloc(1, sizeof(CompressedWriter));
+    if (writer == NULL) {
+        return NULL;
+    }
+    writer->pending = malloc(sizeof(Contact) * COMPRESSED_BLOCK_RECORDS);
+    writer->file = fopen(path, "wb");
+    if (writer->pending == NULL || writer->file == NULL ||
+        fwrite(FILE_MAGIC, 1, sizeof(FILE_MAGIC), writer->file) != sizeof(FILE_MAGIC)) {
+        if (writer->file != NULL) {
+            fclose(writer->file);
+        }
+        free(writer->pending);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+static int flush_block(CompressedWriter *writer) {
+    if (writer->pending_count == 0) {
+        return 0;
+    }
+
+    ByteBuffer payload = {NULL, 0, 0};
+    int status = encode_ids(&payload, writer->pending, writer->pending_count);
+    status |= encode_phones(&payload, writer->pending, writer->pending_count);
+    status |= encode_domains(&payload, writer->pending, writer->pending_count);
+    status |= encode_strings(&payload, writer->pending, writer->pending_count);
+    if (status == 0) {
+        status = write_block(writer->file, (uint32_t)writer->pending_count, &payload);
+    }
+
+    free(payload.data);
+    writer->pending_count = 0;
+    return status == 0 ? 0 : -1;
+}
+
+int compressed_writer_add(CompressedWriter *writer, const Contact *contact) {
+    if (writer->failed) {
+        return -1;
+    }
+
+    writer->pending[writer->pending_count++] = *contact;
+    writer->total++;
+
+    if (writer->pending_count == COMPRESSED_BLOCK_RECORDS && flush_block(writer) != 0) {
+        writer->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+int compressed_writer_close(CompressedWriter *writer, int next_id) {
+    int status = writer->failed ? -1 : flush_block(writer);
+
+    // End marker: a block with zero records carrying the next ID and the total count.
+    ByteBuffer trailer = {NULL, 0, 0};
+    if (status == 0) {
+        status = buffer_put_varint(&trailer, zigzag_encode(next_id));
+        status |= buffer_put_varint(&trailer, writer->total);
+    }
+    if (status == 0) {
+        status = write_block(writer->file, 0, &trailer);
+    }
+    free(trailer.data);
+
+    if (fclose(writer->file) != 0) {
+        status = -1;
+    }
+    free(writer->pending);
+    free(writer);
+    return status == 0 ? 0 : -1;
+}
+
+// ========================= Reader ========================= //
+
+struct CompressedReader {
+    FILE *file;
+    Contact *block;
+    size_t block_count;
+    size_t position;
+    unsigned char *payload;
+    size_t payload_capacity;
+    int next_id;
+    int finished;
+};
+
+CompressedReader *compressed_reader_open(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    unsigned char magic[sizeof(FILE_MAGIC)];
+    CompressedReader *reader = calloc(1, sizeof(CompressedReader));
+    if (reader == NULL || fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        free(reader);
+        fclose(file);
+        return NULL;
+    }
+
+    reader->block = malloc(sizeof(Contact) * COMPRESSED_BLOCK_RECORDS);
+    if (reader->block == NULL) {
+        free(reader);
+        fclose(file);
+        return NULL;
+    }
+    reader->file = file;
+    reader->next_id = 1;
+    return reader;
+}
+
+static int read_string(const unsigned char **cursor, const unsigned char *end, char *out,
+                       size_t capacity) {
+    uint64_t length;
+    if (read_varint(cursor, end, &length) != 0 || length >= capacity ||
+        length > (uint64_t)(end - *cursor)) {
+        return -1;
+    }
+    memcpy(out, *cursor, (size_t)length);
+    out[length] = '\0';
+    *cursor += length;
+    return 0;
+}
+
+static int decode_ids(const unsigned char **cursor, const unsigned char *end, Contact *contacts,
+                      size_t count) {
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t delta;
+        if (read_varint(cursor, end, &delta) != 0) {
+            return -1;
+        }
+        previous += zigzag_decode(delta);
+        contacts[i].id = (int)previous;
+        contacts[i].next = NULL;
+    }
+    return 0;
+}
+
+static int decode_phones(const unsigned char **cursor, const unsigned char *end,
+                         Contact *contacts, size_t count) {
+    uint64_t minimum;
+    if (read_varint(cursor, end, &minimum) != 0 || *cursor >= end) {
+        return -1;
+    }
+    unsigned char width = *(*cursor)++;
+    size_t packed_bytes = (count * width + 7) / 8;
+    if (width > 64 || packed_bytes > (size_t)(end - *cursor)) {
+        return -1;
+    }
+
+    const unsigned char *packed = *cursor;
+    uint64_t mask = width == 64 ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+    for (size_t i = 0; i < count; i++) {
+        // Gather the bytes spanning this value, then shift and mask it out in one go.
+        size_t bit = i * width;
+        size_t first = bit / 8;
+        size_t last = (bit + width + 7) / 8;
+        uint64_t window = 0;
+        unsigned int shift = bit % 8;
+        for (size_t k = first; k < last && k < first + 8; k++) {
+            window |= (uint64_t)packed[k] << (8 * (k - first));
+        }
+        uint64_t value = window >> shift;
+        if (last - first > 8) {
+            value |= (uint64_t)packed[first + 8] << (64 - shift);
+        }
+        value = (value & mask) + minimum;
+
+        // Format as ten digits by hand; snprintf dominates decode time otherwise.
+        char *phone = contacts[i].phone;
+        for (int d = PHONE_DIGITS - 1; d >= 0; d--) {
+            phone[d] = (char)('0' + value % 10);
+            value /= 10;
+        }
+        phone[PHONE_DIGITS] = '\0';
+    }
+    *cursor += packed_bytes;
+
+    uint64_t exceptions;
+    if (read_varint(cursor, end, &exceptions) != 0) {
+        return -1;
+    }
+    for (uint64_t e = 0; e < exceptions; e++) {
+        uint64_t index;
+        if (read_varint(cursor, end, &index) != 0 || index >= count ||
+            read_string(cursor, end, contacts[index].phone, MAX_PHONE_LENGTH) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int decode_emails(const unsigned char **cursor, const unsigned char *end,
+                         Contact *contacts, size_t count) {
+    uint64_t dictionary_size;
+    if (read_varint(cursor, end, &dictionary_size) != 0 ||
+        dictionary_size > (uint64_t)(end - *cursor)) {
+        return -1;
+    }
+
+    char (*dictionary)[MAX_EMAIL_LENGTH] = malloc(MAX_EMAIL_LENGTH * (size_t)(dictionary_size + 1));
+    size_t *lengths = malloc(sizeof(size_t) * (size_t)(dictionary_size + 1));
+    size_t *codes = malloc(sizeof(size_t) * count);
+    int status = (dictionary == NULL || lengths == NULL || codes == NULL) ? -1 : 0;
+
+    for (uint64_t k = 0; status == 0 && k < dictionary_size; k++) {
+        status = read_string(cursor, end, dictionary[k], MAX_EMAIL_LENGTH);
+        lengths[k] = status == 0 ? strlen(dictionary[k]) : 0;
+    }
+    for (size_t i = 0; status == 0 && i < count; i++) {
+        uint64_t code;
+        status = read_varint(cursor, end, &code);
+        if (status == 0 && code > dictionary_size) {
+            status = -1;
+        }
+        codes[i] = (size_t)code;
+    }
+
+    // Names and local parts, then stitch each email back together.
+    uint64_t raw_length;
+    uint64_t compressed_length;
+    unsigned char *raw = NULL;
+    if (status == 0 && (read_varint(cursor, end, &raw_length) != 0 ||
+                        read_varint(cursor, end, &compressed_length) != 0 ||
+                        compressed_length > (uint64_t)(end - *cursor) ||
+                        raw_length > count * (size_t)(MAX_NAME_LENGTH + MAX_EMAIL_LENGTH))) {
+        status = -1;
+    }
+    if (status == 0) {
+        raw = malloc((size_t)raw_length + 1);
+        status = raw == NULL ? -1
+                             : lz_decompress(*cursor, (size_t)compressed_length, raw, (size_t)raw_length);
+    }
+    if (status == 0) {
+        raw[raw_length] = '\0';
+        *cursor += compressed_length;
+
+        const char *text = (const char *)raw;
+        const char *text_end = text + raw_length;
+        for (size_t i = 0; status == 0 && i < count; i++) {
+            size_t name_length = strlen(text);
+            const char *local = text + name_length + 1;
+            if (local >= text_end || name_length >= MAX_NAME_LENGTH) {
+                status = -1;
+                break;
+            }
+            size_t local_length = strlen(local);
+            memcpy(contacts[i].name, text, name_length + 1);
+
+            size_t domain_length = codes[i] == 0 ? 0 : lengths[codes[i] - 1] + 1;
+            if (local_length + domain_length >= MAX_EMAIL_LENGTH) {
+                status = -1;
+                break;
+            }
+            char *email = contacts[i].email;
+            memcpy(email, local, local_length);
+            if (codes[i] != 0) {
+                email[local_length] = '@';
+                memcpy(email + local_length + 1, dictionary[codes[i] - 1], domain_length - 1);
+            }
+            email[local_length + domain_length] = '\0';
+            text = local + local_length + 1;
+        }
+    }
+
+    free(raw);
+    free(dictionary);
+    free(lengths);
+    free(codes);
+    return status;
+}
+
+/**
+ * @brief Reads and decodes the next block into the reader's buffer.
+ * @return 1 if a block was decoded, 0 at the end marker, -1 on damage.
+ */
+static int read_block(CompressedReader *reader) {
+    unsigned char header[BLOCK_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), reader->file) != sizeof(header)) {
+        return -1;
+    }
+    uint32_t record_count = get_u32(header);
+    uint32_t payload_size = get_u32(header + 4);
+    if (record_count > COMPRESSED_BLOCK_RECORDS) {
+        return -1;
+    }
+
+    if (payload_size > reader->payload_capacity) {
+        unsigned char *grown = realloc(reader->payload, payload_size);
+        if (grown == NULL) {
+            return -1;
+        }
+        reader->payload = grown;
+        reader->payload_capacity = payload_size;
+    }
+    if (fread(reader->payload, 1, payload_size, reader->file) != payload_size) {
+        return -1;
+    }
+
+    const unsigned char *cursor = reader->payload;
+    const unsigned char *end = reader->payload + payload_size;
+
+    if (record_count == 0) {
+        uint64_t next_id;
+        if (read_varint(&cursor, end, &next_id) != 0) {
+            return -1;
+        }
+        reader->next_id = (int)zigzag_decode(next_id);
+        return 0;
+    }
+
+    if (decode_ids(&cursor, end, reader->block, record_count) != 0 ||
+        decode_phones(&cursor, end, reader->block, record_count) != 0 ||
+        decode_emails(&cursor, end, reader->block, record_count) != 0) {
+        return -1;
+    }
+
+    reader->block_count = record_count;
+    reader->position = 0;
+    return 1;
+}
+
+int compressed_reader_next(CompressedReader *reader, Contact *contact) {
+    if (reader->finished) {
+        return 0;
+    }
+
+    if (reader->position == reader->block_count) {
+        int status = read_block(reader);
+        if (status <= 0) {
+            reader->finished = 1;
+            return status;
+        }
+    }
+
+    *contact = reader->block[reader->position++];
+    return 1;
+}
+
+int compressed_reader_next_id(const CompressedReader *reader) {
+    return reader->next_id;
+}
+
+void compressed_reader_close(CompressedReader *reader) {
+    if (reader == NULL) {
+        return;
+    }
+    fclose(reader->file);
+    free(reader->block);
+    free(reader->payload);
+    free(reader);
+}
+
+// ========================= Whole-Book Helpers ========================= //
+
+int save_contacts_compressed(const AddressBook *book, const char *path) {
+    CompressedWriter *writer = compressed_writer_open(path);
+    if (writer == NULL) {
+        return -1;
+    }
+
+    // With snapshots enabled, write a consistent version while writers carry on.
+    BookSnapshot *snapshot = snapshot_open(book);
+    int count = snapshot != NULL ? (int)snapshot->count : book->contact_count;
+    int next_id = snapshot != NULL ? snapshot->next_id : book->next_id;
+
+    const Contact *current = NULL;
+    for (int i = 0; i < count; i++) {
+        current = snapshot != NULL ? snapshot->contacts[i]
+                                   : (current == NULL ? book->head : current->next);
+        if (compressed_writer_add(writer, current) != 0) {
+            snapshot_close(snapshot);
+            compressed_writer_close(writer, next_id);
+            return -1;
+        }
+    }
+    snapshot_close(snapshot);
+
+    return compressed_writer_close(writer, next_id) == 0 ? count : -1;
+}
+
+int load_contacts_compressed(AddressBook *book, const char *path) {
+    CompressedReader *reader = compressed_reader_open(path);
+    if (reader == NULL) {
+        return -1;
+    }
+
+    int loaded = 0;
+    int status;
+    Contact record;
+    while ((status = compressed_reader_next(reader, &record)) == 1) {
+        Contact *contact = malloc(sizeof(Contact));
+        if (contact == NULL) {
+            status = -1;
+            break;
+        }
+        *contact = record;
+        book_append_contact(book, contact);
+        loaded++;
+    }
+
+    if (status == 0 && compressed_reader_next_id(reader) > book->next_id) {
+        book->next_id = compressed_reader_next_id(reader);
+    }
+    compressed_reader_close(reader);
+    return status == 0 ? loaded : -1;
+}
+
+void load_contacts_from_compressed_file(AddressBook *book) {
+    FILE *probe = fopen(COMPRESSED_FILE_NAME, "rb");
+    if (probe == NULL) {
+        printf("\nEin: *Sniffs* No '%s' yet, so I'll fetch the plain CSV instead.\n",
+               COMPRESSED_FILE_NAME);
+        load_contacts_from_file(book);
+        return;
+    }
+    fclose(probe);
+
+    printf("\n<=====================| LOAD CONTACTS FROM COMPRESSED FILE |=====================>\n\n");
+
+    int loaded = load_contacts_compressed(book, COMPRESSED_FILE_NAME);
+    if (loaded < 0) {
+        printf("Ein: *Tilts head* '%s' looks damaged, I couldn't unpack all of it.\n",
+               COMPRESSED_FILE_NAME);
+        printf("Ein: I kept the %d contact(s) I managed to read.\n", book->contact_count);
+        return;
+    }
+    printf("Ein: Unpacked %d contact(s) from my compressed vault.\n", loaded);
+}
+
+void save_contacts_to_compressed_file(const AddressBook *book) {
+
+    printf("\n<======================| SAVE CONTACTS TO COMPRESSED FILE |======================>\n");
+
+    int saved = save_contacts_compressed(book, COMPRESSED_FILE_NAME);
+    if (saved < 0) {
+        printf("Ein: *Whines softly* I couldn't write '%s'.\n", COMPRESSED_FILE_NAME);
+        printf("Ein: Let's check the file location and try again later.\n");
+        return;
+    }
+
+    printf("Ein: All contacts are packed tightly into my data vault.\n");
+    printf("--------------------------------------------------\n");
+    printf("| %-46s |\n", "Compressed save complete!");
+    printf("| Total contacts saved: %-24d |\n", saved);
+    printf("--------------------------------------------------\n");
+}
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include "address_book.h"
 #include "contact_helper.h"
+#include "contact_index.h"
 
 // ========================= Utility Functions  ========================= //
 
@@ -83,6 +84,11 @@ ValidationStatus is_valid_phone(const char *phone)
  */
 ValidationStatus is_phone_duplicate(const char *phone, const AddressBook *book)
 {
+    if (book->indexes != NULL) {
+        return contact_index_lookup(&book->indexes->by_phone, phone) != NULL ? INVALID_DUPLICATE
+                                                                             : VALID;
+    }
+
     const Contact *current = book->head;
 
     while(current != NULL) {
@@ -137,6 +143,13 @@ ValidationStatus is_valid_email(const char *email)
  */
 ValidationStatus is_email_duplicate(const char *email, const AddressBook *book)
 {
+    if (book->indexes != NULL) {
+        char key[MAX_EMAIL_LENGTH];
+        index_fold_key(email, key);
+        return contact_index_lookup(&book->indexes->by_email, key) != NULL ? INVALID_DUPLICATE
+                                                                           : VALID;
+    }
+
     const Contact *current = book->head;
 
     while(current != NULL) {
@@ -173,6 +186,12 @@ void print_validation_error(const ValidationStatus status)
         case INVALID_DUPLICATE:
             printf("*Perks ears* I already have that one in my book — no duplicates allowed.\n");
             break; 
+        case INVALID_NOT_FOUND:
+            printf("*Sniffs around* I couldn't find a contact with that ID.\n");
+            break;
+        case INVALID_NO_MEMORY:
+            printf("*Whines* I ran out of room to remember that. Let's try again later.\n");
+            break;
         default:
             printf("*Scratches ear* Something unexpected happened. Let's try again.\n");
             break;
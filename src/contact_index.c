@@ -0,0 +1,496 @@
+/**
+ * @file contact_index.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the hash indexes over contact fields.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "address_book.h"
+#include "contact_index.h"
+#include "contact_report.h"
+#include "phonetic.h"
+
+#define INDEX_INITIAL_CAPACITY 64
+
+// ========================= Helpers ========================= //
+
+/**
+ * @brief FNV-1a hash of a null-terminated key.
+ */
+static size_t hash_string(const char *key) {
+    size_t hash = 2166136261u;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Integer mixer (from MurmurHash3's finalizer) so sequential IDs spread out.
+ */
+static size_t hash_id(int id) {
+    unsigned int h = (unsigned int)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+void index_fold_key(const char *value, char *key) {
+    int i = 0;
+    for (; value[i] != '\0' && i < MAX_EMAIL_LENGTH - 1; i++) {
+        key[i] = (char)tolower((unsigned char)value[i]);
+    }
+    key[i] = '\0';
+}
+
+size_t phone_digits(const char *value, char *digits, size_t size) {
+    size_t count = 0;
+    for (; *value != '\0' && count + 1 < size; value++) {
+        if (isdigit((unsigned char)*value)) {
+            digits[count++] = *value;
+        }
+    }
+    digits[count] = '\0';
+    return count;
+}
+
+bool phone_suffix_matches(const char *a, const char *b) {
+    size_t a_length = strlen(a);
+    size_t b_length = strlen(b);
+    size_t overlap = a_length < b_length ? a_length : b_length;
+    return overlap >= PHONE_SUFFIX_DIGITS &&
+           memcmp(a + a_length - overlap, b + b_length - overlap, overlap) == 0;
+}
+
+int phone_tail_key(const char *value) {
+    int tail = 0;
+    int digits = 0;
+    int scale = 1;
+    for (int i = 0; i < PHONE_SUFFIX_DIGITS; i++) {
+        scale *= 10;
+    }
+    for (; *value != '\0'; value++) {
+        if (isdigit((unsigned char)*value)) {
+            tail = (tail * 10 + (*value - '0')) % scale;
+            digits++;
+        }
+    }
+    return digits >= PHONE_SUFFIX_DIGITS ? tail : -1;
+}
+
+// ========================= Contact Index ========================= //
+
+static int contact_index_init(ContactIndex *index) {
+    index->capacity = INDEX_INITIAL_CAPACITY;
+    index->used = 0;
+    index->slots = calloc(index->capacity, sizeof(IndexBucket));
+    return index->slots == NULL ? -1 : 0;
+}
+
+static void contact_index_destroy(ContactIndex *index) {
+    if (index->slots == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < index->capacity; i++) {
+        free(index->slots[i].key);
+        free(index->slots[i].contacts);
+    }
+    free(index->slots);
+    index->slots = NULL;
+}
+
+static IndexBucket *contact_index_slot(const ContactIndex *index, const char *key) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_string(key) & mask;
+
+    while (index->slots[i].key != NULL && strcmp(index->slots[i].key, key) != 0) {
+        i = (i + 1) & mask;
+    }
+    return &index->slots[i];
+}
+
+/**
+ * @brief Rehashes the index, dropping keys that no longer hold any contact.
+ *
+ * The table only doubles when the live keys would still fill it past half, so a
+ * churn of edits that leaves many empty keys behind is cleaned up in place.
+ */
+static int contact_index_rehash(ContactIndex *index) {
+    size_t live = 0;
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->slots[i].key != NULL && index->slots[i].count > 0) {
+            live++;
+        }
+    }
+
+    ContactIndex fresh;
+    fresh.capacity = index->capacity;
+    while ((live + 1) * 2 > fresh.capacity) {
+        fresh.capacity *= 2;
+    }
+    fresh.used = 0;
+    fresh.slots = calloc(fresh.capacity, sizeof(IndexBucket));
+    if (fresh.slots == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        IndexBucket *bucket = &index->slots[i];
+        if (bucket->key == NULL) {
+            continue;
+        }
+        if (bucket->count == 0) {
+            free(bucket->key);
+            free(bucket->contacts);
+            continue;
+        }
+        *contact_index_slot(&fresh, bucket->key) = *bucket;
+        fresh.used++;
+    }
+
+    free(index->slots);
+    *index = fresh;
+    return 0;
+}
+
+static int contact_index_add(ContactIndex *index, const char *key, Contact *contact) {
+    IndexBucket *bucket = contact_index_slot(index, key);
+
+    if (bucket->key == NULL) {
+        if ((index->used + 1) * 10 > index->capacity * 7) {
+            if (contact_index_rehash(index) != 0) {
+                return -1;
+            }
+            bucket = contact_index_slot(index, key);
+        }
+        bucket->key = malloc(strlen(key) + 1);
+        if (bucket->key == NULL) {
+            return -1;
+        }
+        strcpy(bucket->key, key);
+        index->used++;
+    }
+
+    if (bucket->count == bucket->capacity) {
+        size_t capacity = bucket->capacity == 0 ? 1 : bucket->capacity * 2;
+        Contact **grown = realloc(bucket->contacts, sizeof(Contact *) * capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        bucket->contacts = grown;
+        bucket->capacity = capacity;
+    }
+
+    bucket->contacts[bucket->count++] = contact;
+    return 0;
+}
+
+static void contact_index_remove(ContactIndex *index, const char *key, const Contact *contact) {
+    IndexBucket *bucket = contact_index_slot(index, key);
+    if (bucket->key == NULL) {
+        return;
+    }
+
+    // Shift rather than swap so the bucket keeps insertion (list) order.
+    for (size_t i = 0; i < bucket->count; i++) {
+        if (bucket->contacts[i] == contact) {
+            memmove(&bucket->contacts[i], &bucket->contacts[i + 1],
+                    sizeof(Contact *) * (bucket->count - i - 1));
+            bucket->count--;
+            return;
+        }
+    }
+}
+
+const IndexBucket *contact_index_lookup(const ContactIndex *index, const char *key) {
+    if (index->slots == NULL) {
+        return NULL;
+    }
+    const IndexBucket *bucket = contact_index_slot(index, key);
+    return (bucket->key != NULL && bucket->count > 0) ? bucket : NULL;
+}
+
+// ========================= ID Index ========================= //
+
+static int id_index_init(IdIndex *index) {
+    index->capacity = INDEX_INITIAL_CAPACITY;
+    index->count = 0;
+    index->slots = calloc(index->capacity, sizeof(Contact *));
+    return index->slots == NULL ? -1 : 0;
+}
+
+static int id_index_grow(IdIndex *index) {
+    size_t capacity = index->capacity * 2;
+    Contact **slots = calloc(capacity, sizeof(Contact *));
+    if (slots == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        Contact *contact = index->slots[i];
+        if (contact != NULL) {
+            size_t j = hash_id(contact->id) & (capacity - 1);
+            while (slots[j] != NULL) {
+                j = (j + 1) & (capacity - 1);
+            }
+            slots[j] = contact;
+        }
+    }
+
+    free(index->slots);
+    index->slots = slots;
+    index->capacity = capacity;
+    return 0;
+}
+
+static int id_index_add(IdIndex *index, Contact *contact) {
+    if ((index->count + 1) * 10 > index->capacity * 7 && id_index_grow(index) != 0) {
+        return -1;
+    }
+
+    size_t mask = index->capacity - 1;
+    size_t i = hash_id(contact->id) & mask;
+    while (index->slots[i] != NULL) {
+        i = (i + 1) & mask;
+    }
+    index->slots[i] = contact;
+    index->count++;
+    return 0;
+}
+
+/**
+ * @brief Removes a contact using backward-shift deletion, so no tombstones are needed.
+ */
+static void id_index_remove(IdIndex *index, const Contact *contact) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_id(contact->id) & mask;
+
+    while (index->slots[i] != NULL && index->slots[i] != contact) {
+        i = (i + 1) & mask;
+    }
+    if (index->slots[i] == NULL) {
+        return;
+    }
+
+    index->slots[i] = NULL;
+    index->count--;
+
+    // Pull later members of the probe run back into the hole when that is legal.
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; index->slots[j] != NULL; j = (j + 1) & mask) {
+        size_t home = hash_id(index->slots[j]->id) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            index->slots[hole] = index->slots[j];
+            index->slots[j] = NULL;
+            hole = j;
+        }
+    }
+}
+
+Contact *id_index_lookup(const IdIndex *index, int id) {
+    if (index->slots == NULL) {
+        return NULL;
+    }
+
+    size_t mask = index->capacity - 1;
+    for (size_t i = hash_id(id) & mask; index->slots[i] != NULL; i = (i + 1) & mask) {
+        if (index->slots[i]->id == id) {
+            return index->slots[i];
+        }
+    }
+    return NULL;
+}
+
+// ========================= Phone Suffix Index ========================= //
+
+static int phone_tail_index_init(PhoneTailIndex *index) {
+    index->capacity = INDEX_INITIAL_CAPACITY;
+    index->count = 0;
+    index->slots = calloc(index->capacity, sizeof(PhoneTailSlot));
+    return index->slots == NULL ? -1 : 0;
+}
+
+static int phone_tail_index_grow(PhoneTailIndex *index) {
+    size_t capacity = index->capacity * 2;
+    PhoneTailSlot *slots = calloc(capacity, sizeof(PhoneTailSlot));
+    if (slots == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->slots[i].contact != NULL) {
+            size_t j = hash_id(index->slots[i].tail) & (capacity - 1);
+            while (slots[j].contact != NULL) {
+                j = (j + 1) & (capacity - 1);
+            }
+            slots[j] = index->slots[i];
+        }
+    }
+
+    free(index->slots);
+    index->slots = slots;
+    index->capacity = capacity;
+    return 0;
+}
+
+static int phone_tail_index_add(PhoneTailIndex *index, int tail, Contact *contact) {
+    if ((index->count + 1) * 10 > index->capacity * 7 && phone_tail_index_grow(index) != 0) {
+        return -1;
+    }
+
+    size_t mask = index->capacity - 1;
+    size_t i = hash_id(tail) & mask;
+    while (index->slots[i].contact != NULL) {
+        i = (i + 1) & mask;
+    }
+    index->slots[i].contact = contact;
+    index->slots[i].tail = tail;
+    index->count++;
+    return 0;
+}
+
+/**
+ * @brief Removes a contact using backward-shift deletion, as id_index_remove does.
+ */
+static void phone_tail_index_remove(PhoneTailIndex *index, int tail, const Contact *contact) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_id(tail) & mask;
+
+    while (index->slots[i].contact != NULL && index->slots[i].contact != contact) {
+        i = (i + 1) & mask;
+    }
+    if (index->slots[i].contact == NULL) {
+        return;
+    }
+
+    index->slots[i].contact = NULL;
+    index->count--;
+
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; index->slots[j].contact != NULL; j = (j + 1) & mask) {
+        size_t home = hash_id(index->slots[j].tail) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            index->slots[hole] = index->slots[j];
+            index->slots[j].contact = NULL;
+            hole = j;
+        }
+    }
+}
+
+Contact *phone_tail_index_next(const PhoneTailIndex *index, int tail, size_t *position) {
+    if (index->slots == NULL) {
+        return NULL;
+    }
+
+    // The position counts the slots already probed past the key's home slot.
+    size_t mask = index->capacity - 1;
+    size_t home = hash_id(tail) & mask;
+    while (*position < index->capacity) {
+        const PhoneTailSlot *slot = &index->slots[(home + *position) & mask];
+        if (slot->contact == NULL) {
+            return NULL;
+        }
+        (*position)++;
+        if (slot->tail == tail) {
+            return slot->contact;
+        }
+    }
+    return NULL;
+}
+
+// ========================= Book Indexes ========================= //
+
+BookIndexes *book_indexes_create(void) {
+    BookIndexes *indexes = calloc(1, sizeof(BookIndexes));
+    if (indexes == NULL) {
+        return NULL;
+    }
+
+    if (id_index_init(&indexes->by_id) != 0 || contact_index_init(&indexes->by_name) != 0 ||
+        contact_index_init(&indexes->by_phone) != 0 ||
+        phone_tail_index_init(&indexes->by_phone_tail) != 0 ||
+        contact_index_init(&indexes->by_email) != 0 ||
+        contact_index_init(&indexes->by_domain) != 0 ||
+        contact_index_init(&indexes->by_sound) != 0) {
+        book_indexes_free(indexes);
+        return NULL;
+    }
+    return indexes;
+}
+
+void book_indexes_free(BookIndexes *indexes) {
+    if (indexes == NULL) {
+        return;
+    }
+    free(indexes->by_id.slots);
+    contact_index_destroy(&indexes->by_name);
+    contact_index_destroy(&indexes->by_phone);
+    free(indexes->by_phone_tail.slots);
+    contact_index_destroy(&indexes->by_email);
+    contact_index_destroy(&indexes->by_domain);
+    contact_index_destroy(&indexes->by_sound);
+    free(indexes);
+}
+
+int book_indexes_add(BookIndexes *indexes, Contact *contact) {
+    char key[MAX_EMAIL_LENGTH];
+    int status = id_index_add(&indexes->by_id, contact);
+
+    index_fold_key(contact->name, key);
+    status |= contact_index_add(&indexes->by_name, key, contact);
+
+    status |= contact_index_add(&indexes->by_phone, contact->phone, contact);
+
+    int tail = phone_tail_key(contact->phone);
+    if (tail >= 0) {
+        status |= phone_tail_index_add(&indexes->by_phone_tail, tail, contact);
+    }
+
+    index_fold_key(contact->email, key);
+    status |= contact_index_add(&indexes->by_email, key, contact);
+
+    report_domain_key(contact->email, key);
+    status |= contact_index_add(&indexes->by_domain, key, contact);
+
+    char codes[PHONETIC_MAX_TOKENS][PHONETIC_CODE_LENGTH];
+    int code_count = phonetic_name_codes(contact->name, codes);
+    for (int i = 0; i < code_count; i++) {
+        status |= contact_index_add(&indexes->by_sound, codes[i], contact);
+    }
+
+    return status == 0 ? 0 : -1;
+}
+
+void book_indexes_remove(BookIndexes *indexes, const Contact *contact) {
+    char key[MAX_EMAIL_LENGTH];
+    id_index_remove(&indexes->by_id, contact);
+
+    index_fold_key(contact->name, key);
+    contact_index_remove(&indexes->by_name, key, contact);
+
+    contact_index_remove(&indexes->by_phone, contact->phone, contact);
+
+    int tail = phone_tail_key(contact->phone);
+    if (tail >= 0) {
+        phone_tail_index_remove(&indexes->by_phone_tail, tail, contact);
+    }
+
+    index_fold_key(contact->email, key);
+    contact_index_remove(&indexes->by_email, key, contact);
+
+    report_domain_key(contact->email, key);
+    contact_index_remove(&indexes->by_domain, key, contact);
+
+    char codes[PHONETIC_MAX_TOKENS][PHONETIC_CODE_LENGTH];
+    int code_count = phonetic_name_codes(contact->name, codes);
+    for (int i = 0; i < code_count; i++) {
+        contact_index_remove(&indexes->by_sound, codes[i], contact);
+    }
+}
@@ -0,0 +1,339 @@
+/**
+ * @file contact_report.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the incrementally maintained group-by reports.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "contact_report.h"
+
+#define COUNT_TABLE_INITIAL_CAPACITY 64
+
+// ========================= Count Table ========================= //
+
+/**
+ * @brief FNV-1a hash of a null-terminated key.
+ */
+static size_t hash_key(const char *key) {
+    size_t hash = 2166136261u;
+    while (*key != '\0') {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the slot holding @p key, or the empty slot where it would be inserted.
+ */
+static ReportRow *count_table_slot(const CountTable *table, const char *key) {
+    size_t mask = table->capacity - 1;
+    size_t index = hash_key(key) & mask;
+
+    while (table->slots[index].key[0] != '\0' && strcmp(table->slots[index].key, key) != 0) {
+        index = (index + 1) & mask;
+    }
+    return &table->slots[index];
+}
+
+/**
+ * @brief Doubles the capacity of a count table and rehashes its keys.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+static int count_table_grow(CountTable *table) {
+    CountTable bigger;
+    bigger.capacity = table->capacity * 2;
+    bigger.used = table->used;
+    bigger.slots = calloc(bigger.capacity, sizeof(ReportRow));
+    if (bigger.slots == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].key[0] != '\0') {
+            *count_table_slot(&bigger, table->slots[i].key) = table->slots[i];
+        }
+    }
+
+    free(table->slots);
+    *table = bigger;
+    return 0;
+}
+
+/**
+ * @brief Empties a slot using backward-shift deletion, so no tombstones are needed.
+ */
+static void count_table_delete(CountTable *table, ReportRow *slot) {
+    size_t mask = table->capacity - 1;
+    size_t hole = (size_t)(slot - table->slots);
+
+    slot->key[0] = '\0';
+    slot->count = 0;
+    table->used--;
+
+    // Pull later members of the probe run back into the hole when that is legal.
+    for (size_t j = (hole + 1) & mask; table->slots[j].key[0] != '\0'; j = (j + 1) & mask) {
+        size_t home = hash_key(table->slots[j].key) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            table->slots[hole] = table->slots[j];
+            table->slots[j].key[0] = '\0';
+            table->slots[j].count = 0;
+            hole = j;
+        }
+    }
+}
+
+/**
+ * @brief Adds @p delta to the count of @p key, inserting the key if needed.
+ *
+ * A key whose count drops to zero is deleted, so the table only ever holds live groups.
+ *
+ * @return 0 on success, -1 if the table had to grow and memory could not be allocated;
+ *         the table no longer matches the book and must be discarded.
+ */
+static int count_table_adjust(CountTable *table, const char *key, int delta) {
+    ReportRow *slot = count_table_slot(table, key);
+    if (slot->key[0] == '\0') {
+        if (delta <= 0) {
+            return 0;
+        }
+        if ((table->used + 1) * 10 > table->capacity * 7) {
+            if (count_table_grow(table) != 0) {
+                return -1;
+            }
+            slot = count_table_slot(table, key);
+        }
+        strncpy(slot->key, key, MAX_EMAIL_LENGTH - 1);
+        slot->key[MAX_EMAIL_LENGTH - 1] = '\0';
+        slot->count = 0;
+        table->used++;
+    }
+
+    slot->count += delta;
+    if (slot->count <= 0) {
+        count_table_delete(table, slot);
+    }
+    return 0;
+}
+
+static int count_table_init(CountTable *table) {
+    table->capacity = COUNT_TABLE_INITIAL_CAPACITY;
+    table->used = 0;
+    table->slots = calloc(table->capacity, sizeof(ReportRow));
+    return table->slots == NULL ? -1 : 0;
+}
+
+// ========================= Aggregates ========================= //
+
+ContactAggregates *aggregates_create(void) {
+    ContactAggregates *aggregates = malloc(sizeof(ContactAggregates));
+    if (aggregates == NULL) {
+        return NULL;
+    }
+
+    if (count_table_init(&aggregates->by_domain) != 0 ||
+        count_table_init(&aggregates->by_phone_prefix) != 0) {
+        free(aggregates->by_domain.slots);
+        free(aggregates);
+        return NULL;
+    }
+    return aggregates;
+}
+
+void aggregates_free(ContactAggregates *aggregates) {
+    if (aggregates == NULL) {
+        return;
+    }
+    free(aggregates->by_domain.slots);
+    free(aggregates->by_phone_prefix.slots);
+    free(aggregates);
+}
+
+/**
+ * @brief The domain is everything after the last '@', folded to lowercase.
+ */
+void report_domain_key(const char *email, char *key) {
+    const char *at = strrchr(email, '@');
+    if (at == NULL || at[1] == '\0') {
+        strcpy(key, "(no domain)");
+        return;
+    }
+
+    int i = 0;
+    for (const char *p = at + 1; *p != '\0' && i < MAX_EMAIL_LENGTH - 1; p++) {
+        key[i++] = (char)tolower((unsigned char)*p);
+    }
+    key[i] = '\0';
+}
+
+/**
+ * @brief The prefix is the first REPORT_PHONE_PREFIX_LENGTH characters of the phone number.
+ */
+void report_phone_prefix_key(const char *phone, char *key) {
+    if (phone[0] == '\0') {
+        strcpy(key, "(no phone)");
+        return;
+    }
+    snprintf(key, MAX_EMAIL_LENGTH, "%.*s", REPORT_PHONE_PREFIX_LENGTH, phone);
+}
+
+static int aggregates_adjust(ContactAggregates *aggregates, const Contact *contact, int delta) {
+    char key[MAX_EMAIL_LENGTH];
+
+    report_domain_key(contact->email, key);
+    if (count_table_adjust(&aggregates->by_domain, key, delta) != 0) {
+        return -1;
+    }
+
+    report_phone_prefix_key(contact->phone, key);
+    return count_table_adjust(&aggregates->by_phone_prefix, key, delta);
+}
+
+int aggregates_add_contact(ContactAggregates *aggregates, const Contact *contact) {
+    if (aggregates == NULL || contact == NULL) {
+        return -1;
+    }
+    return aggregates_adjust(aggregates, contact, 1);
+}
+
+void aggregates_remove_contact(ContactAggregates *aggregates, const Contact *contact) {
+    if (aggregates != NULL && contact != NULL) {
+        aggregates_adjust(aggregates, contact, -1);
+    }
+}
+
+// ========================= Reports ========================= //
+
+static int compare_rows(const void *a, const void *b) {
+    const ReportRow *left = a;
+    const ReportRow *right = b;
+
+    if (left->count != right->count) {
+        return right->count - left->count;
+    }
+    return strcmp(left->key, right->key);
+}
+
+/**
+ * @brief Copies the non-empty groups of a table into a sorted, heap-allocated array.
+ */
+static size_t collect_rows(const CountTable *table, ReportRow **rows) {
+    *rows = NULL;
+
+    size_t count = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].key[0] != '\0' && table->slots[i].count > 0) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    *rows = malloc(sizeof(ReportRow) * count);
+    if (*rows == NULL) {
+        return 0;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].key[0] != '\0' && table->slots[i].count > 0) {
+            (*rows)[n++] = table->slots[i];
+        }
+    }
+
+    qsort(*rows, count, sizeof(ReportRow), compare_rows);
+    return count;
+}
+
+size_t aggregates_report(const AddressBook *book, ReportOption group, ReportRow **rows) {
+    *rows = NULL;
+    if (book == NULL || (group != REPORT_BY_EMAIL_DOMAIN && group != REPORT_BY_PHONE_PREFIX)) {
+        return 0;
+    }
+
+    // Normal path: the book keeps its aggregates current, so just read them.
+    const ContactAggregates *aggregates = book->aggregates;
+    ContactAggregates *scanned = NULL;
+
+    // Fallback: if the aggregates could not be allocated, count with a one-off scan.
+    if (aggregates == NULL) {
+        scanned = aggregates_create();
+        if (scanned == NULL) {
+            return 0;
+        }
+        for (const Contact *current = book->head; current != NULL; current = current->next) {
+            if (aggregates_add_contact(scanned, current) != 0) {
+                aggregates_free(scanned);
+                return 0;
+            }
+        }
+        aggregates = scanned;
+    }
+
+    size_t count = collect_rows(group == REPORT_BY_EMAIL_DOMAIN ? &aggregates->by_domain
+                                                                : &aggregates->by_phone_prefix,
+                                rows);
+    aggregates_free(scanned);
+    return count;
+}
+
+void show_reports(const AddressBook *book) {
+
+    printf("\n<================================| REPORTS |===================================>\n");
+
+    if (book->head == NULL) {
+        printf("Ein: *Ears droop* There's nobody in the book yet, so there's nothing to count.\n");
+        return;
+    }
+
+    int attempts = 0;
+
+    do {
+        printf("\n-------------------- REPORT OPTIONS --------------------\n");
+        printf("  %d) Contacts per email domain\n", REPORT_BY_EMAIL_DOMAIN);
+        printf("  %d) Contacts per phone prefix\n", REPORT_BY_PHONE_PREFIX);
+        printf("  %d) Cancel\n", REPORT_CANCEL);
+        printf("---------------------------------------------------------\n");
+
+        int choice = get_int_input("Ein: How should I group the pack? ");
+
+        if (choice == REPORT_CANCEL) {
+            printf("Ein: Alright, no counting today. Back to the main menu.\n");
+            return;
+        }
+
+        if (choice != REPORT_BY_EMAIL_DOMAIN && choice != REPORT_BY_PHONE_PREFIX) {
+            printf("Ein: That's not one of the options. Let's try again.\n");
+            if (handle_attempt(&attempts) == CANCEL) {
+                return;
+            }
+            continue;
+        }
+
+        ReportRow *rows = NULL;
+        size_t count = aggregates_report(book, (ReportOption)choice, &rows);
+
+        printf("\nEin: *Counts paws* Here's how the pack splits up:\n");
+        printf("--------------------------------------------------------\n");
+        printf("| %-40s | %-9s |\n",
+               choice == REPORT_BY_EMAIL_DOMAIN ? "Email domain" : "Phone prefix", "Contacts");
+        printf("--------------------------------------------------------\n");
+        for (size_t i = 0; i < count; i++) {
+            printf("| %-40s | %-9d |\n", rows[i].key, rows[i].count);
+        }
+        printf("--------------------------------------------------------\n");
+        printf("| Groups: %-44zu |\n", count);
+        printf("--------------------------------------------------------\n");
+
+        free(rows);
+        return;
+
+    } while (attempts < MAX_ATTEMPTS);
+}
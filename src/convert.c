@@ -0,0 +1,931 @@
+/**
+ * @file convert.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the streaming converter: reader -> parser -> writer pipeline.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include "address_book.h"
+#include "compressed_store.h"
+#include "contact_helper.h"
+#include "convert.h"
+#include "thread_pool.h"
+
+#define CONVERT_RUN_BUFFER 4096 // stdio buffer per sorted run while merging
+#define CONVERT_MAX_FAN_IN 64   // runs merged at once
+#define CONVERT_COUNT_WIDTH 10  // CSV count line is padded so it can be rewritten in place
+
+// ========================= Bounded Queue ========================= //
+
+/**
+ * @brief A fixed-capacity blocking FIFO of pointers, closable by the producer.
+ */
+typedef struct {
+    void **items;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    bool closed;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} BoundedQueue;
+
+static int queue_init(BoundedQueue *queue, size_t capacity) {
+    queue->items = malloc(sizeof(void *) * capacity);
+    if (queue->items == NULL) {
+        return -1;
+    }
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->count = 0;
+    queue->closed = false;
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+    pthread_cond_init(&queue->not_full, NULL);
+    return 0;
+}
+
+static void queue_destroy(BoundedQueue *queue) {
+    free(queue->items);
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+}
+
+static void queue_push(BoundedQueue *queue, void *item) {
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->capacity) {
+        pthread_cond_wait(&queue->not_full, &queue->lock);
+    }
+    queue->items[(queue->head + queue->count) % queue->capacity] = item;
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+ * @brief Takes the oldest item, waiting for one; returns NULL once closed and drained.
+ */
+static void *queue_pop(BoundedQueue *queue) {
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0 && !queue->closed) {
+        pthread_cond_wait(&queue->not_empty, &queue->lock);
+    }
+    void *item = NULL;
+    if (queue->count > 0) {
+        item = queue->items[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count--;
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return item;
+}
+
+static void queue_close(BoundedQueue *queue) {
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = true;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// ========================= Pipeline State ========================= //
+
+typedef struct {
+    char data[CONVERT_CHUNK_SIZE];
+    size_t length;
+} Chunk;
+
+typedef struct {
+    Contact *records;
+    size_t count;
+} RecordBatch;
+
+/**
+ * @brief Everything the three stages share. Buffers cycle between the free and full queues,
+ * so the pools bound memory however large the input is.
+ */
+typedef struct {
+    FILE *input;
+    const ConvertOptions *options;
+    size_t batch_records;
+
+    Chunk *chunks;
+    RecordBatch *batches;
+    BoundedQueue free_chunks;
+    BoundedQueue full_chunks;
+    BoundedQueue free_batches;
+    BoundedQueue full_batches;
+
+    bool read_failed;
+    size_t records_read;     // Written by the parser, read after it finishes.
+    size_t records_invalid;
+} Pipeline;
+
+// ========================= Reader Stage ========================= //
+
+/**
+ * @brief Fills chunks with whole lines; a partial last line is carried into the next chunk.
+ */
+static void reader_stage(void *arg) {
+    Pipeline *pipeline = arg;
+    const size_t capacity = CONVERT_CHUNK_SIZE;
+    char *carry = malloc(capacity);
+    size_t carry_length = 0;
+
+    while (carry != NULL) {
+        Chunk *chunk = queue_pop(&pipeline->free_chunks);
+        memcpy(chunk->data, carry, carry_length);
+        size_t read = fread(chunk->data + carry_length, 1, capacity - carry_length,
+                            pipeline->input);
+        size_t total = carry_length + read;
+        carry_length = 0;
+
+        if (total == 0) {
+            queue_push(&pipeline->free_chunks, chunk);
+            break;
+        }
+
+        chunk->length = total;
+        if (read > 0 && total == capacity) {
+            // Hand over whole lines only; a line longer than a chunk is cut (and later rejected).
+            size_t last = total;
+            while (last > 0 && chunk->data[last - 1] != '\n') {
+                last--;
+            }
+            if (last > 0) {
+                chunk->length = last;
+                carry_length = total - chunk->length;
+                memcpy(carry, chunk->data + chunk->length, carry_length);
+            }
+        }
+        queue_push(&pipeline->full_chunks, chunk);
+
+        if (read == 0) {
+            break;
+        }
+    }
+
+    if (carry == NULL || ferror(pipeline->input)) {
+        pipeline->read_failed = true;
+    }
+    free(carry);
+    queue_close(&pipeline->full_chunks);
+}
+
+// ========================= Parser Stage ========================= //
+
+const char *convert_status_reason(ValidationStatus status) {
+    switch (status) {
+        case INVALID_EMPTY:
+            return "a field is empty";
+        case INVALID_CHARACTERS:
+            return "name has characters other than letters and spaces, or phone has non-digits";
+        case INVALID_LENGTH:
+            return "phone is not 10 digits, or a field is too long";
+        case INVALID_FORMAT:
+            return "malformed line or email";
+        default:
+            return "invalid record";
+    }
+}
+
+/**
+ * @brief Copies a field, reporting INVALID_LENGTH instead of truncating.
+ */
+static ValidationStatus copy_field(char *dest, size_t size, const char *start, const char *end) {
+    size_t length = (size_t)(end - start);
+    if (length >= size) {
+        return INVALID_LENGTH;
+    }
+    memcpy(dest, start, length);
+    dest[length] = '\0';
+    return VALID;
+}
+
+ValidationStatus convert_parse_record(const char *line, const char *end, Contact *contact) {
+    char *after_id;
+    long id = strtol(line, &after_id, 10);
+    if (after_id == line || after_id >= end || *after_id != ',' || id <= 0 || id > 2147483647L) {
+        return INVALID_FORMAT;
+    }
+
+    const char *name = after_id + 1;
+    const char *phone = memchr(name, ',', (size_t)(end - name));
+    if (phone == NULL) {
+        return INVALID_FORMAT;
+    }
+    phone++;
+    const char *email = memchr(phone, ',', (size_t)(end - phone));
+    if (email == NULL) {
+        return INVALID_FORMAT;
+    }
+    email++;
+
+    ValidationStatus status = copy_field(contact->name, sizeof(contact->name), name, phone - 1);
+    if (status == VALID) {
+        status = copy_field(contact->phone, sizeof(contact->phone), phone, email - 1);
+    }
+    if (status == VALID) {
+        status = copy_field(contact->email, sizeof(contact->email), email, end);
+    }
+    if (status != VALID) {
+        return status;
+    }
+
+    contact->id = (int)id;
+    contact->next = NULL;
+    status = is_valid_name(contact->name);
+    if (status == VALID) {
+        status = is_valid_phone(contact->phone);
+    }
+    if (status == VALID) {
+        status = is_valid_email(contact->email);
+    }
+    return status;
+}
+
+static void parser_stage(void *arg) {
+    Pipeline *pipeline = arg;
+    const ConvertOptions *options = pipeline->options;
+    RecordBatch *batch = queue_pop(&pipeline->free_batches);
+    size_t line_number = 0;
+    char partial[CONVERT_CHUNK_SIZE];
+    size_t partial_length = 0;
+
+    Chunk *chunk;
+    while ((chunk = queue_pop(&pipeline->full_chunks)) != NULL) {
+        const char *cursor = chunk->data;
+        const char *chunk_end = chunk->data + chunk->length;
+
+        while (cursor < chunk_end) {
+            const char *newline = memchr(cursor, '\n', (size_t)(chunk_end - cursor));
+            const char *end = newline != NULL ? newline : chunk_end;
+            const char *next = newline != NULL ? newline + 1 : chunk_end;
+            const char *line = cursor;
+
+            // A chunk that ends mid-line (only at end of input, or on an over-long line).
+            if (partial_length > 0 || newline == NULL) {
+                size_t room = sizeof(partial) - partial_length;
+                size_t take = (size_t)(end - cursor) < room ? (size_t)(end - cursor) : room;
+                memcpy(partial + partial_length, cursor, take);
+                partial_length += take;
+                cursor = next;
+                if (newline == NULL) {
+                    continue;
+                }
+                line = partial;
+                end = partial + partial_length;
+            }
+            cursor = next;
+
+            if (end > line && end[-1] == '\r') {
+                end--;
+            }
+            line_number++;
+            bool is_count_line = line_number == 1 && memchr(line, ',', (size_t)(end - line)) == NULL;
+            if (end > line && !is_count_line) {
+                pipeline->records_read++;
+                Contact *record = &batch->records[batch->count];
+                ValidationStatus status = convert_parse_record(line, end, record);
+                if (status == VALID) {
+                    if (++batch->count == pipeline->batch_records) {
+                        queue_push(&pipeline->full_batches, batch);
+                        batch = queue_pop(&pipeline->free_batches);
+                        batch->count = 0;
+                    }
+                }
+                else {
+                    if (options->report != NULL &&
+                        pipeline->records_invalid < options->report_limit) {
+                        fprintf(options->report, "Ein: Line %zu skipped: %s.\n", line_number,
+                                convert_status_reason(status));
+                    }
+                    pipeline->records_invalid++;
+                }
+            }
+            partial_length = 0;
+        }
+        queue_push(&pipeline->free_chunks, chunk);
+    }
+
+    // The last line may have no newline.
+    if (partial_length > 0) {
+        const char *end = partial + partial_length;
+        line_number++;
+        pipeline->records_read++;
+        ValidationStatus status =
+            convert_parse_record(partial, end, &batch->records[batch->count]);
+        if (status == VALID) {
+            batch->count++;
+        }
+        else {
+            if (options->report != NULL && pipeline->records_invalid < options->report_limit) {
+                fprintf(options->report, "Ein: Line %zu skipped: %s.\n", line_number,
+                        convert_status_reason(status));
+            }
+            pipeline->records_invalid++;
+        }
+    }
+
+    queue_push(&pipeline->full_batches, batch);
+    queue_close(&pipeline->full_batches);
+}
+
+// ========================= Output ========================= //
+
+/**
+ * @brief One open output file of any format.
+ */
+typedef struct {
+    ConvertFormat format;
+    FILE *file;
+    CompressedWriter *compressed;
+    size_t count;
+    int max_id;
+} Output;
+
+static int output_open(Output *output, const char *path, ConvertFormat format) {
+    output->format = format;
+    output->file = NULL;
+    output->compressed = NULL;
+    output->count = 0;
+    output->max_id = 0;
+
+    if (format == CONVERT_COMPRESSED) {
+        output->compressed = compressed_writer_open(path);
+        return output->compressed == NULL ? -1 : 0;
+    }
+
+    output->file = fopen(path, "wb");
+    if (output->file == NULL) {
+        return -1;
+    }
+    if (format == CONVERT_CSV) {
+        // Placeholder count, rewritten once the number of valid records is known.
+        fprintf(output->file, "%*d\n", CONVERT_COUNT_WIDTH, 0);
+    }
+    return 0;
+}
+
+static void write_json_string(FILE *file, const char *text) {
+    fputc('"', file);
+    for (; *text != '\0'; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        }
+        else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        }
+        else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static int output_write(Output *output, const Contact *contact) {
+    if (contact->id > output->max_id) {
+        output->max_id = contact->id;
+    }
+    output->count++;
+
+    switch (output->format) {
+        case CONVERT_COMPRESSED:
+            return compressed_writer_add(output->compressed, contact);
+        case CONVERT_JSONL:
+            fprintf(output->file, "{\"id\":%d,\"name\":", contact->id);
+            write_json_string(output->file, contact->name);
+            fputs(",\"phone\":", output->file);
+            write_json_string(output->file, contact->phone);
+            fputs(",\"email\":", output->file);
+            write_json_string(output->file, contact->email);
+            fputs("}\n", output->file);
+            break;
+        default:
+            fprintf(output->file, "%d,%s,%s,%s\n", contact->id, contact->name, contact->phone,
+                    contact->email);
+            break;
+    }
+    return ferror(output->file) ? -1 : 0;
+}
+
+static int output_close(Output *output, bool ok) {
+    if (output->format == CONVERT_COMPRESSED) {
+        int status = compressed_writer_close(output->compressed, output->max_id + 1);
+        return ok && status == 0 ? 0 : -1;
+    }
+
+    if (ok && output->format == CONVERT_CSV) {
+        ok = fseek(output->file, 0, SEEK_SET) == 0 &&
+             fprintf(output->file, "%*zu", CONVERT_COUNT_WIDTH, output->count) ==
+                 CONVERT_COUNT_WIDTH;
+    }
+    if (fclose(output->file) != 0) {
+        ok = false;
+    }
+    return ok ? 0 : -1;
+}
+
+// ========================= External Sort ========================= //
+
+static int fold_compare(const char *left, const char *right) {
+    for (;; left++, right++) {
+        int a = tolower((unsigned char)*left);
+        int b = tolower((unsigned char)*right);
+        if (a != b || a == '\0') {
+            return a - b;
+        }
+    }
+}
+
+static int compare_contacts(const Contact *left, const Contact *right, ConvertSort sort) {
+    int order = 0;
+    switch (sort) {
+        case CONVERT_SORT_NAME:
+            order = fold_compare(left->name, right->name);
+            break;
+        case CONVERT_SORT_PHONE:
+            order = strcmp(left->phone, right->phone);
+            break;
+        case CONVERT_SORT_EMAIL:
+            order = strcmp(left->email, right->email);
+            break;
+        default:
+            break;
+    }
+    if (order != 0) {
+        return order;
+    }
+    return (left->id > right->id) - (left->id < right->id);
+}
+
+// qsort has no context argument, so the key is handed over per sort call.
+static _Thread_local ConvertSort active_sort;
+
+static int compare_for_qsort(const void *a, const void *b) {
+    return compare_contacts(a, b, active_sort);
+}
+
+static void sort_records(Contact *records, size_t count, ConvertSort sort) {
+    active_sort = sort;
+    qsort(records, count, sizeof(Contact), compare_for_qsort);
+}
+
+/**
+ * @brief Sorted runs on disk plus the in-memory run being filled.
+ *
+ * Runs form a stack tagged with merge levels: whenever the top @c fan_in runs share a level they
+ * are merged into one run of the next level, so few files are open at once and every record is
+ * rewritten only log(runs) times.
+ */
+typedef struct {
+    Contact *buffer;
+    size_t capacity;
+    size_t count;
+    size_t fan_in;
+    FILE **runs;
+    size_t *levels;
+    size_t run_count;
+    size_t run_capacity;
+    size_t spilled;
+} Sorter;
+
+static FILE *open_run(void) {
+    FILE *run = tmpfile();
+    if (run != NULL) {
+        setvbuf(run, NULL, _IOFBF, CONVERT_RUN_BUFFER);
+    }
+    return run;
+}
+
+/**
+ * @brief Merges runs [first, run_count) into @p output, or into a new run if @p output is NULL.
+ * The in-memory run is empty at this point, so its buffer holds the merge heads.
+ */
+static int merge_runs(Sorter *sorter, size_t first, ConvertSort sort, Output *output) {
+    size_t count = sorter->run_count - first;
+    FILE **runs = sorter->runs + first;
+    Contact *heads = sorter->buffer;
+    bool live[CONVERT_MAX_FAN_IN];
+
+    FILE *merged = NULL;
+    if (output == NULL && (merged = open_run()) == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        rewind(runs[i]);
+        live[i] = fread(&heads[i], sizeof(Contact), 1, runs[i]) == 1;
+    }
+
+    int status = 0;
+    for (;;) {
+        size_t best = count;
+        for (size_t i = 0; i < count; i++) {
+            if (live[i] && (best == count || compare_contacts(&heads[i], &heads[best], sort) < 0)) {
+                best = i;
+            }
+        }
+        if (best == count) {
+            break;
+        }
+        if (merged != NULL ? fwrite(&heads[best], sizeof(Contact), 1, merged) != 1
+                           : output_write(output, &heads[best]) != 0) {
+            status = -1;
+            break;
+        }
+        live[best] = fread(&heads[best], sizeof(Contact), 1, runs[best]) == 1;
+    }
+
+    size_t level = sorter->levels[first] + 1;
+    for (size_t i = 0; i < count; i++) {
+        fclose(runs[i]);
+    }
+    sorter->run_count = first;
+    if (merged != NULL) {
+        if (status != 0) {
+            fclose(merged);
+            return -1;
+        }
+        sorter->runs[sorter->run_count] = merged;
+        sorter->levels[sorter->run_count] = level;
+        sorter->run_count++;
+    }
+    return status;
+}
+
+static int sorter_spill(Sorter *sorter, ConvertSort sort) {
+    if (sorter->run_count == sorter->run_capacity) {
+        size_t capacity = sorter->run_capacity == 0 ? 8 : sorter->run_capacity * 2;
+        FILE **runs = realloc(sorter->runs, sizeof(FILE *) * capacity);
+        if (runs == NULL) {
+            return -1;
+        }
+        sorter->runs = runs;
+        size_t *levels = realloc(sorter->levels, sizeof(size_t) * capacity);
+        if (levels == NULL) {
+            return -1;
+        }
+        sorter->levels = levels;
+        sorter->run_capacity = capacity;
+    }
+
+    FILE *run = open_run();
+    if (run == NULL) {
+        return -1;
+    }
+    sort_records(sorter->buffer, sorter->count, sort);
+    if (fwrite(sorter->buffer, sizeof(Contact), sorter->count, run) != sorter->count) {
+        fclose(run);
+        return -1;
+    }
+    sorter->runs[sorter->run_count] = run;
+    sorter->levels[sorter->run_count] = 0;
+    sorter->run_count++;
+    sorter->spilled++;
+    sorter->count = 0;
+
+    // Collapse full levels, bottom up.
+    while (sorter->run_count >= sorter->fan_in) {
+        size_t first = sorter->run_count - sorter->fan_in;
+        if (sorter->levels[first] != sorter->levels[sorter->run_count - 1]) {
+            break;
+        }
+        if (merge_runs(sorter, first, sort, NULL) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes everything sorted: straight from memory if nothing spilled, else by merging.
+ */
+static int sorter_finish(Sorter *sorter, ConvertSort sort, Output *output) {
+    if (sorter->run_count == 0) {
+        sort_records(sorter->buffer, sorter->count, sort);
+        for (size_t i = 0; i < sorter->count; i++) {
+            if (output_write(output, &sorter->buffer[i]) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (sorter->count > 0 && sorter_spill(sorter, sort) != 0) {
+        return -1;
+    }
+    // Reduce to at most fan_in runs, then merge those straight into the output.
+    while (sorter->run_count > sorter->fan_in) {
+        if (merge_runs(sorter, sorter->run_count - sorter->fan_in, sort, NULL) != 0) {
+            return -1;
+        }
+    }
+    return merge_runs(sorter, 0, sort, output);
+}
+
+static void sorter_free(Sorter *sorter) {
+    for (size_t i = 0; i < sorter->run_count; i++) {
+        fclose(sorter->runs[i]);
+    }
+    free(sorter->runs);
+    free(sorter->levels);
+    free(sorter->buffer);
+}
+
+// ========================= Conversion ========================= //
+
+void convert_default_options(ConvertOptions *options) {
+    options->format = CONVERT_CSV;
+    options->sort = CONVERT_SORT_NONE;
+    options->memory_limit = CONVERT_DEFAULT_MEMORY;
+    options->batch_records = CONVERT_DEFAULT_BATCH;
+    options->report = stdout;
+    options->report_limit = CONVERT_REPORT_LIMIT;
+}
+
+/**
+ * @brief Splits the memory limit between chunk, batch, and sort-run buffers.
+ * @return 0 if the limit can hold the pipeline, -1 otherwise.
+ */
+static int plan_memory(const ConvertOptions *options, size_t *batch_records,
+                       size_t *run_records) {
+    size_t fixed = sizeof(Chunk) * CONVERT_CHUNK_BUFFERS + CONVERT_CHUNK_SIZE * 2;
+    if (options->memory_limit < CONVERT_MIN_MEMORY || options->memory_limit <= fixed) {
+        return -1;
+    }
+    size_t budget = options->memory_limit - fixed;
+
+    // Sorting keeps most of the budget for runs; a merge needs one buffered head per run.
+    size_t batch_budget = options->sort == CONVERT_SORT_NONE ? budget : budget / 4;
+    size_t records = batch_budget / (sizeof(Contact) * CONVERT_BATCH_BUFFERS);
+    if (options->batch_records > 0 && options->batch_records < records) {
+        records = options->batch_records;
+    }
+    if (records == 0) {
+        return -1;
+    }
+    *batch_records = records;
+
+    size_t remaining = budget - records * sizeof(Contact) * CONVERT_BATCH_BUFFERS;
+    *run_records = options->sort == CONVERT_SORT_NONE
+                       ? 0
+                       : remaining / (sizeof(Contact) + CONVERT_RUN_BUFFER / 8);
+    return 0;
+}
+
+static void free_pipeline(Pipeline *pipeline) {
+    if (pipeline->batches != NULL) {
+        for (size_t i = 0; i < CONVERT_BATCH_BUFFERS; i++) {
+            free(pipeline->batches[i].records);
+        }
+    }
+    free(pipeline->batches);
+    free(pipeline->chunks);
+    queue_destroy(&pipeline->free_chunks);
+    queue_destroy(&pipeline->full_chunks);
+    queue_destroy(&pipeline->free_batches);
+    queue_destroy(&pipeline->full_batches);
+}
+
+static int init_pipeline(Pipeline *pipeline, size_t batch_records) {
+    memset(pipeline, 0, sizeof(Pipeline));
+    pipeline->batch_records = batch_records;
+    if (queue_init(&pipeline->free_chunks, CONVERT_CHUNK_BUFFERS) != 0 ||
+        queue_init(&pipeline->full_chunks, CONVERT_CHUNK_BUFFERS) != 0 ||
+        queue_init(&pipeline->free_batches, CONVERT_BATCH_BUFFERS) != 0 ||
+        queue_init(&pipeline->full_batches, CONVERT_BATCH_BUFFERS) != 0) {
+        return -1;
+    }
+
+    pipeline->chunks = malloc(sizeof(Chunk) * CONVERT_CHUNK_BUFFERS);
+    pipeline->batches = calloc(CONVERT_BATCH_BUFFERS, sizeof(RecordBatch));
+    if (pipeline->chunks == NULL || pipeline->batches == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < CONVERT_CHUNK_BUFFERS; i++) {
+        queue_push(&pipeline->free_chunks, &pipeline->chunks[i]);
+    }
+    for (size_t i = 0; i < CONVERT_BATCH_BUFFERS; i++) {
+        pipeline->batches[i].records = malloc(sizeof(Contact) * batch_records);
+        if (pipeline->batches[i].records == NULL) {
+            return -1;
+        }
+        queue_push(&pipeline->free_batches, &pipeline->batches[i]);
+    }
+    return 0;
+}
+
+int convert_contacts(const char *input_path, const char *output_path,
+                     const ConvertOptions *options, ConvertStats *stats) {
+    ConvertStats ignored;
+    if (stats == NULL) {
+        stats = &ignored;
+    }
+    memset(stats, 0, sizeof(ConvertStats));
+
+    size_t batch_records;
+    size_t run_records;
+    if (plan_memory(options, &batch_records, &run_records) != 0) {
+        return -1;
+    }
+
+    Sorter sorter = {0};
+    if (options->sort != CONVERT_SORT_NONE) {
+        sorter.capacity = run_records;
+        sorter.fan_in = run_records / 8 < 2 ? 2 : run_records / 8;
+        if (sorter.fan_in > CONVERT_MAX_FAN_IN) {
+            sorter.fan_in = CONVERT_MAX_FAN_IN;
+        }
+        sorter.buffer = malloc(sizeof(Contact) * sorter.capacity);
+        if (sorter.buffer == NULL) {
+            return -1;
+        }
+    }
+
+    FILE *input = fopen(input_path, "rb");
+    if (input == NULL) {
+        sorter_free(&sorter);
+        return -1;
+    }
+
+    Output output;
+    if (output_open(&output, output_path, options->format) != 0) {
+        fclose(input);
+        sorter_free(&sorter);
+        return -1;
+    }
+
+    Pipeline pipeline;
+    ThreadPool *pool = NULL;
+    bool ok = init_pipeline(&pipeline, batch_records) == 0 &&
+              (pool = thread_pool_create(2)) != NULL;
+    pipeline.input = input;
+    pipeline.options = options;
+
+    if (ok) {
+        stats->memory_used = sizeof(Chunk) * CONVERT_CHUNK_BUFFERS + CONVERT_CHUNK_SIZE * 2 +
+                             sizeof(Contact) * batch_records * CONVERT_BATCH_BUFFERS +
+                             sizeof(Contact) * sorter.capacity;
+
+        // Reader and parser run on the pool; this thread is the writer.
+        if (thread_pool_submit(pool, reader_stage, &pipeline) != 0) {
+            queue_close(&pipeline.full_chunks);
+            queue_close(&pipeline.full_batches);
+            ok = false;
+        }
+        else if (thread_pool_submit(pool, parser_stage, &pipeline) != 0) {
+            // Drain the reader ourselves so it can finish, then stop.
+            Chunk *chunk;
+            while ((chunk = queue_pop(&pipeline.full_chunks)) != NULL) {
+                queue_push(&pipeline.free_chunks, chunk);
+            }
+            queue_close(&pipeline.full_batches);
+            ok = false;
+        }
+
+        RecordBatch *batch;
+        while ((batch = queue_pop(&pipeline.full_batches)) != NULL) {
+            for (size_t i = 0; ok && i < batch->count; i++) {
+                if (options->sort == CONVERT_SORT_NONE) {
+                    ok = output_write(&output, &batch->records[i]) == 0;
+                    continue;
+                }
+                sorter.buffer[sorter.count++] = batch->records[i];
+                if (sorter.count == sorter.capacity) {
+                    ok = sorter_spill(&sorter, options->sort) == 0;
+                }
+            }
+            batch->count = 0;
+            queue_push(&pipeline.free_batches, batch);
+        }
+        thread_pool_wait(pool);
+        ok = ok && !pipeline.read_failed;
+    }
+
+    if (ok && options->sort != CONVERT_SORT_NONE) {
+        ok = sorter_finish(&sorter, options->sort, &output) == 0;
+    }
+
+    stats->records_read = pipeline.records_read;
+    stats->records_invalid = pipeline.records_invalid;
+    stats->records_written = output.count;
+    stats->sorted_runs = sorter.spilled;
+
+    thread_pool_destroy(pool);
+    free_pipeline(&pipeline);
+    sorter_free(&sorter);
+    fclose(input);
+    return output_close(&output, ok) == 0 && ok ? 0 : -1;
+}
+
+// ========================= Command Line ========================= //
+
+static void print_convert_usage(void) {
+    printf("Usage: addressbook convert <input.csv> <output> [options]\n");
+    printf("  --format csv|jsonl|abz          Output format (default: csv)\n");
+    printf("  --sort id|name|phone|email      Sort the output (external sort)\n");
+    printf("  --memory <MB>                   Cap buffer memory (default: %d MB)\n",
+           CONVERT_DEFAULT_MEMORY / (1024 * 1024));
+    printf("  --batch <records>               Records per parsed batch (default: %d)\n",
+           CONVERT_DEFAULT_BATCH);
+}
+
+static double elapsed_seconds(const struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int run_convert_command(int argc, char *argv[]) {
+    if (argc < 2) {
+        print_convert_usage();
+        return 1;
+    }
+
+    ConvertOptions options;
+    convert_default_options(&options);
+
+    for (int i = 2; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool known = value != NULL;
+
+        if (known && strcmp(argv[i], "--format") == 0) {
+            if (strcmp(value, "csv") == 0) {
+                options.format = CONVERT_CSV;
+            }
+            else if (strcmp(value, "jsonl") == 0) {
+                options.format = CONVERT_JSONL;
+            }
+            else if (strcmp(value, "abz") == 0) {
+                options.format = CONVERT_COMPRESSED;
+            }
+            else {
+                known = false;
+            }
+        }
+        else if (known && strcmp(argv[i], "--sort") == 0) {
+            if (strcmp(value, "id") == 0) {
+                options.sort = CONVERT_SORT_ID;
+            }
+            else if (strcmp(value, "name") == 0) {
+                options.sort = CONVERT_SORT_NAME;
+            }
+            else if (strcmp(value, "phone") == 0) {
+                options.sort = CONVERT_SORT_PHONE;
+            }
+            else if (strcmp(value, "email") == 0) {
+                options.sort = CONVERT_SORT_EMAIL;
+            }
+            else {
+                known = false;
+            }
+        }
+        else if (known && strcmp(argv[i], "--memory") == 0 && atoi(value) > 0) {
+            options.memory_limit = (size_t)atoi(value) * 1024 * 1024;
+        }
+        else if (known && strcmp(argv[i], "--batch") == 0 && atoi(value) > 0) {
+            options.batch_records = (size_t)atoi(value);
+        }
+        else {
+            known = false;
+        }
+
+        if (!known) {
+            print_convert_usage();
+            return 1;
+        }
+        i++;
+    }
+
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    ConvertStats stats;
+    if (convert_contacts(argv[0], argv[1], &options, &stats) != 0) {
+        printf("Ein: *Whines* The conversion failed: check that '%s' exists, '%s' is writable,\n",
+               argv[0], argv[1]);
+        printf("Ein: and that the memory limit is at least %d KB.\n", CONVERT_MIN_MEMORY / 1024);
+        return 1;
+    }
+
+    if (stats.records_invalid > options.report_limit) {
+        printf("Ein: ...and %zu more invalid record(s).\n",
+               stats.records_invalid - options.report_limit);
+    }
+    printf("Ein: Converted %zu of %zu record(s) into '%s' in %.2fs (%zu skipped, %zu sorted "
+           "run(s), %zu KB of buffers).\n",
+           stats.records_written, stats.records_read, argv[1], elapsed_seconds(&start),
+           stats.records_invalid, stats.sorted_runs, stats.memory_used / 1024);
+    return 0;
+}
@@ -0,0 +1,513 @@
+/**
+ * @file csv_watch.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of contacts.csv hot reload: the inotify watch, the base, and the diff.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // st_mtim
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include "address_book.h"
+#include "ab_api.h"
+#include "contact_helper.h"
+#include "convert.h"
+#include "csv_watch.h"
+#include "trace.h"
+
+#define WATCH_LINE_LENGTH 512
+#define WATCH_EVENT_BUFFER 4096
+
+/**
+ * @brief What the base remembers of one record.
+ */
+typedef struct {
+    int id;
+    uint64_t fingerprint;
+} BaseEntry;
+
+/**
+ * @brief A record the file changed, waiting to be applied.
+ */
+typedef struct {
+    Contact values;
+    size_t line_number;
+    const BaseEntry *base; // NULL for a record the base did not have.
+} PendingChange;
+
+struct CsvWatch {
+    int fd;
+    char *directory;
+    const char *name; // File name within directory (points into path).
+    char *path;
+    BaseEntry *base;  // Sorted by ID.
+    size_t base_count;
+    bool retry;       // The last reload failed, so the next poll tries again.
+    bool have_stamp;  // Size and modification time of the file as last seen.
+    off_t size;
+    struct timespec mtime;
+};
+
+// ========================= Fingerprints ========================= //
+
+/**
+ * @brief FNV-1a hash of a record's "name,phone,email" text.
+ */
+static uint64_t fingerprint_text(const char *text, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t fingerprint_contact(const Contact *contact) {
+    char text[MAX_NAME_LENGTH + MAX_PHONE_LENGTH + MAX_EMAIL_LENGTH];
+    int length = snprintf(text, sizeof(text), "%s,%s,%s", contact->name, contact->phone,
+                          contact->email);
+    return fingerprint_text(text, (size_t)length);
+}
+
+static int compare_base(const void *a, const void *b) {
+    const BaseEntry *left = a;
+    const BaseEntry *right = b;
+    return (left->id > right->id) - (left->id < right->id);
+}
+
+static const BaseEntry *find_base(const CsvWatch *watch, int id) {
+    BaseEntry key = {id, 0};
+    return bsearch(&key, watch->base, watch->base_count, sizeof(BaseEntry), compare_base);
+}
+
+/**
+ * @brief Sorts new base entries by ID (files written by the app already are) and drops repeats.
+ */
+static size_t finish_base(BaseEntry *entries, size_t count) {
+    bool sorted = true;
+    for (size_t i = 1; i < count && sorted; i++) {
+        sorted = entries[i - 1].id <= entries[i].id;
+    }
+    if (!sorted) {
+        qsort(entries, count, sizeof(BaseEntry), compare_base);
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (kept == 0 || entries[kept - 1].id != entries[i].id) {
+            entries[kept++] = entries[i];
+        }
+    }
+    return kept;
+}
+
+/**
+ * @brief Reads the file's size and modification time.
+ * @return true if the file exists.
+ */
+static bool read_stamp(const CsvWatch *watch, off_t *size, struct timespec *mtime) {
+    struct stat info;
+    if (stat(watch->path, &info) != 0) {
+        return false;
+    }
+    *size = info.st_size;
+    *mtime = info.st_mtim;
+    return true;
+}
+
+// ========================= Watching ========================= //
+
+CsvWatch *csv_watch_open(const char *path) {
+    CsvWatch *watch = calloc(1, sizeof(CsvWatch));
+    if (watch == NULL) {
+        return NULL;
+    }
+    watch->fd = -1;
+    watch->path = malloc(strlen(path) + 1);
+    watch->directory = malloc(strlen(path) + 2);
+    if (watch->path == NULL || watch->directory == NULL) {
+        csv_watch_close(watch);
+        return NULL;
+    }
+    strcpy(watch->path, path);
+
+    // Watch the directory, so editors that save by renaming a new file over the old are seen.
+    const char *slash = strrchr(path, '/');
+    if (slash == NULL) {
+        strcpy(watch->directory, ".");
+        watch->name = watch->path;
+    }
+    else {
+        size_t length = slash == path ? 1 : (size_t)(slash - path);
+        memcpy(watch->directory, path, length);
+        watch->directory[length] = '\0';
+        watch->name = watch->path + (slash - path) + 1;
+    }
+
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd < 0 ||
+        inotify_add_watch(watch->fd, watch->directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        csv_watch_close(watch);
+        return NULL;
+    }
+    return watch;
+}
+
+int csv_watch_reset(CsvWatch *watch, const AddressBook *book) {
+    BaseEntry *base = malloc(sizeof(BaseEntry) * ((size_t)book->contact_count + 1));
+    if (base == NULL) {
+        return -1;
+    }
+    size_t count = 0;
+    for (const Contact *c = book->head; c != NULL; c = c->next) {
+        base[count].id = c->id;
+        base[count].fingerprint = fingerprint_contact(c);
+        count++;
+    }
+    free(watch->base);
+    watch->base = base;
+    watch->base_count = finish_base(base, count);
+    watch->have_stamp = read_stamp(watch, &watch->size, &watch->mtime);
+    return 0;
+}
+
+int csv_watch_fd(const CsvWatch *watch) {
+    return watch->fd;
+}
+
+/**
+ * @brief Drains pending inotify events.
+ * @return true if any of them was about the watched file.
+ */
+static bool file_changed(CsvWatch *watch) {
+    bool changed = false;
+    _Alignas(struct inotify_event) char buffer[WATCH_EVENT_BUFFER];
+    for (;;) {
+        ssize_t length = read(watch->fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+        for (char *at = buffer; at < buffer + length;) {
+            const struct inotify_event *event = (const struct inotify_event *)at;
+            if (event->len > 0 && strcmp(event->name, watch->name) == 0) {
+                changed = true;
+            }
+            if (event->mask & IN_Q_OVERFLOW) {
+                changed = true;
+            }
+            at += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+int csv_watch_poll(CsvWatch *watch, AddressBook *book, FILE *report, CsvWatchStats *stats) {
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(*stats));
+    }
+    bool changed = file_changed(watch);
+    if (!changed && !watch->retry) {
+        return 0;
+    }
+
+    // Our own saves raise events too; a file that still has the stamp we saw is unchanged.
+    off_t size;
+    struct timespec mtime;
+    if (!read_stamp(watch, &size, &mtime)) {
+        return 0; // Deleted or mid-rename; the rename itself raises the next event.
+    }
+    if (watch->have_stamp && size == watch->size && mtime.tv_sec == watch->mtime.tv_sec &&
+        mtime.tv_nsec == watch->mtime.tv_nsec) {
+        return 0;
+    }
+    watch->retry = csv_watch_reload(watch, book, report, stats) != 0;
+    return watch->retry ? -1 : 1;
+}
+
+void csv_watch_close(CsvWatch *watch) {
+    if (watch == NULL) {
+        return;
+    }
+    if (watch->fd >= 0) {
+        close(watch->fd);
+    }
+    free(watch->base);
+    free(watch->directory);
+    free(watch->path);
+    free(watch);
+}
+
+// ========================= Reloading ========================= //
+
+static const char *reject_reason(ValidationStatus status) {
+    switch (status) {
+        case INVALID_DUPLICATE:
+            return "its ID, phone, or email is already used by another contact";
+        case INVALID_NO_MEMORY:
+            return "out of memory";
+        default:
+            return convert_status_reason(status);
+    }
+}
+
+static void report_conflict(FILE *report, int id, const char *here, const char *there,
+                            const char *path) {
+    if (report != NULL) {
+        fprintf(report, "Ein: Conflict on ID %d: %s here, but %s in %s; kept this session's "
+                        "version.\n",
+                id, here, there, path);
+    }
+}
+
+static void report_reject(FILE *report, size_t line_number, const char *path,
+                          ValidationStatus status) {
+    if (report != NULL) {
+        fprintf(report, "Ein: Skipped line %zu of %s: %s.\n", line_number, path,
+                reject_reason(status));
+    }
+}
+
+/**
+ * @brief Applies an edited or added record unless the book changed the same contact.
+ */
+static void apply_change(AddressBook *book, const PendingChange *change, const char *path,
+                         FILE *report, CsvWatchStats *stats) {
+    const Contact *values = &change->values;
+    Contact *local = NULL;
+    ab_find(book, values->id, &local);
+    uint64_t wanted = fingerprint_contact(values);
+    if (local != NULL && fingerprint_contact(local) == wanted) {
+        return; // Both sides made the same change.
+    }
+
+    if (change->base != NULL) {
+        if (local == NULL) {
+            stats->conflicts++;
+            report_conflict(report, values->id, "deleted", "edited", path);
+            return;
+        }
+        if (fingerprint_contact(local) != change->base->fingerprint) {
+            stats->conflicts++;
+            report_conflict(report, values->id, "edited", "edited differently", path);
+            return;
+        }
+        ValidationStatus status = ab_update(book, values->id, values->name, values->phone,
+                                            values->email);
+        if (status != VALID) {
+            stats->rejected++;
+            report_reject(report, change->line_number, path, status);
+            return;
+        }
+        stats->updated++;
+        return;
+    }
+
+    if (local != NULL) {
+        stats->conflicts++;
+        report_conflict(report, values->id, "a different contact was added",
+                        "another was added", path);
+        return;
+    }
+    ValidationStatus status = ab_insert(book, values);
+    if (status != VALID) {
+        stats->rejected++;
+        report_reject(report, change->line_number, path, status);
+        return;
+    }
+    stats->added++;
+}
+
+int csv_watch_reload(CsvWatch *watch, AddressBook *book, FILE *report, CsvWatchStats *stats) {
+    CsvWatchStats local_stats;
+    stats = stats != NULL ? stats : &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    // Stamp first: a write racing with the read below raises another event and another reload.
+    off_t size = 0;
+    struct timespec mtime = {0, 0};
+    bool have_stamp = read_stamp(watch, &size, &mtime);
+    FILE *file = fopen(watch->path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+
+    TraceSpan span = TRACE_BEGIN("watch.reload");
+    size_t capacity = watch->base_count + 1024;
+    BaseEntry *seen = malloc(sizeof(BaseEntry) * capacity);
+    bool *kept = calloc(watch->base_count + 1, sizeof(bool));
+    PendingChange *changes = NULL;
+    size_t change_count = 0;
+    size_t change_capacity = 0;
+    size_t seen_count = 0;
+    size_t next_base = 0;
+    bool failed = seen == NULL || kept == NULL;
+
+    char line[WATCH_LINE_LENGTH];
+    size_t line_number = 1;
+    if (!failed && fgets(line, sizeof(line), file) == NULL) {
+        line[0] = '\0'; // An empty file: every contact was deleted.
+    }
+    while (!failed && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        size_t length = strlen(line);
+        bool overlong = length == sizeof(line) - 1 && line[length - 1] != '\n';
+        if (overlong) {
+            int c;
+            while ((c = fgetc(file)) != '\n' && c != EOF) {
+            }
+        }
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+        if (length == 0) {
+            continue;
+        }
+
+        char *after_id;
+        long id = strtol(line, &after_id, 10);
+        stats->examined++;
+        if (overlong || after_id == line || *after_id != ',' || id <= 0 || id > 2147483647L) {
+            stats->rejected++;
+            report_reject(report, line_number, watch->path, overlong ? INVALID_LENGTH
+                                                                     : INVALID_FORMAT);
+            continue;
+        }
+
+        // Unchanged records are recognised by their fingerprint alone, without parsing.
+        const char *rest = after_id + 1;
+        uint64_t fingerprint = fingerprint_text(rest, (size_t)(line + length - rest));
+        // Files are normally in ID order, so the next base entry is tried before searching.
+        const BaseEntry *base = NULL;
+        if (next_base < watch->base_count && watch->base[next_base].id == (int)id) {
+            base = &watch->base[next_base];
+        }
+        else {
+            base = find_base(watch, (int)id);
+        }
+        next_base = base != NULL ? (size_t)(base - watch->base) + 1 : next_base;
+        if (base != NULL && kept[base - watch->base]) {
+            stats->rejected++;
+            if (report != NULL) {
+                fprintf(report, "Ein: Skipped a second contact with ID %ld in %s.\n", id,
+                        watch->path);
+            }
+            continue;
+        }
+        if (seen_count == capacity) {
+            capacity *= 2;
+            BaseEntry *grown = realloc(seen, sizeof(BaseEntry) * capacity);
+            if (grown == NULL) {
+                failed = true;
+                break;
+            }
+            seen = grown;
+        }
+        seen[seen_count].id = (int)id;
+        seen[seen_count].fingerprint = fingerprint;
+        seen_count++;
+        if (base != NULL) {
+            kept[base - watch->base] = true;
+            if (base->fingerprint == fingerprint) {
+                continue;
+            }
+        }
+
+        PendingChange change = {.line_number = line_number, .base = base};
+        ValidationStatus status = convert_parse_record(line, line + length, &change.values);
+        if (status != VALID) {
+            stats->rejected++;
+            report_reject(report, line_number, watch->path, status);
+            continue;
+        }
+        if (change_count == change_capacity) {
+            change_capacity = change_capacity == 0 ? 64 : change_capacity * 2;
+            PendingChange *grown = realloc(changes, sizeof(PendingChange) * change_capacity);
+            if (grown == NULL) {
+                failed = true;
+                break;
+            }
+            changes = grown;
+        }
+        changes[change_count++] = change;
+    }
+    failed = failed || ferror(file);
+    fclose(file);
+
+    if (!failed) {
+        // Deletions first, then edits, then additions (see csv_watch.h).
+        for (size_t i = 0; i < watch->base_count; i++) {
+            if (kept[i]) {
+                continue;
+            }
+            Contact *local = NULL;
+            if (ab_find(book, watch->base[i].id, &local) != VALID) {
+                continue;
+            }
+            if (fingerprint_contact(local) != watch->base[i].fingerprint) {
+                stats->conflicts++;
+                report_conflict(report, local->id, "edited", "deleted", watch->path);
+                continue;
+            }
+            ab_remove(book, local->id);
+            stats->deleted++;
+        }
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < change_count; i++) {
+                if ((changes[i].base != NULL) == (pass == 0)) {
+                    apply_change(book, &changes[i], watch->path, report, stats);
+                }
+            }
+        }
+
+        // The file as just read is the new base, whatever was applied or kept.
+        free(watch->base);
+        watch->base = seen;
+        watch->base_count = finish_base(seen, seen_count);
+        watch->have_stamp = have_stamp;
+        watch->size = size;
+        watch->mtime = mtime;
+        seen = NULL;
+    }
+    TRACE_END_COUNT(span, "changes", stats->added + stats->updated + stats->deleted);
+
+    free(seen);
+    free(kept);
+    free(changes);
+    return failed ? -1 : 0;
+}
+
+// ========================= Interactive ========================= //
+
+void check_contacts_file(CsvWatch *watch, AddressBook *book) {
+    CsvWatchStats stats;
+    int status = csv_watch_poll(watch, book, stdout, &stats);
+    if (status < 0) {
+        printf("\nEin: *Whines* '%s' changed, but I couldn't read it. I'll try again later.\n",
+               watch->path);
+        return;
+    }
+    if (status == 0) {
+        return;
+    }
+    size_t applied = stats.added + stats.updated + stats.deleted;
+    if (applied == 0 && stats.conflicts == 0 && stats.rejected == 0) {
+        return;
+    }
+    printf("\nEin: *Ears perk up* Someone changed '%s' while we were working.\n", watch->path);
+    printf("Ein: Picked up %zu new, %zu edited, and %zu deleted contact(s).\n", stats.added,
+           stats.updated, stats.deleted);
+    if (stats.conflicts > 0) {
+        printf("Ein: %zu contact(s) were changed both here and in the file; I kept yours, so "
+               "saving will overwrite theirs.\n",
+               stats.conflicts);
+    }
+    if (stats.rejected > 0) {
+        printf("Ein: Skipped %zu record(s) from the file that I couldn't use.\n", stats.rejected);
+    }
+}
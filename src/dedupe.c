@@ -0,0 +1,493 @@
+/**
+ * @file dedupe.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the sorted-neighbourhood near-duplicate detection job.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include "address_book.h"
+#include "dedupe.h"
+
+#define PHONE_KEY_DIGITS 10
+#define PHONE_SUFFIX_DIGITS 4
+#define MAX_NAME_TOKENS (MAX_NAME_LENGTH / 2)
+
+/**
+ * @brief A contact reduced to its normalized blocking keys.
+ */
+typedef struct {
+    const Contact *contact;
+    char name_key[MAX_NAME_LENGTH];      /**< Normalized, token-sorted name. */
+    char reversed_key[MAX_NAME_LENGTH];  /**< name_key reversed, to catch typos up front. */
+    char phone_key[PHONE_KEY_DIGITS + 1]; /**< Last ten digits of the phone number. */
+    char email_key[MAX_EMAIL_LENGTH];     /**< Email local part without dots or +tags. */
+} DedupeRecord;
+
+// ========================= Normalization ========================= //
+
+void dedupe_default_options(DedupeOptions *options) {
+    options->window = DEDUPE_DEFAULT_WINDOW;
+    options->name_threshold = DEDUPE_DEFAULT_NAME_THRESHOLD;
+}
+
+static int compare_tokens(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+void normalize_name(const char *name, char *out) {
+    char buffer[MAX_NAME_LENGTH];
+    char *tokens[MAX_NAME_TOKENS];
+    int token_count = 0;
+    int length = 0;
+    bool in_token = false;
+
+    // Split into lowercase letter-only tokens; everything else is a separator.
+    for (const char *p = name; *p != '\0' && length < MAX_NAME_LENGTH - 1; p++) {
+        if (isalpha((unsigned char)*p)) {
+            if (!in_token && token_count < MAX_NAME_TOKENS) {
+                tokens[token_count++] = &buffer[length];
+                in_token = true;
+            }
+            buffer[length++] = (char)tolower((unsigned char)*p);
+        }
+        else if (in_token) {
+            buffer[length++] = '\0';
+            in_token = false;
+        }
+    }
+    buffer[length] = '\0';
+
+    // Sorting the tokens makes "Kumar Ravi" and "Ravi Kumar" the same key.
+    qsort(tokens, (size_t)token_count, sizeof(char *), compare_tokens);
+
+    out[0] = '\0';
+    size_t used = 0;
+    for (int i = 0; i < token_count; i++) {
+        size_t token_length = strlen(tokens[i]);
+        if (used + token_length + (i > 0 ? 1 : 0) >= MAX_NAME_LENGTH) {
+            break;
+        }
+        if (i > 0) {
+            out[used++] = ' ';
+        }
+        memcpy(out + used, tokens[i], token_length);
+        used += token_length;
+        out[used] = '\0';
+    }
+}
+
+static void normalize_phone(const char *phone, char *out) {
+    char digits[MAX_PHONE_LENGTH];
+    size_t count = 0;
+
+    for (const char *p = phone; *p != '\0' && count < sizeof(digits) - 1; p++) {
+        if (isdigit((unsigned char)*p)) {
+            digits[count++] = *p;
+        }
+    }
+    digits[count] = '\0';
+
+    // Keep only the trailing digits so "+91 98450 12345" matches "9845012345".
+    const char *start = count > PHONE_KEY_DIGITS ? digits + count - PHONE_KEY_DIGITS : digits;
+    strcpy(out, start);
+}
+
+static void normalize_email_local(const char *email, char *out) {
+    size_t used = 0;
+
+    for (const char *p = email; *p != '\0' && *p != '@' && *p != '+'; p++) {
+        if (*p != '.' && used < MAX_EMAIL_LENGTH - 1) {
+            out[used++] = (char)tolower((unsigned char)*p);
+        }
+    }
+    out[used] = '\0';
+}
+
+// ========================= Similarity ========================= //
+
+double jaro_winkler(const char *a, const char *b) {
+    int len_a = (int)strlen(a);
+    int len_b = (int)strlen(b);
+
+    if (len_a == 0 && len_b == 0) {
+        return 1.0;
+    }
+    if (len_a == 0 || len_b == 0 || len_a > MAX_NAME_LENGTH || len_b > MAX_NAME_LENGTH) {
+        return 0.0;
+    }
+
+    bool matched_a[MAX_NAME_LENGTH] = {false};
+    bool matched_b[MAX_NAME_LENGTH] = {false};
+    int range = (len_a > len_b ? len_a : len_b) / 2 - 1;
+    if (range < 0) {
+        range = 0;
+    }
+
+    int matches = 0;
+    for (int i = 0; i < len_a; i++) {
+        int start = i - range > 0 ? i - range : 0;
+        int end = i + range + 1 < len_b ? i + range + 1 : len_b;
+        for (int j = start; j < end; j++) {
+            if (!matched_b[j] && a[i] == b[j]) {
+                matched_a[i] = true;
+                matched_b[j] = true;
+                matches++;
+                break;
+            }
+        }
+    }
+    if (matches == 0) {
+        return 0.0;
+    }
+
+    int transpositions = 0;
+    for (int i = 0, j = 0; i < len_a; i++) {
+        if (!matched_a[i]) {
+            continue;
+        }
+        while (!matched_b[j]) {
+            j++;
+        }
+        if (a[i] != b[j]) {
+            transpositions++;
+        }
+        j++;
+    }
+
+    double m = matches;
+    double jaro = (m / len_a + m / len_b + (m - transpositions / 2.0) / m) / 3.0;
+
+    int prefix = 0;
+    while (prefix < 4 && prefix < len_a && prefix < len_b && a[prefix] == b[prefix]) {
+        prefix++;
+    }
+    return jaro + prefix * 0.1 * (1.0 - jaro);
+}
+
+/**
+ * @brief Whether two phone keys end in the same PHONE_SUFFIX_DIGITS digits.
+ */
+static bool same_phone_suffix(const char *a, const char *b) {
+    size_t a_length = strlen(a);
+    size_t b_length = strlen(b);
+    if (a_length < PHONE_SUFFIX_DIGITS || b_length < PHONE_SUFFIX_DIGITS) {
+        return false;
+    }
+    return memcmp(a + a_length - PHONE_SUFFIX_DIGITS, b + b_length - PHONE_SUFFIX_DIGITS,
+                  PHONE_SUFFIX_DIGITS) == 0;
+}
+
+/**
+ * @brief Decides whether two records are likely the same person.
+ *
+ * A name is never enough on its own: common names repeat, and union-find would chain every
+ * "John Smith" in the book into one proposal. An identical or very similar name also needs
+ * the same email local part or the same last PHONE_SUFFIX_DIGITS phone digits; a moderately
+ * similar name needs the same email local part or the whole phone key.
+ */
+static bool is_likely_duplicate(const DedupeRecord *a, const DedupeRecord *b, double threshold) {
+    bool same_email = a->email_key[0] != '\0' && strcmp(a->email_key, b->email_key) == 0;
+    bool same_phone = a->phone_key[0] != '\0' && strcmp(a->phone_key, b->phone_key) == 0;
+    if (!same_email && !same_phone_suffix(a->phone_key, b->phone_key)) {
+        return false;
+    }
+
+    double similarity = a->name_key[0] != '\0' && strcmp(a->name_key, b->name_key) == 0
+                            ? 1.0
+                            : jaro_winkler(a->name_key, b->name_key);
+    if (similarity >= threshold) {
+        return true;
+    }
+    return similarity >= threshold - 0.1 && (same_phone || same_email);
+}
+
+// ========================= Union-Find ========================= //
+
+static size_t find_root(size_t *parent, size_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]]; // Path halving keeps the trees flat.
+        i = parent[i];
+    }
+    return i;
+}
+
+static void union_sets(size_t *parent, size_t *size, size_t a, size_t b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a == b) {
+        return;
+    }
+    if (size[a] < size[b]) {
+        size_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+}
+
+// ========================= Sorted Neighbourhood ========================= //
+
+static int compare_by_name(const void *a, const void *b) {
+    return strcmp((*(const DedupeRecord *const *)a)->name_key,
+                  (*(const DedupeRecord *const *)b)->name_key);
+}
+
+static int compare_by_reversed_name(const void *a, const void *b) {
+    return strcmp((*(const DedupeRecord *const *)a)->reversed_key,
+                  (*(const DedupeRecord *const *)b)->reversed_key);
+}
+
+static int compare_by_phone(const void *a, const void *b) {
+    return strcmp((*(const DedupeRecord *const *)a)->phone_key,
+                  (*(const DedupeRecord *const *)b)->phone_key);
+}
+
+static int compare_by_email(const void *a, const void *b) {
+    return strcmp((*(const DedupeRecord *const *)a)->email_key,
+                  (*(const DedupeRecord *const *)b)->email_key);
+}
+
+/**
+ * @brief Sorts the records by one blocking key and compares each record with its neighbours.
+ */
+static void sorted_neighbourhood_pass(DedupeRecord **order, const DedupeRecord *records,
+                                      size_t count, int (*compare)(const void *, const void *),
+                                      const DedupeOptions *options, size_t *parent, size_t *size,
+                                      size_t *comparisons) {
+    qsort(order, count, sizeof(DedupeRecord *), compare);
+
+    for (size_t i = 0; i < count; i++) {
+        size_t end = i + (size_t)options->window;
+        for (size_t j = i + 1; j < end && j < count; j++) {
+            size_t a = (size_t)(order[i] - records);
+            size_t b = (size_t)(order[j] - records);
+            if (find_root(parent, a) == find_root(parent, b)) {
+                continue;
+            }
+            (*comparisons)++;
+            if (is_likely_duplicate(order[i], order[j], options->name_threshold)) {
+                union_sets(parent, size, a, b);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Orders members by their cluster root, then by contact ID.
+ */
+typedef struct {
+    size_t root;
+    const Contact *contact;
+} ClusterMember;
+
+static int compare_members(const void *a, const void *b) {
+    const ClusterMember *left = a;
+    const ClusterMember *right = b;
+
+    if (left->root != right->root) {
+        return left->root < right->root ? -1 : 1;
+    }
+    return (left->contact->id > right->contact->id) - (left->contact->id < right->contact->id);
+}
+
+static int compare_clusters(const void *a, const void *b) {
+    const DuplicateCluster *left = a;
+    const DuplicateCluster *right = b;
+    return (left->members[0]->id > right->members[0]->id) -
+           (left->members[0]->id < right->members[0]->id);
+}
+
+/**
+ * @brief Turns the union-find forest into a list of clusters with two or more members.
+ * @return 0 on success, -1 if memory could not be allocated.
+ */
+static int collect_clusters(DedupeReport *report, const DedupeRecord *records, size_t *parent,
+                            size_t count) {
+    ClusterMember *members = malloc(sizeof(ClusterMember) * count);
+    if (members == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        members[i].root = find_root(parent, i);
+        members[i].contact = records[i].contact;
+    }
+    qsort(members, count, sizeof(ClusterMember), compare_members);
+
+    size_t cluster_total = 0;
+    for (size_t i = 0; i < count;) {
+        size_t j = i;
+        while (j < count && members[j].root == members[i].root) {
+            j++;
+        }
+        if (j - i > 1) {
+            cluster_total++;
+        }
+        i = j;
+    }
+
+    report->clusters = cluster_total > 0 ? calloc(cluster_total, sizeof(DuplicateCluster)) : NULL;
+    if (cluster_total > 0 && report->clusters == NULL) {
+        free(members);
+        return -1;
+    }
+
+    for (size_t i = 0; i < count;) {
+        size_t j = i;
+        while (j < count && members[j].root == members[i].root) {
+            j++;
+        }
+        if (j - i > 1) {
+            DuplicateCluster *cluster = &report->clusters[report->cluster_count];
+            cluster->members = malloc(sizeof(Contact *) * (j - i));
+            if (cluster->members == NULL) {
+                free(members);
+                return -1;
+            }
+            for (size_t k = i; k < j; k++) {
+                cluster->members[cluster->member_count++] = members[k].contact;
+            }
+            report->cluster_count++;
+        }
+        i = j;
+    }
+
+    free(members);
+    qsort(report->clusters, report->cluster_count, sizeof(DuplicateCluster), compare_clusters);
+    return 0;
+}
+
+DedupeReport *find_duplicate_clusters(const AddressBook *book, const DedupeOptions *options) {
+    DedupeOptions defaults;
+    if (options == NULL) {
+        dedupe_default_options(&defaults);
+        options = &defaults;
+    }
+
+    DedupeReport *report = calloc(1, sizeof(DedupeReport));
+    if (report == NULL) {
+        return NULL;
+    }
+
+    size_t count = 0;
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        count++;
+    }
+    report->record_count = count;
+    if (count < 2) {
+        return report;
+    }
+
+    DedupeRecord *records = malloc(sizeof(DedupeRecord) * count);
+    DedupeRecord **order = malloc(sizeof(DedupeRecord *) * count);
+    size_t *parent = malloc(sizeof(size_t) * count);
+    size_t *size = malloc(sizeof(size_t) * count);
+    if (records == NULL || order == NULL || parent == NULL || size == NULL) {
+        free(records);
+        free(order);
+        free(parent);
+        free(size);
+        free(report);
+        return NULL;
+    }
+
+    // Build the blocking keys once per contact.
+    size_t i = 0;
+    for (const Contact *current = book->head; current != NULL; current = current->next, i++) {
+        DedupeRecord *record = &records[i];
+        record->contact = current;
+        normalize_name(current->name, record->name_key);
+
+        size_t length = strlen(record->name_key);
+        for (size_t k = 0; k < length; k++) {
+            record->reversed_key[k] = record->name_key[length - 1 - k];
+        }
+        record->reversed_key[length] = '\0';
+
+        normalize_phone(current->phone, record->phone_key);
+        normalize_email_local(current->email, record->email_key);
+
+        order[i] = record;
+        parent[i] = i;
+        size[i] = 1;
+    }
+
+    // One sorted-neighbourhood pass per blocking key.
+    int (*passes[])(const void *, const void *) = {compare_by_name, compare_by_reversed_name,
+                                                   compare_by_phone, compare_by_email};
+    for (size_t p = 0; p < sizeof(passes) / sizeof(passes[0]); p++) {
+        sorted_neighbourhood_pass(order, records, count, passes[p], options, parent, size,
+                                  &report->comparisons);
+    }
+
+    int status = collect_clusters(report, records, parent, count);
+
+    free(records);
+    free(order);
+    free(parent);
+    free(size);
+
+    if (status != 0) {
+        free_dedupe_report(report);
+        return NULL;
+    }
+    return report;
+}
+
+void print_dedupe_report(const DedupeReport *report) {
+
+    printf("\n<============================| DUPLICATE REPORT |===============================>\n");
+
+    if (report->cluster_count == 0) {
+        printf("Ein: *Sniffs every record* No look-alikes here. Every friend is one of a kind!\n");
+        printf("Ein: (Checked %zu contact(s) with %zu comparison(s).)\n", report->record_count,
+               report->comparisons);
+        return;
+    }
+
+    printf("Ein: *Nose twitches* These contacts smell like the same person:\n");
+
+    for (size_t i = 0; i < report->cluster_count; i++) {
+        const DuplicateCluster *cluster = &report->clusters[i];
+
+        printf("\n--------------------------------------------------------------------------------\n");
+        printf(" Proposal %zu: merge into ID %d\n", i + 1, cluster->members[0]->id);
+        printf("--------------------------------------------------------------------------------\n");
+        for (size_t k = 0; k < cluster->member_count; k++) {
+            const Contact *member = cluster->members[k];
+            printf(" %-6s | %-4d | %-20s | %-15s | %-25s\n", k == 0 ? "keep" : "merge",
+                   member->id, member->name, member->phone, member->email);
+        }
+    }
+
+    printf("--------------------------------------------------------------------------------\n");
+    printf("Ein: %zu proposal(s) from %zu contact(s) using %zu comparison(s).\n",
+           report->cluster_count, report->record_count, report->comparisons);
+    printf("Ein: I haven't changed anything, review these and merge the ones you agree with.\n");
+}
+
+void show_duplicates(const AddressBook *book) {
+    DedupeReport *report = find_duplicate_clusters(book, NULL);
+    if (report == NULL) {
+        printf("Ein: *Whines* I couldn't fetch enough memory to compare everyone.\n");
+        return;
+    }
+    print_dedupe_report(report);
+    free_dedupe_report(report);
+}
+
+void free_dedupe_report(DedupeReport *report) {
+    if (report == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < report->cluster_count; i++) {
+        free(report->clusters[i].members);
+    }
+    free(report->clusters);
+    free(report);
+}
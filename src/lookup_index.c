@@ -0,0 +1,504 @@
+/**
+ * @file lookup_index.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the memory-mapped lookup file and the lookup command.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // mmap, fstat, st_mtim
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "address_book.h"
+#include "convert.h"
+#include "lookup_index.h"
+#include "trace.h"
+
+#define LOOKUP_MAGIC "ABIDX01\n"
+#define LOOKUP_LINE_LENGTH 512
+
+/**
+ * @brief Start of the file.
+ */
+typedef struct {
+    char magic[8];
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t strings_size;
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+} LookupHeader;
+
+/**
+ * @brief One contact: its ID and where its strings start.
+ */
+typedef struct {
+    int32_t id;
+    uint32_t offset;
+} LookupEntry;
+
+struct LookupIndex {
+    void *map;
+    size_t map_size;
+    const LookupHeader *header;
+    const LookupEntry *entries;   // Sorted by ID.
+    const uint32_t *by_phone;     // Entry numbers sorted by phone.
+    const uint32_t *by_email;     // Entry numbers sorted by email.
+    const char *strings;
+};
+
+// ========================= Building ========================= //
+
+/**
+ * @brief Sort key used while building: a field of one entry.
+ */
+typedef struct {
+    const char *key;
+    uint32_t entry;
+} SortKey;
+
+static int compare_entries(const void *a, const void *b) {
+    const LookupEntry *left = a;
+    const LookupEntry *right = b;
+    if (left->id != right->id) {
+        return left->id < right->id ? -1 : 1;
+    }
+    return (left->offset > right->offset) - (left->offset < right->offset);
+}
+
+static int compare_keys(const void *a, const void *b) {
+    const SortKey *left = a;
+    const SortKey *right = b;
+    int order = strcmp(left->key, right->key);
+    return order != 0 ? order : (left->entry > right->entry) - (left->entry < right->entry);
+}
+
+static const char *entry_phone(const char *strings, const LookupEntry *entry) {
+    const char *name = strings + entry->offset;
+    return name + strlen(name) + 1;
+}
+
+static const char *entry_email(const char *strings, const LookupEntry *entry) {
+    const char *phone = entry_phone(strings, entry);
+    return phone + strlen(phone) + 1;
+}
+
+/**
+ * @brief Sorts the entry numbers by one field and writes them out.
+ */
+static int write_order(FILE *file, const LookupEntry *entries, size_t count, const char *strings,
+                       SortKey *keys, bool by_email) {
+    for (size_t i = 0; i < count; i++) {
+        keys[i].key = by_email ? entry_email(strings, &entries[i])
+                               : entry_phone(strings, &entries[i]);
+        keys[i].entry = (uint32_t)i;
+    }
+    qsort(keys, count, sizeof(SortKey), compare_keys);
+    for (size_t i = 0; i < count; i++) {
+        if (fwrite(&keys[i].entry, sizeof(uint32_t), 1, file) != 1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reads the CSV into entries and a string heap.
+ * @return Number of entries, or -1 on a read or memory error.
+ */
+static long read_records(FILE *csv, LookupEntry **entries_out, char **strings_out,
+                         size_t *strings_size, int *skipped) {
+    size_t count = 0, capacity = 0, used = 0, room = 0;
+    LookupEntry *entries = NULL;
+    char *strings = NULL;
+    char line[LOOKUP_LINE_LENGTH];
+
+    // The first line is the record count, which the records themselves make redundant here.
+    bool first = true;
+    while (fgets(line, sizeof(line), csv) != NULL) {
+        size_t length = strlen(line);
+        bool complete = length > 0 && line[length - 1] == '\n';
+        if (!complete && !feof(csv)) {
+            int c;
+            while ((c = getc(csv)) != '\n' && c != EOF) {
+            }
+            (*skipped)++;
+            first = false;
+            continue;
+        }
+        if (first) {
+            first = false;
+            continue;
+        }
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+        if (length == 0) {
+            continue;
+        }
+
+        Contact contact;
+        if (convert_parse_record(line, line + length, &contact) != VALID) {
+            (*skipped)++;
+            continue;
+        }
+
+        size_t needed = strlen(contact.name) + strlen(contact.phone) + strlen(contact.email) + 3;
+        if (count == capacity || used + needed > room) {
+            size_t new_capacity =
+                count == capacity ? (capacity == 0 ? 1024 : capacity * 2) : capacity;
+            size_t new_room = used + needed > room ? (room == 0 ? 65536 : room * 2) : room;
+            LookupEntry *grown_entries = realloc(entries, sizeof(LookupEntry) * new_capacity);
+            if (grown_entries != NULL) {
+                entries = grown_entries;
+                capacity = new_capacity;
+            }
+            char *grown_strings = realloc(strings, new_room);
+            if (grown_strings != NULL) {
+                strings = grown_strings;
+                room = new_room;
+            }
+            if (grown_entries == NULL || grown_strings == NULL || used + needed > UINT32_MAX) {
+                free(entries);
+                free(strings);
+                return -1;
+            }
+        }
+
+        entries[count].id = contact.id;
+        entries[count].offset = (uint32_t)used;
+        count++;
+        used += (size_t)sprintf(strings + used, "%s", contact.name) + 1;
+        used += (size_t)sprintf(strings + used, "%s", contact.phone) + 1;
+        used += (size_t)sprintf(strings + used, "%s", contact.email) + 1;
+    }
+
+    if (ferror(csv)) {
+        free(entries);
+        free(strings);
+        return -1;
+    }
+    *entries_out = entries;
+    *strings_out = strings;
+    *strings_size = used;
+    return (long)count;
+}
+
+int lookup_index_build(const char *csv_path, const char *index_path, int *skipped) {
+    int bad = 0;
+    if (skipped != NULL) {
+        *skipped = 0;
+    }
+
+    FILE *csv = fopen(csv_path, "r");
+    if (csv == NULL) {
+        return -1;
+    }
+    TraceSpan span = TRACE_BEGIN("index.lookup_file");
+    struct stat source;
+    LookupEntry *entries = NULL;
+    char *strings = NULL;
+    size_t strings_size = 0;
+    long count = fstat(fileno(csv), &source) == 0
+                     ? read_records(csv, &entries, &strings, &strings_size, &bad)
+                     : -1;
+    fclose(csv);
+    if (count < 0) {
+        TRACE_END(span);
+        return -1;
+    }
+    qsort(entries, (size_t)count, sizeof(LookupEntry), compare_entries);
+
+    LookupHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LOOKUP_MAGIC, sizeof(header.magic));
+    header.count = (uint32_t)count;
+    header.strings_size = strings_size;
+    header.source_size = (uint64_t)source.st_size;
+    header.source_mtime_sec = (int64_t)source.st_mtim.tv_sec;
+    header.source_mtime_nsec = (int64_t)source.st_mtim.tv_nsec;
+
+    // Write beside the old file and swap it in at the end.
+    char temp_path[FILENAME_MAX];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", index_path);
+    FILE *file = fopen(temp_path, "wb");
+    SortKey *keys = malloc(sizeof(SortKey) * (count > 0 ? (size_t)count : 1));
+    int status = file != NULL && keys != NULL ? 0 : -1;
+    if (status == 0) {
+        status = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                         fwrite(entries, sizeof(LookupEntry), (size_t)count, file) == (size_t)count
+                     ? 0
+                     : -1;
+    }
+    if (status == 0) {
+        status = write_order(file, entries, (size_t)count, strings, keys, false);
+    }
+    if (status == 0) {
+        status = write_order(file, entries, (size_t)count, strings, keys, true);
+    }
+    if (status == 0 && strings_size > 0) {
+        status = fwrite(strings, 1, strings_size, file) == strings_size ? 0 : -1;
+    }
+    if (file != NULL && fclose(file) != 0) {
+        status = -1;
+    }
+    if (status == 0 && rename(temp_path, index_path) != 0) {
+        status = -1;
+    }
+    if (status != 0) {
+        remove(temp_path);
+    }
+
+    free(keys);
+    free(entries);
+    free(strings);
+    if (skipped != NULL) {
+        *skipped = bad;
+    }
+    TRACE_END_COUNT(span, "records", count);
+    return status == 0 ? (int)count : -1;
+}
+
+// ========================= Lookups ========================= //
+
+LookupIndex *lookup_index_open(const char *index_path) {
+    int fd = open(index_path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(LookupHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Check the layout; entries are checked as lookups touch them, so opening stays O(1).
+    const LookupHeader *header = map;
+    uint64_t count = header->count;
+    uint64_t arrays = sizeof(LookupHeader) + count * (sizeof(LookupEntry) + 2 * sizeof(uint32_t));
+    bool valid = memcmp(header->magic, LOOKUP_MAGIC, sizeof(header->magic)) == 0 &&
+                 arrays <= size && header->strings_size == size - arrays &&
+                 (header->strings_size == 0 || ((const char *)map)[size - 1] == '\0');
+
+    LookupIndex *index = valid ? malloc(sizeof(LookupIndex)) : NULL;
+    if (index == NULL) {
+        munmap(map, size);
+        return NULL;
+    }
+    index->map = map;
+    index->map_size = size;
+    index->header = header;
+    index->entries = (const LookupEntry *)(header + 1);
+    index->by_phone = (const uint32_t *)(index->entries + count);
+    index->by_email = index->by_phone + count;
+    index->strings = (const char *)map + arrays;
+    return index;
+}
+
+bool lookup_index_is_current(const LookupIndex *index, const char *csv_path) {
+    struct stat source;
+    return stat(csv_path, &source) == 0 &&
+           (uint64_t)source.st_size == index->header->source_size &&
+           (int64_t)source.st_mtim.tv_sec == index->header->source_mtime_sec &&
+           (int64_t)source.st_mtim.tv_nsec == index->header->source_mtime_nsec;
+}
+
+size_t lookup_index_count(const LookupIndex *index) {
+    return index->header->count;
+}
+
+/**
+ * @brief Field @p which (0 name, 1 phone, 2 email) of an entry, read without trusting the
+ * file: a damaged entry reads as empty strings. The strings end with a NUL, so strlen stops.
+ */
+static const char *mapped_field(const LookupIndex *index, uint32_t entry, int which) {
+    const char *end = index->strings + index->header->strings_size;
+    if (entry >= index->header->count) {
+        return "";
+    }
+    const char *field = index->entries[entry].offset < index->header->strings_size
+                            ? index->strings + index->entries[entry].offset
+                            : end;
+    for (int i = 0; i < which && field < end; i++) {
+        field += strlen(field) + 1;
+    }
+    return field < end ? field : "";
+}
+
+static void copy_entry(const LookupIndex *index, uint32_t entry, Contact *contact) {
+    snprintf(contact->name, sizeof(contact->name), "%s", mapped_field(index, entry, 0));
+    snprintf(contact->phone, sizeof(contact->phone), "%s", mapped_field(index, entry, 1));
+    snprintf(contact->email, sizeof(contact->email), "%s", mapped_field(index, entry, 2));
+    contact->id = entry < index->header->count ? index->entries[entry].id : 0;
+    contact->next = NULL;
+}
+
+int lookup_index_find(const LookupIndex *index, LookupField field, const char *value,
+                      Contact *matches, int max) {
+    size_t count = index->header->count;
+    size_t low = 0;
+    size_t high = count;
+    int found = 0;
+
+    if (field == LOOKUP_BY_ID) {
+        char *end;
+        long id = strtol(value, &end, 10);
+        if (end == value || *end != '\0') {
+            return 0;
+        }
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (index->entries[middle].id < id) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        for (; low < count && index->entries[low].id == id; low++) {
+            if (found < max) {
+                copy_entry(index, (uint32_t)low, &matches[found]);
+            }
+            found++;
+        }
+        return found;
+    }
+
+    // Emails are stored in lowercase.
+    char key[MAX_EMAIL_LENGTH];
+    snprintf(key, sizeof(key), "%s", value);
+    for (size_t i = 0; field == LOOKUP_BY_EMAIL && key[i] != '\0'; i++) {
+        key[i] = (char)tolower((unsigned char)key[i]);
+    }
+
+    const uint32_t *order = field == LOOKUP_BY_EMAIL ? index->by_email : index->by_phone;
+    int which = field == LOOKUP_BY_EMAIL ? 2 : 1;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strcmp(mapped_field(index, order[middle], which), key) < 0) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    for (; low < count && strcmp(mapped_field(index, order[low], which), key) == 0; low++) {
+        if (found < max) {
+            copy_entry(index, order[low], &matches[found]);
+        }
+        found++;
+    }
+    return found;
+}
+
+void lookup_index_close(LookupIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    munmap(index->map, index->map_size);
+    free(index);
+}
+
+// ========================= Command ========================= //
+
+static void print_lookup_usage(void) {
+    printf("Usage: addressbook lookup [--index <file>] --phone <number> | --email <address> | "
+           "--id <id>\n");
+    printf("       addressbook lookup [--index <file>] --build\n");
+    printf("  Prints each match as id,name,phone,email. The lookup file (%s by default)\n",
+           LOOKUP_INDEX_FILE_NAME);
+    printf("  is rebuilt from contacts.csv first if it is missing or out of date.\n");
+}
+
+int run_lookup_command(int argc, char *argv[]) {
+    const char *index_path = LOOKUP_INDEX_FILE_NAME;
+    const char *value = NULL;
+    LookupField field = LOOKUP_BY_ID;
+    bool build = false;
+
+    for (int i = 0; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--build") == 0) {
+            build = true;
+        }
+        else if (strcmp(argv[i], "--index") == 0 && has_value) {
+            index_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--phone") == 0 && has_value && value == NULL) {
+            field = LOOKUP_BY_PHONE;
+            value = argv[++i];
+        }
+        else if (strcmp(argv[i], "--email") == 0 && has_value && value == NULL) {
+            field = LOOKUP_BY_EMAIL;
+            value = argv[++i];
+        }
+        else if (strcmp(argv[i], "--id") == 0 && has_value && value == NULL) {
+            field = LOOKUP_BY_ID;
+            value = argv[++i];
+        }
+        else {
+            print_lookup_usage();
+            return 1;
+        }
+    }
+    if (build == (value != NULL)) {
+        print_lookup_usage();
+        return 1;
+    }
+
+    LookupIndex *index = build ? NULL : lookup_index_open(index_path);
+    if (index == NULL || !lookup_index_is_current(index, "contacts.csv")) {
+        // A missing CSV leaves an existing lookup file as the best answer there is.
+        int skipped = 0;
+        int built = access("contacts.csv", R_OK) == 0 || index == NULL
+                        ? lookup_index_build("contacts.csv", index_path, &skipped)
+                        : 0;
+        if (built < 0) {
+            printf("Ein: *Whines* I couldn't build %s from contacts.csv.\n", index_path);
+            lookup_index_close(index);
+            return 1;
+        }
+        if (build) {
+            printf("Ein: Indexed %d contact(s) into %s.\n", built, index_path);
+            if (skipped > 0) {
+                printf("Ein: Skipped %d damaged record(s).\n", skipped);
+            }
+            return 0;
+        }
+        if (access("contacts.csv", R_OK) == 0) {
+            lookup_index_close(index);
+            index = lookup_index_open(index_path);
+        }
+        if (index == NULL) {
+            printf("Ein: *Whines* I couldn't open %s.\n", index_path);
+            return 1;
+        }
+    }
+
+    Contact matches[LOOKUP_MAX_MATCHES];
+    int found = lookup_index_find(index, field, value, matches, LOOKUP_MAX_MATCHES);
+    for (int i = 0; i < found && i < LOOKUP_MAX_MATCHES; i++) {
+        printf("%d,%s,%s,%s\n", matches[i].id, matches[i].name, matches[i].phone,
+               matches[i].email);
+    }
+    if (found == 0) {
+        printf("Ein: *Sniffs around* Nobody has that %s.\n",
+               field == LOOKUP_BY_ID ? "ID" : field == LOOKUP_BY_PHONE ? "phone" : "email");
+    }
+    lookup_index_close(index);
+    return found > 0 ? 0 : 1;
+}
@@ -8,9 +8,32 @@
  */
  
 #include <stdio.h> 
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
 #include "address_book.h"
+#include "autocomplete.h"
+#include "change_feed.h"
 #include "contact_helper.h"
+#include "compressed_store.h"
+#include "contact_report.h"
+#include "convert.h"
+#include "csv_watch.h"
+#include "dedupe.h"
+#include "lookup_index.h"
+#include "merge.h"
+#include "page_store.h"
+#include "query.h"
+#include "query_cache.h"
+#include "replica.h"
+#include "sharded_book.h"
+#include "shared_book.h"
+#include "slot_store.h"
+#include "snapshot.h"
+#include "tags.h"
+#include "trace.h"
 
+// Numbers 1-7 keep their original meaning, so scripted input still works; newer options follow.
 typedef enum {
     CREATE = 1,
     SEARCH,
@@ -18,10 +41,105 @@ typedef enum {
     DELETE,
     LIST,
     SAVE,
-    EXIT
+    EXIT,
+    QUERY,
+    QUICK_FIND,
+    REPORT,
+    DEDUPE,
+    TAGS
 } MenuOption;
 
-int main(void) {
+int main(int argc, char *argv[]) {
+    bool use_compressed = false;
+    bool use_feed = false;
+    bool use_slots = false;
+    SlotStore *slots = NULL;
+    bool use_watch = false;
+    CsvWatch *watch = NULL;
+    QueryCache *query_cache = NULL;
+
+    // Tracing covers subcommands too; the trace file is written at exit.
+    if (trace_start_from_env() < 0) {
+        printf("Ein: *Whines* I can't trace to %s (this build may have tracing compiled out).\n",
+               getenv(TRACE_ENV_VARIABLE));
+    }
+
+    if (argc > 1 && strcmp(argv[1], "shards") == 0) {
+        return run_shards_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "convert") == 0) {
+        return run_convert_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "suggest") == 0) {
+        return run_suggest_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "pages") == 0) {
+        return run_pages_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "merge") == 0) {
+        return run_merge_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "changes") == 0) {
+        return run_changes_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "lookup") == 0) {
+        return run_lookup_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "tags") == 0) {
+        return run_tags_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "shared") == 0) {
+        return run_shared_command(argc - 2, argv + 2);
+    }
+    if (argc > 1 && strcmp(argv[1], "replica") == 0) {
+        return run_replica_command(argc - 2, argv + 2);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--compressed") == 0 && !use_slots && !use_watch) {
+            use_compressed = true;
+        }
+        else if (strcmp(argv[i], "--feed") == 0) {
+            use_feed = true;
+        }
+        else if (strcmp(argv[i], "--slots") == 0 && !use_compressed && !use_watch) {
+            use_slots = true;
+        }
+        else if (strcmp(argv[i], "--watch") == 0 && !use_compressed && !use_slots) {
+            use_watch = true;
+        }
+        else {
+            printf("Usage: %s [--compressed | --slots | --watch] [--feed]\n", argv[0]);
+            printf("       %s shards <count> split|stats|query \"<query>\"\n", argv[0]);
+            printf("       %s convert <input.csv> <output> [--format csv|jsonl|abz] [--sort <field>]\n"
+                   "               [--memory <MB>] [--batch <records>]\n", argv[0]);
+            printf("       %s suggest [--field name|phone|email] [--limit <count>] <prefix>...\n",
+                   argv[0]);
+            printf("       %s pages [--pool <pages>] import|export|stats|get|phone|email|name|add|set|remove ...\n",
+                   argv[0]);
+            printf("       %s merge [--base <base.csv>] [--prefer ours|theirs] [--memory <MB>]\n"
+                   "               [--report <file>] <ours.csv> <theirs.csv> <output.csv>\n", argv[0]);
+            printf("       %s changes [--from <sequence>] [--follow] [<log>]\n", argv[0]);
+            printf("       %s lookup --phone <number> | --email <address> | --id <id> | --build\n",
+                   argv[0]);
+            printf("       %s tags list | count|show \"<expression>\" | add|remove <tag> <id>...\n",
+                   argv[0]);
+            printf("       %s shared [--name <name>] create|destroy|import|save|stats|list|get|phone|email|\n"
+                   "               add|set|remove ...\n", argv[0]);
+            printf("       %s replica [--csv <file>] [--log <file>] [--from <sequence>]\n", argv[0]);
+            printf("  --compressed  Load from and save to %s instead of contacts.csv\n",
+                   COMPRESSED_FILE_NAME);
+            printf("  --slots       Keep contacts in %s, writing each change as it is made\n",
+                   SLOT_STORE_FILE_NAME);
+            printf("  --watch       Pick up changes other programs make to contacts.csv\n");
+            printf("  --feed        Append every change to %s for other programs to follow\n",
+                   CHANGE_FEED_FILE_NAME);
+            printf("  Set %s=<file> to write a Chrome trace of loading, saving, and searches\n",
+                   TRACE_ENV_VARIABLE);
+            return 1;
+        }
+    }
+
     printf("\n================================================================================\n");
     printf("||                                                                            ||\n");
     printf("||                       ADDRESS BOOK - YOUR CONTACT VAULT                    ||\n");
@@ -37,7 +155,56 @@ int main(void) {
     initialize(&book); // Initialize the address book
     printf("Ein: All set! Your address book is fresh and ready for new contacts.\n");
 
-    load_contacts_from_file(&book); // Load contacts from the file
+    // Load contacts from the file
+    if (use_compressed) {
+        load_contacts_from_compressed_file(&book);
+    }
+    else if (use_slots) {
+        slots = open_contacts_slot_file(&book);
+    }
+    else {
+        load_contacts_from_file(&book);
+    }
+    int skipped_tags = 0;
+    if (load_tags(&book, TAGS_FILE_NAME, &skipped_tags) > 0 && skipped_tags > 0) {
+        printf("Ein: Skipped %d tag entr(ies) for contacts that are gone.\n", skipped_tags);
+    }
+
+    // Listing and saving read through snapshots; without them they walk the live list.
+    if (book_enable_snapshots(&book) != 0) {
+        printf("Ein: *Whines* I'm short on memory, so listings won't use snapshots.\n");
+    }
+    // Quick find and prefix queries share the sorted arrays, built on first use.
+    if (book_enable_autocomplete(&book) != 0) {
+        printf("Ein: *Whines* I'm short on memory, so prefix searches will scan every contact.\n");
+    }
+    // Enabled after loading, so only this session's changes are recorded.
+    if (use_feed && book_enable_change_feed(&book, CHANGE_FEED_FILE_NAME) != 0) {
+        printf("Ein: *Whines* I can't open %s, so changes won't be recorded.\n",
+               CHANGE_FEED_FILE_NAME);
+    }
+    // Attached after the feed, so the feed's log (if any) is the one it opened above.
+    if (slots != NULL && slot_store_attach(slots, &book) != 0) {
+        printf("Ein: *Whines* I can't follow changes into %s, so I'll save to the CSV instead.\n",
+               SLOT_STORE_FILE_NAME);
+        slot_store_close(slots);
+        slots = NULL;
+    }
+    if (use_watch) {
+        watch = csv_watch_open("contacts.csv");
+        if (watch == NULL || csv_watch_reset(watch, &book) != 0) {
+            printf("Ein: *Whines* I can't keep an eye on contacts.csv, so I won't see other "
+                   "programs' changes.\n");
+            csv_watch_close(watch);
+            watch = NULL;
+        }
+    }
+    // Without the cache, queries simply run every time.
+    query_cache = query_cache_create(QUERY_CACHE_DEFAULT_ENTRIES, QUERY_CACHE_DEFAULT_CONTACTS);
+    if (query_cache != NULL && query_cache_attach(query_cache, &book) != 0) {
+        query_cache_free(query_cache);
+        query_cache = NULL;
+    }
 
     MenuOption menu_choice = 0;
 
@@ -50,9 +217,18 @@ int main(void) {
         printf("  %d. List all contacts\n", LIST);
         printf("  %d. Save contacts to file\n", SAVE);
         printf("  %d. Exit\n", EXIT);
+        printf("  %d. Advanced search (query)\n", QUERY);
+        printf("  %d. Quick find (autocomplete)\n", QUICK_FIND);
+        printf("  %d. Reports\n", REPORT);
+        printf("  %d. Find duplicates\n", DEDUPE);
+        printf("  %d. Tags\n", TAGS);
         printf("--------------------------------------------------------------------------------\n");
 
         menu_choice = get_int_input("Ein: What would you like to do?:  ");
+        // Pick up other programs' changes before acting, so a SAVE never overwrites them unseen.
+        if (watch != NULL) {
+            check_contacts_file(watch, &book);
+        }
         
         switch (menu_choice) {
             case CREATE:
@@ -61,6 +237,12 @@ int main(void) {
             case SEARCH:
                 search_contact(&book);
                 break;
+            case QUERY:
+                run_query(&book, query_cache);
+                break;
+            case QUICK_FIND:
+                run_autocomplete(&book);
+                break;
             case EDIT:
                 edit_contact(&book);
                 break;
@@ -70,9 +252,33 @@ int main(void) {
             case LIST:         
                 list_contacts(&book);
                 break;
+            case REPORT:
+                show_reports(&book);
+                break;
+            case DEDUPE:
+                show_duplicates(&book);
+                break;
+            case TAGS:
+                manage_tags(&book);
+                break;
             case SAVE:
                 printf("\nEin: Just finished storing everything securely. Woof!\n");
-                save_contacts_to_file(&book);
+                if (use_compressed) {
+                    save_contacts_to_compressed_file(&book);
+                }
+                else if (slots != NULL && slot_store_sync(slots) == 0) {
+                    printf("Ein: Every change is already in %s; I just made sure it's on disk.\n",
+                           SLOT_STORE_FILE_NAME);
+                }
+                else {
+                    save_contacts_to_file(&book);
+                    if (watch != NULL) {
+                        csv_watch_reset(watch, &book);
+                    }
+                }
+                if (save_tags(&book, TAGS_FILE_NAME) < 0) {
+                    printf("Ein: *Whines* I couldn't write %s.\n", TAGS_FILE_NAME);
+                }
                 break;
             case EXIT:
                 printf("\n<================================| EXIT |======================================>\n");
@@ -85,7 +291,12 @@ int main(void) {
         }
     } while (menu_choice != EXIT);
     
+    if (slots != NULL && slot_store_close(slots) != 0) {
+        printf("Ein: *Whines* Some changes may not have reached %s.\n", SLOT_STORE_FILE_NAME);
+    }
+    csv_watch_close(watch);
+    query_cache_free(query_cache);
     free_address_book(&book); // Free the memory allocated for the address book.
 
     return 0;
-}  
\ No newline at end of file
+}  
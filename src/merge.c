@@ -0,0 +1,884 @@
+/**
+ * @file merge.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the streaming merge: sort inputs by ID, merge them in one pass,
+ * then drop contacts whose phone or email collides.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "convert.h"
+#include "merge.h"
+
+#define MERGE_LINE_SIZE 256           // longer than any valid record line
+#define MERGE_STREAM_BUFFER (64 * 1024) // stdio buffer per input and output stream
+#define MERGE_COUNT_WIDTH 10            // count line is padded so it can be rewritten in place
+#define MERGE_KEY_PROBES 6              // bits per key in each bitset of the key filter
+
+enum { BASE, OURS, THEIRS, INPUT_COUNT };
+
+static const char *const side_names[INPUT_COUNT] = {"base", "ours", "theirs"};
+
+// ========================= Record Streams ========================= //
+
+/**
+ * @brief One input read a record at a time, in ID order.
+ */
+typedef struct {
+    const char *name;   // "base", "ours", "theirs", or the pass name for reports
+    FILE *file;
+    Contact current;
+    bool has_current;
+    size_t line_number;
+    int last_id;
+    bool by_id;         // skip records whose ID does not increase
+} RecordStream;
+
+static int stream_open(RecordStream *stream, const char *name, const char *path, bool by_id) {
+    stream->name = name;
+    stream->by_id = by_id;
+    stream->has_current = false;
+    stream->line_number = 0;
+    stream->last_id = 0;
+    stream->file = fopen(path, "rb");
+    if (stream->file == NULL) {
+        return -1;
+    }
+    setvbuf(stream->file, NULL, _IOFBF, MERGE_STREAM_BUFFER);
+    return 0;
+}
+
+static void stream_close(RecordStream *stream) {
+    if (stream->file != NULL) {
+        fclose(stream->file);
+        stream->file = NULL;
+    }
+}
+
+/**
+ * @brief Advances to the next valid record, skipping (and reporting) anything else.
+ * @return 0 on success (has_current is false at the end of the file), -1 on a read error.
+ */
+static int stream_next(RecordStream *stream, const MergeOptions *options, MergeStats *stats) {
+    char line[MERGE_LINE_SIZE];
+    stream->has_current = false;
+
+    while (fgets(line, sizeof(line), stream->file) != NULL) {
+        size_t length = strlen(line);
+        bool too_long = length == sizeof(line) - 1 && line[length - 1] != '\n';
+        if (too_long) {
+            int c;
+            while ((c = fgetc(stream->file)) != EOF && c != '\n') {
+            }
+        }
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+
+        stream->line_number++;
+        bool is_count_line = stream->line_number == 1 && strchr(line, ',') == NULL;
+        if (length == 0 || is_count_line) {
+            continue;
+        }
+
+        ValidationStatus status =
+            too_long ? INVALID_LENGTH : convert_parse_record(line, line + length, &stream->current);
+        if (status != VALID) {
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: Skipped line %zu of %s: %s.\n", stream->line_number,
+                        stream->name, convert_status_reason(status));
+            }
+            stats->invalid++;
+            continue;
+        }
+        if (stream->by_id && stream->current.id <= stream->last_id) {
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: Skipped a second contact with ID %d in %s.\n",
+                        stream->current.id, stream->name);
+            }
+            stats->invalid++;
+            continue;
+        }
+
+        stream->last_id = stream->current.id;
+        stream->has_current = true;
+        return 0;
+    }
+    return ferror(stream->file) ? -1 : 0;
+}
+
+static int write_record(FILE *file, const Contact *contact) {
+    return fprintf(file, "%d,%s,%s,%s\n", contact->id, contact->name, contact->phone,
+                   contact->email) < 0 ? -1 : 0;
+}
+
+static void report_record(FILE *report, const char *label, const Contact *contact) {
+    if (contact == NULL) {
+        fprintf(report, "    %-7s (deleted)\n", label);
+    }
+    else {
+        fprintf(report, "    %-7s %d,%s,%s,%s\n", label, contact->id, contact->name,
+                contact->phone, contact->email);
+    }
+}
+
+// ========================= Sorting ========================= //
+
+/**
+ * @brief Checks whether a file's records are in strictly increasing ID order.
+ * @return 1 if they are, 0 if not, -1 if the file could not be read.
+ */
+static int is_sorted_by_id(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    setvbuf(file, NULL, _IOFBF, MERGE_STREAM_BUFFER);
+
+    char line[MERGE_LINE_SIZE];
+    bool line_start = true;
+    bool first_line = true;
+    long last_id = 0;
+    int sorted = 1;
+    while (sorted && fgets(line, sizeof(line), file) != NULL) {
+        bool starts_record = line_start && !(first_line && strchr(line, ',') == NULL);
+        line_start = strchr(line, '\n') != NULL;
+        first_line = false;
+        if (starts_record) {
+            char *end;
+            long id = strtol(line, &end, 10);
+            // Malformed lines do not decide the order; the merge skips them anyway.
+            if (end != line && *end == ',') {
+                sorted = id > last_id;
+                last_id = id;
+            }
+        }
+    }
+    if (ferror(file)) {
+        sorted = -1;
+    }
+    fclose(file);
+    return sorted;
+}
+
+/**
+ * @brief Sorts a file with the converter's external sort; invalid records count as skipped.
+ */
+static int sort_file(const char *input_path, const char *output_path, ConvertSort sort,
+                     const MergeOptions *options, MergeStats *stats) {
+    ConvertOptions convert;
+    convert_default_options(&convert);
+    convert.sort = sort;
+    convert.memory_limit = options->memory_limit;
+    convert.report = options->report;
+
+    ConvertStats sorted;
+    if (convert_contacts(input_path, output_path, &convert, &sorted) != 0) {
+        return -1;
+    }
+    stats->records_written = sorted.records_written;
+    stats->invalid += sorted.records_invalid;
+    return 0;
+}
+
+// ========================= Three-Way Merge ========================= //
+
+static bool same_contact(const Contact *left, const Contact *right) {
+    if (left == NULL || right == NULL) {
+        return left == right;
+    }
+    return strcmp(left->name, right->name) == 0 && strcmp(left->phone, right->phone) == 0 &&
+           strcmp(left->email, right->email) == 0;
+}
+
+/**
+ * @brief Merges one field edited on both sides.
+ * @return true if both sides changed it to different values.
+ */
+static bool merge_field(char *result, const char *base, const char *ours, const char *theirs,
+                        MergePreference prefer, bool *took_ours, bool *took_theirs) {
+    bool ours_changed = strcmp(ours, base) != 0;
+    bool theirs_changed = strcmp(theirs, base) != 0;
+
+    if (ours_changed && theirs_changed && strcmp(ours, theirs) != 0) {
+        strcpy(result, prefer == MERGE_PREFER_OURS ? ours : theirs);
+        return true;
+    }
+    if (theirs_changed && !ours_changed) {
+        strcpy(result, theirs);
+        *took_theirs = true;
+    }
+    else {
+        strcpy(result, ours);
+        *took_ours = *took_ours || (ours_changed && !theirs_changed);
+    }
+    return false;
+}
+
+/**
+ * @brief Decides the merged version of one ID.
+ * @param record Storage for a field-by-field merge.
+ * @param conflict Output: a description of the conflict, or NULL if there was none.
+ * @return The contact to keep, or NULL if the ID is deleted.
+ */
+static const Contact *merge_one(const Contact *base, const Contact *ours, const Contact *theirs,
+                                bool three_way, const MergeOptions *options, MergeStats *stats,
+                                Contact *record, const char **conflict) {
+    const Contact *preferred = options->prefer == MERGE_PREFER_OURS ? ours : theirs;
+    *conflict = NULL;
+
+    if (same_contact(ours, theirs)) {
+        if (ours == NULL) {
+            stats->deleted++;
+        }
+        return ours;
+    }
+    if (!three_way || base == NULL) {
+        // Without a common ancestor, a contact on one side only is an addition.
+        if (ours == NULL || theirs == NULL) {
+            if (ours != NULL) {
+                stats->from_ours++;
+                return ours;
+            }
+            stats->from_theirs++;
+            return theirs;
+        }
+        *conflict = three_way ? "added on both sides as different contacts"
+                              : "different in the two books";
+        return preferred;
+    }
+
+    if (same_contact(ours, base) || same_contact(theirs, base)) {
+        const Contact *changed = same_contact(ours, base) ? theirs : ours;
+        if (changed == NULL) {
+            stats->deleted++;
+        }
+        else if (changed == ours) {
+            stats->from_ours++;
+        }
+        else {
+            stats->from_theirs++;
+        }
+        return changed;
+    }
+    if (ours == NULL || theirs == NULL) {
+        *conflict = ours == NULL ? "deleted in ours, edited in theirs"
+                                 : "edited in ours, deleted in theirs";
+        if (preferred == NULL) {
+            stats->deleted++;
+        }
+        return preferred;
+    }
+
+    // Both sides edited it: merge field by field.
+    bool took_ours = false;
+    bool took_theirs = false;
+    bool clash = false;
+    *record = *ours;
+    clash |= merge_field(record->name, base->name, ours->name, theirs->name, options->prefer,
+                         &took_ours, &took_theirs);
+    clash |= merge_field(record->phone, base->phone, ours->phone, theirs->phone, options->prefer,
+                         &took_ours, &took_theirs);
+    clash |= merge_field(record->email, base->email, ours->email, theirs->email, options->prefer,
+                         &took_ours, &took_theirs);
+    if (clash) {
+        *conflict = "the same field edited differently on both sides";
+    }
+    stats->from_ours += took_ours;
+    stats->from_theirs += took_theirs;
+    return record;
+}
+
+// ========================= Key Filter ========================= //
+
+enum { KEY_PHONE, KEY_EMAIL, KEY_COUNT };
+
+static const char *const key_names[KEY_COUNT] = {"phone", "email"};
+
+/**
+ * @brief The merged phones and emails in two Bloom filters per key: seen, and seen again. A
+ * value goes into "again" when "seen" already held it, so a value that is not in "again" is
+ * certainly unique, and only records whose phone or email is (suspects) can share it with
+ * another contact.
+ */
+typedef struct {
+    uint64_t *seen[KEY_COUNT];
+    uint64_t *again[KEY_COUNT];
+    uint64_t mask;   // bits per bitset - 1
+    bool repeated;   // some hash was seen again
+} KeyFilter;
+
+static uint64_t key_hash(const char *key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char *c = (const unsigned char *)key; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static const char *contact_key(const Contact *contact, int key) {
+    return key == KEY_PHONE ? contact->phone : contact->email;
+}
+
+static void key_filter_free(KeyFilter *filter) {
+    for (int key = 0; key < KEY_COUNT; key++) {
+        free(filter->seen[key]);
+        free(filter->again[key]);
+    }
+}
+
+/**
+ * @brief Sizes the bitsets to half the memory limit, leaving the other half for suspects.
+ * @return 0 on success, -1 if memory ran out.
+ */
+static int key_filter_init(KeyFilter *filter, size_t memory_limit) {
+    size_t words = 1;
+    while (words * 2 * sizeof(uint64_t) * 2 * KEY_COUNT <= memory_limit / 2) {
+        words *= 2;
+    }
+    filter->mask = (uint64_t)words * 64 - 1;
+    filter->repeated = false;
+    int status = 0;
+    for (int key = 0; key < KEY_COUNT; key++) {
+        filter->seen[key] = calloc(words, sizeof(uint64_t));
+        filter->again[key] = calloc(words, sizeof(uint64_t));
+        if (filter->seen[key] == NULL || filter->again[key] == NULL) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief The bits a value sets, by double hashing.
+ */
+static void key_probes(const KeyFilter *filter, const char *value, uint64_t bits[]) {
+    uint64_t hash = key_hash(value);
+    uint64_t step = (hash >> 32) | 1;
+    for (int i = 0; i < MERGE_KEY_PROBES; i++) {
+        bits[i] = (hash + (uint64_t)i * step) & filter->mask;
+    }
+}
+
+static bool bloom_holds(const uint64_t *bitset, const uint64_t bits[]) {
+    for (int i = 0; i < MERGE_KEY_PROBES; i++) {
+        if (!(bitset[bits[i] / 64] & (1ull << (bits[i] % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void bloom_set(uint64_t *bitset, const uint64_t bits[]) {
+    for (int i = 0; i < MERGE_KEY_PROBES; i++) {
+        bitset[bits[i] / 64] |= 1ull << (bits[i] % 64);
+    }
+}
+
+static void key_filter_add(KeyFilter *filter, const Contact *contact) {
+    uint64_t bits[MERGE_KEY_PROBES];
+    for (int key = 0; key < KEY_COUNT; key++) {
+        key_probes(filter, contact_key(contact, key), bits);
+        if (bloom_holds(filter->seen[key], bits)) {
+            bloom_set(filter->again[key], bits);
+            filter->repeated = true;
+        }
+        else {
+            bloom_set(filter->seen[key], bits);
+        }
+    }
+}
+
+static bool key_filter_suspect(const KeyFilter *filter, const Contact *contact) {
+    uint64_t bits[MERGE_KEY_PROBES];
+    for (int key = 0; key < KEY_COUNT; key++) {
+        key_probes(filter, contact_key(contact, key), bits);
+        if (bloom_holds(filter->again[key], bits)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Walks the ID-sorted inputs together and writes the merged records to @p output,
+ * adding each one's phone and email to @p filter.
+ */
+static int merge_by_id(RecordStream streams[INPUT_COUNT], bool three_way, FILE *output,
+                       KeyFilter *filter, const MergeOptions *options, MergeStats *stats) {
+    for (int i = three_way ? BASE : OURS; i < INPUT_COUNT; i++) {
+        if (stream_next(&streams[i], options, stats) != 0) {
+            return -1;
+        }
+    }
+
+    for (;;) {
+        int id = 0;
+        for (int i = three_way ? BASE : OURS; i < INPUT_COUNT; i++) {
+            if (streams[i].has_current && (id == 0 || streams[i].current.id < id)) {
+                id = streams[i].current.id;
+            }
+        }
+        if (id == 0) {
+            return 0;
+        }
+
+        const Contact *side[INPUT_COUNT] = {NULL, NULL, NULL};
+        for (int i = three_way ? BASE : OURS; i < INPUT_COUNT; i++) {
+            if (streams[i].has_current && streams[i].current.id == id) {
+                side[i] = &streams[i].current;
+            }
+        }
+
+        Contact record;
+        const char *conflict;
+        const Contact *result = merge_one(side[BASE], side[OURS], side[THEIRS], three_way,
+                                          options, stats, &record, &conflict);
+        if (conflict != NULL) {
+            stats->conflicts++;
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: Conflict on ID %d (%s); kept %s.\n", id, conflict,
+                        side_names[options->prefer == MERGE_PREFER_OURS ? OURS : THEIRS]);
+                for (int i = three_way ? BASE : OURS; i < INPUT_COUNT; i++) {
+                    report_record(options->report, side_names[i], side[i]);
+                }
+                report_record(options->report, "result", result);
+            }
+        }
+        if (result != NULL) {
+            if (write_record(output, result) != 0) {
+                return -1;
+            }
+            key_filter_add(filter, result);
+            stats->records_written++;
+        }
+
+        // Advance only after writing: result may point into a stream's current record.
+        for (int i = three_way ? BASE : OURS; i < INPUT_COUNT; i++) {
+            if (side[i] != NULL && stream_next(&streams[i], options, stats) != 0) {
+                return -1;
+            }
+        }
+    }
+}
+
+// ========================= Key Collisions ========================= //
+
+/**
+ * @brief A merged record whose phone or email hash repeats.
+ */
+typedef struct {
+    Contact contact;
+    bool dropped;
+} Suspect;
+
+static int compare_suspect_ids(const void *a, const void *b) {
+    const Suspect *left = a;
+    const Suspect *right = b;
+    return (left->contact.id > right->contact.id) - (left->contact.id < right->contact.id);
+}
+
+static int compare_suspect_phones(const void *a, const void *b) {
+    int order = strcmp(((const Suspect *)a)->contact.phone, ((const Suspect *)b)->contact.phone);
+    return order != 0 ? order : compare_suspect_ids(a, b);
+}
+
+static int compare_suspect_emails(const void *a, const void *b) {
+    int order = strcmp(((const Suspect *)a)->contact.email, ((const Suspect *)b)->contact.email);
+    return order != 0 ? order : compare_suspect_ids(a, b);
+}
+
+/**
+ * @brief Sorts the suspects by one key and, among those still kept, drops every contact whose
+ * key an earlier (lower) ID already uses.
+ */
+static void drop_suspect_duplicates(Suspect *suspects, size_t count, int key,
+                                    const MergeOptions *options, MergeStats *stats) {
+    qsort(suspects, count, sizeof(Suspect),
+          key == KEY_PHONE ? compare_suspect_phones : compare_suspect_emails);
+    const Contact *kept = NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (suspects[i].dropped) {
+            continue;
+        }
+        const Contact *contact = &suspects[i].contact;
+        if (kept != NULL && strcmp(contact_key(kept, key), contact_key(contact, key)) == 0) {
+            suspects[i].dropped = true;
+            stats->duplicates++;
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: Dropped ID %d: its %s is already used by ID %d.\n",
+                        contact->id, key_names[key], kept->id);
+                report_record(options->report, "dropped", contact);
+            }
+            continue;
+        }
+        kept = contact;
+    }
+}
+
+/**
+ * @brief Collects the suspects from the merged file, finds the real collisions among them in
+ * memory, and copies the merged file to @p output_path without the dropped contacts.
+ * @return 0 on success, 1 if the suspects do not fit in half the memory limit (nothing was
+ * written), -1 on a read or write error.
+ */
+static int drop_suspect_keys(const char *merged_path, const char *output_path,
+                             const KeyFilter *filter, const MergeOptions *options,
+                             MergeStats *stats) {
+    size_t limit = options->memory_limit / 2 / sizeof(Suspect);
+    size_t count = 0;
+    size_t capacity = 0;
+    Suspect *suspects = NULL;
+    RecordStream stream;
+    if (stream_open(&stream, "merged", merged_path, false) != 0) {
+        return -1;
+    }
+
+    int status;
+    while ((status = stream_next(&stream, options, stats)) == 0 && stream.has_current) {
+        if (!key_filter_suspect(filter, &stream.current)) {
+            continue;
+        }
+        if (count == capacity) {
+            size_t grown = capacity == 0 ? 256 : capacity * 2;
+            grown = grown < limit ? grown : limit;
+            Suspect *larger = count < limit ? realloc(suspects, sizeof(Suspect) * grown) : NULL;
+            if (larger == NULL) {
+                status = 1;
+                break;
+            }
+            suspects = larger;
+            capacity = grown;
+        }
+        suspects[count].contact = stream.current;
+        suspects[count++].dropped = false;
+    }
+    stream_close(&stream);
+    if (status != 0) {
+        free(suspects);
+        return status;
+    }
+
+    // Same order as the external passes: phone collisions first, then email among the kept.
+    drop_suspect_duplicates(suspects, count, KEY_PHONE, options, stats);
+    drop_suspect_duplicates(suspects, count, KEY_EMAIL, options, stats);
+    qsort(suspects, count, sizeof(Suspect), compare_suspect_ids);
+
+    FILE *output = fopen(output_path, "wb");
+    if (output == NULL || stream_open(&stream, "merged", merged_path, false) != 0) {
+        if (output != NULL) {
+            fclose(output);
+        }
+        free(suspects);
+        return -1;
+    }
+    setvbuf(output, NULL, _IOFBF, MERGE_STREAM_BUFFER);
+    fprintf(output, "%*d\n", MERGE_COUNT_WIDTH, 0);
+
+    // Both are in ID order, so one cursor over the suspects finds the dropped records.
+    size_t next = 0;
+    size_t written = 0;
+    while ((status = stream_next(&stream, options, stats)) == 0 && stream.has_current) {
+        while (next < count && suspects[next].contact.id < stream.current.id) {
+            next++;
+        }
+        if (next < count && suspects[next].contact.id == stream.current.id &&
+            suspects[next].dropped) {
+            continue;
+        }
+        if (write_record(output, &stream.current) != 0) {
+            status = -1;
+            break;
+        }
+        written++;
+    }
+    stream_close(&stream);
+    free(suspects);
+
+    bool counted = fseek(output, 0, SEEK_SET) == 0 &&
+                   fprintf(output, "%*zu", MERGE_COUNT_WIDTH, written) == MERGE_COUNT_WIDTH;
+    if (status == 0 && !counted) {
+        status = -1;
+    }
+    if (fclose(output) != 0) {
+        status = -1;
+    }
+    stats->records_written = written;
+    return status;
+}
+
+static bool same_key(const Contact *left, const Contact *right, ConvertSort sort) {
+    if (sort == CONVERT_SORT_PHONE) {
+        return strcmp(left->phone, right->phone) == 0;
+    }
+    return strcmp(left->email, right->email) == 0;
+}
+
+/**
+ * @brief Streams a file sorted by phone or email (then ID), keeping only the lowest ID of each
+ * key, and writes the survivors to @p output_path. Used when there are too many suspects to
+ * resolve in memory.
+ */
+static int drop_duplicate_keys(const char *input_path, const char *output_path, ConvertSort sort,
+                               const MergeOptions *options, MergeStats *stats) {
+    const char *field = sort == CONVERT_SORT_PHONE ? "phone" : "email";
+    RecordStream stream;
+    if (stream_open(&stream, field, input_path, false) != 0) {
+        return -1;
+    }
+    FILE *output = fopen(output_path, "wb");
+    if (output == NULL) {
+        stream_close(&stream);
+        return -1;
+    }
+    setvbuf(output, NULL, _IOFBF, MERGE_STREAM_BUFFER);
+
+    int status = 0;
+    bool has_kept = false;
+    Contact kept;
+    while ((status = stream_next(&stream, options, stats)) == 0 && stream.has_current) {
+        if (has_kept && same_key(&kept, &stream.current, sort)) {
+            stats->duplicates++;
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: Dropped ID %d: its %s is already used by ID %d.\n",
+                        stream.current.id, field, kept.id);
+                report_record(options->report, "dropped", &stream.current);
+            }
+            continue;
+        }
+        kept = stream.current;
+        has_kept = true;
+        if (write_record(output, &kept) != 0) {
+            status = -1;
+            break;
+        }
+    }
+
+    stream_close(&stream);
+    if (fclose(output) != 0) {
+        status = -1;
+    }
+    return status;
+}
+
+// ========================= Merge ========================= //
+
+void merge_default_options(MergeOptions *options) {
+    options->prefer = MERGE_PREFER_OURS;
+    options->memory_limit = CONVERT_DEFAULT_MEMORY;
+    options->report = stdout;
+}
+
+static char *temp_path(const char *output_path, const char *tag) {
+    size_t size = strlen(output_path) + strlen(tag) + sizeof(".merge-.tmp");
+    char *path = malloc(size);
+    if (path != NULL) {
+        snprintf(path, size, "%s.merge-%s.tmp", output_path, tag);
+    }
+    return path;
+}
+
+int merge_books(const char *base_path, const char *ours_path, const char *theirs_path,
+                const char *output_path, const MergeOptions *options, MergeStats *stats) {
+    MergeStats ignored;
+    if (stats == NULL) {
+        stats = &ignored;
+    }
+    memset(stats, 0, sizeof(MergeStats));
+
+    bool three_way = base_path != NULL;
+    const char *paths[INPUT_COUNT] = {base_path, ours_path, theirs_path};
+    char *sorted_paths[INPUT_COUNT] = {NULL, NULL, NULL};
+    char *merged_path = temp_path(output_path, "merged");
+    char *keyed_path = temp_path(output_path, "keyed");
+    KeyFilter filter;
+    bool ok = key_filter_init(&filter, options->memory_limit) == 0 && merged_path != NULL &&
+              keyed_path != NULL;
+
+    // Inputs already in ID order (the usual case for saved books) are read in place.
+    for (int i = three_way ? BASE : OURS; ok && i < INPUT_COUNT; i++) {
+        int sorted = is_sorted_by_id(paths[i]);
+        ok = sorted >= 0;
+        if (ok && sorted == 0) {
+            if (options->report != NULL) {
+                fprintf(options->report, "Ein: %s ('%s') is not in ID order; sorting it first.\n",
+                        side_names[i], paths[i]);
+            }
+            sorted_paths[i] = temp_path(output_path, side_names[i]);
+            ok = sorted_paths[i] != NULL &&
+                 sort_file(paths[i], sorted_paths[i], CONVERT_SORT_ID, options, stats) == 0;
+            paths[i] = sorted_paths[i];
+        }
+    }
+
+    if (ok) {
+        RecordStream streams[INPUT_COUNT] = {{0}};
+        for (int i = three_way ? BASE : OURS; ok && i < INPUT_COUNT; i++) {
+            ok = stream_open(&streams[i], side_names[i], paths[i], true) == 0;
+        }
+        FILE *merged = ok ? fopen(merged_path, "wb") : NULL;
+        if (merged != NULL) {
+            setvbuf(merged, NULL, _IOFBF, MERGE_STREAM_BUFFER);
+            fprintf(merged, "%*d\n", MERGE_COUNT_WIDTH, 0);
+            ok = merge_by_id(streams, three_way, merged, &filter, options, stats) == 0 &&
+                 fseek(merged, 0, SEEK_SET) == 0 &&
+                 fprintf(merged, "%*zu", MERGE_COUNT_WIDTH, stats->records_written) ==
+                     MERGE_COUNT_WIDTH;
+            ok = fclose(merged) == 0 && ok;
+        }
+        else {
+            ok = false;
+        }
+        for (int i = 0; i < INPUT_COUNT; i++) {
+            stream_close(&streams[i]);
+        }
+    }
+
+    // Different contacts may now share a phone or email; keep the oldest of each. Usually no
+    // hash repeats and the merged file is already the result; otherwise the suspects are
+    // checked in memory, and only if there are too many does it take external sorts.
+    int resolved = 1;
+    if (ok && !filter.repeated) {
+        ok = rename(merged_path, output_path) == 0;
+        resolved = 0;
+    }
+    else if (ok) {
+        resolved = drop_suspect_keys(merged_path, output_path, &filter, options, stats);
+        ok = resolved >= 0;
+    }
+    if (ok && resolved == 1) {
+        ok = sort_file(merged_path, keyed_path, CONVERT_SORT_PHONE, options, stats) == 0 &&
+             drop_duplicate_keys(keyed_path, merged_path, CONVERT_SORT_PHONE, options, stats) == 0 &&
+             sort_file(merged_path, keyed_path, CONVERT_SORT_EMAIL, options, stats) == 0 &&
+             drop_duplicate_keys(keyed_path, merged_path, CONVERT_SORT_EMAIL, options, stats) == 0 &&
+             sort_file(merged_path, output_path, CONVERT_SORT_ID, options, stats) == 0;
+    }
+    key_filter_free(&filter);
+
+    for (int i = 0; i < INPUT_COUNT; i++) {
+        if (sorted_paths[i] != NULL) {
+            remove(sorted_paths[i]);
+            free(sorted_paths[i]);
+        }
+    }
+    if (merged_path != NULL) {
+        remove(merged_path);
+    }
+    if (keyed_path != NULL) {
+        remove(keyed_path);
+    }
+    free(merged_path);
+    free(keyed_path);
+    return ok ? 0 : -1;
+}
+
+// ========================= Command Line ========================= //
+
+static void print_merge_usage(void) {
+    printf("Usage: addressbook merge [options] <ours.csv> <theirs.csv> <output.csv>\n");
+    printf("  --base <base.csv>       Common ancestor, for a three-way merge\n");
+    printf("  --prefer ours|theirs    Side kept when changes conflict (default: ours)\n");
+    printf("  --memory <MB>           Memory limit of each external sort (default: %d MB)\n",
+           CONVERT_DEFAULT_MEMORY / (1024 * 1024));
+    printf("  --report <file>         Write the conflict report to a file instead of the screen\n");
+}
+
+static double elapsed_seconds(const struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int run_merge_command(int argc, char *argv[]) {
+    MergeOptions options;
+    merge_default_options(&options);
+    const char *base_path = NULL;
+    const char *report_path = NULL;
+    const char *files[3];
+    int file_count = 0;
+
+    for (int i = 0; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool known = true;
+
+        if (strncmp(argv[i], "--", 2) != 0) {
+            known = file_count < 3;
+            if (known) {
+                files[file_count++] = argv[i];
+            }
+        }
+        else if (value != NULL && strcmp(argv[i], "--base") == 0) {
+            base_path = value;
+            i++;
+        }
+        else if (value != NULL && strcmp(argv[i], "--prefer") == 0) {
+            known = strcmp(value, "ours") == 0 || strcmp(value, "theirs") == 0;
+            options.prefer = strcmp(value, "theirs") == 0 ? MERGE_PREFER_THEIRS : MERGE_PREFER_OURS;
+            i++;
+        }
+        else if (value != NULL && strcmp(argv[i], "--memory") == 0 && atoi(value) > 0) {
+            options.memory_limit = (size_t)atoi(value) * 1024 * 1024;
+            i++;
+        }
+        else if (value != NULL && strcmp(argv[i], "--report") == 0) {
+            report_path = value;
+            i++;
+        }
+        else {
+            known = false;
+        }
+
+        if (!known) {
+            print_merge_usage();
+            return 1;
+        }
+    }
+    if (file_count != 3) {
+        print_merge_usage();
+        return 1;
+    }
+
+    if (report_path != NULL) {
+        options.report = fopen(report_path, "w");
+        if (options.report == NULL) {
+            printf("Ein: *Whines* I can't write the report to '%s'.\n", report_path);
+            return 1;
+        }
+    }
+
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    MergeStats stats;
+    int status = merge_books(base_path, files[0], files[1], files[2], &options, &stats);
+    if (report_path != NULL) {
+        fclose(options.report);
+    }
+    if (status != 0) {
+        printf("Ein: *Whines* The merge failed: check that every input exists, '%s' is writable,\n",
+               files[2]);
+        printf("Ein: and that the memory limit is at least %d KB.\n", CONVERT_MIN_MEMORY / 1024);
+        return 1;
+    }
+
+    printf("Ein: Merged %zu contact(s) into '%s' in %.2fs (%zu change(s) from ours, %zu from "
+           "theirs, %zu deleted, %zu invalid skipped).\n",
+           stats.records_written, files[2], elapsed_seconds(&start), stats.from_ours,
+           stats.from_theirs, stats.deleted, stats.invalid);
+    if (stats.conflicts > 0 || stats.duplicates > 0) {
+        printf("Ein: %zu conflict(s) and %zu duplicate phone/email contact(s) need a look; "
+               "see the report%s%s.\n",
+               stats.conflicts, stats.duplicates, report_path != NULL ? " in " : " above",
+               report_path != NULL ? report_path : "");
+        return 1;
+    }
+    printf("Ein: Clean merge. Woof!\n");
+    return 0;
+}
@@ -0,0 +1,1200 @@
+/**
+ * @file page_store.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the paged store: buffer pool, B+trees, and the pages subcommand.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // pread, pwrite, fsync
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "page_store.h"
+
+#define PAGE_STORE_MAGIC "ABPAGES1"
+#define PAGE_HEADER_SIZE 16
+#define PAGE_NONE 0 // Page 0 is the file header, so it is never a tree page.
+#define ID_SIZE 4
+#define RECORD_SIZE (MAX_NAME_LENGTH + MAX_PHONE_LENGTH + MAX_EMAIL_LENGTH)
+#define MAX_KEY_SIZE (MAX_EMAIL_LENGTH + ID_SIZE)
+
+/**
+ * @brief Kinds of tree page.
+ */
+enum { PAGE_LEAF = 1, PAGE_INTERNAL = 2 };
+
+/**
+ * @brief The trees of a store, in the order their roots are kept in the file header.
+ */
+enum { TREE_PRIMARY, TREE_NAME, TREE_PHONE, TREE_EMAIL, TREE_COUNT };
+
+/**
+ * @brief Width of the field part of each secondary key (the primary key is just the ID).
+ */
+static const size_t FIELD_WIDTHS[TREE_COUNT] = {0, MAX_NAME_LENGTH, MAX_PHONE_LENGTH,
+                                                MAX_EMAIL_LENGTH};
+
+/**
+ * @brief Bytes stored beside each leaf key: the record in the primary tree, nothing elsewhere.
+ */
+static const size_t VALUE_SIZES[TREE_COUNT] = {RECORD_SIZE, 0, 0, 0};
+
+/**
+ * @brief One buffer pool frame.
+ */
+typedef struct {
+    uint32_t page_no;    /**< Page held, or PAGE_NONE for an empty frame. */
+    int pins;            /**< Users currently holding the page. */
+    bool dirty;          /**< Whether the page must be written back. */
+    bool referenced;     /**< CLOCK bit: set on use, cleared as the hand passes. */
+    int chain;           /**< Next frame in the same hash bucket, or -1. */
+    unsigned char *data; /**< PAGE_SIZE bytes. */
+} Frame;
+
+struct PageStore {
+    int fd;                   /**< The data file. */
+    Frame *frames;            /**< The buffer pool. */
+    size_t frame_count;       /**< Number of frames. */
+    unsigned char *memory;    /**< Page memory of every frame, in one block. */
+    int *buckets;             /**< Page number hash to first frame, or -1. */
+    size_t bucket_mask;       /**< Number of buckets minus one. */
+    size_t hand;              /**< CLOCK hand. */
+    uint32_t page_count;      /**< Pages in the file, including the header. */
+    uint32_t next_id;         /**< Next ID handed out by page_store_add. */
+    uint32_t contact_count;   /**< Contacts stored. */
+    uint32_t roots[TREE_COUNT]; /**< Root page of each tree, or PAGE_NONE while empty. */
+    PageStoreStats counters;  /**< Hits, misses, evictions, and writes. */
+};
+
+/**
+ * @brief A position in a tree's leaf chain.
+ */
+typedef struct {
+    PageStore *store;
+    int tree;
+    uint32_t page;
+    unsigned int index;
+} Cursor;
+
+// ========================= Encoding ========================= //
+
+static void put_u32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char *in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+/**
+ * @brief Writes an ID big-endian, so byte order of keys matches numeric order.
+ */
+static void encode_id(unsigned char *out, int id) {
+    for (int i = 0; i < ID_SIZE; i++) {
+        out[i] = (unsigned char)((uint32_t)id >> (8 * (ID_SIZE - 1 - i)));
+    }
+}
+
+static int decode_id(const unsigned char *in) {
+    uint32_t id = 0;
+    for (int i = 0; i < ID_SIZE; i++) {
+        id = (id << 8) | in[i];
+    }
+    return (int)id;
+}
+
+static size_t key_size(int tree) {
+    return FIELD_WIDTHS[tree] + ID_SIZE;
+}
+
+/**
+ * @brief The key of a contact in a tree: the folded, zero-padded field (if any), then the ID.
+ */
+static void make_key(unsigned char *key, int tree, const Contact *contact) {
+    size_t width = FIELD_WIDTHS[tree];
+    if (tree != TREE_PRIMARY) {
+        const char *value = tree == TREE_NAME ? contact->name
+                            : tree == TREE_PHONE ? contact->phone
+                            : contact->email;
+        memset(key, 0, width);
+        for (size_t i = 0; i + 1 < width && value[i] != '\0'; i++) {
+            key[i] = (unsigned char)tolower((unsigned char)value[i]);
+        }
+    }
+    encode_id(key + width, contact->id);
+}
+
+/**
+ * @brief Copies a string into a fixed-size field, truncating it and always terminating it.
+ */
+static void copy_field(char *dest, const char *src, size_t size) {
+    size_t length = strnlen(src, size - 1);
+    memcpy(dest, src, length);
+    dest[length] = '\0';
+}
+
+static void encode_record(unsigned char *value, const Contact *contact) {
+    memset(value, 0, RECORD_SIZE);
+    copy_field((char *)value, contact->name, MAX_NAME_LENGTH);
+    copy_field((char *)value + MAX_NAME_LENGTH, contact->phone, MAX_PHONE_LENGTH);
+    copy_field((char *)value + MAX_NAME_LENGTH + MAX_PHONE_LENGTH, contact->email,
+               MAX_EMAIL_LENGTH);
+}
+
+static void decode_record(const unsigned char *key, const unsigned char *value, Contact *contact) {
+    contact->id = decode_id(key);
+    memcpy(contact->name, value, MAX_NAME_LENGTH);
+    memcpy(contact->phone, value + MAX_NAME_LENGTH, MAX_PHONE_LENGTH);
+    memcpy(contact->email, value + MAX_NAME_LENGTH + MAX_PHONE_LENGTH, MAX_EMAIL_LENGTH);
+    contact->next = NULL;
+}
+
+// ========================= Buffer Pool ========================= //
+
+static size_t bucket_of(const PageStore *store, uint32_t page_no) {
+    return (page_no * 2654435761u) & store->bucket_mask;
+}
+
+static Frame *pool_lookup(PageStore *store, uint32_t page_no) {
+    for (int i = store->buckets[bucket_of(store, page_no)]; i >= 0; i = store->frames[i].chain) {
+        if (store->frames[i].page_no == page_no) {
+            return &store->frames[i];
+        }
+    }
+    return NULL;
+}
+
+static void pool_unlink(PageStore *store, Frame *frame) {
+    int *link = &store->buckets[bucket_of(store, frame->page_no)];
+    int index = (int)(frame - store->frames);
+    while (*link != index) {
+        link = &store->frames[*link].chain;
+    }
+    *link = frame->chain;
+    frame->page_no = PAGE_NONE;
+}
+
+static int pool_write(PageStore *store, Frame *frame) {
+    if (!frame->dirty) {
+        return 0;
+    }
+    if (pwrite(store->fd, frame->data, PAGE_SIZE, (off_t)frame->page_no * PAGE_SIZE) != PAGE_SIZE) {
+        return -1;
+    }
+    frame->dirty = false;
+    store->counters.writes++;
+    return 0;
+}
+
+/**
+ * @brief Picks a frame to reuse with CLOCK: unpinned frames get a second chance if they were
+ * used since the hand last passed. The victim is written back and unlinked.
+ * @return The frame, or NULL if every frame is pinned or the write-back failed.
+ */
+static Frame *pool_victim(PageStore *store) {
+    for (size_t step = 0; step < 2 * store->frame_count + 1; step++) {
+        Frame *frame = &store->frames[store->hand];
+        store->hand = (store->hand + 1) % store->frame_count;
+
+        if (frame->pins > 0) {
+            continue;
+        }
+        if (frame->page_no != PAGE_NONE && frame->referenced) {
+            frame->referenced = false;
+            continue;
+        }
+        if (frame->page_no != PAGE_NONE) {
+            if (pool_write(store, frame) != 0) {
+                return NULL;
+            }
+            pool_unlink(store, frame);
+            store->counters.evictions++;
+        }
+        return frame;
+    }
+    return NULL;
+}
+
+static void pool_install(PageStore *store, Frame *frame, uint32_t page_no) {
+    size_t bucket = bucket_of(store, page_no);
+    frame->page_no = page_no;
+    frame->chain = store->buckets[bucket];
+    store->buckets[bucket] = (int)(frame - store->frames);
+    frame->pins = 1;
+    frame->referenced = true;
+    frame->dirty = false;
+}
+
+/**
+ * @brief Pins a page in the pool, reading it from the file if needed.
+ * @return The page bytes (release with page_release), or NULL on an I/O error.
+ */
+static unsigned char *page_fetch(PageStore *store, uint32_t page_no) {
+    Frame *frame = pool_lookup(store, page_no);
+    if (frame != NULL) {
+        store->counters.hits++;
+        frame->pins++;
+        frame->referenced = true;
+        return frame->data;
+    }
+
+    frame = pool_victim(store);
+    if (frame == NULL) {
+        return NULL;
+    }
+    if (pread(store->fd, frame->data, PAGE_SIZE, (off_t)page_no * PAGE_SIZE) != PAGE_SIZE) {
+        return NULL;
+    }
+    store->counters.misses++;
+    pool_install(store, frame, page_no);
+    return frame->data;
+}
+
+/**
+ * @brief Appends a new, empty tree page to the file and pins it.
+ * @return The page bytes, or NULL if no frame could be freed.
+ */
+static unsigned char *page_new(PageStore *store, int type, uint32_t *page_no) {
+    Frame *frame = pool_victim(store);
+    if (frame == NULL) {
+        return NULL;
+    }
+    *page_no = store->page_count++;
+    pool_install(store, frame, *page_no);
+    frame->dirty = true;
+
+    memset(frame->data, 0, PAGE_SIZE);
+    frame->data[0] = (unsigned char)type;
+    return frame->data;
+}
+
+static void page_release(PageStore *store, unsigned char *data, bool dirty) {
+    Frame *frame = &store->frames[(size_t)(data - store->memory) / PAGE_SIZE];
+    frame->pins--;
+    frame->dirty = frame->dirty || dirty;
+}
+
+// ========================= Tree Pages ========================= //
+
+static bool page_is_leaf(const unsigned char *page) {
+    return page[0] == PAGE_LEAF;
+}
+
+static unsigned int page_entries(const unsigned char *page) {
+    return (unsigned int)page[2] | (unsigned int)page[3] << 8;
+}
+
+static void set_page_entries(unsigned char *page, unsigned int count) {
+    page[2] = (unsigned char)count;
+    page[3] = (unsigned char)(count >> 8);
+}
+
+/**
+ * @brief Next leaf in the chain (leaves) or leftmost child (internal pages).
+ */
+static uint32_t page_link(const unsigned char *page) {
+    return get_u32(page + 4);
+}
+
+static void set_page_link(unsigned char *page, uint32_t link) {
+    put_u32(page + 4, link);
+}
+
+/**
+ * @brief Size of one entry: key and value in leaves, key and child page in internal pages.
+ */
+static size_t entry_size(int tree, bool leaf) {
+    return key_size(tree) + (leaf ? VALUE_SIZES[tree] : 4);
+}
+
+static unsigned int page_capacity(int tree, bool leaf) {
+    return (unsigned int)((PAGE_SIZE - PAGE_HEADER_SIZE) / entry_size(tree, leaf));
+}
+
+static unsigned char *page_entry(unsigned char *page, int tree, bool leaf, unsigned int i) {
+    return page + PAGE_HEADER_SIZE + i * entry_size(tree, leaf);
+}
+
+/**
+ * @brief First entry whose key is not below @p key.
+ */
+static unsigned int page_lower_bound(unsigned char *page, int tree, const unsigned char *key) {
+    bool leaf = page_is_leaf(page);
+    unsigned int low = 0;
+    unsigned int high = page_entries(page);
+    while (low < high) {
+        unsigned int mid = low + (high - low) / 2;
+        if (memcmp(page_entry(page, tree, leaf, mid), key, key_size(tree)) < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Position of the child of an internal page that covers @p key: 0 is the leftmost child,
+ * i > 0 the child stored with entry i - 1 (whose key is the smallest in that subtree).
+ */
+static unsigned int child_position(unsigned char *page, int tree, const unsigned char *key) {
+    unsigned int low = 0;
+    unsigned int high = page_entries(page);
+    while (low < high) {
+        unsigned int mid = low + (high - low) / 2;
+        if (memcmp(page_entry(page, tree, false, mid), key, key_size(tree)) <= 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static uint32_t child_at(unsigned char *page, int tree, unsigned int position) {
+    return position == 0 ? page_link(page)
+                         : get_u32(page_entry(page, tree, false, position - 1) + key_size(tree));
+}
+
+// ========================= B+Tree ========================= //
+
+/**
+ * @brief Inserts into the subtree at @p page_no, splitting pages on the way back up.
+ * @return 0 if done, 1 if the page split (the new right page and its first key are returned
+ * in @p up_page and @p up_key), -2 if the key already exists, -1 on an I/O error.
+ */
+static int node_insert(PageStore *store, int tree, uint32_t page_no, const unsigned char *key,
+                       const unsigned char *value, unsigned char *up_key, uint32_t *up_page) {
+    unsigned char *page = page_fetch(store, page_no);
+    if (page == NULL) {
+        return -1;
+    }
+
+    bool leaf = page_is_leaf(page);
+    size_t klen = key_size(tree);
+    unsigned char entry[MAX_KEY_SIZE + RECORD_SIZE];
+    unsigned int position;
+
+    if (leaf) {
+        position = page_lower_bound(page, tree, key);
+        if (position < page_entries(page) &&
+            memcmp(page_entry(page, tree, true, position), key, klen) == 0) {
+            page_release(store, page, false);
+            return -2;
+        }
+        memcpy(entry, key, klen);
+        memcpy(entry + klen, value, VALUE_SIZES[tree]);
+    }
+    else {
+        // Unpin while descending so a deep insert never holds more than a few frames.
+        position = child_position(page, tree, key);
+        uint32_t child = child_at(page, tree, position);
+        page_release(store, page, false);
+
+        int status = node_insert(store, tree, child, key, value, up_key, up_page);
+        if (status != 1) {
+            return status;
+        }
+        page = page_fetch(store, page_no);
+        if (page == NULL) {
+            return -1;
+        }
+        memcpy(entry, up_key, klen);
+        put_u32(entry + klen, *up_page);
+    }
+
+    size_t size = entry_size(tree, leaf);
+    unsigned int count = page_entries(page);
+    unsigned char *slot = page_entry(page, tree, leaf, position);
+
+    if (count < page_capacity(tree, leaf)) {
+        memmove(slot + size, slot, (count - position) * size);
+        memcpy(slot, entry, size);
+        set_page_entries(page, count + 1);
+        page_release(store, page, true);
+        return 0;
+    }
+
+    // Split: lay out all count + 1 entries, then share them between this page and a new one.
+    unsigned char all[PAGE_SIZE + MAX_KEY_SIZE + RECORD_SIZE];
+    unsigned char *first = page_entry(page, tree, leaf, 0);
+    memcpy(all, first, position * size);
+    memcpy(all + position * size, entry, size);
+    memcpy(all + (position + 1) * size, slot, (count - position) * size);
+    count++;
+
+    // Appends at the right edge (ascending IDs) keep the left page full instead of half full.
+    unsigned int keep = count / 2;
+    if (leaf && position == count - 1 && page_link(page) == PAGE_NONE) {
+        keep = count - 1;
+    }
+
+    uint32_t right_no;
+    unsigned char *right = page_new(store, leaf ? PAGE_LEAF : PAGE_INTERNAL, &right_no);
+    if (right == NULL) {
+        page_release(store, page, false);
+        return -1;
+    }
+
+    memcpy(first, all, keep * size);
+    set_page_entries(page, keep);
+    if (leaf) {
+        memcpy(page_entry(right, tree, true, 0), all + keep * size, (count - keep) * size);
+        set_page_entries(right, count - keep);
+        set_page_link(right, page_link(page));
+        set_page_link(page, right_no);
+        memcpy(up_key, all + keep * size, klen);
+    }
+    else {
+        // The middle entry moves up; its child becomes the right page's leftmost child.
+        unsigned char *middle = all + keep * size;
+        memcpy(up_key, middle, klen);
+        set_page_link(right, get_u32(middle + klen));
+        memcpy(page_entry(right, tree, false, 0), middle + size, (count - keep - 1) * size);
+        set_page_entries(right, count - keep - 1);
+    }
+    *up_page = right_no;
+
+    page_release(store, right, true);
+    page_release(store, page, true);
+    return 1;
+}
+
+/**
+ * @brief Inserts a key (and value) into a tree, growing a new root when the old one splits.
+ * @return 0 on success, -2 if the key already exists, -1 on an I/O error.
+ */
+static int tree_insert(PageStore *store, int tree, const unsigned char *key,
+                       const unsigned char *value) {
+    if (store->roots[tree] == PAGE_NONE) {
+        unsigned char *root = page_new(store, PAGE_LEAF, &store->roots[tree]);
+        if (root == NULL) {
+            return -1;
+        }
+        page_release(store, root, true);
+    }
+
+    unsigned char up_key[MAX_KEY_SIZE];
+    uint32_t up_page;
+    int status = node_insert(store, tree, store->roots[tree], key, value, up_key, &up_page);
+    if (status != 1) {
+        return status;
+    }
+
+    uint32_t root_no;
+    unsigned char *root = page_new(store, PAGE_INTERNAL, &root_no);
+    if (root == NULL) {
+        return -1;
+    }
+    set_page_link(root, store->roots[tree]);
+    memcpy(page_entry(root, tree, false, 0), up_key, key_size(tree));
+    put_u32(page_entry(root, tree, false, 0) + key_size(tree), up_page);
+    set_page_entries(root, 1);
+    page_release(store, root, true);
+
+    store->roots[tree] = root_no;
+    return 0;
+}
+
+/**
+ * @brief Finds the leaf that would hold @p key.
+ * @param leaf Output: the leaf's page number, or PAGE_NONE for an empty tree.
+ * @return 0 on success, -1 on an I/O error.
+ */
+static int find_leaf(PageStore *store, int tree, const unsigned char *key, uint32_t *leaf) {
+    uint32_t page_no = store->roots[tree];
+    while (page_no != PAGE_NONE) {
+        unsigned char *page = page_fetch(store, page_no);
+        if (page == NULL) {
+            return -1;
+        }
+        if (page_is_leaf(page)) {
+            page_release(store, page, false);
+            break;
+        }
+        uint32_t child = child_at(page, tree, child_position(page, tree, key));
+        page_release(store, page, false);
+        page_no = child;
+    }
+    *leaf = page_no;
+    return 0;
+}
+
+/**
+ * @brief Removes a key from its leaf. Pages are never merged, so separators above may name
+ * keys that no longer exist, which the search rules tolerate.
+ * @return 0 if removed, 1 if the key was not there, -1 on an I/O error.
+ */
+static int tree_delete(PageStore *store, int tree, const unsigned char *key) {
+    uint32_t leaf_no;
+    if (find_leaf(store, tree, key, &leaf_no) != 0) {
+        return -1;
+    }
+    if (leaf_no == PAGE_NONE) {
+        return 1;
+    }
+
+    unsigned char *page = page_fetch(store, leaf_no);
+    if (page == NULL) {
+        return -1;
+    }
+    unsigned int count = page_entries(page);
+    unsigned int position = page_lower_bound(page, tree, key);
+    if (position == count || memcmp(page_entry(page, tree, true, position), key, key_size(tree)) != 0) {
+        page_release(store, page, false);
+        return 1;
+    }
+
+    size_t size = entry_size(tree, true);
+    unsigned char *slot = page_entry(page, tree, true, position);
+    memmove(slot, slot + size, (count - position - 1) * size);
+    set_page_entries(page, count - 1);
+    page_release(store, page, true);
+    return 0;
+}
+
+/**
+ * @brief Positions a cursor on the first entry whose key is not below @p key.
+ */
+static int cursor_seek(Cursor *cursor, PageStore *store, int tree, const unsigned char *key) {
+    cursor->store = store;
+    cursor->tree = tree;
+    cursor->index = 0;
+    if (find_leaf(store, tree, key, &cursor->page) != 0) {
+        return -1;
+    }
+    if (cursor->page == PAGE_NONE) {
+        return 0;
+    }
+
+    unsigned char *page = page_fetch(store, cursor->page);
+    if (page == NULL) {
+        return -1;
+    }
+    cursor->index = page_lower_bound(page, tree, key);
+    page_release(store, page, false);
+    return 0;
+}
+
+/**
+ * @brief Copies out the entry under the cursor and advances, following the leaf chain.
+ * @return 1 if an entry was read, 0 at the end of the tree, -1 on an I/O error.
+ */
+static int cursor_next(Cursor *cursor, unsigned char *key, unsigned char *value) {
+    while (cursor->page != PAGE_NONE) {
+        unsigned char *page = page_fetch(cursor->store, cursor->page);
+        if (page == NULL) {
+            return -1;
+        }
+        if (cursor->index < page_entries(page)) {
+            unsigned char *entry = page_entry(page, cursor->tree, true, cursor->index++);
+            size_t klen = key_size(cursor->tree);
+            memcpy(key, entry, klen);
+            if (value != NULL) {
+                memcpy(value, entry + klen, VALUE_SIZES[cursor->tree]);
+            }
+            page_release(cursor->store, page, false);
+            return 1;
+        }
+        uint32_t next = page_link(page);
+        page_release(cursor->store, page, false);
+        cursor->page = next;
+        cursor->index = 0;
+    }
+    return 0;
+}
+
+// ========================= Opening and Flushing ========================= //
+
+static int write_header(PageStore *store) {
+    unsigned char header[PAGE_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, PAGE_STORE_MAGIC, 8);
+    put_u32(header + 8, PAGE_SIZE);
+    put_u32(header + 12, store->page_count);
+    put_u32(header + 16, store->next_id);
+    put_u32(header + 20, store->contact_count);
+    for (int tree = 0; tree < TREE_COUNT; tree++) {
+        put_u32(header + 24 + 4 * tree, store->roots[tree]);
+    }
+    return pwrite(store->fd, header, PAGE_SIZE, 0) == PAGE_SIZE ? 0 : -1;
+}
+
+static int read_header(PageStore *store) {
+    unsigned char header[PAGE_SIZE];
+    ssize_t length = pread(store->fd, header, PAGE_SIZE, 0);
+    if (length == 0) {
+        // A new file: one header page and four empty trees.
+        store->page_count = 1;
+        store->next_id = 1;
+        return write_header(store);
+    }
+    if (length != PAGE_SIZE || memcmp(header, PAGE_STORE_MAGIC, 8) != 0 ||
+        get_u32(header + 8) != PAGE_SIZE) {
+        return -1;
+    }
+
+    store->page_count = get_u32(header + 12);
+    store->next_id = get_u32(header + 16);
+    store->contact_count = get_u32(header + 20);
+    for (int tree = 0; tree < TREE_COUNT; tree++) {
+        store->roots[tree] = get_u32(header + 24 + 4 * tree);
+    }
+    return 0;
+}
+
+PageStore *page_store_open(const char *path, size_t pool_pages) {
+    if (pool_pages < PAGE_STORE_MIN_POOL) {
+        pool_pages = PAGE_STORE_MIN_POOL;
+    }
+
+    PageStore *store = calloc(1, sizeof(PageStore));
+    if (store == NULL) {
+        return NULL;
+    }
+    store->fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    size_t buckets = 1;
+    while (buckets < pool_pages * 2) {
+        buckets *= 2;
+    }
+    store->frame_count = pool_pages;
+    store->bucket_mask = buckets - 1;
+    store->frames = calloc(pool_pages, sizeof(Frame));
+    store->memory = malloc(pool_pages * PAGE_SIZE);
+    store->buckets = malloc(buckets * sizeof(int));
+
+    if (store->fd < 0 || store->frames == NULL || store->memory == NULL ||
+        store->buckets == NULL || read_header(store) != 0) {
+        if (store->fd >= 0) {
+            close(store->fd);
+        }
+        free(store->frames);
+        free(store->memory);
+        free(store->buckets);
+        free(store);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < buckets; i++) {
+        store->buckets[i] = -1;
+    }
+    for (size_t i = 0; i < pool_pages; i++) {
+        store->frames[i].page_no = PAGE_NONE;
+        store->frames[i].chain = -1;
+        store->frames[i].data = store->memory + i * PAGE_SIZE;
+    }
+    return store;
+}
+
+int page_store_flush(PageStore *store) {
+    for (size_t i = 0; i < store->frame_count; i++) {
+        if (store->frames[i].page_no != PAGE_NONE && pool_write(store, &store->frames[i]) != 0) {
+            return -1;
+        }
+    }
+    if (write_header(store) != 0 || fsync(store->fd) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int page_store_close(PageStore *store) {
+    if (store == NULL) {
+        return 0;
+    }
+    int status = page_store_flush(store);
+    close(store->fd);
+    free(store->frames);
+    free(store->memory);
+    free(store->buckets);
+    free(store);
+    return status;
+}
+
+// ========================= Contacts ========================= //
+
+int page_store_get(PageStore *store, int id, Contact *contact) {
+    unsigned char key[ID_SIZE];
+    unsigned char found[ID_SIZE];
+    unsigned char value[RECORD_SIZE];
+    encode_id(key, id);
+
+    Cursor cursor;
+    if (cursor_seek(&cursor, store, TREE_PRIMARY, key) != 0) {
+        return -1;
+    }
+    int status = cursor_next(&cursor, found, value);
+    if (status <= 0) {
+        return status;
+    }
+    if (memcmp(found, key, ID_SIZE) != 0) {
+        return 0;
+    }
+    decode_record(found, value, contact);
+    return 1;
+}
+
+/**
+ * @brief Finds the contact whose field in a secondary tree equals @p text.
+ * @return 1 if found, 0 if not, -1 on an I/O error.
+ */
+static int find_by_field(PageStore *store, int tree, const char *text, Contact *contact) {
+    Contact probe;
+    memset(&probe, 0, sizeof(probe));
+    char *field = tree == TREE_PHONE ? probe.phone : probe.email;
+    strncpy(field, text, FIELD_WIDTHS[tree] - 1);
+
+    unsigned char key[MAX_KEY_SIZE];
+    unsigned char found[MAX_KEY_SIZE];
+    make_key(key, tree, &probe);
+
+    Cursor cursor;
+    if (cursor_seek(&cursor, store, tree, key) != 0) {
+        return -1;
+    }
+    int status = cursor_next(&cursor, found, NULL);
+    if (status <= 0) {
+        return status;
+    }
+    if (memcmp(found, key, FIELD_WIDTHS[tree]) != 0) {
+        return 0;
+    }
+    return page_store_get(store, decode_id(found + FIELD_WIDTHS[tree]), contact);
+}
+
+int page_store_find_phone(PageStore *store, const char *phone, Contact *contact) {
+    return find_by_field(store, TREE_PHONE, phone, contact);
+}
+
+int page_store_find_email(PageStore *store, const char *email, Contact *contact) {
+    return find_by_field(store, TREE_EMAIL, email, contact);
+}
+
+/**
+ * @brief Checks that no other contact uses @p contact's phone or email.
+ * @param io_error Output: set when a lookup failed to read the file.
+ * @return VALID or INVALID_DUPLICATE.
+ */
+static ValidationStatus check_unique(PageStore *store, const Contact *contact, bool *io_error) {
+    Contact other;
+    int status = page_store_find_phone(store, contact->phone, &other);
+    *io_error = status < 0;
+    if (status == 1 && other.id != contact->id) {
+        return INVALID_DUPLICATE;
+    }
+
+    status = page_store_find_email(store, contact->email, &other);
+    *io_error = *io_error || status < 0;
+    return status == 1 && other.id != contact->id ? INVALID_DUPLICATE : VALID;
+}
+
+/**
+ * @brief Inserts a contact's keys into every tree.
+ * @return 0 on success, -2 if its ID is taken, -1 on an I/O error.
+ */
+static int store_insert(PageStore *store, const Contact *contact) {
+    unsigned char key[MAX_KEY_SIZE];
+    unsigned char value[RECORD_SIZE];
+
+    make_key(key, TREE_PRIMARY, contact);
+    encode_record(value, contact);
+    int status = tree_insert(store, TREE_PRIMARY, key, value);
+    for (int tree = TREE_NAME; tree < TREE_COUNT && status == 0; tree++) {
+        make_key(key, tree, contact);
+        status = tree_insert(store, tree, key, NULL);
+    }
+    if (status != 0) {
+        return status;
+    }
+
+    store->contact_count++;
+    if ((uint32_t)contact->id >= store->next_id) {
+        store->next_id = (uint32_t)contact->id + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Removes a contact's keys from every tree, using the values it was stored under.
+ */
+static int store_delete(PageStore *store, const Contact *contact) {
+    unsigned char key[MAX_KEY_SIZE];
+    for (int tree = 0; tree < TREE_COUNT; tree++) {
+        make_key(key, tree, contact);
+        if (tree_delete(store, tree, key) < 0) {
+            return -1;
+        }
+    }
+    store->contact_count--;
+    return 0;
+}
+
+int page_store_insert(PageStore *store, const Contact *contact) {
+    bool io_error;
+    if (contact->id <= 0 || check_unique(store, contact, &io_error) != VALID || io_error) {
+        return -1;
+    }
+    return store_insert(store, contact) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Runs the field validators on a contact's values.
+ */
+static ValidationStatus validate(const Contact *values) {
+    ValidationStatus status = is_valid_name(values->name);
+    if (status == VALID) {
+        status = is_valid_phone(values->phone);
+    }
+    if (status == VALID) {
+        status = is_valid_email(values->email);
+    }
+    return status;
+}
+
+int page_store_add(PageStore *store, const char *name, const char *phone, const char *email,
+                   ValidationStatus *status) {
+    Contact contact;
+    memset(&contact, 0, sizeof(contact));
+    strncpy(contact.name, name, MAX_NAME_LENGTH - 1);
+    strncpy(contact.phone, phone, MAX_PHONE_LENGTH - 1);
+    strncpy(contact.email, email, MAX_EMAIL_LENGTH - 1);
+    contact.id = (int)store->next_id;
+
+    bool io_error = false;
+    *status = validate(&contact);
+    if (*status == VALID) {
+        *status = check_unique(store, &contact, &io_error);
+    }
+    if (*status != VALID || io_error || store_insert(store, &contact) != 0) {
+        return -1;
+    }
+    return contact.id;
+}
+
+int page_store_update(PageStore *store, int id, const Contact *values, ValidationStatus *status) {
+    Contact old;
+    int found = page_store_get(store, id, &old);
+    *status = found == 0 ? INVALID_NOT_FOUND : VALID;
+    if (found != 1) {
+        return -1;
+    }
+
+    Contact updated = *values;
+    updated.id = id;
+    bool io_error = false;
+    *status = validate(&updated);
+    if (*status == VALID) {
+        *status = check_unique(store, &updated, &io_error);
+    }
+    if (*status != VALID || io_error) {
+        return -1;
+    }
+
+    return store_delete(store, &old) == 0 && store_insert(store, &updated) == 0 ? 0 : -1;
+}
+
+int page_store_remove(PageStore *store, int id) {
+    Contact old;
+    if (page_store_get(store, id, &old) != 1) {
+        return -1;
+    }
+    return store_delete(store, &old);
+}
+
+int page_store_scan(PageStore *store, PageStoreVisitor visit, void *context) {
+    unsigned char key[ID_SIZE] = {0};
+    unsigned char value[RECORD_SIZE];
+    Cursor cursor;
+    if (cursor_seek(&cursor, store, TREE_PRIMARY, key) != 0) {
+        return -1;
+    }
+
+    int status;
+    while ((status = cursor_next(&cursor, key, value)) == 1) {
+        Contact contact;
+        decode_record(key, value, &contact);
+        if (visit(&contact, context) != 0) {
+            return 0;
+        }
+    }
+    return status;
+}
+
+int page_store_scan_name(PageStore *store, const char *prefix, PageStoreVisitor visit,
+                         void *context) {
+    Contact probe;
+    memset(&probe, 0, sizeof(probe));
+    strncpy(probe.name, prefix, MAX_NAME_LENGTH - 1);
+
+    unsigned char key[MAX_KEY_SIZE];
+    make_key(key, TREE_NAME, &probe);
+    size_t length = strlen(probe.name);
+
+    Cursor cursor;
+    if (cursor_seek(&cursor, store, TREE_NAME, key) != 0) {
+        return -1;
+    }
+
+    unsigned char found[MAX_KEY_SIZE];
+    int status;
+    while ((status = cursor_next(&cursor, found, NULL)) == 1 && memcmp(found, key, length) == 0) {
+        // The cursor holds no pins, so the primary lookup is free to evict its leaf.
+        Contact contact;
+        if (page_store_get(store, decode_id(found + MAX_NAME_LENGTH), &contact) != 1) {
+            return -1;
+        }
+        if (visit(&contact, context) != 0) {
+            return 0;
+        }
+    }
+    return status < 0 ? -1 : 0;
+}
+
+void page_store_stats(const PageStore *store, PageStoreStats *stats) {
+    *stats = store->counters;
+    stats->contact_count = store->contact_count;
+    stats->page_count = store->page_count;
+    stats->pool_pages = store->frame_count;
+}
+
+// ========================= CSV ========================= //
+
+int page_store_import_csv(PageStore *store, const char *path, int *skipped) {
+    if (skipped != NULL) {
+        *skipped = 0;
+    }
+
+    FILE *fptr = fopen(path, "r");
+    if (fptr == NULL) {
+        return -1;
+    }
+
+    int num_contacts;
+    if (fscanf(fptr, "%d\n", &num_contacts) != 1) {
+        fclose(fptr);
+        return -1;
+    }
+
+    int imported = 0;
+    for (int i = 0; i < num_contacts; i++) {
+        Contact contact;
+        if (fscanf(fptr, "%d,%49[^,],%19[^,],%49[^\n]\n", &contact.id, contact.name,
+                   contact.phone, contact.email) != 4) {
+            if (skipped != NULL) {
+                (*skipped)++;
+            }
+            continue;
+        }
+
+        bool io_error = false;
+        if (contact.id <= 0 || validate(&contact) != VALID ||
+            check_unique(store, &contact, &io_error) != VALID || io_error) {
+            if (io_error) {
+                fclose(fptr);
+                return -1;
+            }
+            if (skipped != NULL) {
+                (*skipped)++;
+            }
+            continue;
+        }
+
+        int status = store_insert(store, &contact);
+        if (status == -1) {
+            fclose(fptr);
+            return -1;
+        }
+        if (status == -2 && skipped != NULL) {
+            (*skipped)++;
+        }
+        imported += status == 0;
+    }
+
+    fclose(fptr);
+    return imported;
+}
+
+static int write_csv_line(const Contact *contact, void *context) {
+    return fprintf((FILE *)context, "%d,%s,%s,%s\n", contact->id, contact->name, contact->phone,
+                   contact->email) < 0;
+}
+
+int page_store_export_csv(PageStore *store, const char *path) {
+    FILE *fptr = fopen(path, "w");
+    if (fptr == NULL) {
+        return -1;
+    }
+
+    fprintf(fptr, "%u\n", store->contact_count);
+    int status = page_store_scan(store, write_csv_line, fptr);
+    if (fclose(fptr) != 0 || status != 0) {
+        return -1;
+    }
+    return (int)store->contact_count;
+}
+
+// ========================= Pages Subcommand ========================= //
+
+static void print_pages_usage(void) {
+    printf("Usage: addressbook pages [--pool <pages>] <action>\n");
+    printf("  import <file.csv>          Add the contacts of a CSV file to %s\n",
+           PAGE_STORE_FILE_NAME);
+    printf("  export <file.csv>          Write every contact to a CSV file\n");
+    printf("  stats                      Show the file and buffer pool counters\n");
+    printf("  get <id> | phone <number> | email <address> | name <prefix>\n");
+    printf("  add <name> <phone> <email> | set <id> <name> <phone> <email> | remove <id>\n");
+}
+
+static void print_contact_row(const Contact *contact) {
+    printf(" %-7d | %-20s | %-15s | %-30s\n", contact->id, contact->name, contact->phone,
+           contact->email);
+}
+
+static int print_contact_visitor(const Contact *contact, void *context) {
+    (void)context;
+    print_contact_row(contact);
+    return 0;
+}
+
+static void print_pool_stats(const PageStore *store) {
+    PageStoreStats stats;
+    page_store_stats(store, &stats);
+    printf("Ein: %zu contact(s) in %zu page(s). Pool of %zu page(s) (%zu KB): %zu hit(s), "
+           "%zu miss(es), %zu eviction(s), %zu write(s).\n",
+           stats.contact_count, stats.page_count, stats.pool_pages,
+           stats.pool_pages * PAGE_SIZE / 1024, stats.hits, stats.misses, stats.evictions,
+           stats.writes);
+}
+
+/**
+ * @brief Runs one action of the pages subcommand.
+ * @return Process exit status.
+ */
+static int pages_action(PageStore *store, int argc, char *argv[]) {
+    const char *action = argv[0];
+    Contact contact;
+    ValidationStatus status;
+    int found = 0;
+
+    if (strcmp(action, "import") == 0 && argc == 2) {
+        int skipped;
+        int imported = page_store_import_csv(store, argv[1], &skipped);
+        if (imported < 0) {
+            printf("Ein: *Whines* I couldn't import '%s'.\n", argv[1]);
+            return 1;
+        }
+        printf("Ein: Imported %d contact(s), skipped %d.\n", imported, skipped);
+        return 0;
+    }
+    if (strcmp(action, "export") == 0 && argc == 2) {
+        int exported = page_store_export_csv(store, argv[1]);
+        if (exported < 0) {
+            printf("Ein: *Whines* I couldn't write '%s'.\n", argv[1]);
+            return 1;
+        }
+        printf("Ein: Wrote %d contact(s) to '%s'.\n", exported, argv[1]);
+        return 0;
+    }
+    if (strcmp(action, "stats") == 0 && argc == 1) {
+        return 0;
+    }
+    if (strcmp(action, "name") == 0 && argc == 2) {
+        return page_store_scan_name(store, argv[1], print_contact_visitor, NULL) == 0 ? 0 : 1;
+    }
+    if ((strcmp(action, "get") == 0 || strcmp(action, "phone") == 0 ||
+         strcmp(action, "email") == 0) && argc == 2) {
+        if (action[0] == 'g') {
+            found = page_store_get(store, atoi(argv[1]), &contact);
+        }
+        else if (action[0] == 'p') {
+            found = page_store_find_phone(store, argv[1], &contact);
+        }
+        else {
+            found = page_store_find_email(store, argv[1], &contact);
+        }
+        if (found == 1) {
+            print_contact_row(&contact);
+        }
+        else {
+            printf("Ein: *Sniffs around* Nope, I couldn't find \"%s\".\n", argv[1]);
+        }
+        return found == 1 ? 0 : 1;
+    }
+    if (strcmp(action, "add") == 0 && argc == 4) {
+        int id = page_store_add(store, argv[1], argv[2], argv[3], &status);
+        if (id < 0) {
+            print_validation_error(status);
+            return 1;
+        }
+        printf("Ein: *Tail wags* Stored %s as contact %d.\n", argv[1], id);
+        return 0;
+    }
+    if (strcmp(action, "set") == 0 && argc == 5) {
+        memset(&contact, 0, sizeof(contact));
+        strncpy(contact.name, argv[2], MAX_NAME_LENGTH - 1);
+        strncpy(contact.phone, argv[3], MAX_PHONE_LENGTH - 1);
+        strncpy(contact.email, argv[4], MAX_EMAIL_LENGTH - 1);
+        if (page_store_update(store, atoi(argv[1]), &contact, &status) != 0) {
+            print_validation_error(status);
+            return 1;
+        }
+        printf("Ein: Contact %s updated.\n", argv[1]);
+        return 0;
+    }
+    if (strcmp(action, "remove") == 0 && argc == 2) {
+        if (page_store_remove(store, atoi(argv[1])) != 0) {
+            print_validation_error(INVALID_NOT_FOUND);
+            return 1;
+        }
+        printf("Ein: Contact %s removed.\n", argv[1]);
+        return 0;
+    }
+
+    print_pages_usage();
+    return 1;
+}
+
+int run_pages_command(int argc, char *argv[]) {
+    size_t pool_pages = PAGE_STORE_DEFAULT_POOL;
+    if (argc >= 2 && strcmp(argv[0], "--pool") == 0) {
+        int pages = atoi(argv[1]);
+        if (pages < PAGE_STORE_MIN_POOL) {
+            printf("Ein: The pool needs at least %d pages.\n", PAGE_STORE_MIN_POOL);
+            return 1;
+        }
+        pool_pages = (size_t)pages;
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 1) {
+        print_pages_usage();
+        return 1;
+    }
+
+    PageStore *store = page_store_open(PAGE_STORE_FILE_NAME, pool_pages);
+    if (store == NULL) {
+        printf("Ein: *Tilts head* %s is missing or isn't a page store.\n", PAGE_STORE_FILE_NAME);
+        return 1;
+    }
+
+    int status = pages_action(store, argc, argv);
+    print_pool_stats(store);
+    if (page_store_close(store) != 0) {
+        printf("Ein: *Whines* I couldn't write everything back to %s.\n", PAGE_STORE_FILE_NAME);
+        status = 1;
+    }
+    return status;
+}
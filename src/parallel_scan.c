@@ -0,0 +1,298 @@
+/**
+ * @file parallel_scan.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the work-stealing parallel scan.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // sysconf(_SC_NPROCESSORS_ONLN)
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "address_book.h"
+#include "parallel_scan.h"
+#include "snapshot.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#define MAX_SCAN_THREADS 64
+
+/**
+ * @brief The run of chunks [next, end) a worker still owns. The owner takes from the front;
+ * thieves take from the back.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t next;
+    size_t end;
+    size_t steals;
+} ScanQueue;
+
+typedef struct {
+    const Contact *const *contacts;
+    size_t count;
+    ScanPredicate match;
+    void *context;
+    Contact **matches;
+    size_t *found;     // Matches per chunk, written at the chunk's own offset in matches.
+    ScanQueue *queues;
+    int worker_count;
+} ScanJob;
+
+typedef struct {
+    ScanJob *job;
+    int index;
+} ScanWorker;
+
+// The workers every scan runs on, started by the first parallel scan and kept for the process.
+// thread_pool_wait waits for the whole pool, so scans take turns on it under scan_pool_lock.
+static pthread_mutex_t scan_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static ThreadPool *scan_pool = NULL;
+
+/**
+ * @brief Returns the shared pool, started (or restarted larger) so it has at least
+ * @p thread_count workers. Called with scan_pool_lock held.
+ */
+static ThreadPool *acquire_scan_pool(int thread_count) {
+    if (scan_pool != NULL && thread_pool_size(scan_pool) >= thread_count) {
+        return scan_pool;
+    }
+    ThreadPool *pool = thread_pool_create(thread_count);
+    if (pool != NULL) {
+        thread_pool_destroy(scan_pool);
+        scan_pool = pool;
+    }
+    return scan_pool;
+}
+
+static size_t scan_range(const ScanJob *job, size_t begin, size_t end, Contact **out) {
+    size_t found = 0;
+    for (size_t i = begin; i < end; i++) {
+        if (job->match(job->contacts[i], job->context)) {
+            out[found++] = (Contact *)job->contacts[i];
+        }
+    }
+    return found;
+}
+
+static bool take_own_chunk(ScanQueue *queue, size_t *chunk) {
+    pthread_mutex_lock(&queue->lock);
+    bool taken = queue->next < queue->end;
+    if (taken) {
+        *chunk = queue->next++;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+
+/**
+ * @brief Moves the back half of another worker's run into this worker's (empty) queue.
+ * @return true if anything was stolen, false once every queue is empty.
+ */
+static bool steal_chunks(ScanJob *job, int thief) {
+    for (int offset = 1; offset < job->worker_count; offset++) {
+        ScanQueue *victim = &job->queues[(thief + offset) % job->worker_count];
+
+        pthread_mutex_lock(&victim->lock);
+        size_t remaining = victim->end - victim->next;
+        size_t take = (remaining + 1) / 2;
+        size_t end = victim->end;
+        victim->end -= take;
+        pthread_mutex_unlock(&victim->lock);
+
+        if (take > 0) {
+            ScanQueue *own = &job->queues[thief];
+            pthread_mutex_lock(&own->lock);
+            own->next = end - take;
+            own->end = end;
+            own->steals++;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void scan_worker(void *arg) {
+    ScanWorker *worker = arg;
+    ScanJob *job = worker->job;
+    ScanQueue *own = &job->queues[worker->index];
+    TraceSpan span = TRACE_BEGIN("scan.worker");
+    size_t chunks = 0;
+
+    do {
+        size_t chunk;
+        while (take_own_chunk(own, &chunk)) {
+            chunks++;
+            size_t begin = chunk * PARALLEL_SCAN_CHUNK;
+            size_t end = begin + PARALLEL_SCAN_CHUNK < job->count ? begin + PARALLEL_SCAN_CHUNK
+                                                                  : job->count;
+            job->found[chunk] = scan_range(job, begin, end, job->matches + begin);
+        }
+    } while (steal_chunks(job, worker->index));
+    TRACE_END_COUNT(span, "chunks", chunks);
+}
+
+/**
+ * @brief Runs the job on the shared pool, one task per worker.
+ * @return 0 on success, -1 if the workers could not be started (nothing was scanned).
+ */
+static int run_workers(ScanJob *job, size_t chunk_count, size_t *steals) {
+    ScanQueue queues[MAX_SCAN_THREADS];
+    ScanWorker workers[MAX_SCAN_THREADS];
+    pthread_mutex_lock(&scan_pool_lock);
+    ThreadPool *pool = acquire_scan_pool(job->worker_count);
+    if (pool == NULL) {
+        pthread_mutex_unlock(&scan_pool_lock);
+        return -1;
+    }
+    if (thread_pool_size(pool) < job->worker_count) {
+        job->worker_count = thread_pool_size(pool); // It could not be started larger.
+    }
+    job->queues = queues;
+
+    for (int i = 0; i < job->worker_count; i++) {
+        pthread_mutex_init(&queues[i].lock, NULL);
+        queues[i].next = chunk_count * (size_t)i / (size_t)job->worker_count;
+        queues[i].end = chunk_count * (size_t)(i + 1) / (size_t)job->worker_count;
+        queues[i].steals = 0;
+        workers[i].job = job;
+        workers[i].index = i;
+    }
+
+    // A task that cannot be queued leaves its run to be stolen by the others.
+    int submitted = 0;
+    for (int i = 0; i < job->worker_count; i++) {
+        submitted += thread_pool_submit(pool, scan_worker, &workers[i]) == 0;
+    }
+    if (submitted == 0) {
+        scan_worker(&workers[0]);
+    }
+    thread_pool_wait(pool);
+    pthread_mutex_unlock(&scan_pool_lock);
+
+    *steals = 0;
+    for (int i = 0; i < job->worker_count; i++) {
+        *steals += queues[i].steals;
+        pthread_mutex_destroy(&queues[i].lock);
+    }
+    return 0;
+}
+
+int parallel_scan_threads(size_t contact_count, int thread_count) {
+    if (thread_count <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (int)online : 1;
+    }
+    if (thread_count > MAX_SCAN_THREADS) {
+        thread_count = MAX_SCAN_THREADS;
+    }
+    size_t chunk_count = (contact_count + PARALLEL_SCAN_CHUNK - 1) / PARALLEL_SCAN_CHUNK;
+    if (contact_count < PARALLEL_SCAN_MIN_CONTACTS) {
+        return 1;
+    }
+    return (size_t)thread_count < chunk_count ? thread_count : (int)chunk_count;
+}
+
+/**
+ * @brief Copies the live list into an array, for books without snapshots.
+ * @return The array (free with free()), or NULL if memory could not be allocated.
+ */
+static const Contact **list_array(const AddressBook *book, size_t *count) {
+    size_t length = 0;
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        length++;
+    }
+    const Contact **contacts = malloc(sizeof(Contact *) * (length > 0 ? length : 1));
+    if (contacts == NULL) {
+        return NULL;
+    }
+    *count = 0;
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        contacts[(*count)++] = current;
+    }
+    return contacts;
+}
+
+int parallel_scan(const AddressBook *book, ScanPredicate match, void *context, int thread_count,
+                  ScanResult *result, ScanStats *stats) {
+    ScanStats local = {1, 1, 0};
+    TraceSpan span = TRACE_BEGIN("scan");
+    memset(result, 0, sizeof(*result));
+
+    // Read a snapshot if snapshots are on, so writers can keep going; else the list as it is.
+    BookSnapshot *snapshot = NULL;
+    const Contact **contacts = NULL;
+    size_t count = 0;
+    if (book->snapshots != NULL) {
+        snapshot = snapshot_open(book);
+        if (snapshot != NULL) {
+            contacts = snapshot->contacts;
+            count = snapshot->count;
+        }
+    }
+    else {
+        contacts = list_array(book, &count);
+    }
+
+    // The output is sized from what is actually read, never from book->contact_count.
+    int workers = parallel_scan_threads(count, thread_count);
+    size_t chunk_count = (count + PARALLEL_SCAN_CHUNK - 1) / PARALLEL_SCAN_CHUNK;
+    Contact **matches = NULL;
+    size_t *chunk_found = NULL;
+    if (contacts != NULL) {
+        matches = malloc(sizeof(Contact *) * (count > 0 ? count : 1));
+    }
+    if (matches != NULL && workers > 1) {
+        chunk_found = calloc(chunk_count, sizeof(size_t));
+    }
+    if (matches == NULL || (workers > 1 && chunk_found == NULL)) {
+        free(matches);
+        if (snapshot != NULL) {
+            snapshot_close(snapshot);
+        }
+        else {
+            free(contacts);
+        }
+        TRACE_END(span);
+        return -1;
+    }
+
+    ScanJob job = {contacts, count, match, context, matches, chunk_found, NULL, workers};
+    size_t found = 0;
+    if (workers > 1 && run_workers(&job, chunk_count, &local.steals) == 0) {
+        // Chunk c left its matches at offset c * CHUNK; pack them down in order.
+        for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+            memmove(matches + found, matches + chunk * PARALLEL_SCAN_CHUNK,
+                    sizeof(Contact *) * chunk_found[chunk]);
+            found += chunk_found[chunk];
+        }
+        local.threads = job.worker_count;
+        local.chunks = chunk_count;
+    }
+    else {
+        found = scan_range(&job, 0, count, matches);
+    }
+
+    free(chunk_found);
+    if (snapshot == NULL) {
+        free(contacts);
+    }
+    result->matches = matches;
+    result->count = found;
+    result->scanned = count;
+    result->snapshot = snapshot;
+    if (stats != NULL) {
+        *stats = local;
+    }
+    TRACE_END_COUNT(span, "matches", found);
+    return 0;
+}
+
+void parallel_scan_free(ScanResult *result) {
+    free(result->matches);
+    snapshot_close(result->snapshot);
+    memset(result, 0, sizeof(*result));
+}
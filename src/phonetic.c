@@ -0,0 +1,95 @@
+/**
+ * @file phonetic.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of Soundex codes and sounds-like name matching.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include "address_book.h"
+#include "phonetic.h"
+
+/**
+ * @brief Soundex digit of each letter: '0' for vowels (and y), 0 for h and w, which neither
+ * code nor separate equal digits.
+ */
+static const char SOUNDEX_DIGITS[26] = {
+    '0', '1', '2', '3', '0', '1', '2', 0,   '0', '2', '2', '4', '5',
+    '5', '0', '1', '2', '6', '2', '3', '0', '1', 0,   '2', '0', '2',
+};
+
+int soundex_code(const char *token, char code[PHONETIC_CODE_LENGTH]) {
+    if (!isalpha((unsigned char)token[0])) {
+        return -1;
+    }
+
+    int first = tolower((unsigned char)token[0]) - 'a';
+    code[0] = (char)toupper((unsigned char)token[0]);
+    char previous = SOUNDEX_DIGITS[first];
+    int length = 1;
+
+    for (int i = 1; isalpha((unsigned char)token[i]) && length < PHONETIC_CODE_LENGTH - 1; i++) {
+        char digit = SOUNDEX_DIGITS[tolower((unsigned char)token[i]) - 'a'];
+        if (digit == 0) {
+            continue; // h and w: the letters on either side still count as adjacent
+        }
+        if (digit != '0' && digit != previous) {
+            code[length++] = digit;
+        }
+        previous = digit;
+    }
+
+    while (length < PHONETIC_CODE_LENGTH - 1) {
+        code[length++] = '0';
+    }
+    code[length] = '\0';
+    return 0;
+}
+
+int phonetic_name_codes(const char *name, char codes[][PHONETIC_CODE_LENGTH]) {
+    int count = 0;
+    const char *p = name;
+
+    while (*p != '\0' && count < PHONETIC_MAX_TOKENS) {
+        while (*p != '\0' && !isalpha((unsigned char)*p)) {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+
+        char code[PHONETIC_CODE_LENGTH];
+        soundex_code(p, code);
+        while (isalpha((unsigned char)*p)) {
+            p++;
+        }
+
+        bool seen = false;
+        for (int i = 0; i < count && !seen; i++) {
+            seen = strcmp(codes[i], code) == 0;
+        }
+        if (!seen) {
+            strcpy(codes[count++], code);
+        }
+    }
+    return count;
+}
+
+bool phonetic_name_matches(const char *name, char query[][PHONETIC_CODE_LENGTH],
+                           int query_count) {
+    char codes[PHONETIC_MAX_TOKENS][PHONETIC_CODE_LENGTH];
+    int count = phonetic_name_codes(name, codes);
+
+    for (int q = 0; q < query_count; q++) {
+        bool found = false;
+        for (int i = 0; i < count && !found; i++) {
+            found = strcmp(codes[i], query[q]) == 0;
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
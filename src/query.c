@@ -0,0 +1,927 @@
+/**
+ * @file query.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the query parser, planner, executor, and explain output.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <limits.h>
+#include "address_book.h"
+#include "autocomplete.h"
+#include "contact_helper.h"
+#include "contact_index.h"
+#include "contact_report.h"
+#include "parallel_scan.h"
+#include "query.h"
+#include "query_cache.h"
+#include "trace.h"
+
+// ========================= Lexer ========================= //
+
+typedef enum {
+    TOKEN_END,
+    TOKEN_WORD,   /**< Bare word: field name, keyword, or unquoted value. */
+    TOKEN_STRING, /**< Quoted value. */
+    TOKEN_EQUALS,
+    TOKEN_PREFIX,
+    TOKEN_CONTAINS,
+    TOKEN_LPAREN,
+    TOKEN_RPAREN,
+    TOKEN_INVALID
+} TokenType;
+
+typedef struct {
+    TokenType type;
+    char text[MAX_EMAIL_LENGTH];
+} Token;
+
+typedef struct {
+    const char *cursor;
+    Token token;
+    char *error;
+    size_t error_size;
+    bool failed;
+} Parser;
+
+static void parser_fail(Parser *parser, const char *format, ...) {
+    if (parser->failed) {
+        return;
+    }
+    parser->failed = true;
+    if (parser->error != NULL && parser->error_size > 0) {
+        va_list args;
+        va_start(args, format);
+        vsnprintf(parser->error, parser->error_size, format, args);
+        va_end(args);
+    }
+}
+
+static bool is_word_char(char c) {
+    return isalnum((unsigned char)c) || c == '_' || c == '.' || c == '@' || c == '+' || c == '-';
+}
+
+static void next_token(Parser *parser) {
+    const char *p = parser->cursor;
+    Token *token = &parser->token;
+
+    while (isspace((unsigned char)*p)) {
+        p++;
+    }
+    token->text[0] = '\0';
+
+    if (*p == '\0') {
+        token->type = TOKEN_END;
+    }
+    else if (*p == '(' || *p == ')') {
+        token->type = *p == '(' ? TOKEN_LPAREN : TOKEN_RPAREN;
+        p++;
+    }
+    else if (*p == '=') {
+        token->type = TOKEN_EQUALS;
+        p++;
+    }
+    else if ((*p == '^' || *p == '~') && p[1] == '=') {
+        token->type = *p == '^' ? TOKEN_PREFIX : TOKEN_CONTAINS;
+        p += 2;
+    }
+    else if (*p == '\'' || *p == '"') {
+        char quote = *p++;
+        size_t length = 0;
+        while (*p != '\0' && *p != quote) {
+            if (length < MAX_EMAIL_LENGTH - 1) {
+                token->text[length++] = *p;
+            }
+            p++;
+        }
+        token->text[length] = '\0';
+        if (*p != quote) {
+            token->type = TOKEN_INVALID;
+            parser_fail(parser, "unterminated quoted value");
+        }
+        else {
+            token->type = TOKEN_STRING;
+            p++;
+        }
+    }
+    else if (is_word_char(*p)) {
+        size_t length = 0;
+        while (is_word_char(*p)) {
+            if (length < MAX_EMAIL_LENGTH - 1) {
+                token->text[length++] = *p;
+            }
+            p++;
+        }
+        token->text[length] = '\0';
+        token->type = TOKEN_WORD;
+    }
+    else {
+        token->type = TOKEN_INVALID;
+        parser_fail(parser, "unexpected character '%c'", *p);
+    }
+
+    parser->cursor = p;
+}
+
+static bool token_is_keyword(const Token *token, const char *keyword) {
+    if (token->type != TOKEN_WORD) {
+        return false;
+    }
+    size_t i = 0;
+    for (; keyword[i] != '\0'; i++) {
+        if (tolower((unsigned char)token->text[i]) != keyword[i]) {
+            return false;
+        }
+    }
+    return token->text[i] == '\0';
+}
+
+// ========================= Parser ========================= //
+
+static QueryNode *new_node(QueryNodeType type) {
+    QueryNode *node = calloc(1, sizeof(QueryNode));
+    if (node != NULL) {
+        node->type = type;
+    }
+    return node;
+}
+
+static void free_node(QueryNode *node) {
+    if (node == NULL) {
+        return;
+    }
+    free_node(node->left);
+    free_node(node->right);
+    free(node);
+}
+
+static QueryNode *parse_or(Parser *parser);
+
+/**
+ * @brief Reads an ID value: digits only and no larger than an int holds.
+ */
+static bool parse_id(const char *value, int *id) {
+    if (*value == '\0') {
+        return false;
+    }
+    for (const char *p = value; *p != '\0'; p++) {
+        if (!isdigit((unsigned char)*p)) {
+            return false;
+        }
+    }
+    errno = 0;
+    long parsed = strtol(value, NULL, 10);
+    if (errno == ERANGE || parsed > INT_MAX) {
+        return false;
+    }
+    *id = (int)parsed;
+    return true;
+}
+
+static QueryNode *parse_predicate(Parser *parser) {
+    static const struct {
+        const char *name;
+        QueryField field;
+    } fields[] = {{"id", FIELD_ID},
+                  {"name", FIELD_NAME},
+                  {"phone", FIELD_PHONE},
+                  {"email", FIELD_EMAIL},
+                  {"domain", FIELD_DOMAIN}};
+
+    size_t f = 0;
+    for (; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        if (token_is_keyword(&parser->token, fields[f].name)) {
+            break;
+        }
+    }
+    if (f == sizeof(fields) / sizeof(fields[0])) {
+        parser_fail(parser, "expected a field (id, name, phone, email, domain) near '%s'",
+                    parser->token.text);
+        return NULL;
+    }
+    next_token(parser);
+
+    QueryOperator op;
+    if (parser->token.type == TOKEN_EQUALS) {
+        op = OP_EQUALS;
+    }
+    else if (parser->token.type == TOKEN_PREFIX || token_is_keyword(&parser->token, "prefix")) {
+        op = OP_PREFIX;
+    }
+    else if (parser->token.type == TOKEN_CONTAINS ||
+             token_is_keyword(&parser->token, "contains")) {
+        op = OP_CONTAINS;
+    }
+    else {
+        parser_fail(parser, "expected =, ^=, or ~= after '%s'", fields[f].name);
+        return NULL;
+    }
+    next_token(parser);
+
+    // Allow the wordy form "name prefix = 'Sa'".
+    if (op != OP_EQUALS && parser->token.type == TOKEN_EQUALS) {
+        next_token(parser);
+    }
+
+    if (parser->token.type != TOKEN_WORD && parser->token.type != TOKEN_STRING) {
+        parser_fail(parser, "expected a value after the operator");
+        return NULL;
+    }
+
+    QueryNode *node = new_node(NODE_PREDICATE);
+    if (node == NULL) {
+        parser_fail(parser, "out of memory");
+        return NULL;
+    }
+    node->field = fields[f].field;
+    node->op = op;
+
+    if (node->field == FIELD_NAME || node->field == FIELD_EMAIL || node->field == FIELD_DOMAIN) {
+        index_fold_key(parser->token.text, node->value);
+    }
+    else {
+        strcpy(node->value, parser->token.text);
+    }
+
+    // Store an ID in canonical form so the filter agrees with the index: id = 007 is id = 7.
+    int id;
+    if (node->field == FIELD_ID && op == OP_EQUALS) {
+        if (!parse_id(node->value, &id)) {
+            parser_fail(parser, "id must be a number from 0 to %d", INT_MAX);
+            free(node);
+            return NULL;
+        }
+        snprintf(node->value, sizeof(node->value), "%d", id);
+    }
+
+    next_token(parser);
+    return node;
+}
+
+static QueryNode *parse_primary(Parser *parser) {
+    if (parser->token.type == TOKEN_LPAREN) {
+        next_token(parser);
+        QueryNode *inner = parse_or(parser);
+        if (inner == NULL) {
+            return NULL;
+        }
+        if (parser->token.type != TOKEN_RPAREN) {
+            parser_fail(parser, "missing ')'");
+            free_node(inner);
+            return NULL;
+        }
+        next_token(parser);
+        return inner;
+    }
+    return parse_predicate(parser);
+}
+
+static QueryNode *parse_binary(Parser *parser, QueryNodeType type, const char *keyword,
+                               QueryNode *(*operand)(Parser *)) {
+    QueryNode *left = operand(parser);
+
+    while (left != NULL && token_is_keyword(&parser->token, keyword)) {
+        next_token(parser);
+        QueryNode *right = operand(parser);
+        QueryNode *node = right != NULL ? new_node(type) : NULL;
+        if (node == NULL) {
+            if (right != NULL) {
+                parser_fail(parser, "out of memory");
+            }
+            free_node(left);
+            free_node(right);
+            return NULL;
+        }
+        node->left = left;
+        node->right = right;
+        left = node;
+    }
+    return left;
+}
+
+static QueryNode *parse_and(Parser *parser) {
+    return parse_binary(parser, NODE_AND, "and", parse_primary);
+}
+
+static QueryNode *parse_or(Parser *parser) {
+    return parse_binary(parser, NODE_OR, "or", parse_and);
+}
+
+Query *query_parse(const char *text, char *error, size_t error_size) {
+    Parser parser = {text, {TOKEN_END, ""}, error, error_size, false};
+    if (error != NULL && error_size > 0) {
+        error[0] = '\0';
+    }
+
+    next_token(&parser);
+    if (parser.token.type == TOKEN_END) {
+        parser_fail(&parser, "the query is empty");
+        return NULL;
+    }
+
+    QueryNode *root = parse_or(&parser);
+    if (root != NULL && parser.token.type != TOKEN_END) {
+        parser_fail(&parser, "unexpected '%s' (did you mean AND or OR?)", parser.token.text);
+        free_node(root);
+        return NULL;
+    }
+    if (root == NULL) {
+        parser_fail(&parser, "invalid query");
+        return NULL;
+    }
+
+    Query *query = malloc(sizeof(Query));
+    if (query == NULL) {
+        parser_fail(&parser, "out of memory");
+        free_node(root);
+        return NULL;
+    }
+    query->root = root;
+    return query;
+}
+
+void query_free(Query *query) {
+    if (query == NULL) {
+        return;
+    }
+    free_node(query->root);
+    free(query);
+}
+
+static QueryNode *copy_node(const QueryNode *node) {
+    QueryNode *copy = new_node(node->type);
+    if (copy == NULL) {
+        return NULL;
+    }
+    *copy = *node;
+    copy->left = NULL;
+    copy->right = NULL;
+    if ((node->left != NULL && (copy->left = copy_node(node->left)) == NULL) ||
+        (node->right != NULL && (copy->right = copy_node(node->right)) == NULL)) {
+        free_node(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+Query *query_copy(const Query *query) {
+    Query *copy = malloc(sizeof(Query));
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->root = copy_node(query->root);
+    if (copy->root == NULL) {
+        free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+// ========================= Evaluation ========================= //
+
+static void field_value(const Contact *contact, QueryField field, char *out) {
+    switch (field) {
+        case FIELD_ID:
+            snprintf(out, MAX_EMAIL_LENGTH, "%d", contact->id);
+            break;
+        case FIELD_NAME:
+            index_fold_key(contact->name, out);
+            break;
+        case FIELD_PHONE:
+            strcpy(out, contact->phone);
+            break;
+        case FIELD_EMAIL:
+            index_fold_key(contact->email, out);
+            break;
+        case FIELD_DOMAIN:
+            report_domain_key(contact->email, out);
+            break;
+    }
+}
+
+static bool node_matches(const QueryNode *node, const Contact *contact) {
+    switch (node->type) {
+        case NODE_AND:
+            return node_matches(node->left, contact) && node_matches(node->right, contact);
+        case NODE_OR:
+            return node_matches(node->left, contact) || node_matches(node->right, contact);
+        case NODE_PREDICATE:
+            break;
+    }
+
+    char value[MAX_EMAIL_LENGTH];
+    field_value(contact, node->field, value);
+
+    switch (node->op) {
+        case OP_EQUALS:
+            return strcmp(value, node->value) == 0;
+        case OP_PREFIX:
+            return strncmp(value, node->value, strlen(node->value)) == 0;
+        case OP_CONTAINS:
+            return strstr(value, node->value) != NULL;
+    }
+    return false;
+}
+
+bool query_matches(const Query *query, const Contact *contact) {
+    return node_matches(query->root, contact);
+}
+
+static const char *field_name(QueryField field) {
+    static const char *names[] = {"id", "name", "phone", "email", "domain"};
+    return names[field];
+}
+
+static const char *operator_symbol(QueryOperator op) {
+    static const char *symbols[] = {"=", "^=", "~="};
+    return symbols[op];
+}
+
+static void append(char *buffer, size_t size, size_t *used, const char *format, ...) {
+    if (*used >= size) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + *used, size - *used, format, args);
+    va_end(args);
+    if (written > 0) {
+        *used += (size_t)written;
+    }
+}
+
+static void node_to_string(const QueryNode *node, char *buffer, size_t size, size_t *used) {
+    if (node->type == NODE_PREDICATE) {
+        append(buffer, size, used, "%s %s '%s'", field_name(node->field),
+               operator_symbol(node->op), node->value);
+        return;
+    }
+
+    const char *keyword = node->type == NODE_AND ? "AND" : "OR";
+    const QueryNode *sides[] = {node->left, node->right};
+    for (int i = 0; i < 2; i++) {
+        // Only an OR nested under an AND needs parentheses to keep its meaning.
+        bool wrap = node->type == NODE_AND && sides[i]->type == NODE_OR;
+        if (i == 1) {
+            append(buffer, size, used, " %s ", keyword);
+        }
+        append(buffer, size, used, wrap ? "(" : "");
+        node_to_string(sides[i], buffer, size, used);
+        append(buffer, size, used, wrap ? ")" : "");
+    }
+}
+
+void query_to_string(const Query *query, char *buffer, size_t size) {
+    size_t used = 0;
+    if (size == 0) {
+        return;
+    }
+    buffer[0] = '\0';
+    node_to_string(query->root, buffer, size, &used);
+}
+
+// ========================= Planner ========================= //
+
+typedef enum {
+    PLAN_SCAN,
+    PLAN_ID_LOOKUP,
+    PLAN_INDEX_LOOKUP,
+    PLAN_PREFIX_RANGE,
+    PLAN_UNION
+} PlanType;
+
+/**
+ * @brief An access path: how candidate contacts are fetched before filtering.
+ */
+typedef struct Plan {
+    PlanType type;
+    const QueryNode *predicate; /**< Predicate answered by an index lookup or prefix range. */
+    const IndexBucket *bucket;  /**< Bucket found by an index lookup (may be NULL). */
+    AutocompleteField sorted;   /**< Sorted array walked by a prefix range. */
+    Contact *id_match;          /**< Contact found by an ID lookup (may be NULL). */
+    size_t estimate;            /**< Expected number of candidates. */
+    struct Plan *left;          /**< First input of a union. */
+    struct Plan *right;         /**< Second input of a union. */
+} Plan;
+
+static void plan_free(Plan *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    plan_free(plan->left);
+    plan_free(plan->right);
+    free(plan);
+}
+
+static const ContactIndex *index_for_field(const BookIndexes *indexes, QueryField field) {
+    switch (field) {
+        case FIELD_NAME:
+            return &indexes->by_name;
+        case FIELD_PHONE:
+            return &indexes->by_phone;
+        case FIELD_EMAIL:
+            return &indexes->by_email;
+        case FIELD_DOMAIN:
+            return &indexes->by_domain;
+        case FIELD_ID:
+            break;
+    }
+    return NULL;
+}
+
+/**
+ * @brief The autocomplete array that keeps a field sorted, if there is one.
+ */
+static bool sorted_field(QueryField field, AutocompleteField *sorted) {
+    switch (field) {
+        case FIELD_NAME:
+            *sorted = AUTOCOMPLETE_NAME;
+            return true;
+        case FIELD_PHONE:
+            *sorted = AUTOCOMPLETE_PHONE;
+            return true;
+        case FIELD_EMAIL:
+            *sorted = AUTOCOMPLETE_EMAIL;
+            return true;
+        case FIELD_ID:
+        case FIELD_DOMAIN:
+            break;
+    }
+    return false;
+}
+
+/**
+ * @brief Chooses an access path for a query node. Estimates for index lookups and prefix
+ * ranges are exact, since the planner probes the index while planning.
+ *
+ * Equality uses the hash indexes. A prefix on name, phone, or email walks its range of the
+ * autocomplete module's sorted arrays when the book has autocomplete enabled. Contains, and
+ * prefixes on id or domain, have no index and are answered by a (parallel) full scan.
+ */
+static Plan *plan_node(const AddressBook *book, const QueryNode *node) {
+    Plan *plan = calloc(1, sizeof(Plan));
+    if (plan == NULL) {
+        return NULL;
+    }
+    plan->type = PLAN_SCAN;
+    plan->estimate = (size_t)book->contact_count;
+
+    const BookIndexes *indexes = book->indexes;
+
+    if (node->type == NODE_PREDICATE) {
+        if (indexes != NULL && node->op == OP_EQUALS) {
+            plan->predicate = node;
+            if (node->field == FIELD_ID) {
+                int id;
+                plan->type = PLAN_ID_LOOKUP;
+                plan->id_match = parse_id(node->value, &id) ? id_index_lookup(&indexes->by_id, id)
+                                                            : NULL;
+                plan->estimate = plan->id_match != NULL ? 1 : 0;
+            }
+            else {
+                plan->type = PLAN_INDEX_LOOKUP;
+                plan->bucket = contact_index_lookup(index_for_field(indexes, node->field),
+                                                    node->value);
+                plan->estimate = plan->bucket != NULL ? plan->bucket->count : 0;
+            }
+        }
+        else if (node->op == OP_PREFIX && book->autocomplete != NULL &&
+                 sorted_field(node->field, &plan->sorted)) {
+            // A range covering most of the book is slower to walk than a parallel scan.
+            long count = autocomplete_prefix_count(book, plan->sorted, node->value);
+            if (count >= 0 && (size_t)count <= plan->estimate / 2) {
+                plan->type = PLAN_PREFIX_RANGE;
+                plan->predicate = node;
+                plan->estimate = (size_t)count;
+            }
+        }
+        return plan;
+    }
+
+    Plan *left = plan_node(book, node->left);
+    Plan *right = plan_node(book, node->right);
+    if (left == NULL || right == NULL) {
+        plan_free(left);
+        plan_free(right);
+        free(plan);
+        return NULL;
+    }
+
+    if (node->type == NODE_AND) {
+        // Drive from the most selective indexed side; the other side becomes a filter.
+        Plan *best = NULL;
+        if (left->type != PLAN_SCAN) {
+            best = left;
+        }
+        if (right->type != PLAN_SCAN && (best == NULL || right->estimate < best->estimate)) {
+            best = right;
+        }
+        if (best != NULL) {
+            plan_free(best == left ? right : left);
+            free(plan);
+            return best;
+        }
+    }
+    else if (left->type != PLAN_SCAN && right->type != PLAN_SCAN) {
+        // An OR can only avoid a scan if every branch has an index.
+        plan->type = PLAN_UNION;
+        plan->left = left;
+        plan->right = right;
+        plan->estimate = left->estimate + right->estimate;
+        return plan;
+    }
+
+    plan_free(left);
+    plan_free(right);
+    return plan;
+}
+
+// ========================= Executor ========================= //
+
+typedef struct {
+    const Contact **items;
+    size_t count;
+    size_t capacity;
+} ContactList;
+
+static int list_push(ContactList *list, const Contact *contact) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity == 0 ? 16 : list->capacity * 2;
+        const Contact **grown = realloc(list->items, sizeof(Contact *) * capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = contact;
+    return 0;
+}
+
+static int consider(ContactList *matches, const Query *query, const Contact *contact,
+                    size_t *examined) {
+    (*examined)++;
+    return query_matches(query, contact) ? list_push(matches, contact) : 0;
+}
+
+/**
+ * @brief What a prefix range walk needs to filter each contact it visits.
+ */
+typedef struct {
+    ContactList *matches;
+    const Query *query;
+    size_t *examined;
+} RangeWalk;
+
+static int consider_in_range(const Contact *contact, void *context) {
+    RangeWalk *walk = context;
+    return consider(walk->matches, walk->query, contact, walk->examined);
+}
+
+static bool scan_matches(const Contact *contact, void *context) {
+    return query_matches(context, contact);
+}
+
+/**
+ * @brief Runs the predicates on every contact, spread over the cores for large books. Both the
+ * matches and the examined count come from the contacts the scan read (a snapshot, when
+ * snapshots are on), never from book->contact_count, which a writer may have moved on.
+ */
+static int scan_all(const AddressBook *book, const Query *query, int thread_count,
+                    ContactList *matches, size_t *examined) {
+    ScanResult found;
+    if (parallel_scan(book, scan_matches, (void *)query, thread_count, &found, NULL) != 0) {
+        return -1;
+    }
+    *examined += found.scanned;
+
+    for (size_t i = 0; i < found.count; i++) {
+        if (list_push(matches, found.matches[i]) != 0) {
+            parallel_scan_free(&found);
+            return -1;
+        }
+    }
+    parallel_scan_free(&found);
+    return 0;
+}
+
+static int run_plan(const AddressBook *book, const Plan *plan, const Query *query,
+                    int thread_count, ContactList *matches, size_t *examined) {
+    switch (plan->type) {
+        case PLAN_SCAN:
+            return scan_all(book, query, thread_count, matches, examined);
+        case PLAN_ID_LOOKUP:
+            return plan->id_match != NULL ? consider(matches, query, plan->id_match, examined) : 0;
+        case PLAN_INDEX_LOOKUP:
+            for (size_t i = 0; plan->bucket != NULL && i < plan->bucket->count; i++) {
+                if (consider(matches, query, plan->bucket->contacts[i], examined) != 0) {
+                    return -1;
+                }
+            }
+            return 0;
+        case PLAN_PREFIX_RANGE: {
+            RangeWalk walk = {matches, query, examined};
+            return autocomplete_prefix_each(book, plan->sorted, plan->predicate->value,
+                                            consider_in_range, &walk) != 0
+                       ? -1
+                       : 0;
+        }
+        case PLAN_UNION:
+            if (run_plan(book, plan->left, query, thread_count, matches, examined) != 0) {
+                return -1;
+            }
+            return run_plan(book, plan->right, query, thread_count, matches, examined);
+    }
+    return 0;
+}
+
+static int compare_by_id(const void *a, const void *b) {
+    const Contact *left = *(const Contact *const *)a;
+    const Contact *right = *(const Contact *const *)b;
+
+    if (left->id != right->id) {
+        return left->id < right->id ? -1 : 1;
+    }
+    return (left > right) - (left < right);
+}
+
+int query_execute(const AddressBook *book, const Query *query, QueryResult *result) {
+    return query_execute_threads(book, query, 0, result);
+}
+
+int query_execute_threads(const AddressBook *book, const Query *query, int thread_count,
+                          QueryResult *result) {
+    result->contacts = NULL;
+    result->count = 0;
+    result->examined = 0;
+
+    TraceSpan plan_span = TRACE_BEGIN("query.plan");
+    Plan *plan = plan_node(book, query->root);
+    if (plan == NULL) {
+        TRACE_END(plan_span);
+        return -1;
+    }
+    TRACE_END_COUNT(plan_span, "estimate", plan->estimate);
+
+    TraceSpan execute_span = TRACE_BEGIN("query.execute");
+    ContactList matches = {NULL, 0, 0};
+    int status = run_plan(book, plan, query, thread_count, &matches, &result->examined);
+    bool is_union = plan->type == PLAN_UNION;
+    plan_free(plan);
+    TRACE_END_COUNT(execute_span, "examined", result->examined);
+
+    if (status != 0) {
+        free(matches.items);
+        return -1;
+    }
+
+    // Order by ID; a union may have found the same contact through both branches.
+    if (matches.count > 1) {
+        qsort(matches.items, matches.count, sizeof(Contact *), compare_by_id);
+    }
+    if (is_union) {
+        size_t unique = 0;
+        for (size_t i = 0; i < matches.count; i++) {
+            if (unique == 0 || matches.items[unique - 1] != matches.items[i]) {
+                matches.items[unique++] = matches.items[i];
+            }
+        }
+        matches.count = unique;
+    }
+
+    result->contacts = matches.items;
+    result->count = matches.count;
+    return 0;
+}
+
+void query_result_free(QueryResult *result) {
+    free(result->contacts);
+    result->contacts = NULL;
+    result->count = 0;
+}
+
+// ========================= Explain ========================= //
+
+static void explain_plan(const Plan *plan, int depth, FILE *out) {
+    fprintf(out, "%*s-> ", depth * 4, "");
+
+    switch (plan->type) {
+        case PLAN_SCAN: {
+            int threads = parallel_scan_threads(plan->estimate, 0);
+            if (threads > 1) {
+                fprintf(out, "Parallel full scan on %d threads (est. %zu rows)\n", threads,
+                        plan->estimate);
+            }
+            else {
+                fprintf(out, "Full scan of the contact list (est. %zu rows)\n", plan->estimate);
+            }
+            break;
+        }
+        case PLAN_ID_LOOKUP:
+        case PLAN_INDEX_LOOKUP:
+            fprintf(out, "Index lookup on %s = '%s' (est. %zu rows)\n",
+                    field_name(plan->predicate->field), plan->predicate->value, plan->estimate);
+            break;
+        case PLAN_PREFIX_RANGE:
+            fprintf(out, "Sorted range on %s ^= '%s' (est. %zu rows)\n",
+                    field_name(plan->predicate->field), plan->predicate->value, plan->estimate);
+            break;
+        case PLAN_UNION:
+            fprintf(out, "Union of index lookups (est. %zu rows)\n", plan->estimate);
+            explain_plan(plan->left, depth + 1, out);
+            explain_plan(plan->right, depth + 1, out);
+            break;
+    }
+}
+
+void query_explain(const AddressBook *book, const Query *query, FILE *out) {
+    char text[QUERY_MAX_LENGTH * 2];
+    query_to_string(query, text, sizeof(text));
+
+    fprintf(out, "Query : %s\n", text);
+    fprintf(out, "Plan  :\n");
+
+    Plan *plan = plan_node(book, query->root);
+    if (plan == NULL) {
+        fprintf(out, "    (could not build a plan: out of memory)\n");
+        return;
+    }
+    explain_plan(plan, 1, out);
+    fprintf(out, "    Filter each candidate on: %s\n", text);
+    plan_free(plan);
+}
+
+// ========================= User Interaction ========================= //
+
+void run_query(const AddressBook *book, QueryCache *cache) {
+
+    printf("\n<===============================| QUERY CONTACTS |===============================>\n");
+    printf("Ein: Give me a trail to follow, like: name ^= 'Sa' AND domain = 'corp.com'\n");
+    printf("Ein: Fields: id, name, phone, email, domain. Operators: = ^= ~=. Combine with AND/OR.\n");
+
+    int attempts = 0;
+    char text[QUERY_MAX_LENGTH];
+    char error[QUERY_ERROR_LENGTH];
+
+    do {
+        printf("\nQuery: ");
+        if (fgets(text, sizeof(text), stdin) == NULL) {
+            return;
+        }
+        remove_newline(text);
+
+        Query *query = query_parse(text, error, sizeof(error));
+        if (query == NULL) {
+            printf("Ein: *Tilts head* I couldn't follow that trail: %s.\n", error);
+            if (handle_attempt(&attempts) == CANCEL) {
+                return;
+            }
+            continue;
+        }
+
+        printf("\nEin: Here's how I'll sniff this out:\n");
+        query_explain(book, query, stdout);
+
+        QueryResult result;
+        int cached = query_cache_execute(cache, book, query, &result);
+        if (cached < 0) {
+            printf("Ein: *Whines* I couldn't fetch the results right now.\n");
+            query_free(query);
+            return;
+        }
+
+        if (cached == 1) {
+            QueryCacheStats stats;
+            query_cache_stats(cache, &stats);
+            printf("\nEin: I remember this trail! %zu match(es), nothing re-checked "
+                   "(%zu of %zu queries answered from memory).\n",
+                   result.count, stats.hits, stats.lookups);
+        }
+        else {
+            printf("\nEin: Checked %zu candidate(s), found %zu match(es).\n", result.examined,
+                   result.count);
+        }
+        if (result.count > 0) {
+            printf("-----------------------------------------------------------------------------\n");
+            printf("| %-4s | %-20s | %-15s | %-25s |\n", "ID", "Name", "Phone", "Email");
+            printf("-----------------------------------------------------------------------------\n");
+            for (size_t i = 0; i < result.count; i++) {
+                printf("| %-4d | %-20s | %-15s | %-25s |\n", result.contacts[i]->id,
+                       result.contacts[i]->name, result.contacts[i]->phone,
+                       result.contacts[i]->email);
+            }
+            printf("-----------------------------------------------------------------------------\n");
+        }
+
+        query_result_free(&result);
+        query_free(query);
+        return;
+
+    } while (attempts < MAX_ATTEMPTS);
+}
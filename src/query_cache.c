@@ -0,0 +1,227 @@
+/**
+ * @file query_cache.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the query result cache.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "address_book.h"
+#include "change_feed.h"
+#include "query.h"
+#include "query_cache.h"
+
+#define CACHE_KEY_LENGTH (QUERY_MAX_LENGTH * 2)
+
+/**
+ * @brief One cached result, linked into the recency list.
+ */
+typedef struct CacheEntry {
+    char *key;                /**< Canonical query text. */
+    uint64_t hash;            /**< Hash of @c key, compared before the text. */
+    Query *query;             /**< Own copy of the query, for invalidation. */
+    const Contact **contacts; /**< The result, ordered by ID. */
+    size_t count;
+    struct CacheEntry *prev;  /**< More recently used entry. */
+    struct CacheEntry *next;  /**< Less recently used entry. */
+} CacheEntry;
+
+struct QueryCache {
+    CacheEntry *newest;
+    CacheEntry *oldest;
+    size_t max_entries;
+    size_t max_contacts;
+    AddressBook *book;
+    int subscription;
+    QueryCacheStats stats;
+};
+
+static uint64_t key_hash(const char *key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char *c = (const unsigned char *)key; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static void unlink_entry(QueryCache *cache, CacheEntry *entry) {
+    if (entry->prev != NULL) {
+        entry->prev->next = entry->next;
+    }
+    else {
+        cache->newest = entry->next;
+    }
+    if (entry->next != NULL) {
+        entry->next->prev = entry->prev;
+    }
+    else {
+        cache->oldest = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void push_newest(QueryCache *cache, CacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->prev = entry;
+    }
+    else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+static void drop_entry(QueryCache *cache, CacheEntry *entry) {
+    unlink_entry(cache, entry);
+    cache->stats.entries--;
+    cache->stats.contacts -= entry->count;
+    query_free(entry->query);
+    free(entry->contacts);
+    free(entry->key);
+    free(entry);
+}
+
+/**
+ * @brief Drops the entries whose results a change affects: those the contact matched before
+ * the change, and those it matches after.
+ */
+static void invalidate(const ChangeRecord *change, void *context) {
+    QueryCache *cache = context;
+    CacheEntry *entry = cache->newest;
+    while (entry != NULL) {
+        CacheEntry *next = entry->next;
+        if ((change->op != CHANGE_CREATE && query_matches(entry->query, &change->before)) ||
+            (change->op != CHANGE_DELETE && query_matches(entry->query, &change->after))) {
+            drop_entry(cache, entry);
+            cache->stats.invalidations++;
+        }
+        entry = next;
+    }
+}
+
+static int copy_result(const Contact **contacts, size_t count, QueryResult *result) {
+    result->contacts = malloc(sizeof(Contact *) * (count > 0 ? count : 1));
+    if (result->contacts == NULL) {
+        return -1;
+    }
+    memcpy(result->contacts, contacts, sizeof(Contact *) * count);
+    result->count = count;
+    result->examined = 0;
+    return 0;
+}
+
+/**
+ * @brief Stores a fresh result, evicting the least recently used entries to make room. Results
+ * that cannot be stored are simply not cached.
+ */
+static void remember(QueryCache *cache, const char *key, uint64_t hash, const Query *query,
+                     const QueryResult *result) {
+    if (result->count > cache->max_contacts) {
+        return;
+    }
+    CacheEntry *entry = calloc(1, sizeof(CacheEntry));
+    if (entry == NULL) {
+        return;
+    }
+    entry->key = malloc(strlen(key) + 1);
+    entry->query = query_copy(query);
+    entry->contacts = malloc(sizeof(Contact *) * (result->count > 0 ? result->count : 1));
+    if (entry->key == NULL || entry->query == NULL || entry->contacts == NULL) {
+        free(entry->key);
+        query_free(entry->query);
+        free(entry->contacts);
+        free(entry);
+        return;
+    }
+    strcpy(entry->key, key);
+    entry->hash = hash;
+    if (result->count > 0) {
+        memcpy(entry->contacts, result->contacts, sizeof(Contact *) * result->count);
+    }
+    entry->count = result->count;
+
+    while (cache->oldest != NULL && (cache->stats.entries >= cache->max_entries ||
+                                     cache->stats.contacts + entry->count > cache->max_contacts)) {
+        drop_entry(cache, cache->oldest);
+        cache->stats.evictions++;
+    }
+    push_newest(cache, entry);
+    cache->stats.entries++;
+    cache->stats.contacts += entry->count;
+}
+
+QueryCache *query_cache_create(size_t max_entries, size_t max_contacts) {
+    QueryCache *cache = calloc(1, sizeof(QueryCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->max_entries = max_entries > 0 ? max_entries : 1;
+    cache->max_contacts = max_contacts;
+    cache->subscription = -1;
+    return cache;
+}
+
+int query_cache_attach(QueryCache *cache, AddressBook *book) {
+    if (cache->book != NULL || book_enable_change_feed(book, NULL) != 0) {
+        return -1;
+    }
+    cache->subscription = change_feed_subscribe(book, invalidate, cache);
+    if (cache->subscription < 0) {
+        return -1;
+    }
+    cache->book = book;
+    return 0;
+}
+
+int query_cache_execute(QueryCache *cache, const AddressBook *book, const Query *query,
+                        QueryResult *result) {
+    if (cache == NULL || cache->book != book) {
+        return query_execute(book, query, result) == 0 ? 0 : -1;
+    }
+
+    char key[CACHE_KEY_LENGTH];
+    query_to_string(query, key, sizeof(key));
+    uint64_t hash = key_hash(key);
+    cache->stats.lookups++;
+
+    for (CacheEntry *entry = cache->newest; entry != NULL; entry = entry->next) {
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            if (copy_result(entry->contacts, entry->count, result) != 0) {
+                return -1;
+            }
+            unlink_entry(cache, entry);
+            push_newest(cache, entry);
+            cache->stats.hits++;
+            return 1;
+        }
+    }
+
+    if (query_execute(book, query, result) != 0) {
+        return -1;
+    }
+    remember(cache, key, hash, query, result);
+    return 0;
+}
+
+void query_cache_stats(const QueryCache *cache, QueryCacheStats *stats) {
+    *stats = cache->stats;
+}
+
+void query_cache_free(QueryCache *cache) {
+    if (cache == NULL) {
+        return;
+    }
+    if (cache->book != NULL) {
+        change_feed_unsubscribe(cache->book, cache->subscription);
+    }
+    while (cache->newest != NULL) {
+        drop_entry(cache, cache->newest);
+    }
+    free(cache);
+}
@@ -0,0 +1,310 @@
+/**
+ * @file replica.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of read replicas and the replica subcommand.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // poll
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include "address_book.h"
+#include "ab_api.h"
+#include "change_feed.h"
+#include "contact_helper.h"
+#include "query.h"
+#include "query_cache.h"
+#include "replica.h"
+#include "search_cursor.h"
+
+#define REPLICA_LINE_LENGTH (QUERY_MAX_LENGTH + 16)
+
+struct Replica {
+    AddressBook book;
+    char *log_path;
+    ChangeCursor *cursor;   // NULL until the log exists.
+    QueryCache *cache;      // NULL if it could not be set up; queries then run uncached.
+    unsigned long long applied_sequence;
+    long long apply_lag_ms;
+    size_t applied;
+};
+
+static long long now_ms(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Makes the book hold a change's outcome: the after values for a create or update, no
+ * contact for a delete, whatever it held before.
+ * @return 0 on success, -1 if memory ran out.
+ */
+static int apply_change(AddressBook *book, const ChangeRecord *change) {
+    Contact *contact = NULL;
+    bool exists = ab_find(book, change->id, &contact) == VALID;
+
+    if (change->op == CHANGE_DELETE) {
+        return exists ? book_remove_contact(book, contact) : 0;
+    }
+    if (exists) {
+        return book_update_contact(book, contact, &change->after) != NULL ? 0 : -1;
+    }
+    Contact *added = malloc(sizeof(Contact));
+    if (added == NULL) {
+        return -1;
+    }
+    *added = change->after;
+    added->id = change->id;
+    added->next = NULL;
+    book_append_contact(book, added);
+    return 0;
+}
+
+Replica *replica_open(const char *csv_path, const char *log_path,
+                      unsigned long long from_sequence) {
+    Replica *replica = calloc(1, sizeof(Replica));
+    if (replica == NULL) {
+        return NULL;
+    }
+    initialize(&replica->book);
+    replica->log_path = malloc(strlen(log_path) + 1);
+    if (replica->log_path == NULL || load_contacts_csv(&replica->book, csv_path, NULL) == -2) {
+        replica_close(replica);
+        return NULL;
+    }
+    strcpy(replica->log_path, log_path);
+    replica->applied_sequence = from_sequence;
+    replica->apply_lag_ms = -1;
+
+    replica->cache = query_cache_create(QUERY_CACHE_DEFAULT_ENTRIES, QUERY_CACHE_DEFAULT_CONTACTS);
+    if (replica->cache != NULL && query_cache_attach(replica->cache, &replica->book) != 0) {
+        query_cache_free(replica->cache);
+        replica->cache = NULL;
+    }
+    return replica;
+}
+
+int replica_catch_up(Replica *replica) {
+    if (replica->cursor == NULL) {
+        replica->cursor = change_cursor_open(replica->log_path, replica->applied_sequence);
+        if (replica->cursor == NULL) {
+            return 0; // The primary has not written a change yet.
+        }
+    }
+
+    int count = 0;
+    int status;
+    ChangeRecord change;
+    while ((status = change_cursor_next(replica->cursor, &change)) == 1) {
+        if (apply_change(&replica->book, &change) != 0) {
+            return -1;
+        }
+        replica->applied_sequence = change.sequence;
+        replica->applied++;
+        if (change.time_ms > 0) {
+            replica->apply_lag_ms = now_ms() - change.time_ms;
+        }
+        count++;
+    }
+    return status < 0 ? -1 : count;
+}
+
+const AddressBook *replica_book(const Replica *replica) {
+    return &replica->book;
+}
+
+int replica_query(Replica *replica, const Query *query, QueryResult *result) {
+    return query_cache_execute(replica->cache, &replica->book, query, result);
+}
+
+void replica_status(Replica *replica, ReplicaStatus *status) {
+    status->applied_sequence = replica->applied_sequence;
+    status->log_sequence = replica->applied_sequence;
+    unsigned long long last = 0;
+    if (change_log_last_sequence(replica->log_path, &last) == 0 && last > status->log_sequence) {
+        status->log_sequence = last;
+    }
+    status->behind = status->log_sequence - status->applied_sequence;
+    status->backlog_bytes = replica->cursor != NULL ? change_cursor_backlog(replica->cursor) : 0;
+    status->apply_lag_ms = replica->apply_lag_ms;
+    status->applied = replica->applied;
+    status->contacts = (size_t)replica->book.contact_count;
+}
+
+void replica_close(Replica *replica) {
+    if (replica == NULL) {
+        return;
+    }
+    query_cache_free(replica->cache);
+    change_cursor_close(replica->cursor);
+    free_address_book(&replica->book);
+    free(replica->log_path);
+    free(replica);
+}
+
+// ========================= Replica Subcommand ========================= //
+
+static void print_replica_usage(void) {
+    printf("Usage: addressbook replica [--csv <file>] [--log <file>] [--from <sequence>]\n");
+    printf("  Follows the change log written by `addressbook --feed` and answers read-only\n");
+    printf("  commands, one per line on standard input:\n");
+    printf("    query <expression> | phone <digits> | get <id> | lag | quit\n");
+    printf("  --csv <file>        Contacts to start from (default: contacts.csv)\n");
+    printf("  --log <file>        Change log to follow (default: %s)\n", CHANGE_FEED_FILE_NAME);
+    printf("  --from <sequence>   Changes already in the CSV (default: replay the whole log)\n");
+}
+
+static void print_replica_row(const Contact *contact) {
+    printf(" %-7d | %-20s | %-15s | %-30s\n", contact->id, contact->name, contact->phone,
+           contact->email);
+}
+
+static void print_replica_lag(Replica *replica) {
+    ReplicaStatus status;
+    replica_status(replica, &status);
+    printf("Ein: Applied change %llu of %llu (%llu behind, %ld byte(s) unread), %zu contact(s).\n",
+           status.applied_sequence, status.log_sequence, status.behind, status.backlog_bytes,
+           status.contacts);
+    if (status.apply_lag_ms >= 0) {
+        printf("Ein: The last change landed %lld ms after the primary made it.\n",
+               status.apply_lag_ms);
+    }
+}
+
+/**
+ * @brief Answers one command line.
+ * @return false once the command is quit.
+ */
+static bool replica_command(Replica *replica, char *line) {
+    char *argument = strchr(line, ' ');
+    if (argument != NULL) {
+        *argument++ = '\0';
+    }
+    const AddressBook *book = replica_book(replica);
+
+    if (strcmp(line, "quit") == 0) {
+        return false;
+    }
+    if (strcmp(line, "lag") == 0) {
+        print_replica_lag(replica);
+    }
+    else if (strcmp(line, "get") == 0 && argument != NULL) {
+        Contact *contact = NULL;
+        if (ab_find(book, atoi(argument), &contact) == VALID) {
+            print_replica_row(contact);
+        }
+        else {
+            printf("Ein: *Sniffs around* Nope, I couldn't find contact %s.\n", argument);
+        }
+    }
+    else if (strcmp(line, "phone") == 0 && argument != NULL) {
+        SearchCursor cursor;
+        // A phone-suffix search can only be refused for having too few digits.
+        if (search_cursor_open(&cursor, book, SEARCH_PHONE_ENDS_WITH, argument, 0) !=
+            SEARCH_CURSOR_OK) {
+            printf("Ein: *Tilts head* I need at least %d digits to follow a number.\n",
+                   PHONE_SUFFIX_DIGITS);
+            return true;
+        }
+        size_t found = 0;
+        for (Contact *contact; (contact = search_cursor_next(&cursor)) != NULL; found++) {
+            print_replica_row(contact);
+        }
+        printf("Ein: %zu match(es).\n", found);
+    }
+    else if (strcmp(line, "query") == 0 && argument != NULL) {
+        char error[QUERY_ERROR_LENGTH];
+        Query *query = query_parse(argument, error, sizeof(error));
+        if (query == NULL) {
+            printf("Ein: *Tilts head* I couldn't follow that trail: %s.\n", error);
+            return true;
+        }
+        QueryResult result;
+        if (replica_query(replica, query, &result) < 0) {
+            printf("Ein: *Whines* I couldn't fetch the results right now.\n");
+        }
+        else {
+            for (size_t i = 0; i < result.count; i++) {
+                print_replica_row(result.contacts[i]);
+            }
+            printf("Ein: %zu match(es).\n", result.count);
+            query_result_free(&result);
+        }
+        query_free(query);
+    }
+    else {
+        printf("Ein: *Tilts head* I only answer query, phone, get, lag, and quit.\n");
+    }
+    return true;
+}
+
+int run_replica_command(int argc, char *argv[]) {
+    const char *csv_path = "contacts.csv";
+    const char *log_path = CHANGE_FEED_FILE_NAME;
+    unsigned long long from = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            from = strtoull(argv[++i], NULL, 10);
+        }
+        else {
+            print_replica_usage();
+            return 1;
+        }
+    }
+
+    Replica *replica = replica_open(csv_path, log_path, from);
+    if (replica == NULL) {
+        printf("Ein: *Whines* I couldn't start a replica from '%s'.\n", csv_path);
+        return 1;
+    }
+    if (replica_catch_up(replica) < 0) {
+        printf("Ein: *Whines* I couldn't follow '%s'.\n", log_path);
+        replica_close(replica);
+        return 1;
+    }
+    printf("Ein: Replica ready with %d contact(s), following %s.\n",
+           replica_book(replica)->contact_count, log_path);
+
+    // Unbuffered, so poll() sees every command that has not been read yet.
+    setvbuf(stdin, NULL, _IONBF, 0);
+    struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+    char line[REPLICA_LINE_LENGTH];
+    int status = 0;
+    for (;;) {
+        fflush(stdout);
+        int ready = poll(&input, 1, CHANGE_FEED_FOLLOW_INTERVAL_MS);
+        // Catch up before every answer too, so it reflects everything the primary has logged.
+        if (replica_catch_up(replica) < 0) {
+            printf("Ein: *Whines* I couldn't follow '%s'.\n", log_path);
+            status = 1;
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            break;
+        }
+        remove_newline(line);
+        if (!replica_command(replica, line)) {
+            break;
+        }
+    }
+
+    replica_close(replica);
+    return status;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file search_cursor.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the streaming search cursor.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include "address_book.h"
+#include "contact_index.h"
+#include "phonetic.h"
+#include "search_cursor.h"
+
+/**
+ * @brief Picks the index bucket holding every possible match, or leaves the cursor on the list.
+ */
+static void choose_source(SearchCursor *cursor) {
+    const BookIndexes *indexes = cursor->book->indexes;
+    if (indexes == NULL) {
+        cursor->node = cursor->book->head;
+        return;
+    }
+
+    char key[MAX_EMAIL_LENGTH];
+    switch (cursor->field) {
+        case SEARCH_BY_NAME:
+            index_fold_key(cursor->value, key);
+            cursor->bucket = contact_index_lookup(&indexes->by_name, key);
+            break;
+        case SEARCH_BY_PHONE:
+            cursor->bucket = contact_index_lookup(&indexes->by_phone, cursor->value);
+            break;
+        case SEARCH_BY_EMAIL:
+            index_fold_key(cursor->value, key);
+            cursor->bucket = contact_index_lookup(&indexes->by_email, key);
+            break;
+        case SEARCH_PHONE_ENDS_WITH:
+            // Either number ends in the other, so both end in the same indexed digits.
+            cursor->tails = &indexes->by_phone_tail;
+            cursor->tail = phone_tail_key(cursor->value);
+            return;
+        default:
+            // Every query code must match, so the smallest of their buckets holds all matches.
+            for (int q = 0; q < cursor->code_count; q++) {
+                const IndexBucket *bucket =
+                    contact_index_lookup(&indexes->by_sound, cursor->codes[q]);
+                if (bucket == NULL) {
+                    cursor->bucket = NULL;
+                    break;
+                }
+                if (cursor->bucket == NULL || bucket->count < cursor->bucket->count) {
+                    cursor->bucket = bucket;
+                }
+            }
+            break;
+    }
+    cursor->done = cursor->bucket == NULL;
+}
+
+static bool cursor_matches(SearchCursor *cursor, const Contact *contact) {
+    switch (cursor->field) {
+        case SEARCH_BY_NAME:
+            return strcmp(cursor->value, contact->name) == 0;
+        case SEARCH_BY_PHONE:
+            return strcmp(cursor->value, contact->phone) == 0;
+        case SEARCH_BY_EMAIL:
+            return strcmp(cursor->value, contact->email) == 0;
+        case SEARCH_PHONE_ENDS_WITH: {
+            char digits[MAX_PHONE_LENGTH];
+            phone_digits(contact->phone, digits, sizeof(digits));
+            return phone_suffix_matches(cursor->value, digits);
+        }
+        default:
+            // A single code's bucket holds exactly the names with that code.
+            return (cursor->bucket != NULL && cursor->code_count == 1) ||
+                   phonetic_name_matches(contact->name, cursor->codes, cursor->code_count);
+    }
+}
+
+SearchCursorStatus search_cursor_open(SearchCursor *cursor, const AddressBook *book,
+                                      SearchOption field, const char *value, size_t limit) {
+    char digits[MAX_EMAIL_LENGTH];
+    if (field < SEARCH_BY_NAME || field > SEARCH_PHONE_ENDS_WITH || field == SEARCH_CANCEL) {
+        return SEARCH_CURSOR_BAD_FIELD;
+    }
+    if (field == SEARCH_PHONE_ENDS_WITH &&
+        phone_digits(value, digits, sizeof(digits)) < PHONE_SUFFIX_DIGITS) {
+        return SEARCH_CURSOR_TOO_FEW_DIGITS;
+    }
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->book = book;
+    cursor->field = field;
+    cursor->limit = limit;
+
+    if (field == SEARCH_SOUNDS_LIKE) {
+        cursor->code_count = phonetic_name_codes(value, cursor->codes);
+        if (cursor->code_count == 0) {
+            cursor->done = 1;
+            return SEARCH_CURSOR_OK;
+        }
+    }
+    else if (field == SEARCH_PHONE_ENDS_WITH) {
+        strcpy(cursor->value, digits);
+    }
+    else if (strlen(value) >= sizeof(cursor->value)) {
+        cursor->done = 1; // Longer than any stored field, so nothing can match.
+        return SEARCH_CURSOR_OK;
+    }
+    else {
+        strcpy(cursor->value, value);
+    }
+    choose_source(cursor);
+    return SEARCH_CURSOR_OK;
+}
+
+Contact *search_cursor_next(SearchCursor *cursor) {
+    if (cursor->done || (cursor->limit > 0 && cursor->yielded >= cursor->limit)) {
+        return NULL;
+    }
+
+    for (;;) {
+        Contact *candidate = NULL;
+        if (cursor->tails != NULL) {
+            candidate = phone_tail_index_next(cursor->tails, cursor->tail, &cursor->position);
+        }
+        else if (cursor->bucket != NULL) {
+            if (cursor->position < cursor->bucket->count) {
+                candidate = cursor->bucket->contacts[cursor->position++];
+            }
+        }
+        else if (cursor->node != NULL) {
+            candidate = (Contact *)cursor->node;
+            cursor->node = candidate->next;
+        }
+        if (candidate == NULL) {
+            cursor->done = 1;
+            return NULL;
+        }
+
+        cursor->examined++;
+        if (cursor_matches(cursor, candidate)) {
+            cursor->yielded++;
+            return candidate;
+        }
+    }
+}
+
+size_t search_cursor_examined(const SearchCursor *cursor) {
+    return cursor->examined;
+}
@@ -0,0 +1,590 @@
+/**
+ * @file sharded_book.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of phone-partitioned shards with parallel load, save, and query.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "address_book.h"
+#include "ab_api.h"
+#include "contact_helper.h"
+#include "contact_index.h"
+#include "sharded_book.h"
+
+/**
+ * @brief Per-shard work item for the parallel load, save, and query tasks.
+ */
+typedef struct {
+    AddressBook *book;
+    const Query *query;
+    char path[SHARD_PATH_LENGTH];
+    int count;               // Contacts loaded/written, or a negative error code.
+    QueryResult result;
+    int status;
+} ShardTask;
+
+// ========================= Helpers ========================= //
+
+/**
+ * @brief FNV-1a hash of a phone, so shard assignment is stable across runs and builds.
+ */
+static unsigned int hash_phone(const char *phone) {
+    unsigned int hash = 2166136261u;
+    while (*phone != '\0') {
+        hash ^= (unsigned char)*phone++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static Contact *copy_contact(int id, const Contact *values) {
+    Contact *contact = malloc(sizeof(Contact));
+    if (contact == NULL) {
+        return NULL;
+    }
+    contact->id = id;
+    strcpy(contact->name, values->name);
+    strcpy(contact->phone, values->phone);
+    strcpy(contact->email, values->email);
+    contact->next = NULL;
+    return contact;
+}
+
+static bool email_taken(const ShardedBook *sharded, const char *email) {
+    for (int i = 0; i < sharded->shard_count; i++) {
+        if (is_email_duplicate(email, &sharded->shards[i]) == INVALID_DUPLICATE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static ShardTask *create_tasks(const ShardedBook *sharded, const char *pattern) {
+    if (sharded->shard_count < 1) {
+        return NULL;
+    }
+    ShardTask *tasks = calloc((size_t)sharded->shard_count, sizeof(ShardTask));
+    if (tasks == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < sharded->shard_count; i++) {
+        tasks[i].book = &sharded->shards[i];
+        if (pattern != NULL) {
+            snprintf(tasks[i].path, sizeof(tasks[i].path), pattern, i);
+        }
+    }
+    return tasks;
+}
+
+/**
+ * @brief Submits one task per shard and waits for all of them; runs inline if submitting fails.
+ */
+static void run_on_shards(const ShardedBook *sharded, ThreadTask task, ShardTask *tasks) {
+    for (int i = 0; i < sharded->shard_count; i++) {
+        if (thread_pool_submit(sharded->pool, task, &tasks[i]) != 0) {
+            task(&tasks[i]);
+        }
+    }
+    thread_pool_wait(sharded->pool);
+}
+
+static void load_shard_task(void *arg) {
+    ShardTask *task = arg;
+    task->count = load_contacts_csv(task->book, task->path, NULL);
+}
+
+static void save_shard_task(void *arg) {
+    ShardTask *task = arg;
+    task->count = save_contacts_csv(task->book, task->path);
+}
+
+static void query_shard_task(void *arg) {
+    ShardTask *task = arg;
+    // The shards already run in parallel; a parallel scan inside each would oversubscribe.
+    task->status = query_execute_threads(task->book, task->query, 1, &task->result);
+}
+
+/**
+ * @brief Which shard a misplaced-contact scan is looking at.
+ */
+typedef struct {
+    const ShardedBook *sharded;
+    int shard;
+} RehomeScan;
+
+static int is_misplaced(const Contact *contact, void *context) {
+    const RehomeScan *scan = context;
+    return shard_for_phone(scan->sharded, contact->phone) != scan->shard;
+}
+
+/**
+ * @brief Moves contacts whose phone belongs to another shard (e.g. after a shard-count change).
+ */
+static void rehome_contacts(ShardedBook *sharded) {
+    for (int i = 0; i < sharded->shard_count; i++) {
+        RehomeScan scan = {sharded, i};
+        book_suspend_indexing(&sharded->shards[i]);
+        Contact *moved = book_extract_contacts(&sharded->shards[i], is_misplaced, &scan);
+        book_resume_indexing(&sharded->shards[i]);
+        while (moved != NULL) {
+            Contact *next = moved->next;
+            book_append_contact(&sharded->shards[shard_for_phone(sharded, moved->phone)], moved);
+            moved = next;
+        }
+    }
+}
+
+// ========================= Lifecycle ========================= //
+
+int sharded_book_init(ShardedBook *sharded, int shard_count, int thread_count) {
+    sharded->shards = NULL;
+    sharded->shard_count = 0;
+    sharded->next_id = 1;
+    sharded->pool = NULL;
+
+    if (shard_count < 1 || shard_count > SHARD_MAX_COUNT) {
+        return -1;
+    }
+
+    sharded->shards = malloc(sizeof(AddressBook) * (size_t)shard_count);
+    if (sharded->shards == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < shard_count; i++) {
+        initialize(&sharded->shards[i]);
+    }
+    sharded->shard_count = shard_count;
+
+    sharded->pool = thread_pool_create(thread_count < 1 ? shard_count : thread_count);
+    if (sharded->pool == NULL) {
+        sharded_book_free(sharded);
+        return -1;
+    }
+    return 0;
+}
+
+void sharded_book_free(ShardedBook *sharded) {
+    for (int i = 0; i < sharded->shard_count; i++) {
+        free_address_book(&sharded->shards[i]);
+    }
+    free(sharded->shards);
+    thread_pool_destroy(sharded->pool);
+    sharded->shards = NULL;
+    sharded->shard_count = 0;
+    sharded->pool = NULL;
+}
+
+int shard_for_phone(const ShardedBook *sharded, const char *phone) {
+    return (int)(hash_phone(phone) % (unsigned int)sharded->shard_count);
+}
+
+int sharded_book_count(const ShardedBook *sharded) {
+    int total = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        total += sharded->shards[i].contact_count;
+    }
+    return total;
+}
+
+// ========================= Persistence ========================= //
+
+int sharded_book_load(ShardedBook *sharded, const char *pattern) {
+    ShardTask *tasks = create_tasks(sharded, pattern);
+    if (tasks == NULL) {
+        return -1;
+    }
+
+    run_on_shards(sharded, load_shard_task, tasks);
+
+    int total = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        if (tasks[i].count == -2) {
+            total = -1;
+        }
+        else if (total >= 0 && tasks[i].count > 0) {
+            total += tasks[i].count;
+        }
+        if (sharded->shards[i].next_id > sharded->next_id) {
+            sharded->next_id = sharded->shards[i].next_id;
+        }
+    }
+    free(tasks);
+
+    // Files past the last shard were written with a larger shard count; fold them in too.
+    for (int k = sharded->shard_count; total >= 0; k++) {
+        char path[SHARD_PATH_LENGTH];
+        snprintf(path, sizeof(path), pattern, k);
+        int loaded = load_contacts_csv(&sharded->shards[0], path, NULL);
+        if (loaded == -1) {
+            break;
+        }
+        total = loaded < 0 ? -1 : total + loaded;
+    }
+    if (sharded->shards[0].next_id > sharded->next_id) {
+        sharded->next_id = sharded->shards[0].next_id;
+    }
+
+    if (total >= 0) {
+        rehome_contacts(sharded);
+    }
+    return total;
+}
+
+int sharded_book_save(const ShardedBook *sharded, const char *pattern) {
+    ShardTask *tasks = create_tasks(sharded, pattern);
+    if (tasks == NULL) {
+        return -1;
+    }
+
+    run_on_shards(sharded, save_shard_task, tasks);
+
+    int total = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        if (tasks[i].count < 0) {
+            total = -1;
+        }
+        else if (total >= 0) {
+            total += tasks[i].count;
+        }
+    }
+    free(tasks);
+
+    // Drop files left over from a larger shard count so the next load does not read them twice.
+    if (total >= 0) {
+        for (int k = sharded->shard_count;; k++) {
+            char path[SHARD_PATH_LENGTH];
+            snprintf(path, sizeof(path), pattern, k);
+            if (remove(path) != 0) {
+                break;
+            }
+        }
+    }
+    return total;
+}
+
+// ========================= Mutations ========================= //
+
+int sharded_book_add(ShardedBook *sharded, const char *name, const char *phone,
+                     const char *email, ValidationStatus *status) {
+    *status = is_valid_name(name);
+    if (*status == VALID) {
+        *status = is_valid_phone(phone);
+    }
+    if (*status == VALID) {
+        *status = is_valid_email(email);
+    }
+    if (*status != VALID) {
+        return -1;
+    }
+
+    int owner = shard_for_phone(sharded, phone);
+    if (is_phone_duplicate(phone, &sharded->shards[owner]) == INVALID_DUPLICATE ||
+        email_taken(sharded, email)) {
+        *status = INVALID_DUPLICATE;
+        return -1;
+    }
+
+    Contact values;
+    strcpy(values.name, name);
+    strcpy(values.phone, phone);
+    strcpy(values.email, email);
+
+    Contact *contact = copy_contact(sharded->next_id, &values);
+    if (contact == NULL) {
+        *status = INVALID_NO_MEMORY;
+        return -1;
+    }
+    sharded->next_id++;
+    book_append_contact(&sharded->shards[owner], contact);
+    return contact->id;
+}
+
+int sharded_book_import(ShardedBook *sharded, const AddressBook *book) {
+    int copied = 0;
+    for (const Contact *current = book->head; current != NULL; current = current->next) {
+        Contact *contact = copy_contact(current->id, current);
+        if (contact == NULL) {
+            return -1;
+        }
+        book_append_contact(&sharded->shards[shard_for_phone(sharded, current->phone)], contact);
+        copied++;
+    }
+    if (book->next_id > sharded->next_id) {
+        sharded->next_id = book->next_id;
+    }
+    return copied;
+}
+
+/**
+ * @brief Finds a contact and the shard holding it (IDs are not tied to a shard).
+ */
+static Contact *find_with_shard(const ShardedBook *sharded, int id, int *shard) {
+    for (int i = 0; i < sharded->shard_count; i++) {
+        Contact *contact;
+        if (ab_find(&sharded->shards[i], id, &contact) == VALID) {
+            *shard = i;
+            return contact;
+        }
+    }
+    return NULL;
+}
+
+Contact *sharded_book_find(const ShardedBook *sharded, int id) {
+    int shard;
+    return find_with_shard(sharded, id, &shard);
+}
+
+ValidationStatus sharded_book_update(ShardedBook *sharded, int id, const Contact *values) {
+    int shard;
+    Contact *contact = find_with_shard(sharded, id, &shard);
+    if (contact == NULL) {
+        return INVALID_NOT_FOUND;
+    }
+
+    ValidationStatus status = is_valid_name(values->name);
+    if (status == VALID) {
+        status = is_valid_phone(values->phone);
+    }
+    if (status == VALID) {
+        status = is_valid_email(values->email);
+    }
+    if (status != VALID) {
+        return status;
+    }
+
+    int owner = shard_for_phone(sharded, values->phone);
+    if (strcmp(values->phone, contact->phone) != 0 &&
+        is_phone_duplicate(values->phone, &sharded->shards[owner]) == INVALID_DUPLICATE) {
+        return INVALID_DUPLICATE;
+    }
+
+    char old_key[MAX_EMAIL_LENGTH];
+    char new_key[MAX_EMAIL_LENGTH];
+    index_fold_key(contact->email, old_key);
+    index_fold_key(values->email, new_key);
+    if (strcmp(old_key, new_key) != 0 && email_taken(sharded, values->email)) {
+        return INVALID_DUPLICATE;
+    }
+
+    if (owner == shard) {
+        return book_update_contact(&sharded->shards[shard], contact, values) != NULL
+                   ? VALID
+                   : INVALID_NO_MEMORY;
+    }
+
+    Contact *moved = copy_contact(id, values);
+    if (moved == NULL) {
+        return INVALID_NO_MEMORY;
+    }
+    book_remove_contact(&sharded->shards[shard], contact);
+    book_append_contact(&sharded->shards[owner], moved);
+    return VALID;
+}
+
+int sharded_book_remove(ShardedBook *sharded, int id) {
+    int shard;
+    Contact *contact = find_with_shard(sharded, id, &shard);
+    if (contact == NULL) {
+        return -1;
+    }
+    return book_remove_contact(&sharded->shards[shard], contact);
+}
+
+// ========================= Query ========================= //
+
+int sharded_book_query(const ShardedBook *sharded, const Query *query, QueryResult *result) {
+    result->contacts = NULL;
+    result->count = 0;
+    result->examined = 0;
+
+    ShardTask *tasks = create_tasks(sharded, NULL);
+    if (tasks == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < sharded->shard_count; i++) {
+        tasks[i].query = query;
+    }
+
+    run_on_shards(sharded, query_shard_task, tasks);
+
+    int status = 0;
+    size_t total = 0;
+    for (int i = 0; i < sharded->shard_count; i++) {
+        if (tasks[i].status != 0) {
+            status = -1;
+        }
+        total += tasks[i].result.count;
+        result->examined += tasks[i].result.examined;
+    }
+
+    if (status == 0 && total > 0) {
+        result->contacts = malloc(sizeof(Contact *) * total);
+        if (result->contacts == NULL) {
+            status = -1;
+        }
+    }
+
+    // Each shard's matches are already ordered by ID, so a k-way merge keeps that order.
+    if (status == 0) {
+        size_t *cursor = sharded->shard_count > 0
+                             ? calloc((size_t)sharded->shard_count, sizeof(size_t))
+                             : NULL;
+        if (cursor == NULL) {
+            status = -1;
+        }
+        while (status == 0 && result->count < total) {
+            int best = -1;
+            for (int i = 0; i < sharded->shard_count; i++) {
+                if (cursor[i] < tasks[i].result.count &&
+                    (best < 0 || tasks[i].result.contacts[cursor[i]]->id <
+                                     tasks[best].result.contacts[cursor[best]]->id)) {
+                    best = i;
+                }
+            }
+            result->contacts[result->count++] = tasks[best].result.contacts[cursor[best]++];
+        }
+        free(cursor);
+    }
+
+    for (int i = 0; i < sharded->shard_count; i++) {
+        query_result_free(&tasks[i].result);
+    }
+    free(tasks);
+
+    if (status != 0) {
+        query_result_free(result);
+    }
+    return status;
+}
+
+// ========================= Command Line ========================= //
+
+static void print_shards_usage(void) {
+    printf("Usage: addressbook shards <count> split|stats|query \"<query>\"\n");
+    printf("  split  Distribute contacts.csv across <count> shard files (%s)\n",
+           SHARD_FILE_PATTERN);
+    printf("  stats  Load the shards in parallel and show how contacts are spread\n");
+    printf("  query  Load the shards and run a query on all of them in parallel\n");
+}
+
+static double elapsed_seconds(const struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int split_command(ShardedBook *sharded) {
+    AddressBook book;
+    initialize(&book);
+    int loaded = load_contacts_csv(&book, "contacts.csv", NULL);
+    if (loaded < 0) {
+        printf("Ein: *Sniffs around* I couldn't read 'contacts.csv' to split it.\n");
+        return 1;
+    }
+
+    int copied = sharded_book_import(sharded, &book);
+    free_address_book(&book);
+    if (copied < 0 || sharded_book_save(sharded, SHARD_FILE_PATTERN) < 0) {
+        printf("Ein: *Whines* I couldn't write the shard files.\n");
+        return 1;
+    }
+    printf("Ein: Split %d contact(s) across %d shard(s).\n", copied, sharded->shard_count);
+    return 0;
+}
+
+static int query_command(const ShardedBook *sharded, const char *text) {
+    char error[QUERY_ERROR_LENGTH];
+    Query *query = query_parse(text, error, sizeof(error));
+    if (query == NULL) {
+        printf("Ein: *Tilts head* I couldn't follow that trail: %s.\n", error);
+        return 1;
+    }
+
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    QueryResult result;
+    int status = sharded_book_query(sharded, query, &result);
+    query_free(query);
+    if (status != 0) {
+        printf("Ein: *Whines* I couldn't fetch the results right now.\n");
+        return 1;
+    }
+
+    printf("Ein: Checked %zu candidate(s) across %d shard(s), found %zu match(es) in %.3fs.\n",
+           result.examined, sharded->shard_count, result.count, elapsed_seconds(&start));
+    if (result.count > 0) {
+        printf("-----------------------------------------------------------------------------\n");
+        printf("| %-4s | %-20s | %-15s | %-25s |\n", "ID", "Name", "Phone", "Email");
+        printf("-----------------------------------------------------------------------------\n");
+        for (size_t i = 0; i < result.count; i++) {
+            printf("| %-4d | %-20s | %-15s | %-25s |\n", result.contacts[i]->id,
+                   result.contacts[i]->name, result.contacts[i]->phone,
+                   result.contacts[i]->email);
+        }
+        printf("-----------------------------------------------------------------------------\n");
+    }
+    query_result_free(&result);
+    return 0;
+}
+
+int run_shards_command(int argc, char *argv[]) {
+    if (argc < 2) {
+        print_shards_usage();
+        return 1;
+    }
+
+    int shard_count = atoi(argv[0]);
+    const char *action = argv[1];
+    bool is_query = strcmp(action, "query") == 0;
+    if (shard_count < 1 || shard_count > SHARD_MAX_COUNT) {
+        printf("Ein: The shard count must be between 1 and %d.\n", SHARD_MAX_COUNT);
+        return 1;
+    }
+    if ((is_query && argc != 3) ||
+        (!is_query && (argc != 2 || (strcmp(action, "split") != 0 &&
+                                     strcmp(action, "stats") != 0)))) {
+        print_shards_usage();
+        return 1;
+    }
+
+    ShardedBook sharded;
+    if (sharded_book_init(&sharded, shard_count, 0) != 0) {
+        printf("Ein: *Whines* I couldn't set up the shards.\n");
+        return 1;
+    }
+
+    int status = 0;
+    if (strcmp(action, "split") == 0) {
+        status = split_command(&sharded);
+    }
+    else {
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        int loaded = sharded_book_load(&sharded, SHARD_FILE_PATTERN);
+        if (loaded < 0) {
+            printf("Ein: *Tilts head* One of the shard files looks damaged.\n");
+            status = 1;
+        }
+        else if (is_query) {
+            status = query_command(&sharded, argv[2]);
+        }
+        else {
+            printf("Ein: Loaded %d contact(s) from %d shard(s) in %.3fs on %d thread(s).\n",
+                   loaded, shard_count, elapsed_seconds(&start),
+                   thread_pool_size(sharded.pool));
+            for (int i = 0; i < shard_count; i++) {
+                char path[SHARD_PATH_LENGTH];
+                snprintf(path, sizeof(path), SHARD_FILE_PATTERN, i);
+                printf("  Shard %-3d %-24s %d contact(s)\n", i, path,
+                       sharded.shards[i].contact_count);
+            }
+        }
+    }
+
+    sharded_book_free(&sharded);
+    return status;
+}
@@ -0,0 +1,820 @@
+/**
+ * @file shared_book.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the shared-memory book and the shared subcommand.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // shm_open, mmap, ftruncate, nanosleep, process-shared rwlocks
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "address_book.h"
+#include "contact_helper.h"
+#include "convert.h"
+#include "shared_book.h"
+
+#define SHARED_MAGIC "ABSHM01\n"
+#define SHARED_LINE_LENGTH 512
+#define SHARED_OPEN_WAIT_MS 2000 // how long an opener waits for a region still being created
+#define NO_RECORD 0u
+
+/**
+ * @brief Start of the region. Offsets are from the start of the region.
+ */
+typedef struct {
+    char magic[8];
+    atomic_uint ready;         // Set last by the creator, once everything below is initialised.
+    uint32_t capacity;
+    uint32_t bucket_count;     // Per hash table, a power of two.
+    uint64_t region_bytes;
+    uint64_t buckets_offset;   // ID, phone, and email tables, back to back.
+    uint64_t links_offset;
+    uint64_t records_offset;
+    pthread_rwlock_t lock;
+    // Everything below is only touched under the lock.
+    uint32_t count;
+    uint32_t head;             // First and last record of the list, in insertion order.
+    uint32_t tail;
+    uint32_t free_head;        // Records freed by removals, chained through next.
+    uint32_t high_water;       // Records 1..high_water have been used at some point.
+    int32_t next_id;
+    uint64_t changes;
+} SharedHeader;
+
+/**
+ * @brief Where a record sits in the list and in each hash chain (record numbers, 0 for none).
+ */
+typedef struct {
+    uint32_t prev;
+    uint32_t next;
+    uint32_t next_by_id;
+    uint32_t next_by_phone;
+    uint32_t next_by_email;
+} SharedLinks;
+
+struct SharedBook {
+    SharedHeader *header;
+    size_t size;
+    uint32_t *buckets[3];     // Indexed by SharedField.
+    SharedLinks *links;       // Indexed by record number.
+    SharedContact *records;   // Indexed by record number; entry 0 is unused.
+};
+
+// ========================= Layout ========================= //
+
+static size_t align_up(size_t value) {
+    return (value + 63) & ~(size_t)63;
+}
+
+static void map_layout(SharedBook *book, void *base) {
+    char *region = base;
+    book->header = base;
+    uint32_t *buckets = (uint32_t *)(region + book->header->buckets_offset);
+    for (int field = 0; field < 3; field++) {
+        book->buckets[field] = buckets + (size_t)field * book->header->bucket_count;
+    }
+    book->links = (SharedLinks *)(region + book->header->links_offset);
+    book->records = (SharedContact *)(region + book->header->records_offset);
+}
+
+static uint32_t id_hash(int id) {
+    uint32_t h = (uint32_t)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * @brief FNV-1a hash of a phone, or of an email folded to lowercase.
+ */
+static uint32_t text_hash(const char *text, bool fold) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++) {
+        hash ^= fold ? (unsigned char)tolower(*c) : *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool same_email(const char *a, const char *b) {
+    while (*a != '\0' && tolower((unsigned char)*a) == tolower((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+static uint32_t *bucket_of(const SharedBook *book, SharedField field, const SharedContact *key) {
+    uint32_t hash;
+    if (field == SHARED_BY_ID) {
+        hash = id_hash(key->id);
+    }
+    else if (field == SHARED_BY_PHONE) {
+        hash = text_hash(key->phone, false);
+    }
+    else {
+        hash = text_hash(key->email, true);
+    }
+    return &book->buckets[field][hash & (book->header->bucket_count - 1)];
+}
+
+static uint32_t *chain_link(const SharedBook *book, SharedField field, uint32_t record) {
+    SharedLinks *links = &book->links[record];
+    return field == SHARED_BY_ID ? &links->next_by_id
+           : field == SHARED_BY_PHONE ? &links->next_by_phone
+                                      : &links->next_by_email;
+}
+
+static bool key_matches(SharedField field, const SharedContact *record, const SharedContact *key) {
+    if (field == SHARED_BY_ID) {
+        return record->id == key->id;
+    }
+    if (field == SHARED_BY_PHONE) {
+        return strcmp(record->phone, key->phone) == 0;
+    }
+    return same_email(record->email, key->email);
+}
+
+// ========================= Records (under the lock) ========================= //
+
+static uint32_t find_record(const SharedBook *book, SharedField field, const SharedContact *key) {
+    uint32_t record = *bucket_of(book, field, key);
+    while (record != NO_RECORD && !key_matches(field, &book->records[record], key)) {
+        record = *chain_link(book, field, record);
+    }
+    return record;
+}
+
+static void chain_insert(SharedBook *book, SharedField field, uint32_t record) {
+    uint32_t *bucket = bucket_of(book, field, &book->records[record]);
+    *chain_link(book, field, record) = *bucket;
+    *bucket = record;
+}
+
+static void chain_remove(SharedBook *book, SharedField field, uint32_t record) {
+    uint32_t *at = bucket_of(book, field, &book->records[record]);
+    while (*at != NO_RECORD && *at != record) {
+        at = chain_link(book, field, *at);
+    }
+    if (*at == record) {
+        *at = *chain_link(book, field, record);
+    }
+}
+
+/**
+ * @brief Checks a contact's values against the same rules as ab_add and ab_update.
+ * @param self Record being changed (NO_RECORD for a new contact), which may keep its own values.
+ */
+static ValidationStatus check_values(const SharedBook *book, const SharedContact *values,
+                                     uint32_t self) {
+    ValidationStatus status = is_valid_name(values->name);
+    if (status == VALID) {
+        status = is_valid_phone(values->phone);
+    }
+    if (status == VALID) {
+        status = is_valid_email(values->email);
+    }
+    if (status == VALID) {
+        uint32_t phone_owner = find_record(book, SHARED_BY_PHONE, values);
+        uint32_t email_owner = find_record(book, SHARED_BY_EMAIL, values);
+        if ((phone_owner != NO_RECORD && phone_owner != self) ||
+            (email_owner != NO_RECORD && email_owner != self)) {
+            status = INVALID_DUPLICATE;
+        }
+    }
+    return status;
+}
+
+static ValidationStatus copy_values(SharedContact *values, const char *name, const char *phone,
+                                    const char *email) {
+    if (strlen(name) >= MAX_NAME_LENGTH || strlen(phone) >= MAX_PHONE_LENGTH ||
+        strlen(email) >= MAX_EMAIL_LENGTH) {
+        return INVALID_LENGTH;
+    }
+    strcpy(values->name, name);
+    strcpy(values->phone, phone);
+    strcpy(values->email, email);
+    return VALID;
+}
+
+/**
+ * @brief Stores a validated contact in a free record and links it everywhere.
+ */
+static ValidationStatus insert_record(SharedBook *book, const SharedContact *values) {
+    SharedHeader *header = book->header;
+    uint32_t record = header->free_head;
+    if (record != NO_RECORD) {
+        header->free_head = book->links[record].next;
+    }
+    else if (header->high_water < header->capacity) {
+        record = ++header->high_water;
+    }
+    else {
+        return INVALID_NO_MEMORY;
+    }
+
+    book->records[record] = *values;
+    SharedLinks *links = &book->links[record];
+    memset(links, 0, sizeof(*links));
+    for (int field = 0; field < 3; field++) {
+        chain_insert(book, (SharedField)field, record);
+    }
+    links->prev = header->tail;
+    if (header->tail != NO_RECORD) {
+        book->links[header->tail].next = record;
+    }
+    else {
+        header->head = record;
+    }
+    header->tail = record;
+    header->count++;
+    if (values->id >= header->next_id) {
+        header->next_id = values->id + 1;
+    }
+    header->changes++;
+    return VALID;
+}
+
+// ========================= Opening ========================= //
+
+SharedBook *shared_book_create(const char *name, size_t capacity) {
+    if (capacity < 1 || capacity > SHARED_BOOK_MAX_CAPACITY) {
+        return NULL;
+    }
+    uint32_t bucket_count = 1;
+    while (bucket_count < capacity) {
+        bucket_count <<= 1;
+    }
+    size_t buckets_offset = align_up(sizeof(SharedHeader));
+    size_t links_offset = align_up(buckets_offset + 3 * sizeof(uint32_t) * bucket_count);
+    size_t records_offset = align_up(links_offset + sizeof(SharedLinks) * (capacity + 1));
+    size_t size = records_offset + sizeof(SharedContact) * (capacity + 1);
+
+    SharedBook *book = calloc(1, sizeof(SharedBook));
+    if (book == NULL) {
+        return NULL;
+    }
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        free(book);
+        return NULL;
+    }
+    void *base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name);
+        free(book);
+        return NULL;
+    }
+
+    // The new region reads as zeros, so the tables and links start out empty.
+    SharedHeader *header = base;
+    header->capacity = (uint32_t)capacity;
+    header->bucket_count = bucket_count;
+    header->region_bytes = size;
+    header->buckets_offset = buckets_offset;
+    header->links_offset = links_offset;
+    header->records_offset = records_offset;
+    header->next_id = 1;
+
+    pthread_rwlockattr_t attributes;
+    int status = pthread_rwlockattr_init(&attributes);
+    if (status == 0) {
+        status = pthread_rwlockattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        if (status == 0) {
+            status = pthread_rwlock_init(&header->lock, &attributes);
+        }
+        pthread_rwlockattr_destroy(&attributes);
+    }
+    if (status != 0) {
+        munmap(base, size);
+        shm_unlink(name);
+        free(book);
+        return NULL;
+    }
+    memcpy(header->magic, SHARED_MAGIC, sizeof(header->magic));
+    atomic_store_explicit(&header->ready, 1, memory_order_release);
+
+    book->size = size;
+    map_layout(book, base);
+    return book;
+}
+
+SharedBook *shared_book_open(const char *name) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    // The creator sizes the region right after creating it; wait for that if we raced it.
+    struct stat info;
+    struct timespec pause = {0, 1000000};
+    int waited = 0;
+    while (fstat(fd, &info) == 0 && (size_t)info.st_size < sizeof(SharedHeader) &&
+           waited++ < SHARED_OPEN_WAIT_MS) {
+        nanosleep(&pause, NULL);
+    }
+    if ((size_t)info.st_size < sizeof(SharedHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    SharedHeader *header = base;
+    while (atomic_load_explicit(&header->ready, memory_order_acquire) == 0 &&
+           waited++ < SHARED_OPEN_WAIT_MS) {
+        nanosleep(&pause, NULL);
+    }
+    SharedBook *book = calloc(1, sizeof(SharedBook));
+    if (book == NULL || atomic_load_explicit(&header->ready, memory_order_acquire) == 0 ||
+        memcmp(header->magic, SHARED_MAGIC, sizeof(header->magic)) != 0 ||
+        header->region_bytes != size) {
+        munmap(base, size);
+        free(book);
+        return NULL;
+    }
+    book->size = size;
+    map_layout(book, base);
+    return book;
+}
+
+void shared_book_close(SharedBook *book) {
+    if (book == NULL) {
+        return;
+    }
+    munmap(book->header, book->size);
+    free(book);
+}
+
+int shared_book_destroy(const char *name) {
+    return shm_unlink(name) == 0 ? 0 : -1;
+}
+
+// ========================= Changes ========================= //
+
+ValidationStatus shared_book_add(SharedBook *book, const char *name, const char *phone,
+                                 const char *email, int *id) {
+    SharedContact values;
+    ValidationStatus status = copy_values(&values, name, phone, email);
+    if (status != VALID) {
+        return status;
+    }
+
+    pthread_rwlock_wrlock(&book->header->lock);
+    values.id = book->header->next_id;
+    status = check_values(book, &values, NO_RECORD);
+    if (status == VALID) {
+        status = insert_record(book, &values);
+    }
+    pthread_rwlock_unlock(&book->header->lock);
+
+    if (status == VALID && id != NULL) {
+        *id = values.id;
+    }
+    return status;
+}
+
+ValidationStatus shared_book_update(SharedBook *book, int id, const char *name,
+                                    const char *phone, const char *email) {
+    SharedContact key = {.id = id};
+    pthread_rwlock_wrlock(&book->header->lock);
+    uint32_t record = find_record(book, SHARED_BY_ID, &key);
+    if (record == NO_RECORD) {
+        pthread_rwlock_unlock(&book->header->lock);
+        return INVALID_NOT_FOUND;
+    }
+
+    SharedContact *current = &book->records[record];
+    SharedContact values = *current;
+    ValidationStatus status = copy_values(&values, name != NULL ? name : current->name,
+                                          phone != NULL ? phone : current->phone,
+                                          email != NULL ? email : current->email);
+    if (status == VALID) {
+        status = check_values(book, &values, record);
+    }
+    if (status == VALID) {
+        // Only the chains whose key changes are touched.
+        bool phone_moves = strcmp(values.phone, current->phone) != 0;
+        bool email_moves = strcmp(values.email, current->email) != 0;
+        if (phone_moves) {
+            chain_remove(book, SHARED_BY_PHONE, record);
+        }
+        if (email_moves) {
+            chain_remove(book, SHARED_BY_EMAIL, record);
+        }
+        *current = values;
+        if (phone_moves) {
+            chain_insert(book, SHARED_BY_PHONE, record);
+        }
+        if (email_moves) {
+            chain_insert(book, SHARED_BY_EMAIL, record);
+        }
+        book->header->changes++;
+    }
+    pthread_rwlock_unlock(&book->header->lock);
+    return status;
+}
+
+ValidationStatus shared_book_remove(SharedBook *book, int id) {
+    SharedContact key = {.id = id};
+    SharedHeader *header = book->header;
+    pthread_rwlock_wrlock(&header->lock);
+    uint32_t record = find_record(book, SHARED_BY_ID, &key);
+    if (record == NO_RECORD) {
+        pthread_rwlock_unlock(&header->lock);
+        return INVALID_NOT_FOUND;
+    }
+
+    for (int field = 0; field < 3; field++) {
+        chain_remove(book, (SharedField)field, record);
+    }
+    SharedLinks *links = &book->links[record];
+    if (links->prev != NO_RECORD) {
+        book->links[links->prev].next = links->next;
+    }
+    else {
+        header->head = links->next;
+    }
+    if (links->next != NO_RECORD) {
+        book->links[links->next].prev = links->prev;
+    }
+    else {
+        header->tail = links->prev;
+    }
+    memset(&book->records[record], 0, sizeof(SharedContact));
+    memset(links, 0, sizeof(*links));
+    links->next = header->free_head;
+    header->free_head = record;
+    header->count--;
+    header->changes++;
+    pthread_rwlock_unlock(&header->lock);
+    return VALID;
+}
+
+// ========================= Reading ========================= //
+
+int shared_book_lookup(SharedBook *book, SharedField field, const char *value,
+                       SharedBookVisitor visit, void *context) {
+    SharedContact key;
+    memset(&key, 0, sizeof(key));
+    if (field == SHARED_BY_ID) {
+        key.id = atoi(value);
+    }
+    else if (strlen(value) >= (field == SHARED_BY_PHONE ? MAX_PHONE_LENGTH : MAX_EMAIL_LENGTH)) {
+        return 0;
+    }
+    else {
+        strcpy(field == SHARED_BY_PHONE ? key.phone : key.email, value);
+    }
+
+    pthread_rwlock_rdlock(&book->header->lock);
+    uint32_t record = find_record(book, field, &key);
+    if (record != NO_RECORD && visit != NULL) {
+        visit(&book->records[record], context);
+    }
+    pthread_rwlock_unlock(&book->header->lock);
+    return record != NO_RECORD;
+}
+
+static int copy_contact(const SharedContact *record, void *context) {
+    Contact *contact = context;
+    contact->id = record->id;
+    memcpy(contact->name, record->name, MAX_NAME_LENGTH);
+    memcpy(contact->phone, record->phone, MAX_PHONE_LENGTH);
+    memcpy(contact->email, record->email, MAX_EMAIL_LENGTH);
+    contact->next = NULL;
+    return 0;
+}
+
+int shared_book_get(SharedBook *book, int id, Contact *contact) {
+    char value[16];
+    snprintf(value, sizeof(value), "%d", id);
+    return shared_book_lookup(book, SHARED_BY_ID, value, copy_contact, contact);
+}
+
+size_t shared_book_scan(SharedBook *book, SharedBookVisitor visit, void *context) {
+    size_t visited = 0;
+    pthread_rwlock_rdlock(&book->header->lock);
+    for (uint32_t record = book->header->head; record != NO_RECORD;
+         record = book->links[record].next) {
+        visited++;
+        if (visit(&book->records[record], context) != 0) {
+            break;
+        }
+    }
+    pthread_rwlock_unlock(&book->header->lock);
+    return visited;
+}
+
+void shared_book_stats(SharedBook *book, SharedBookStats *stats) {
+    pthread_rwlock_rdlock(&book->header->lock);
+    stats->contacts = book->header->count;
+    stats->capacity = book->header->capacity;
+    stats->region_bytes = book->size;
+    stats->next_id = book->header->next_id;
+    stats->changes = book->header->changes;
+    pthread_rwlock_unlock(&book->header->lock);
+}
+
+// ========================= CSV ========================= //
+
+int shared_book_import_csv(SharedBook *book, const char *path, int *skipped) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int imported = 0;
+    int rejected = 0;
+    char line[SHARED_LINE_LENGTH];
+    bool header_line = true;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        size_t length = strlen(line);
+        bool overlong = length == sizeof(line) - 1 && line[length - 1] != '\n';
+        if (overlong) {
+            int c;
+            while ((c = fgetc(file)) != '\n' && c != EOF) {
+            }
+        }
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+        if (header_line || length == 0) {
+            header_line = false; // The first line is the record count.
+            continue;
+        }
+
+        Contact contact;
+        SharedContact values;
+        if (overlong || convert_parse_record(line, line + length, &contact) != VALID) {
+            rejected++;
+            continue;
+        }
+        values.id = contact.id;
+        memcpy(values.name, contact.name, MAX_NAME_LENGTH);
+        memcpy(values.phone, contact.phone, MAX_PHONE_LENGTH);
+        memcpy(values.email, contact.email, MAX_EMAIL_LENGTH);
+
+        pthread_rwlock_wrlock(&book->header->lock);
+        ValidationStatus status = INVALID_DUPLICATE;
+        if (find_record(book, SHARED_BY_ID, &values) == NO_RECORD) {
+            status = check_values(book, &values, NO_RECORD);
+        }
+        if (status == VALID) {
+            status = insert_record(book, &values);
+        }
+        pthread_rwlock_unlock(&book->header->lock);
+        if (status == VALID) {
+            imported++;
+        }
+        else {
+            rejected++;
+        }
+    }
+    fclose(file);
+
+    if (skipped != NULL) {
+        *skipped = rejected;
+    }
+    return imported;
+}
+
+static int write_contact_line(const SharedContact *contact, void *context) {
+    fprintf(context, "%d,%s,%s,%s\n", contact->id, contact->name, contact->phone,
+            contact->email);
+    return 0;
+}
+
+int shared_book_export_csv(SharedBook *book, const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // One read lock over the count and every line, so the file is a single moment's view.
+    pthread_rwlock_rdlock(&book->header->lock);
+    int count = (int)book->header->count;
+    fprintf(file, "%d\n", count);
+    for (uint32_t record = book->header->head; record != NO_RECORD;
+         record = book->links[record].next) {
+        write_contact_line(&book->records[record], file);
+    }
+    pthread_rwlock_unlock(&book->header->lock);
+
+    bool failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed) {
+        return -1;
+    }
+    return count;
+}
+
+// ========================= Shared Subcommand ========================= //
+
+static void print_shared_usage(void) {
+    printf("Usage: addressbook shared [--name <name>] <action>\n");
+    printf("  create [--capacity <contacts>] [--from <file.csv>]\n");
+    printf("                             Create the shared book (default capacity %d)\n",
+           SHARED_BOOK_DEFAULT_CAPACITY);
+    printf("  destroy                    Remove it once every process has let go of it\n");
+    printf("  import <file.csv> | save [<file.csv>]\n");
+    printf("  stats | list | get <id> | phone <number> | email <address>\n");
+    printf("  add <name> <phone> <email> | set <id> <name> <phone> <email> | remove <id>\n");
+}
+
+static int print_shared_row(const SharedContact *contact, void *context) {
+    (void)context;
+    printf(" %-7d | %-20s | %-15s | %-30s\n", contact->id, contact->name, contact->phone,
+           contact->email);
+    return 0;
+}
+
+static void print_shared_stats(SharedBook *book, const char *name) {
+    SharedBookStats stats;
+    shared_book_stats(book, &stats);
+    printf("Ein: %s holds %zu of %zu contact(s) in %zu KB; next ID %d, %llu change(s) so far.\n",
+           name, stats.contacts, stats.capacity, stats.region_bytes / 1024, stats.next_id,
+           (unsigned long long)stats.changes);
+}
+
+static int create_shared_book(const char *name, int argc, char *argv[]) {
+    size_t capacity = SHARED_BOOK_DEFAULT_CAPACITY;
+    const char *from = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--capacity") == 0) {
+            long value = atol(argv[i + 1]);
+            capacity = value > 0 ? (size_t)value : 0;
+        }
+        else if (strcmp(argv[i], "--from") == 0) {
+            from = argv[i + 1];
+        }
+        else {
+            print_shared_usage();
+            return 1;
+        }
+    }
+    if (argc % 2 == 0) {
+        print_shared_usage();
+        return 1;
+    }
+
+    SharedBook *book = shared_book_create(name, capacity);
+    if (book == NULL) {
+        printf("Ein: *Whines* I couldn't create %s (it may exist already, or the capacity is "
+               "not between 1 and %d).\n",
+               name, SHARED_BOOK_MAX_CAPACITY);
+        return 1;
+    }
+    int status = 0;
+    if (from != NULL) {
+        int skipped = 0;
+        int imported = shared_book_import_csv(book, from, &skipped);
+        if (imported < 0) {
+            printf("Ein: *Whines* I couldn't read '%s'.\n", from);
+            status = 1;
+        }
+        else {
+            printf("Ein: Loaded %d contact(s) from '%s', skipped %d.\n", imported, from, skipped);
+        }
+    }
+    print_shared_stats(book, name);
+    shared_book_close(book);
+    return status;
+}
+
+/**
+ * @brief Runs one action of the shared subcommand against an open book.
+ * @return Process exit status.
+ */
+static int shared_action(SharedBook *book, const char *name, int argc, char *argv[]) {
+    const char *action = argv[0];
+    ValidationStatus status;
+
+    if (strcmp(action, "stats") == 0 && argc == 1) {
+        print_shared_stats(book, name);
+        return 0;
+    }
+    if (strcmp(action, "list") == 0 && argc == 1) {
+        size_t listed = shared_book_scan(book, print_shared_row, NULL);
+        printf("Ein: %zu contact(s).\n", listed);
+        return 0;
+    }
+    if (strcmp(action, "import") == 0 && argc == 2) {
+        int skipped = 0;
+        int imported = shared_book_import_csv(book, argv[1], &skipped);
+        if (imported < 0) {
+            printf("Ein: *Whines* I couldn't read '%s'.\n", argv[1]);
+            return 1;
+        }
+        printf("Ein: Imported %d contact(s), skipped %d.\n", imported, skipped);
+        return 0;
+    }
+    if (strcmp(action, "save") == 0 && argc <= 2) {
+        const char *path = argc == 2 ? argv[1] : "contacts.csv";
+        int saved = shared_book_export_csv(book, path);
+        if (saved < 0) {
+            printf("Ein: *Whines* I couldn't write '%s'.\n", path);
+            return 1;
+        }
+        printf("Ein: Wrote %d contact(s) to '%s'.\n", saved, path);
+        return 0;
+    }
+    if ((strcmp(action, "get") == 0 || strcmp(action, "phone") == 0 ||
+         strcmp(action, "email") == 0) && argc == 2) {
+        SharedField field = action[0] == 'g'   ? SHARED_BY_ID
+                            : action[0] == 'p' ? SHARED_BY_PHONE
+                                               : SHARED_BY_EMAIL;
+        if (shared_book_lookup(book, field, argv[1], print_shared_row, NULL) == 0) {
+            printf("Ein: *Sniffs around* Nope, I couldn't find \"%s\".\n", argv[1]);
+            return 1;
+        }
+        return 0;
+    }
+    if (strcmp(action, "add") == 0 && argc == 4) {
+        int id = 0;
+        status = shared_book_add(book, argv[1], argv[2], argv[3], &id);
+        if (status != VALID) {
+            print_validation_error(status);
+            return 1;
+        }
+        printf("Ein: *Tail wags* Stored %s as contact %d.\n", argv[1], id);
+        return 0;
+    }
+    if (strcmp(action, "set") == 0 && argc == 5) {
+        status = shared_book_update(book, atoi(argv[1]), argv[2], argv[3], argv[4]);
+        if (status != VALID) {
+            print_validation_error(status);
+            return 1;
+        }
+        printf("Ein: Contact %s updated.\n", argv[1]);
+        return 0;
+    }
+    if (strcmp(action, "remove") == 0 && argc == 2) {
+        if (shared_book_remove(book, atoi(argv[1])) != VALID) {
+            print_validation_error(INVALID_NOT_FOUND);
+            return 1;
+        }
+        printf("Ein: Contact %s removed.\n", argv[1]);
+        return 0;
+    }
+
+    print_shared_usage();
+    return 1;
+}
+
+int run_shared_command(int argc, char *argv[]) {
+    const char *name = SHARED_BOOK_DEFAULT_NAME;
+    if (argc >= 2 && strcmp(argv[0], "--name") == 0) {
+        name = argv[1];
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 1) {
+        print_shared_usage();
+        return 1;
+    }
+
+    if (strcmp(argv[0], "create") == 0) {
+        return create_shared_book(name, argc, argv);
+    }
+    if (strcmp(argv[0], "destroy") == 0 && argc == 1) {
+        if (shared_book_destroy(name) != 0) {
+            printf("Ein: *Tilts head* There's no shared book called %s.\n", name);
+            return 1;
+        }
+        printf("Ein: %s is gone; processes still using it keep their view until they exit.\n",
+               name);
+        return 0;
+    }
+
+    SharedBook *book = shared_book_open(name);
+    if (book == NULL) {
+        printf("Ein: *Tilts head* There's no shared book called %s. Create it with "
+               "`addressbook shared create`.\n",
+               name);
+        return 1;
+    }
+    int status = shared_action(book, name, argc, argv);
+    shared_book_close(book);
+    return status;
+}
@@ -0,0 +1,564 @@
+/**
+ * @file slot_store.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the record-addressable slot file.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // pread, pwrite, fdatasync, ftruncate
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "address_book.h"
+#include "change_feed.h"
+#include "slot_store.h"
+#include "trace.h"
+
+#define SLOT_MAGIC "ABSLOT1\n"
+#define SLOT_IO_SLOTS 512 // slots read or written per system call when scanning or rewriting
+#define SLOT_MAP_INITIAL_CAPACITY 1024
+
+/**
+ * @brief Slot 0: identifies the file and its slot size.
+ */
+typedef struct {
+    char magic[8];
+    uint32_t slot_size;
+    uint8_t unused[SLOT_SIZE - 12];
+} SlotHeader;
+
+/**
+ * @brief One slot. An ID of 0 marks a free slot.
+ */
+typedef struct {
+    int32_t id;
+    char name[MAX_NAME_LENGTH];
+    char phone[MAX_PHONE_LENGTH];
+    char email[MAX_EMAIL_LENGTH];
+    uint32_t checksum; // FNV-1a of every byte before it
+} SlotRecord;
+
+_Static_assert(sizeof(SlotHeader) == SLOT_SIZE, "the header must fill slot 0");
+_Static_assert(sizeof(SlotRecord) == SLOT_SIZE, "a record must fill exactly one slot");
+_Static_assert(4096 % SLOT_SIZE == 0, "slots must not straddle pages");
+
+/**
+ * @brief One entry of the ID map; slot 0 (the header) marks an unused entry.
+ */
+typedef struct {
+    int32_t id;
+    uint32_t slot;
+} SlotMapEntry;
+
+struct SlotStore {
+    int fd;
+    bool sync_writes;
+    uint32_t slot_count;     // Record slots in the file; slot n lives at n * SLOT_SIZE.
+    SlotMapEntry *map;       // Open addressing, capacity a power of two.
+    size_t map_capacity;
+    size_t map_count;
+    uint32_t *free_slots;    // Stack; the lowest slot is on top after a scan.
+    size_t free_count;
+    size_t free_capacity;
+    size_t damaged;
+    size_t writes;
+    size_t failed_writes;
+    AddressBook *book;       // Book followed through the change feed, or NULL.
+    int subscription;
+};
+
+// ========================= Slots ========================= //
+
+static uint32_t slot_checksum(const SlotRecord *record) {
+    const unsigned char *bytes = (const unsigned char *)record;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(SlotRecord, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Copies a string into a fixed-size field, truncating it and always terminating it.
+ */
+static void copy_field(char *dest, const char *src, size_t size) {
+    size_t length = strnlen(src, size - 1);
+    memcpy(dest, src, length);
+    dest[length] = '\0';
+}
+
+static void fill_record(SlotRecord *record, const Contact *contact) {
+    memset(record, 0, sizeof(*record));
+    if (contact != NULL) {
+        record->id = contact->id;
+        copy_field(record->name, contact->name, sizeof(record->name));
+        copy_field(record->phone, contact->phone, sizeof(record->phone));
+        copy_field(record->email, contact->email, sizeof(record->email));
+    }
+    record->checksum = slot_checksum(record);
+}
+
+static bool record_is_sound(const SlotRecord *record) {
+    return record->checksum == slot_checksum(record) && record->id >= 0 &&
+           memchr(record->name, '\0', MAX_NAME_LENGTH) != NULL &&
+           memchr(record->phone, '\0', MAX_PHONE_LENGTH) != NULL &&
+           memchr(record->email, '\0', MAX_EMAIL_LENGTH) != NULL;
+}
+
+static off_t slot_offset(uint32_t slot) {
+    return (off_t)slot * SLOT_SIZE;
+}
+
+/**
+ * @brief Writes one record into one slot: the only write an edit or delete makes.
+ */
+static int write_slot(SlotStore *store, uint32_t slot, const SlotRecord *record) {
+    store->writes++;
+    if (pwrite(store->fd, record, SLOT_SIZE, slot_offset(slot)) != SLOT_SIZE ||
+        (store->sync_writes && fdatasync(store->fd) != 0)) {
+        store->failed_writes++;
+        return -1;
+    }
+    return 0;
+}
+
+// ========================= ID Map ========================= //
+
+static size_t hash_id(int32_t id) {
+    uint32_t h = (uint32_t)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static SlotMapEntry *map_find(const SlotStore *store, int32_t id) {
+    size_t mask = store->map_capacity - 1;
+    for (size_t i = hash_id(id) & mask; store->map[i].slot != 0; i = (i + 1) & mask) {
+        if (store->map[i].id == id) {
+            return &store->map[i];
+        }
+    }
+    return NULL;
+}
+
+static int map_grow(SlotStore *store) {
+    size_t capacity = store->map_capacity * 2;
+    SlotMapEntry *map = calloc(capacity, sizeof(SlotMapEntry));
+    if (map == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < store->map_capacity; i++) {
+        if (store->map[i].slot != 0) {
+            size_t j = hash_id(store->map[i].id) & (capacity - 1);
+            while (map[j].slot != 0) {
+                j = (j + 1) & (capacity - 1);
+            }
+            map[j] = store->map[i];
+        }
+    }
+    free(store->map);
+    store->map = map;
+    store->map_capacity = capacity;
+    return 0;
+}
+
+static int map_add(SlotStore *store, int32_t id, uint32_t slot) {
+    if ((store->map_count + 1) * 10 > store->map_capacity * 7 && map_grow(store) != 0) {
+        return -1;
+    }
+    size_t mask = store->map_capacity - 1;
+    size_t i = hash_id(id) & mask;
+    while (store->map[i].slot != 0) {
+        i = (i + 1) & mask;
+    }
+    store->map[i].id = id;
+    store->map[i].slot = slot;
+    store->map_count++;
+    return 0;
+}
+
+/**
+ * @brief Removes an entry using backward-shift deletion, so no tombstones are needed.
+ */
+static void map_remove(SlotStore *store, SlotMapEntry *entry) {
+    size_t mask = store->map_capacity - 1;
+    size_t hole = (size_t)(entry - store->map);
+    store->map[hole].slot = 0;
+    store->map_count--;
+
+    for (size_t j = (hole + 1) & mask; store->map[j].slot != 0; j = (j + 1) & mask) {
+        size_t home = hash_id(store->map[j].id) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            store->map[hole] = store->map[j];
+            store->map[j].slot = 0;
+            hole = j;
+        }
+    }
+}
+
+static void map_clear(SlotStore *store) {
+    memset(store->map, 0, sizeof(SlotMapEntry) * store->map_capacity);
+    store->map_count = 0;
+}
+
+static int push_free_slot(SlotStore *store, uint32_t slot) {
+    if (store->free_count == store->free_capacity) {
+        size_t capacity = store->free_capacity == 0 ? 64 : store->free_capacity * 2;
+        uint32_t *grown = realloc(store->free_slots, sizeof(uint32_t) * capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        store->free_slots = grown;
+        store->free_capacity = capacity;
+    }
+    store->free_slots[store->free_count++] = slot;
+    return 0;
+}
+
+// ========================= Opening ========================= //
+
+/**
+ * @brief Reads every slot once, filling the ID map and the free-slot list.
+ */
+static int scan_slots(SlotStore *store) {
+    SlotRecord *records = malloc(sizeof(SlotRecord) * SLOT_IO_SLOTS);
+    if (records == NULL) {
+        return -1;
+    }
+
+    int status = 0;
+    for (uint32_t first = 1; first <= store->slot_count && status == 0; first += SLOT_IO_SLOTS) {
+        uint32_t count = store->slot_count - first + 1;
+        count = count < SLOT_IO_SLOTS ? count : SLOT_IO_SLOTS;
+        size_t bytes = (size_t)count * SLOT_SIZE;
+        if (pread(store->fd, records, bytes, slot_offset(first)) != (ssize_t)bytes) {
+            status = -1;
+            break;
+        }
+        for (uint32_t i = 0; i < count && status == 0; i++) {
+            const SlotRecord *record = &records[i];
+            bool sound = record_is_sound(record);
+            if (sound && record->id != 0 && map_find(store, record->id) == NULL) {
+                status = map_add(store, record->id, first + i);
+                continue;
+            }
+            if (!sound || record->id != 0) {
+                store->damaged++;
+            }
+            status = push_free_slot(store, first + i);
+        }
+    }
+    free(records);
+
+    // Reuse the lowest free slots first, so the file stays dense at the front.
+    for (size_t i = 0; i < store->free_count / 2; i++) {
+        uint32_t swap = store->free_slots[i];
+        store->free_slots[i] = store->free_slots[store->free_count - 1 - i];
+        store->free_slots[store->free_count - 1 - i] = swap;
+    }
+    return status;
+}
+
+SlotStore *slot_store_open(const char *path, bool sync_writes) {
+    SlotStore *store = calloc(1, sizeof(SlotStore));
+    if (store == NULL) {
+        return NULL;
+    }
+    store->sync_writes = sync_writes;
+    store->subscription = -1;
+    store->map_capacity = SLOT_MAP_INITIAL_CAPACITY;
+    store->map = calloc(store->map_capacity, sizeof(SlotMapEntry));
+    store->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (store->map == NULL || store->fd < 0) {
+        slot_store_close(store);
+        return NULL;
+    }
+
+    struct stat info;
+    SlotHeader header;
+    if (fstat(store->fd, &info) != 0) {
+        slot_store_close(store);
+        return NULL;
+    }
+    if (info.st_size == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SLOT_MAGIC, sizeof(header.magic));
+        header.slot_size = SLOT_SIZE;
+        if (pwrite(store->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+            slot_store_close(store);
+            return NULL;
+        }
+        return store;
+    }
+    if (pread(store->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, SLOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.slot_size != SLOT_SIZE) {
+        slot_store_close(store);
+        return NULL;
+    }
+
+    // A partial slot at the end (an append cut short) is ignored and later overwritten.
+    store->slot_count = (uint32_t)(info.st_size / SLOT_SIZE - 1);
+    if (scan_slots(store) != 0) {
+        slot_store_close(store);
+        return NULL;
+    }
+    return store;
+}
+
+int slot_store_load(SlotStore *store, AddressBook *book) {
+    SlotRecord *records = malloc(sizeof(SlotRecord) * SLOT_IO_SLOTS);
+    if (records == NULL) {
+        return -1;
+    }
+
+    TraceSpan span = TRACE_BEGIN("slots.load");
+    int loaded = 0;
+    for (uint32_t first = 1; first <= store->slot_count; first += SLOT_IO_SLOTS) {
+        uint32_t count = store->slot_count - first + 1;
+        count = count < SLOT_IO_SLOTS ? count : SLOT_IO_SLOTS;
+        size_t bytes = (size_t)count * SLOT_SIZE;
+        if (pread(store->fd, records, bytes, slot_offset(first)) != (ssize_t)bytes) {
+            loaded = -1;
+            break;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            // Only the slot the scan chose for an ID holds it; the rest are free.
+            const SlotRecord *record = &records[i];
+            const SlotMapEntry *entry = record->id > 0 ? map_find(store, record->id) : NULL;
+            if (entry == NULL || entry->slot != first + i) {
+                continue;
+            }
+            Contact *contact = malloc(sizeof(Contact));
+            if (contact == NULL) {
+                loaded = -1;
+                break;
+            }
+            contact->id = record->id;
+            memcpy(contact->name, record->name, MAX_NAME_LENGTH);
+            memcpy(contact->phone, record->phone, MAX_PHONE_LENGTH);
+            memcpy(contact->email, record->email, MAX_EMAIL_LENGTH);
+            contact->next = NULL;
+            book_append_contact(book, contact);
+            loaded++;
+        }
+        if (loaded < 0) {
+            break;
+        }
+    }
+    TRACE_END_COUNT(span, "contacts", loaded);
+
+    free(records);
+    return loaded;
+}
+
+int slot_store_rewrite(SlotStore *store, const AddressBook *book) {
+    SlotRecord *records = malloc(sizeof(SlotRecord) * SLOT_IO_SLOTS);
+    if (records == NULL) {
+        return -1;
+    }
+
+    TraceSpan span = TRACE_BEGIN("slots.rewrite");
+    map_clear(store);
+    store->free_count = 0;
+    store->slot_count = 0;
+    int status = ftruncate(store->fd, SLOT_SIZE);
+
+    uint32_t pending = 0;
+    for (const Contact *c = book->head; c != NULL && status == 0; c = c->next) {
+        fill_record(&records[pending++], c);
+        status = map_add(store, c->id, store->slot_count + pending);
+        if (pending == SLOT_IO_SLOTS || (c->next == NULL && status == 0)) {
+            size_t bytes = (size_t)pending * SLOT_SIZE;
+            if (pwrite(store->fd, records, bytes, slot_offset(store->slot_count + 1)) !=
+                (ssize_t)bytes) {
+                status = -1;
+            }
+            store->slot_count += pending;
+            pending = 0;
+        }
+    }
+    if (status == 0 && fdatasync(store->fd) != 0) {
+        status = -1;
+    }
+    TRACE_END_COUNT(span, "contacts", store->slot_count);
+
+    free(records);
+    if (status != 0) {
+        store->failed_writes++;
+        return -1;
+    }
+    return (int)store->slot_count;
+}
+
+// ========================= Changes ========================= //
+
+int slot_store_put(SlotStore *store, const Contact *contact) {
+    SlotRecord record;
+    fill_record(&record, contact);
+
+    const SlotMapEntry *entry = map_find(store, contact->id);
+    if (entry != NULL) {
+        return write_slot(store, entry->slot, &record);
+    }
+
+    uint32_t slot;
+    if (store->free_count > 0) {
+        slot = store->free_slots[store->free_count - 1];
+    }
+    else {
+        slot = store->slot_count + 1;
+    }
+    if (map_add(store, contact->id, slot) != 0) {
+        store->failed_writes++;
+        return -1;
+    }
+    if (write_slot(store, slot, &record) != 0) {
+        map_remove(store, map_find(store, contact->id));
+        return -1;
+    }
+    if (slot > store->slot_count) {
+        store->slot_count = slot;
+    }
+    else {
+        store->free_count--;
+    }
+    return 0;
+}
+
+int slot_store_delete(SlotStore *store, int id) {
+    SlotMapEntry *entry = id > 0 ? map_find(store, id) : NULL;
+    if (entry == NULL) {
+        return -1;
+    }
+    if (push_free_slot(store, entry->slot) != 0) {
+        store->failed_writes++;
+        return -1;
+    }
+
+    SlotRecord record;
+    fill_record(&record, NULL);
+    if (write_slot(store, entry->slot, &record) != 0) {
+        store->free_count--;
+        return -1;
+    }
+    map_remove(store, entry);
+    return 0;
+}
+
+/**
+ * @brief Change-feed subscriber: mirrors each change into its slot. Failures are counted by
+ * the store and reported by slot_store_sync.
+ */
+static void apply_change(const ChangeRecord *change, void *context) {
+    SlotStore *store = context;
+    if (change->op == CHANGE_DELETE) {
+        slot_store_delete(store, change->id);
+    }
+    else {
+        slot_store_put(store, &change->after);
+    }
+}
+
+int slot_store_attach(SlotStore *store, AddressBook *book) {
+    if (store->book != NULL || book_enable_change_feed(book, NULL) != 0) {
+        return -1;
+    }
+    store->subscription = change_feed_subscribe(book, apply_change, store);
+    if (store->subscription < 0) {
+        return -1;
+    }
+    store->book = book;
+    return 0;
+}
+
+int slot_store_sync(SlotStore *store) {
+    int status = fdatasync(store->fd) == 0 ? 0 : -1;
+    return store->failed_writes == 0 ? status : -1;
+}
+
+void slot_store_stats(const SlotStore *store, SlotStoreStats *stats) {
+    stats->slots = store->slot_count;
+    stats->contacts = store->map_count;
+    stats->free_slots = store->free_count;
+    stats->damaged = store->damaged;
+    stats->writes = store->writes;
+    stats->failed_writes = store->failed_writes;
+}
+
+int slot_store_close(SlotStore *store) {
+    if (store == NULL) {
+        return 0;
+    }
+    if (store->book != NULL) {
+        change_feed_unsubscribe(store->book, store->subscription);
+    }
+    int status = 0;
+    if (store->fd >= 0) {
+        status = slot_store_sync(store);
+        if (close(store->fd) != 0) {
+            status = -1;
+        }
+    }
+    free(store->map);
+    free(store->free_slots);
+    free(store);
+    return status;
+}
+
+// ========================= Interactive ========================= //
+
+SlotStore *open_contacts_slot_file(AddressBook *book) {
+    struct stat info;
+    bool exists = stat(SLOT_STORE_FILE_NAME, &info) == 0;
+    SlotStore *store = slot_store_open(SLOT_STORE_FILE_NAME, true);
+    if (store == NULL) {
+        printf("\nEin: *Tilts head* '%s' isn't a slot file I can use, so I'll stick to the CSV.\n",
+               SLOT_STORE_FILE_NAME);
+        load_contacts_from_file(book);
+        return NULL;
+    }
+
+    if (!exists) {
+        printf("\nEin: *Sniffs* No '%s' yet, so I'll move the plain CSV into one.\n",
+               SLOT_STORE_FILE_NAME);
+        load_contacts_from_file(book);
+        if (slot_store_rewrite(store, book) < 0) {
+            printf("Ein: *Whines* I couldn't write '%s', so I'll keep saving to the CSV.\n",
+                   SLOT_STORE_FILE_NAME);
+            slot_store_close(store);
+            remove(SLOT_STORE_FILE_NAME);
+            return NULL;
+        }
+        printf("Ein: From now on every change is written to '%s' as you make it.\n",
+               SLOT_STORE_FILE_NAME);
+        return store;
+    }
+
+    printf("\n<=======================| LOAD CONTACTS FROM SLOT FILE |========================>\n\n");
+
+    SlotStoreStats stats;
+    slot_store_stats(store, &stats);
+    if (stats.damaged > 0) {
+        printf("Ein: Couldn't read %zu slot(s) properly, skipped them.\n", stats.damaged);
+    }
+    if (slot_store_load(store, book) < 0) {
+        printf("Ein: *Whines* I couldn't read all of '%s', I kept the %d contact(s) I found.\n",
+               SLOT_STORE_FILE_NAME, book->contact_count);
+        printf("Ein: I'll save to the CSV this time, so the slot file is left alone.\n");
+        slot_store_close(store);
+        return NULL;
+    }
+    printf("Ein: Fetched %d contact(s) from my slot file; changes are saved as you make them.\n",
+           book->contact_count);
+    return store;
+}
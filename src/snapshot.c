@@ -0,0 +1,346 @@
+/**
+ * @file snapshot.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of versioned snapshots and deferred reclamation.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // PTHREAD_MUTEX_RECURSIVE
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "address_book.h"
+#include "snapshot.h"
+
+/**
+ * @brief A contact that left the book at @c version, kept for older snapshots.
+ */
+typedef struct RetiredContact {
+    Contact *contact;
+    unsigned long version;
+    struct RetiredContact *next;
+} RetiredContact;
+
+/**
+ * @brief The live contacts in list order. Shared by every snapshot taken since it last changed;
+ * a writer copies it before changing it while any snapshot holds it.
+ */
+struct ContactArray {
+    size_t refs;                // The manager's reference plus one per snapshot holding it.
+    size_t count;
+    size_t capacity;
+    const Contact *items[];
+};
+
+struct SnapshotManager {
+    pthread_mutex_t lock;       // Recursive, so writes can nest.
+    int write_depth;
+    unsigned long version;      // Last committed version.
+    ContactArray *live;         // NULL when it has to be rebuilt from the list.
+    BookSnapshot *open;         // Open snapshots.
+    RetiredContact *retired;    // Newest first.
+    size_t retired_count;
+};
+
+// ========================= Helpers ========================= //
+
+static ContactArray *array_alloc(size_t capacity) {
+    ContactArray *array = malloc(sizeof(ContactArray) + sizeof(Contact *) * capacity);
+    if (array != NULL) {
+        array->refs = 1;
+        array->count = 0;
+        array->capacity = capacity;
+    }
+    return array;
+}
+
+static void array_release(ContactArray *array) {
+    if (array != NULL && --array->refs == 0) {
+        free(array);
+    }
+}
+
+/**
+ * @brief Lays the book's list out as a fresh array (the manager's reference), or NULL if
+ * memory ran out.
+ */
+static ContactArray *array_build(const AddressBook *book) {
+    ContactArray *array = array_alloc(book->contact_count > 0 ? (size_t)book->contact_count : 1);
+    for (const Contact *current = book->head; array != NULL && current != NULL;
+         current = current->next) {
+        array->items[array->count++] = current;
+    }
+    return array;
+}
+
+/**
+ * @brief Makes the live array safe to change in place with room for @p extra more contacts:
+ * copied if a snapshot holds it, grown if full. If memory runs out it is dropped, to be
+ * rebuilt by the next snapshot_open. Called with the lock held.
+ * @return The array, or NULL if there is none to change.
+ */
+static ContactArray *writable_live(SnapshotManager *manager, size_t extra) {
+    ContactArray *live = manager->live;
+    if (live == NULL || (live->refs == 1 && live->count + extra <= live->capacity)) {
+        return live;
+    }
+
+    size_t capacity = live->count + extra > live->capacity ? live->capacity * 2 : live->capacity;
+    if (capacity < live->count + extra) {
+        capacity = live->count + extra;
+    }
+    ContactArray *copy = array_alloc(capacity);
+    if (copy != NULL) {
+        copy->count = live->count;
+        memcpy(copy->items, live->items, sizeof(Contact *) * live->count);
+    }
+    array_release(live);
+    manager->live = copy;
+    return copy;
+}
+
+static size_t array_position(const ContactArray *array, const Contact *contact) {
+    size_t i = 0;
+    while (i < array->count && array->items[i] != contact) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Frees retired contacts that every open snapshot is too new to see.
+ *
+ * A contact retired by the write that produced version R is only visible to snapshots taken
+ * at a version below R. Called with the lock held.
+ */
+static void reclaim(SnapshotManager *manager) {
+    bool any_open = manager->open != NULL;
+    unsigned long oldest = 0;
+    for (const BookSnapshot *s = manager->open; s != NULL; s = s->next_open) {
+        if (s == manager->open || s->version < oldest) {
+            oldest = s->version;
+        }
+    }
+
+    RetiredContact **link = &manager->retired;
+    while (*link != NULL) {
+        RetiredContact *entry = *link;
+        if (!any_open || entry->version <= oldest) {
+            *link = entry->next;
+            free(entry->contact);
+            free(entry);
+            manager->retired_count--;
+        }
+        else {
+            link = &entry->next;
+        }
+    }
+}
+
+// ========================= Public API ========================= //
+
+int book_enable_snapshots(AddressBook *book) {
+    if (book->snapshots != NULL) {
+        return 0;
+    }
+
+    SnapshotManager *manager = calloc(1, sizeof(SnapshotManager));
+    if (manager == NULL) {
+        return -1;
+    }
+
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    int status = pthread_mutex_init(&manager->lock, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    if (status != 0) {
+        free(manager);
+        return -1;
+    }
+
+    // Without the array (out of memory), the first snapshot_open builds it.
+    manager->live = array_build(book);
+    book->snapshots = manager;
+    return 0;
+}
+
+BookSnapshot *snapshot_open(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return NULL;
+    }
+
+    BookSnapshot *snapshot = malloc(sizeof(BookSnapshot));
+    if (snapshot == NULL) {
+        return NULL;
+    }
+
+    // Taking a reference to the live array is all an open costs, unless it has to be rebuilt.
+    pthread_mutex_lock(&manager->lock);
+    if (manager->live == NULL) {
+        manager->live = array_build(book);
+    }
+    if (manager->live == NULL) {
+        pthread_mutex_unlock(&manager->lock);
+        free(snapshot);
+        return NULL;
+    }
+
+    snapshot->array = manager->live;
+    snapshot->array->refs++;
+    snapshot->contacts = snapshot->array->items;
+    snapshot->count = snapshot->array->count;
+    snapshot->version = manager->version;
+    snapshot->next_id = book->next_id;
+    snapshot->manager = manager;
+    snapshot->next_open = manager->open;
+    manager->open = snapshot;
+    pthread_mutex_unlock(&manager->lock);
+    return snapshot;
+}
+
+void snapshot_close(BookSnapshot *snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+
+    SnapshotManager *manager = snapshot->manager;
+    pthread_mutex_lock(&manager->lock);
+    for (BookSnapshot **link = &manager->open; *link != NULL; link = &(*link)->next_open) {
+        if (*link == snapshot) {
+            *link = snapshot->next_open;
+            break;
+        }
+    }
+    array_release(snapshot->array);
+    reclaim(manager);
+    pthread_mutex_unlock(&manager->lock);
+
+    free(snapshot);
+}
+
+unsigned long book_version(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&manager->lock);
+    unsigned long version = manager->version;
+    pthread_mutex_unlock(&manager->lock);
+    return version;
+}
+
+size_t snapshot_retired_count(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&manager->lock);
+    size_t count = manager->retired_count;
+    pthread_mutex_unlock(&manager->lock);
+    return count;
+}
+
+void snapshot_write_begin(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager != NULL) {
+        pthread_mutex_lock(&manager->lock);
+        manager->write_depth++;
+    }
+}
+
+void snapshot_write_end(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return;
+    }
+    if (--manager->write_depth == 0) {
+        manager->version++;
+        reclaim(manager);
+    }
+    pthread_mutex_unlock(&manager->lock);
+}
+
+bool snapshots_active(const AddressBook *book) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&manager->lock);
+    bool active = manager->open != NULL;
+    pthread_mutex_unlock(&manager->lock);
+    return active;
+}
+
+void snapshot_retire(const AddressBook *book, Contact *contact) {
+    SnapshotManager *manager = book->snapshots;
+    RetiredContact *entry = NULL;
+
+    if (manager != NULL && manager->open != NULL) {
+        entry = malloc(sizeof(RetiredContact));
+    }
+    if (entry == NULL) {
+        // With a snapshot open but no memory to defer the free, leaking beats freeing under a reader.
+        if (manager == NULL || manager->open == NULL) {
+            free(contact);
+        }
+        return;
+    }
+
+    entry->contact = contact;
+    entry->version = manager->version + 1;
+    entry->next = manager->retired;
+    manager->retired = entry;
+    manager->retired_count++;
+}
+
+void snapshot_note_change(const AddressBook *book, const Contact *removed,
+                          const Contact *added) {
+    SnapshotManager *manager = book->snapshots;
+    if (manager == NULL) {
+        return;
+    }
+    if (removed == NULL && added == NULL) {
+        array_release(manager->live);
+        manager->live = NULL;
+        return;
+    }
+
+    ContactArray *live = writable_live(manager, removed == NULL ? 1 : 0);
+    if (live == NULL) {
+        return;
+    }
+    if (removed == NULL) {
+        live->items[live->count++] = added;
+        return;
+    }
+    size_t i = array_position(live, removed);
+    if (i == live->count) {
+        return;
+    }
+    if (added != NULL) {
+        live->items[i] = added;
+    }
+    else {
+        memmove(live->items + i, live->items + i + 1, sizeof(Contact *) * (live->count - i - 1));
+        live->count--;
+    }
+}
+
+void snapshot_manager_free(SnapshotManager *manager) {
+    if (manager == NULL) {
+        return;
+    }
+    array_release(manager->live);
+    RetiredContact *entry = manager->retired;
+    while (entry != NULL) {
+        RetiredContact *next = entry->next;
+        free(entry->contact);
+        free(entry);
+        entry = next;
+    }
+    pthread_mutex_destroy(&manager->lock);
+    free(manager);
+}
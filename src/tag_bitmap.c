@@ -0,0 +1,601 @@
+/**
+ * @file tag_bitmap.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the compressed ID bitmaps: sparse array and dense bitset containers.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "tag_bitmap.h"
+
+#define BITSET_WORDS 1024                         // 65536 bits
+#define SPARSE_AGAIN (TAG_BITMAP_ARRAY_LIMIT / 2) // dense containers shrinking below this go back
+#define INITIAL_VALUES 4
+#define INITIAL_CONTAINERS 4
+
+/**
+ * @brief The low halves of every ID sharing one high half.
+ */
+typedef struct {
+    uint16_t key;          // high 16 bits of the IDs
+    bool dense;            // bitset rather than sorted array
+    uint32_t cardinality;
+    uint32_t capacity;     // slots in values (sparse only)
+    uint16_t *values;      // sorted low halves (sparse only)
+    uint64_t *words;       // BITSET_WORDS words (dense only)
+} Container;
+
+struct TagBitmap {
+    Container *containers; // sorted by key
+    size_t count;
+    size_t capacity;
+};
+
+typedef enum { COMBINE_AND, COMBINE_OR, COMBINE_ANDNOT } CombineOp;
+
+// ========================= Bit Helpers ========================= //
+
+static int popcount(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static int lowest_bit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// ========================= Containers ========================= //
+
+/**
+ * @brief Binary search in a sorted array.
+ * @return true if found; @p position is its index, or where it would be inserted.
+ */
+static bool array_find(const uint16_t *values, uint32_t count, uint16_t value,
+                       uint32_t *position) {
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (values[middle] < value) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    *position = low;
+    return low < count && values[low] == value;
+}
+
+static void container_free(Container *container) {
+    free(container->values);
+    free(container->words);
+    container->values = NULL;
+    container->words = NULL;
+}
+
+static int make_dense(Container *container) {
+    uint64_t *words = calloc(BITSET_WORDS, sizeof(uint64_t));
+    if (words == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < container->cardinality; i++) {
+        words[container->values[i] >> 6] |= 1ULL << (container->values[i] & 63);
+    }
+    free(container->values);
+    container->values = NULL;
+    container->capacity = 0;
+    container->words = words;
+    container->dense = true;
+    return 0;
+}
+
+static int make_sparse(Container *container) {
+    uint32_t room = container->cardinality > 0 ? container->cardinality : 1;
+    uint16_t *values = malloc(sizeof(uint16_t) * room);
+    if (values == NULL) {
+        return -1;
+    }
+    uint32_t count = 0;
+    for (int w = 0; w < BITSET_WORDS; w++) {
+        for (uint64_t word = container->words[w]; word != 0; word &= word - 1) {
+            values[count++] = (uint16_t)(w * 64 + lowest_bit(word));
+        }
+    }
+    free(container->words);
+    container->words = NULL;
+    container->values = values;
+    container->capacity = container->cardinality;
+    container->dense = false;
+    return 0;
+}
+
+static int container_add(Container *container, uint16_t value) {
+    if (container->dense) {
+        uint64_t bit = 1ULL << (value & 63);
+        if ((container->words[value >> 6] & bit) == 0) {
+            container->words[value >> 6] |= bit;
+            container->cardinality++;
+        }
+        return 0;
+    }
+
+    uint32_t position;
+    if (array_find(container->values, container->cardinality, value, &position)) {
+        return 0;
+    }
+    if (container->cardinality == TAG_BITMAP_ARRAY_LIMIT) {
+        if (make_dense(container) != 0) {
+            return -1;
+        }
+        return container_add(container, value);
+    }
+    if (container->cardinality == container->capacity) {
+        uint32_t capacity = container->capacity == 0 ? INITIAL_VALUES : container->capacity * 2;
+        if (capacity > TAG_BITMAP_ARRAY_LIMIT) {
+            capacity = TAG_BITMAP_ARRAY_LIMIT;
+        }
+        uint16_t *values = realloc(container->values, sizeof(uint16_t) * capacity);
+        if (values == NULL) {
+            return -1;
+        }
+        container->values = values;
+        container->capacity = capacity;
+    }
+    memmove(&container->values[position + 1], &container->values[position],
+            sizeof(uint16_t) * (container->cardinality - position));
+    container->values[position] = value;
+    container->cardinality++;
+    return 0;
+}
+
+static void container_remove(Container *container, uint16_t value) {
+    if (container->dense) {
+        uint64_t bit = 1ULL << (value & 63);
+        if (container->words[value >> 6] & bit) {
+            container->words[value >> 6] &= ~bit;
+            container->cardinality--;
+            // Shrinking well below the limit avoids flipping back and forth at the boundary.
+            // If the array cannot be allocated the container simply stays dense.
+            if (container->cardinality <= SPARSE_AGAIN) {
+                make_sparse(container);
+            }
+        }
+        return;
+    }
+
+    uint32_t position;
+    if (array_find(container->values, container->cardinality, value, &position)) {
+        memmove(&container->values[position], &container->values[position + 1],
+                sizeof(uint16_t) * (container->cardinality - position - 1));
+        container->cardinality--;
+    }
+}
+
+static bool container_contains(const Container *container, uint16_t value) {
+    if (container->dense) {
+        return (container->words[value >> 6] >> (value & 63)) & 1;
+    }
+    uint32_t position;
+    return array_find(container->values, container->cardinality, value, &position);
+}
+
+static int container_copy(Container *dest, const Container *source) {
+    *dest = *source;
+    dest->values = NULL;
+    dest->words = NULL;
+    if (source->dense) {
+        dest->words = malloc(sizeof(uint64_t) * BITSET_WORDS);
+        if (dest->words == NULL) {
+            return -1;
+        }
+        memcpy(dest->words, source->words, sizeof(uint64_t) * BITSET_WORDS);
+        return 0;
+    }
+    dest->capacity = source->cardinality;
+    dest->values = malloc(sizeof(uint16_t) * source->cardinality);
+    if (dest->values == NULL) {
+        return -1;
+    }
+    memcpy(dest->values, source->values, sizeof(uint16_t) * source->cardinality);
+    return 0;
+}
+
+/**
+ * @brief Writes a container's IDs into a bitset.
+ */
+static void load_words(uint64_t *words, const Container *container) {
+    if (container->dense) {
+        memcpy(words, container->words, sizeof(uint64_t) * BITSET_WORDS);
+        return;
+    }
+    memset(words, 0, sizeof(uint64_t) * BITSET_WORDS);
+    for (uint32_t i = 0; i < container->cardinality; i++) {
+        words[container->values[i] >> 6] |= 1ULL << (container->values[i] & 63);
+    }
+}
+
+/**
+ * @brief Merges two sorted arrays (set operations on sparse containers).
+ * @return Number of values written to @p out (room for both inputs).
+ */
+static uint32_t merge_arrays(const Container *left, const Container *right, CombineOp op,
+                             uint16_t *out) {
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    while (i < left->cardinality && j < right->cardinality) {
+        uint16_t a = left->values[i];
+        uint16_t b = right->values[j];
+        if (a == b) {
+            if (op != COMBINE_ANDNOT) {
+                out[count++] = a;
+            }
+            i++;
+            j++;
+        }
+        else if (a < b) {
+            if (op != COMBINE_AND) {
+                out[count++] = a;
+            }
+            i++;
+        }
+        else {
+            if (op == COMBINE_OR) {
+                out[count++] = b;
+            }
+            j++;
+        }
+    }
+    if (op != COMBINE_AND) {
+        while (i < left->cardinality) {
+            out[count++] = left->values[i++];
+        }
+    }
+    if (op == COMBINE_OR) {
+        while (j < right->cardinality) {
+            out[count++] = right->values[j++];
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Combines two containers with the same key into @p out.
+ * @return 0 on success (an empty result has cardinality 0), -1 if memory ran out.
+ */
+static int container_combine(const Container *left, const Container *right, CombineOp op,
+                             Container *out) {
+    out->key = left->key;
+    out->values = NULL;
+    out->words = NULL;
+    out->capacity = 0;
+    out->cardinality = 0;
+    out->dense = false;
+
+    if (op == COMBINE_AND && left->dense && !right->dense) {
+        const Container *swap = left;
+        left = right;
+        right = swap;
+    }
+    if (!left->dense && (op != COMBINE_OR || !right->dense)) {
+        // A sparse left side bounds AND and ANDNOT; two sparse sides merge directly.
+        uint32_t room = left->cardinality + (right->dense ? 0 : right->cardinality);
+        uint16_t *values = malloc(sizeof(uint16_t) * (room > 0 ? room : 1));
+        if (values == NULL) {
+            return -1;
+        }
+        uint32_t count = 0;
+        if (right->dense) {
+            for (uint32_t i = 0; i < left->cardinality; i++) {
+                if (container_contains(right, left->values[i]) == (op == COMBINE_AND)) {
+                    values[count++] = left->values[i];
+                }
+            }
+        }
+        else {
+            count = merge_arrays(left, right, op, values);
+        }
+        out->values = values;
+        out->capacity = count;
+        out->cardinality = count;
+        if (count > TAG_BITMAP_ARRAY_LIMIT) {
+            return make_dense(out);
+        }
+        return 0;
+    }
+
+    // At least one dense side: word-at-a-time loops over both bitsets.
+    uint64_t *words = malloc(sizeof(uint64_t) * BITSET_WORDS);
+    uint64_t *other = malloc(sizeof(uint64_t) * BITSET_WORDS);
+    if (words == NULL || other == NULL) {
+        free(words);
+        free(other);
+        return -1;
+    }
+    load_words(words, left);
+    load_words(other, right);
+    switch (op) {
+        case COMBINE_AND:
+            for (int w = 0; w < BITSET_WORDS; w++) {
+                words[w] &= other[w];
+            }
+            break;
+        case COMBINE_OR:
+            for (int w = 0; w < BITSET_WORDS; w++) {
+                words[w] |= other[w];
+            }
+            break;
+        default:
+            for (int w = 0; w < BITSET_WORDS; w++) {
+                words[w] &= ~other[w];
+            }
+            break;
+    }
+    free(other);
+
+    uint32_t cardinality = 0;
+    for (int w = 0; w < BITSET_WORDS; w++) {
+        cardinality += (uint32_t)popcount(words[w]);
+    }
+    out->words = words;
+    out->dense = true;
+    out->cardinality = cardinality;
+    if (cardinality <= TAG_BITMAP_ARRAY_LIMIT && make_sparse(out) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// ========================= Bitmaps ========================= //
+
+TagBitmap *tag_bitmap_create(void) {
+    return calloc(1, sizeof(TagBitmap));
+}
+
+void tag_bitmap_free(TagBitmap *bitmap) {
+    if (bitmap == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < bitmap->count; i++) {
+        container_free(&bitmap->containers[i]);
+    }
+    free(bitmap->containers);
+    free(bitmap);
+}
+
+TagBitmap *tag_bitmap_copy(const TagBitmap *bitmap) {
+    TagBitmap *copy = tag_bitmap_create();
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->containers = malloc(sizeof(Container) * (bitmap->count > 0 ? bitmap->count : 1));
+    if (copy->containers == NULL) {
+        free(copy);
+        return NULL;
+    }
+    copy->capacity = bitmap->count > 0 ? bitmap->count : 1;
+    for (; copy->count < bitmap->count; copy->count++) {
+        if (container_copy(&copy->containers[copy->count], &bitmap->containers[copy->count]) != 0) {
+            container_free(&copy->containers[copy->count]);
+            tag_bitmap_free(copy);
+            return NULL;
+        }
+    }
+    return copy;
+}
+
+static bool find_container(const TagBitmap *bitmap, uint16_t key, size_t *position) {
+    size_t low = 0;
+    size_t high = bitmap->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (bitmap->containers[middle].key < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    *position = low;
+    return low < bitmap->count && bitmap->containers[low].key == key;
+}
+
+static int reserve_containers(TagBitmap *bitmap) {
+    if (bitmap->count < bitmap->capacity) {
+        return 0;
+    }
+    size_t capacity = bitmap->capacity == 0 ? INITIAL_CONTAINERS : bitmap->capacity * 2;
+    Container *containers = realloc(bitmap->containers, sizeof(Container) * capacity);
+    if (containers == NULL) {
+        return -1;
+    }
+    bitmap->containers = containers;
+    bitmap->capacity = capacity;
+    return 0;
+}
+
+static void remove_container(TagBitmap *bitmap, size_t position) {
+    container_free(&bitmap->containers[position]);
+    memmove(&bitmap->containers[position], &bitmap->containers[position + 1],
+            sizeof(Container) * (bitmap->count - position - 1));
+    bitmap->count--;
+}
+
+int tag_bitmap_add(TagBitmap *bitmap, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t position;
+    if (!find_container(bitmap, key, &position)) {
+        if (reserve_containers(bitmap) != 0) {
+            return -1;
+        }
+        memmove(&bitmap->containers[position + 1], &bitmap->containers[position],
+                sizeof(Container) * (bitmap->count - position));
+        memset(&bitmap->containers[position], 0, sizeof(Container));
+        bitmap->containers[position].key = key;
+        bitmap->count++;
+    }
+
+    Container *container = &bitmap->containers[position];
+    if (container_add(container, (uint16_t)value) != 0) {
+        if (container->cardinality == 0) {
+            remove_container(bitmap, position);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+void tag_bitmap_remove(TagBitmap *bitmap, uint32_t value) {
+    size_t position;
+    if (find_container(bitmap, (uint16_t)(value >> 16), &position)) {
+        container_remove(&bitmap->containers[position], (uint16_t)value);
+        if (bitmap->containers[position].cardinality == 0) {
+            remove_container(bitmap, position);
+        }
+    }
+}
+
+bool tag_bitmap_contains(const TagBitmap *bitmap, uint32_t value) {
+    size_t position;
+    return find_container(bitmap, (uint16_t)(value >> 16), &position) &&
+           container_contains(&bitmap->containers[position], (uint16_t)value);
+}
+
+size_t tag_bitmap_cardinality(const TagBitmap *bitmap) {
+    size_t total = 0;
+    for (size_t i = 0; i < bitmap->count; i++) {
+        total += bitmap->containers[i].cardinality;
+    }
+    return total;
+}
+
+/**
+ * @brief Appends a finished container (keys arrive in increasing order).
+ */
+static int append_container(TagBitmap *bitmap, Container *container) {
+    if (container->cardinality == 0) {
+        container_free(container);
+        return 0;
+    }
+    if (reserve_containers(bitmap) != 0) {
+        container_free(container);
+        return -1;
+    }
+    bitmap->containers[bitmap->count++] = *container;
+    return 0;
+}
+
+static TagBitmap *combine(const TagBitmap *left, const TagBitmap *right, CombineOp op) {
+    TagBitmap *result = tag_bitmap_create();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    size_t i = 0;
+    size_t j = 0;
+    int status = 0;
+    while (status == 0 && (i < left->count || j < right->count)) {
+        const Container *a = i < left->count ? &left->containers[i] : NULL;
+        const Container *b = j < right->count ? &right->containers[j] : NULL;
+        Container container;
+
+        if (b == NULL || (a != NULL && a->key < b->key)) {
+            i++;
+            if (op == COMBINE_AND) {
+                continue;
+            }
+            status = container_copy(&container, a);
+        }
+        else if (a == NULL || b->key < a->key) {
+            j++;
+            if (op != COMBINE_OR) {
+                continue;
+            }
+            status = container_copy(&container, b);
+        }
+        else {
+            status = container_combine(a, b, op, &container);
+            i++;
+            j++;
+        }
+        if (status == 0) {
+            status = append_container(result, &container);
+        }
+        else {
+            container_free(&container);
+        }
+    }
+
+    if (status != 0) {
+        tag_bitmap_free(result);
+        return NULL;
+    }
+    return result;
+}
+
+TagBitmap *tag_bitmap_and(const TagBitmap *left, const TagBitmap *right) {
+    return combine(left, right, COMBINE_AND);
+}
+
+TagBitmap *tag_bitmap_or(const TagBitmap *left, const TagBitmap *right) {
+    return combine(left, right, COMBINE_OR);
+}
+
+TagBitmap *tag_bitmap_andnot(const TagBitmap *left, const TagBitmap *right) {
+    return combine(left, right, COMBINE_ANDNOT);
+}
+
+int tag_bitmap_foreach(const TagBitmap *bitmap, int (*visit)(uint32_t value, void *context),
+                       void *context) {
+    for (size_t i = 0; i < bitmap->count; i++) {
+        const Container *container = &bitmap->containers[i];
+        uint32_t high = (uint32_t)container->key << 16;
+        if (!container->dense) {
+            for (uint32_t k = 0; k < container->cardinality; k++) {
+                int status = visit(high | container->values[k], context);
+                if (status != 0) {
+                    return status;
+                }
+            }
+            continue;
+        }
+        for (int w = 0; w < BITSET_WORDS; w++) {
+            for (uint64_t word = container->words[w]; word != 0; word &= word - 1) {
+                int status = visit(high | (uint32_t)(w * 64 + lowest_bit(word)), context);
+                if (status != 0) {
+                    return status;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+size_t tag_bitmap_memory(const TagBitmap *bitmap) {
+    size_t total = sizeof(TagBitmap) + sizeof(Container) * bitmap->capacity;
+    for (size_t i = 0; i < bitmap->count; i++) {
+        const Container *container = &bitmap->containers[i];
+        total += container->dense ? sizeof(uint64_t) * BITSET_WORDS
+                                  : sizeof(uint16_t) * container->capacity;
+    }
+    return total;
+}
@@ -0,0 +1,714 @@
+/**
+ * @file tags.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of contact tags: the tag set, tag expressions, persistence, and menus.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <time.h>
+#include "address_book.h"
+#include "ab_api.h"
+#include "contact_helper.h"
+#include "tag_bitmap.h"
+#include "tags.h"
+#include "trace.h"
+
+#define TAG_LIST_LIMIT 64 // tags shown by the menu and the list command
+
+/**
+ * @brief One tag and the IDs carrying it.
+ */
+typedef struct {
+    char name[MAX_TAG_LENGTH];
+    TagBitmap *members;
+} Tag;
+
+/**
+ * @brief Every tag of a book, sorted by name.
+ */
+struct TagSet {
+    Tag *tags;
+    size_t count;
+    size_t capacity;
+};
+
+typedef enum { TAG_ADD = 1, TAG_REMOVE, TAG_LIST, TAG_FIND, TAG_CANCEL } TagOption;
+
+// ========================= Tag Set ========================= //
+
+static bool is_tag_char(int c) {
+    return isalnum(c) || c == '-' || c == '_';
+}
+
+ValidationStatus is_valid_tag(const char *tag) {
+    size_t length = strlen(tag);
+    if (length == 0) {
+        return INVALID_EMPTY;
+    }
+    if (length >= MAX_TAG_LENGTH) {
+        return INVALID_LENGTH;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (!is_tag_char((unsigned char)tag[i])) {
+            return INVALID_CHARACTERS;
+        }
+    }
+    return VALID;
+}
+
+static void fold_tag(const char *tag, char *folded) {
+    size_t i = 0;
+    for (; tag[i] != '\0' && i < MAX_TAG_LENGTH - 1; i++) {
+        folded[i] = (char)tolower((unsigned char)tag[i]);
+    }
+    folded[i] = '\0';
+}
+
+/**
+ * @brief Binary search by folded name.
+ * @return true if found; @p position is its index, or where it would be inserted.
+ */
+static bool find_tag(const struct TagSet *set, const char *folded, size_t *position) {
+    size_t low = 0;
+    size_t high = set != NULL ? set->count : 0;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strcmp(set->tags[middle].name, folded) < 0) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    *position = low;
+    return set != NULL && low < set->count && strcmp(set->tags[low].name, folded) == 0;
+}
+
+/**
+ * @brief Finds a tag, creating it if needed.
+ * @return The tag, or NULL if memory ran out.
+ */
+static Tag *obtain_tag(AddressBook *book, const char *folded) {
+    if (book->tags == NULL) {
+        book->tags = calloc(1, sizeof(struct TagSet));
+        if (book->tags == NULL) {
+            return NULL;
+        }
+    }
+    struct TagSet *set = book->tags;
+
+    size_t position;
+    if (find_tag(set, folded, &position)) {
+        return &set->tags[position];
+    }
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity == 0 ? 8 : set->capacity * 2;
+        Tag *tags = realloc(set->tags, sizeof(Tag) * capacity);
+        if (tags == NULL) {
+            return NULL;
+        }
+        set->tags = tags;
+        set->capacity = capacity;
+    }
+    TagBitmap *members = tag_bitmap_create();
+    if (members == NULL) {
+        return NULL;
+    }
+    memmove(&set->tags[position + 1], &set->tags[position],
+            sizeof(Tag) * (set->count - position));
+    strcpy(set->tags[position].name, folded);
+    set->tags[position].members = members;
+    set->count++;
+    return &set->tags[position];
+}
+
+static void drop_tag(struct TagSet *set, size_t position) {
+    tag_bitmap_free(set->tags[position].members);
+    memmove(&set->tags[position], &set->tags[position + 1],
+            sizeof(Tag) * (set->count - position - 1));
+    set->count--;
+}
+
+ValidationStatus book_tag_contact(AddressBook *book, int id, const char *tag) {
+    ValidationStatus status = is_valid_tag(tag);
+    if (status != VALID) {
+        return status;
+    }
+    if (ab_find(book, id, NULL) != VALID) {
+        return INVALID_NOT_FOUND;
+    }
+
+    char folded[MAX_TAG_LENGTH];
+    fold_tag(tag, folded);
+    Tag *entry = obtain_tag(book, folded);
+    if (entry == NULL) {
+        return INVALID_NO_MEMORY;
+    }
+    if (tag_bitmap_add(entry->members, (uint32_t)id) != 0) {
+        size_t position;
+        if (tag_bitmap_cardinality(entry->members) == 0 && find_tag(book->tags, folded, &position)) {
+            drop_tag(book->tags, position);
+        }
+        return INVALID_NO_MEMORY;
+    }
+    return VALID;
+}
+
+ValidationStatus book_untag_contact(AddressBook *book, int id, const char *tag) {
+    char folded[MAX_TAG_LENGTH];
+    fold_tag(tag, folded);
+    size_t position;
+    if (!find_tag(book->tags, folded, &position) ||
+        !tag_bitmap_contains(book->tags->tags[position].members, (uint32_t)id)) {
+        return INVALID_NOT_FOUND;
+    }
+
+    tag_bitmap_remove(book->tags->tags[position].members, (uint32_t)id);
+    if (tag_bitmap_cardinality(book->tags->tags[position].members) == 0) {
+        drop_tag(book->tags, position);
+    }
+    return VALID;
+}
+
+const TagBitmap *book_tag_members(const AddressBook *book, const char *tag) {
+    char folded[MAX_TAG_LENGTH];
+    fold_tag(tag, folded);
+    size_t position;
+    return find_tag(book->tags, folded, &position) ? book->tags->tags[position].members : NULL;
+}
+
+int book_list_tags(const AddressBook *book, const char **names, size_t *counts, int max) {
+    int total = book->tags != NULL ? (int)book->tags->count : 0;
+    for (int i = 0; i < total && i < max; i++) {
+        names[i] = book->tags->tags[i].name;
+        if (counts != NULL) {
+            counts[i] = tag_bitmap_cardinality(book->tags->tags[i].members);
+        }
+    }
+    return total;
+}
+
+int book_contact_tags(const AddressBook *book, int id, const char **names, int max) {
+    int found = 0;
+    for (size_t i = 0; book->tags != NULL && i < book->tags->count; i++) {
+        if (tag_bitmap_contains(book->tags->tags[i].members, (uint32_t)id)) {
+            if (found < max) {
+                names[found] = book->tags->tags[i].name;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+void tags_remove_contact(struct TagSet *tags, int id) {
+    if (tags == NULL) {
+        return;
+    }
+    for (size_t i = tags->count; i-- > 0;) {
+        tag_bitmap_remove(tags->tags[i].members, (uint32_t)id);
+        if (tag_bitmap_cardinality(tags->tags[i].members) == 0) {
+            drop_tag(tags, i);
+        }
+    }
+}
+
+void tags_free(struct TagSet *tags) {
+    if (tags == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < tags->count; i++) {
+        tag_bitmap_free(tags->tags[i].members);
+    }
+    free(tags->tags);
+    free(tags);
+}
+
+// ========================= Tag Expressions ========================= //
+
+/**
+ * @brief Recursive-descent parser state; every rule returns a bitmap it owns.
+ */
+typedef struct {
+    const AddressBook *book;
+    const char *cursor;
+    char *error;
+    size_t error_size;
+} TagParser;
+
+static TagBitmap *parse_union(TagParser *parser);
+
+static void skip_spaces(TagParser *parser) {
+    while (isspace((unsigned char)*parser->cursor)) {
+        parser->cursor++;
+    }
+}
+
+static TagBitmap *parse_error(TagParser *parser, const char *message) {
+    if (parser->error != NULL && parser->error_size > 0) {
+        snprintf(parser->error, parser->error_size, "%s at \"%.16s\"", message, parser->cursor);
+    }
+    return NULL;
+}
+
+static TagBitmap *parse_operand(TagParser *parser) {
+    skip_spaces(parser);
+    if (*parser->cursor == '(') {
+        parser->cursor++;
+        TagBitmap *inner = parse_union(parser);
+        if (inner == NULL) {
+            return NULL;
+        }
+        skip_spaces(parser);
+        if (*parser->cursor != ')') {
+            tag_bitmap_free(inner);
+            return parse_error(parser, "expected ')'");
+        }
+        parser->cursor++;
+        return inner;
+    }
+
+    char name[MAX_TAG_LENGTH];
+    size_t length = 0;
+    while (is_tag_char((unsigned char)*parser->cursor)) {
+        if (length == MAX_TAG_LENGTH - 1) {
+            return parse_error(parser, "tag name too long");
+        }
+        name[length++] = *parser->cursor++;
+    }
+    if (length == 0) {
+        return parse_error(parser, "expected a tag name or '('");
+    }
+    name[length] = '\0';
+
+    const TagBitmap *members = book_tag_members(parser->book, name);
+    TagBitmap *result = members != NULL ? tag_bitmap_copy(members) : tag_bitmap_create();
+    return result != NULL ? result : parse_error(parser, "out of memory");
+}
+
+static TagBitmap *parse_intersection(TagParser *parser) {
+    TagBitmap *result = parse_operand(parser);
+    skip_spaces(parser);
+    while (result != NULL && *parser->cursor == '&') {
+        parser->cursor++;
+        skip_spaces(parser);
+        bool negate = *parser->cursor == '!';
+        if (negate) {
+            parser->cursor++;
+        }
+        TagBitmap *right = parse_operand(parser);
+        TagBitmap *combined = NULL;
+        if (right != NULL) {
+            combined = negate ? tag_bitmap_andnot(result, right) : tag_bitmap_and(result, right);
+            if (combined == NULL) {
+                parse_error(parser, "out of memory");
+            }
+        }
+        tag_bitmap_free(result);
+        tag_bitmap_free(right);
+        result = combined;
+        skip_spaces(parser);
+    }
+    return result;
+}
+
+static TagBitmap *parse_union(TagParser *parser) {
+    TagBitmap *result = parse_intersection(parser);
+    while (result != NULL && *parser->cursor == '|') {
+        parser->cursor++;
+        TagBitmap *right = parse_intersection(parser);
+        TagBitmap *combined = NULL;
+        if (right != NULL) {
+            combined = tag_bitmap_or(result, right);
+            if (combined == NULL) {
+                parse_error(parser, "out of memory");
+            }
+        }
+        tag_bitmap_free(result);
+        tag_bitmap_free(right);
+        result = combined;
+    }
+    return result;
+}
+
+TagBitmap *tag_query(const AddressBook *book, const char *expression, char *error,
+                     size_t error_size) {
+    TraceSpan span = TRACE_BEGIN("tags.query");
+    TagParser parser = {book, expression, error, error_size};
+    TagBitmap *result = parse_union(&parser);
+    TRACE_END(span);
+    if (result != NULL && *parser.cursor != '\0') {
+        tag_bitmap_free(result);
+        return parse_error(&parser, *parser.cursor == '!' ? "'!' only follows '&'"
+                                                          : "unexpected text");
+    }
+    return result;
+}
+
+// ========================= Persistence ========================= //
+
+/**
+ * @brief Writes IDs as comma-separated runs ("1-4,9").
+ */
+typedef struct {
+    FILE *file;
+    uint32_t first;
+    uint32_t last;
+    bool open;
+} RangeWriter;
+
+static void flush_range(RangeWriter *writer) {
+    if (!writer->open) {
+        return;
+    }
+    if (writer->first == writer->last) {
+        fprintf(writer->file, "%u", writer->first);
+    }
+    else {
+        fprintf(writer->file, "%u-%u", writer->first, writer->last);
+    }
+}
+
+static int write_id(uint32_t id, void *context) {
+    RangeWriter *writer = context;
+    if (writer->open && id == writer->last + 1) {
+        writer->last = id;
+        return 0;
+    }
+    if (writer->open) {
+        flush_range(writer);
+        fputc(',', writer->file);
+    }
+    writer->first = writer->last = id;
+    writer->open = true;
+    return 0;
+}
+
+int save_tags(const AddressBook *book, const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int written = 0;
+    for (size_t i = 0; book->tags != NULL && i < book->tags->count; i++) {
+        fprintf(file, "%s:", book->tags->tags[i].name);
+        RangeWriter writer = {file, 0, 0, false};
+        tag_bitmap_foreach(book->tags->tags[i].members, write_id, &writer);
+        flush_range(&writer);
+        fputc('\n', file);
+        written++;
+    }
+
+    bool failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed) {
+        return -1;
+    }
+    return written;
+}
+
+/**
+ * @brief Reads an unsigned number; returns the character after it.
+ */
+static int read_number(FILE *file, int c, unsigned long *value, bool *ok) {
+    *value = 0;
+    *ok = isdigit(c) != 0;
+    while (isdigit(c)) {
+        *value = *value * 10 + (unsigned long)(c - '0');
+        if (*value > 2147483647UL) {
+            *ok = false;
+        }
+        c = getc(file);
+    }
+    return c;
+}
+
+int load_tags(AddressBook *book, const char *path, int *skipped) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int loaded = 0;
+    int bad = 0;
+    bool out_of_memory = false;
+    int c = getc(file);
+    while (c != EOF && !out_of_memory) {
+        char name[MAX_TAG_LENGTH];
+        size_t length = 0;
+        while (c != ':' && c != '\n' && c != EOF) {
+            if (length < MAX_TAG_LENGTH - 1) {
+                name[length] = (char)c;
+            }
+            length++;
+            c = getc(file);
+        }
+        bool ok = c == ':' && length < MAX_TAG_LENGTH;
+        name[length < MAX_TAG_LENGTH ? length : MAX_TAG_LENGTH - 1] = '\0';
+        ok = ok && is_valid_tag(name) == VALID;
+        bool any = false;
+
+        while (ok && c != '\n' && c != EOF) {
+            unsigned long first;
+            unsigned long last;
+            c = read_number(file, getc(file), &first, &ok);
+            last = first;
+            if (ok && c == '-') {
+                c = read_number(file, getc(file), &last, &ok);
+            }
+            ok = ok && first > 0 && first <= last && (c == ',' || c == '\n' || c == EOF);
+            for (unsigned long id = first; ok && id <= last; id++) {
+                ValidationStatus status = book_tag_contact(book, (int)id, name);
+                if (status == INVALID_NO_MEMORY) {
+                    out_of_memory = true;
+                    ok = false;
+                }
+                bad += status == INVALID_NOT_FOUND;
+                any = any || status == VALID;
+            }
+        }
+        if (!ok && !out_of_memory) {
+            bad++;
+        }
+        loaded += any;
+        while (c != '\n' && c != EOF) {
+            c = getc(file);
+        }
+        if (c == '\n') {
+            c = getc(file);
+        }
+    }
+    fclose(file);
+
+    if (skipped != NULL) {
+        *skipped = bad;
+    }
+    return out_of_memory ? -1 : loaded;
+}
+
+// ========================= Menus ========================= //
+
+static double elapsed_milliseconds(const struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static void read_line(const char *prompt, char *buffer, size_t size) {
+    printf("%s", prompt);
+    if (fgets(buffer, (int)size, stdin) == NULL) {
+        buffer[0] = '\0';
+        return;
+    }
+    if (strchr(buffer, '\n') == NULL) {
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF) {
+        }
+    }
+    remove_newline(buffer);
+}
+
+static void print_tag_list(const AddressBook *book) {
+    const char *names[TAG_LIST_LIMIT];
+    size_t counts[TAG_LIST_LIMIT];
+    int total = book_list_tags(book, names, counts, TAG_LIST_LIMIT);
+    if (total == 0) {
+        printf("Ein: *Sniffs around* Nobody is tagged yet.\n");
+        return;
+    }
+    printf("----------------------------------------------------\n");
+    printf("| %-32s | %-13s |\n", "Tag", "Contacts");
+    printf("----------------------------------------------------\n");
+    for (int i = 0; i < total && i < TAG_LIST_LIMIT; i++) {
+        printf("| %-32s | %-13zu |\n", names[i], counts[i]);
+    }
+    printf("----------------------------------------------------\n");
+    if (total > TAG_LIST_LIMIT) {
+        printf("Ein: ...and %d more tag(s).\n", total - TAG_LIST_LIMIT);
+    }
+}
+
+typedef struct {
+    const AddressBook *book;
+    int shown;
+} PrintContext;
+
+static int print_member(uint32_t id, void *context) {
+    PrintContext *print = context;
+    Contact *contact;
+    if (ab_find(print->book, (int)id, &contact) == VALID) {
+        printf("| %-4d | %-20s | %-15s | %-25s |\n", contact->id, contact->name, contact->phone,
+               contact->email);
+        print->shown++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Evaluates an expression and prints the matches as a contact table.
+ * @return 0 on success, -1 if the expression was rejected.
+ */
+static int show_matches(const AddressBook *book, const char *expression, bool list) {
+    char error[TAG_ERROR_LENGTH];
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    TagBitmap *matches = tag_query(book, expression, error, sizeof(error));
+    double millis = elapsed_milliseconds(&start);
+    if (matches == NULL) {
+        printf("Ein: *Tilts head* I couldn't read that tag expression: %s.\n", error);
+        return -1;
+    }
+
+    printf("Ein: %zu contact(s) match \"%s\" (%.3f ms).\n", tag_bitmap_cardinality(matches),
+           expression, millis);
+    if (list && tag_bitmap_cardinality(matches) > 0) {
+        printf("-----------------------------------------------------------------------------\n");
+        printf("| %-4s | %-20s | %-15s | %-25s |\n", "ID", "Name", "Phone", "Email");
+        printf("-----------------------------------------------------------------------------\n");
+        PrintContext print = {book, 0};
+        tag_bitmap_foreach(matches, print_member, &print);
+        printf("-----------------------------------------------------------------------------\n");
+    }
+    tag_bitmap_free(matches);
+    return 0;
+}
+
+void manage_tags(AddressBook *book) {
+    printf("\n<==================================| TAGS |====================================>\n");
+
+    if (book->head == NULL) {
+        printf("Ein: *Ears droop* There's nobody in the book yet, so there's nobody to tag.\n");
+        return;
+    }
+
+    int attempts = 0;
+    for (;;) {
+        printf("\n--------------------- TAG OPTIONS ----------------------\n");
+        printf("  %d) Tag a contact\n", TAG_ADD);
+        printf("  %d) Untag a contact\n", TAG_REMOVE);
+        printf("  %d) List tags\n", TAG_LIST);
+        printf("  %d) Find contacts by tags\n", TAG_FIND);
+        printf("  %d) Back\n", TAG_CANCEL);
+        printf("---------------------------------------------------------\n");
+
+        int choice = get_int_input("Ein: What should we do with tags? ");
+        if (choice == TAG_CANCEL) {
+            printf("Ein: Alright, back to the main menu.\n");
+            return;
+        }
+
+        char input[TAG_QUERY_MAX_LENGTH];
+        switch (choice) {
+            case TAG_ADD:
+            case TAG_REMOVE: {
+                Contact *target = search_contact(book);
+                if (target == NULL) {
+                    break;
+                }
+                read_line("Ein: Which tag? ", input, MAX_TAG_LENGTH);
+                ValidationStatus status = choice == TAG_ADD
+                                              ? book_tag_contact(book, target->id, input)
+                                              : book_untag_contact(book, target->id, input);
+                if (status == VALID) {
+                    printf("Ein: Done! %s is %s \"%s\". Woof!\n", target->name,
+                           choice == TAG_ADD ? "now tagged" : "no longer tagged", input);
+                }
+                else if (status == INVALID_NOT_FOUND) {
+                    printf("Ein: *Sniffs* %s doesn't have that tag.\n", target->name);
+                }
+                else {
+                    printf("Ein: Tags are letters, digits, '-' or '_', up to %d characters.\n",
+                           MAX_TAG_LENGTH - 1);
+                    print_validation_error(status);
+                }
+                break;
+            }
+            case TAG_LIST:
+                print_tag_list(book);
+                break;
+            case TAG_FIND:
+                printf("Ein: Combine tags with & (and), | (or), & ! (and not), and parentheses.\n");
+                read_line("Ein: Tags to match (e.g. vip & !on-call): ", input, sizeof(input));
+                show_matches(book, input, true);
+                break;
+            default:
+                printf("Ein: That's not one of the options. Let's try again.\n");
+                if (handle_attempt(&attempts) == CANCEL) {
+                    return;
+                }
+        }
+    }
+}
+
+static void print_tags_usage(void) {
+    printf("Usage: addressbook tags list\n");
+    printf("       addressbook tags count|show \"<expression>\"\n");
+    printf("       addressbook tags add|remove <tag> <id>...\n");
+    printf("  Expressions combine tags with & (and), | (or), & ! (and not), and parentheses.\n");
+}
+
+int run_tags_command(int argc, char *argv[]) {
+    if (argc < 1) {
+        print_tags_usage();
+        return 1;
+    }
+    bool modify = strcmp(argv[0], "add") == 0 || strcmp(argv[0], "remove") == 0;
+    bool query = strcmp(argv[0], "count") == 0 || strcmp(argv[0], "show") == 0;
+    if (!(strcmp(argv[0], "list") == 0 && argc == 1) && !(query && argc == 2) &&
+        !(modify && argc >= 3)) {
+        print_tags_usage();
+        return 1;
+    }
+
+    AddressBook book;
+    initialize(&book);
+    if (load_contacts_csv(&book, "contacts.csv", NULL) < 0) {
+        printf("Ein: *Whines* I couldn't read contacts.csv.\n");
+        free_address_book(&book);
+        return 1;
+    }
+    int skipped = 0;
+    if (load_tags(&book, TAGS_FILE_NAME, &skipped) > 0 && skipped > 0) {
+        printf("Ein: Skipped %d tag entr(ies) for contacts that are gone.\n", skipped);
+    }
+
+    int status = 0;
+    if (strcmp(argv[0], "list") == 0) {
+        print_tag_list(&book);
+    }
+    else if (query) {
+        status = show_matches(&book, argv[1], strcmp(argv[0], "show") == 0) == 0 ? 0 : 1;
+    }
+    else {
+        int changed = 0;
+        for (int i = 2; i < argc; i++) {
+            int id = atoi(argv[i]);
+            ValidationStatus result = strcmp(argv[0], "add") == 0
+                                          ? book_tag_contact(&book, id, argv[1])
+                                          : book_untag_contact(&book, id, argv[1]);
+            if (result == VALID) {
+                changed++;
+            }
+            else {
+                printf("Ein: Skipped ID %s: ", argv[i]);
+                print_validation_error(result);
+                status = 1;
+            }
+        }
+        if (save_tags(&book, TAGS_FILE_NAME) < 0) {
+            printf("Ein: *Whines* I couldn't write %s.\n", TAGS_FILE_NAME);
+            status = 1;
+        }
+        else {
+            printf("Ein: Updated \"%s\" on %d contact(s).\n", argv[1], changed);
+        }
+    }
+
+    free_address_book(&book);
+    return status;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file thread_pool.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of the worker thread pool on POSIX threads.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "thread_pool.h"
+
+/**
+ * @brief A queued task (singly linked FIFO).
+ */
+typedef struct PoolTask {
+    ThreadTask run;
+    void *arg;
+    struct PoolTask *next;
+} PoolTask;
+
+struct ThreadPool {
+    pthread_t *threads;
+    int thread_count;
+    PoolTask *head;
+    PoolTask *tail;
+    int pending;              // Queued plus running tasks.
+    bool stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t all_done;
+};
+
+static void *worker_main(void *arg) {
+    ThreadPool *pool = arg;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->head == NULL && !pool->stopping) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->head == NULL) {
+            break;
+        }
+
+        PoolTask *task = pool->head;
+        pool->head = task->next;
+        if (pool->head == NULL) {
+            pool->tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        task->run(task->arg);
+        free(task);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->all_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ThreadPool *thread_pool_create(int thread_count) {
+    if (thread_count < 1) {
+        thread_count = 1;
+    }
+
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->threads = malloc(sizeof(pthread_t) * thread_count);
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (int i = 0; i < thread_count; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            break;
+        }
+        pool->thread_count++;
+    }
+    if (pool->thread_count == 0) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int thread_pool_submit(ThreadPool *pool, ThreadTask task, void *arg) {
+    PoolTask *entry = malloc(sizeof(PoolTask));
+    if (entry == NULL) {
+        return -1;
+    }
+    entry->run = task;
+    entry->arg = arg;
+    entry->next = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->tail == NULL) {
+        pool->head = entry;
+    }
+    else {
+        pool->tail->next = entry;
+    }
+    pool->tail = entry;
+    pool->pending++;
+    pthread_cond_signal(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+void thread_pool_wait(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int thread_pool_size(const ThreadPool *pool) {
+    return pool->thread_count;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->all_done);
+    free(pool->threads);
+    free(pool);
+}
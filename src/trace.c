@@ -0,0 +1,176 @@
+/**
+ * @file trace.c
+ * @author Gajavelly Sai Suraj
+ * @brief Implementation of span recording and the Chrome trace-event writer.
+ * @copyright Copyright (c) 2025 All rights Reserved
+ */
+
+#define _XOPEN_SOURCE 700 // clock_gettime(CLOCK_MONOTONIC), getpid
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "trace.h"
+
+/**
+ * @brief A finished span.
+ */
+typedef struct {
+    const char *name;
+    const char *arg_name;
+    long long arg_value;
+    uint64_t start;
+    uint64_t end;
+    int thread;
+} TraceEvent;
+
+atomic_bool trace_active = false;
+
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static TraceEvent *events;
+static size_t event_count;
+static size_t event_capacity;
+static size_t dropped;
+static uint64_t origin;
+static char *output_path;
+static int next_thread = 1;
+static _Thread_local int thread_number;
+static bool exit_hook_registered;
+
+uint64_t trace_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t nanoseconds = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    return nanoseconds != 0 ? nanoseconds : 1; // 0 marks a span started with tracing off
+}
+
+static void stop_at_exit(void) {
+    trace_stop();
+}
+
+int trace_start(const char *path) {
+    pthread_mutex_lock(&trace_lock);
+    int status = -1;
+    if (!trace_active) {
+        output_path = malloc(strlen(path) + 1);
+        if (output_path != NULL) {
+            strcpy(output_path, path);
+            event_count = 0;
+            dropped = 0;
+            origin = trace_now();
+            trace_active = true;
+            status = 0;
+            if (!exit_hook_registered) {
+                exit_hook_registered = atexit(stop_at_exit) == 0;
+            }
+        }
+    }
+    pthread_mutex_unlock(&trace_lock);
+    return status;
+}
+
+int trace_start_from_env(void) {
+    const char *path = getenv(TRACE_ENV_VARIABLE);
+    if (path == NULL || path[0] == '\0') {
+        return 0;
+    }
+#ifdef ADDRESSBOOK_TRACING
+    return trace_start(path) == 0 ? 1 : -1;
+#else
+    return -1;
+#endif
+}
+
+void trace_record(const TraceSpan *span, const char *arg_name, long long arg_value) {
+    uint64_t end = trace_now();
+
+    pthread_mutex_lock(&trace_lock);
+    if (!trace_active) {
+        pthread_mutex_unlock(&trace_lock);
+        return;
+    }
+    if (thread_number == 0) {
+        thread_number = next_thread++;
+    }
+    if (event_count == event_capacity && event_capacity < TRACE_MAX_EVENTS) {
+        size_t capacity = event_capacity == 0 ? 1024 : event_capacity * 2;
+        capacity = capacity < TRACE_MAX_EVENTS ? capacity : TRACE_MAX_EVENTS;
+        TraceEvent *grown = realloc(events, sizeof(TraceEvent) * capacity);
+        if (grown != NULL) {
+            events = grown;
+            event_capacity = capacity;
+        }
+    }
+    if (event_count < event_capacity) {
+        TraceEvent *event = &events[event_count++];
+        event->name = span->name;
+        event->arg_name = arg_name;
+        event->arg_value = arg_value;
+        event->start = span->start;
+        event->end = end;
+        event->thread = thread_number;
+    }
+    else {
+        dropped++;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+/**
+ * @brief Converts a monotonic time to microseconds since tracing started.
+ */
+static double trace_micros(uint64_t time) {
+    return time > origin ? (double)(time - origin) / 1e3 : 0.0;
+}
+
+int trace_stop(void) {
+    pthread_mutex_lock(&trace_lock);
+    if (!trace_active) {
+        pthread_mutex_unlock(&trace_lock);
+        return -1;
+    }
+    trace_active = false;
+
+    int written = -1;
+    FILE *file = fopen(output_path, "w");
+    if (file != NULL) {
+        long pid = (long)getpid();
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":1,"
+                      "\"args\":{\"name\":\"addressbook\"}}",
+                pid);
+        for (size_t i = 0; i < event_count; i++) {
+            const TraceEvent *event = &events[i];
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"addressbook\",\"ph\":\"X\","
+                          "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%d",
+                    event->name, trace_micros(event->start),
+                    trace_micros(event->end) - trace_micros(event->start), pid, event->thread);
+            if (event->arg_name != NULL) {
+                fprintf(file, ",\"args\":{\"%s\":%lld}", event->arg_name, event->arg_value);
+            }
+            fprintf(file, "}");
+        }
+        if (dropped > 0) {
+            fprintf(file, ",\n{\"name\":\"trace.dropped\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,"
+                          "\"pid\":%ld,\"tid\":1,\"args\":{\"spans\":%zu}}",
+                    trace_micros(trace_now()), pid, dropped);
+        }
+        fprintf(file, "\n]}\n");
+        bool failed = ferror(file) != 0;
+        if (fclose(file) == 0 && !failed) {
+            written = (int)event_count;
+        }
+    }
+
+    free(events);
+    events = NULL;
+    event_count = 0;
+    event_capacity = 0;
+    free(output_path);
+    output_path = NULL;
+    pthread_mutex_unlock(&trace_lock);
+    return written;
+}
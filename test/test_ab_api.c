@@ -0,0 +1,78 @@
+// In test/test_ab_api.c
+#define _XOPEN_SOURCE 700 // for dup and dup2
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+
+#define OUTPUT_FILE "test_ab_api_output.txt"
+#define BULK_CONTACTS 50000
+
+int main() {
+    printf("--> Running test: test_ab_api...\n");
+    fflush(stdout);
+
+    // 1. ARRANGE: Capture stdout to prove the API prints nothing.
+    int saved_stdout = dup(fileno(stdout));
+    assert(saved_stdout >= 0);
+    assert(freopen(OUTPUT_FILE, "w", stdout) != NULL);
+
+    AddressBook book;
+    initialize(&book);
+
+    // 2. ACT
+    int ravi;
+    int sara;
+    ValidationStatus added = ab_add(&book, "Ravi Kumar", "9845012345", "ravi@corp.com", &ravi);
+    ValidationStatus second = ab_add(&book, "Sara Lee", "9845000002", "sara@corp.com", &sara);
+    ValidationStatus bad_name = ab_add(&book, "R2D2", "9845000003", "r2@corp.com", NULL);
+    ValidationStatus dup_phone = ab_add(&book, "Ravi Two", "9845012345", "two@corp.com", NULL);
+    ValidationStatus dup_email = ab_add(&book, "Ravi Two", "9845000004", "ravi@corp.com", NULL);
+    ValidationStatus too_long = ab_add(&book, "Averyveryveryveryveryveryveryveryveryveryverylongname",
+                                       "9845000005", "long@corp.com", NULL);
+
+    ValidationStatus keep_own = ab_update(&book, ravi, "Ravi K", "9845012345", NULL);
+    ValidationStatus take_other = ab_update(&book, ravi, NULL, NULL, "sara@corp.com");
+    ValidationStatus unknown = ab_update(&book, 999, "Nobody", NULL, NULL);
+    ValidationStatus removed = ab_remove(&book, sara);
+    ValidationStatus removed_again = ab_remove(&book, sara);
+
+    int bulk_ok = 0;
+    for (int i = 0; i < BULK_CONTACTS; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "bulk%d@corp.com", i);
+        bulk_ok += ab_add(&book, "Bulk Person", phone, email, NULL) == VALID;
+    }
+
+    fflush(stdout);
+    long printed = ftell(stdout);
+    dup2(saved_stdout, fileno(stdout));
+    close(saved_stdout);
+
+    // 3. ASSERT
+    assert(printed == 0);
+    assert(added == VALID && second == VALID && ravi == 1 && sara == 2);
+    assert(bad_name == INVALID_CHARACTERS);
+    assert(dup_phone == INVALID_DUPLICATE && dup_email == INVALID_DUPLICATE);
+    assert(too_long == INVALID_LENGTH);
+    assert(keep_own == VALID && take_other == INVALID_DUPLICATE && unknown == INVALID_NOT_FOUND);
+    assert(removed == VALID && removed_again == INVALID_NOT_FOUND);
+    assert(bulk_ok == BULK_CONTACTS && book.contact_count == BULK_CONTACTS + 1);
+
+    Contact *found;
+    assert(ab_find(&book, ravi, &found) == VALID);
+    assert(strcmp(found->name, "Ravi K") == 0 && strcmp(found->email, "ravi@corp.com") == 0);
+    assert(ab_find(&book, sara, &found) == INVALID_NOT_FOUND && found == NULL);
+    assert(ab_find(&book, BULK_CONTACTS + 2, NULL) == VALID);
+
+    // 4. CLEANUP
+    free_address_book(&book);
+    remove(OUTPUT_FILE);
+
+    printf("    [PASS] All checks passed for the embedding API.\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+// In test/test_autocomplete.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/autocomplete.h"
+
+#define BIG_CONTACTS 5000
+
+static Contact *add(AddressBook *book, const char *name, const char *phone) {
+    Contact *contact = malloc(sizeof(Contact));
+    assert(contact != NULL);
+    contact->id = book->next_id;
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    sprintf(contact->email, "user%d@corp.com", contact->id);
+    book_append_contact(book, contact);
+    return contact;
+}
+
+// Returns the IDs of the suggestions as a string such as "4 2 1", for easy comparison.
+static const char *suggest(const AddressBook *book, AutocompleteField field, const char *prefix,
+                           int limit) {
+    static char ids[256];
+    const Contact *suggestions[AUTOCOMPLETE_MAX_SUGGESTIONS];
+    int count = autocomplete_suggest(book, field, prefix, suggestions, limit);
+    assert(count >= 0);
+
+    ids[0] = '\0';
+    for (int i = 0; i < count; i++) {
+        sprintf(ids + strlen(ids), i == 0 ? "%d" : " %d", suggestions[i]->id);
+    }
+    return ids;
+}
+
+// The best @p limit matches found by brute force, in the same format.
+static const char *brute_force(const AddressBook *book, const int *uses, const char *prefix,
+                               int limit) {
+    static char ids[256];
+    int taken[AUTOCOMPLETE_MAX_SUGGESTIONS];
+    ids[0] = '\0';
+
+    for (int n = 0; n < limit; n++) {
+        const Contact *best = NULL;
+        for (const Contact *c = book->head; c != NULL; c = c->next) {
+            bool used = false;
+            for (int t = 0; t < n; t++) {
+                used = used || taken[t] == c->id;
+            }
+            bool match = true;
+            for (int i = 0; prefix[i] != '\0'; i++) {
+                match = match && tolower((unsigned char)c->name[i]) == prefix[i];
+            }
+            if (!used && match &&
+                (best == NULL || uses[c->id] > uses[best->id] ||
+                 (uses[c->id] == uses[best->id] && c->id > best->id))) {
+                best = c;
+            }
+        }
+        if (best == NULL) {
+            break;
+        }
+        taken[n] = best->id;
+        sprintf(ids + strlen(ids), n == 0 ? "%d" : " %d", best->id);
+    }
+    return ids;
+}
+
+int main() {
+    printf("--> Running test: test_autocomplete...\n");
+
+    // 1. ARRANGE
+    AddressBook book;
+    initialize(&book);
+    const Contact *none[1];
+    assert(autocomplete_suggest(&book, AUTOCOMPLETE_NAME, "a", none, 1) == -1);
+    assert(book_enable_autocomplete(&book) == 0);
+
+    add(&book, "Sachin Rao", "9845000001");
+    Contact *sara = add(&book, "Sara Lee", "9845000002");
+    add(&book, "Samir Khan", "7000000003");
+    add(&book, "John Smith", "9811000004");
+
+    // 2. ACT / ASSERT: Newest first among unpicked contacts, case-insensitive prefixes.
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "SA", 8), "3 2 1") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sa", 2), "3 2") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "", 8), "4 3 2 1") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_PHONE, "9845", 8), "2 1") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_EMAIL, "user3@", 8), "3") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sax", 8), "") == 0);
+    assert(autocomplete_guess_field("98") == AUTOCOMPLETE_PHONE);
+    assert(autocomplete_guess_field("ravi@") == AUTOCOMPLETE_EMAIL);
+    assert(autocomplete_guess_field("ravi") == AUTOCOMPLETE_NAME);
+
+    // Picks raise a contact, and the count survives an edit of its name.
+    autocomplete_record_use(&book, sara);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sa", 8), "2 3 1") == 0);
+    Contact values = *sara;
+    strcpy(values.name, "Sanya Lee");
+    sara = book_update_contact(&book, sara, &values);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sar", 8), "") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "san", 8), "2") == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sa", 8), "2 3 1") == 0);
+
+    // Contacts added after the build are found, removed ones are not.
+    add(&book, "Sam Wilson", "9845000005");
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sa", 8), "2 5 3 1") == 0);
+    assert(book_remove_contact(&book, book.head) == 0);
+    assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "sa", 8), "2 5 3") == 0);
+    free_address_book(&book);
+
+    // A bigger book, with picks, bulk adds and removals, agrees with a brute-force ranking.
+    static int uses[BIG_CONTACTS * 2 + 1];
+    initialize(&book);
+    assert(book_enable_autocomplete(&book) == 0);
+    srand(7);
+    for (int phase = 0; phase < 2; phase++) {
+        for (int i = 0; i < BIG_CONTACTS; i++) {
+            char name[MAX_NAME_LENGTH];
+            sprintf(name, "%c%c%c Person", 'a' + rand() % 3, 'a' + rand() % 4, 'a' + rand() % 26);
+            add(&book, name, "9845000000");
+        }
+        for (int i = 0; i < 300; i++) {
+            Contact *c = book.head;
+            for (int skip = rand() % 200; skip > 0; skip--) {
+                c = c->next;
+            }
+            autocomplete_record_use(&book, c);
+            uses[c->id]++;
+        }
+        assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "ab", 10),
+                      brute_force(&book, uses, "ab", 10)) == 0);
+    }
+    for (int i = 0; i < AUTOCOMPLETE_MAX_REMOVALS + 10; i++) {
+        Contact *c = book.head;
+        for (int skip = rand() % 100; skip > 0; skip--) {
+            c = c->next;
+        }
+        assert(book_remove_contact(&book, c) == 0);
+        if (i % 50 == 0) {
+            assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, "c", 20),
+                          brute_force(&book, uses, "c", 20)) == 0);
+        }
+    }
+    const char *prefixes[] = {"", "a", "bc", "cdz", "ca"};
+    for (size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++) {
+        assert(strcmp(suggest(&book, AUTOCOMPLETE_NAME, prefixes[p], 16),
+                      brute_force(&book, uses, prefixes[p], 16)) == 0);
+    }
+
+    // 3. CLEANUP
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for prefix autocomplete.\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+// In test/test_batch.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/batch.h"
+#include "../include/contact_helper.h"
+#include "../include/contact_index.h"
+
+#define TEST_FILE "test_batch_contacts.csv"
+
+static Contact *lookup_phone(const AddressBook *book, const char *phone) {
+    const IndexBucket *bucket = contact_index_lookup(&book->indexes->by_phone, phone);
+    return bucket != NULL && bucket->count == 1 ? bucket->contacts[0] : NULL;
+}
+
+int main() {
+    printf("--> Running test: test_batch...\n");
+
+    // 1. ARRANGE: A small book, saved once so rejected batches can be shown not to touch it.
+    AddressBook book;
+    initialize(&book);
+    Batch batch;
+    int status;
+    batch_init(&batch);
+    status = batch_add(&batch, "Ravi Kumar", "9845000001", "ravi@corp.com");
+    assert(status == 0);
+    status = batch_add(&batch, "Sara Lee", "9845000002", "sara@corp.com");
+    assert(status == 0);
+    status = batch_add(&batch, "Tom Hardy", "9845000003", "tom@mail.org");
+    assert(status == 0);
+    status = batch_commit(&book, &batch, TEST_FILE, NULL);
+    assert(status == BATCH_OK);
+    assert(book.contact_count == 3 && batch.ops[2].id == 3);
+    batch_free(&batch);
+
+    // 2. ACT / ASSERT: Every kind of conflict rejects the whole batch at the earliest offender.
+    BatchError error;
+    batch_init(&batch);
+    status = batch_add(&batch, "New One", "9000000001", "new1@x.com");
+    assert(status == 0);
+    status = batch_add(&batch, "New Two", "9000000001", "new2@x.com");
+    assert(status == 0);
+    status = batch_commit(&book, &batch, TEST_FILE, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.op_index == 1 && error.status == INVALID_DUPLICATE);
+    batch_free(&batch);
+
+    batch_init(&batch);
+    status = batch_remove(&batch, 3);
+    assert(status == 0);
+    status = batch_update(&batch, 1, "Ravi Kumar", "9845000001", "sara@corp.com");
+    assert(status == 0);
+    status = batch_validate(&book, &batch, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.op_index == 1 && error.status == INVALID_DUPLICATE);
+    batch_free(&batch);
+
+    batch_init(&batch);
+    status = batch_remove(&batch, 2);
+    assert(status == 0);
+    status = batch_remove(&batch, 42);
+    assert(status == 0);
+    status = batch_update(&batch, 2, "Sara Lee", "9845000002", "sara@corp.com");
+    assert(status == 0);
+    status = batch_add(&batch, "Bad 1", "9000000009", "bad@x.com");
+    assert(status == 0);
+    status = batch_validate(&book, &batch, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.op_index == 1 && error.status == INVALID_NOT_FOUND);
+    batch.ops[1].id = 3;
+    status = batch_validate(&book, &batch, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.op_index == 2 && error.status == INVALID_DUPLICATE);
+    batch.ops[2].id = 1;
+    status = batch_validate(&book, &batch, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.op_index == 3 && error.status == INVALID_CHARACTERS);
+    batch_free(&batch);
+
+    AddressBook on_disk;
+    initialize(&on_disk);
+    status = load_contacts_csv(&on_disk, TEST_FILE, NULL);
+    assert(status == 3);
+    free_address_book(&on_disk);
+    assert(book.contact_count == 3);
+
+    // Values freed by the same batch may be re-used: swap two phones and recycle an email.
+    batch_init(&batch);
+    status = batch_update(&batch, 1, "Ravi Kumar", "9845000002", "ravi@corp.com");
+    assert(status == 0);
+    status = batch_update(&batch, 2, "Sara Lee", "9845000001", "sara@corp.com");
+    assert(status == 0);
+    status = batch_remove(&batch, 3);
+    assert(status == 0);
+    status = batch_add(&batch, "Tom Again", "9845000004", "tom@mail.org");
+    assert(status == 0);
+    status = batch_commit(&book, &batch, TEST_FILE, &error);
+    assert(status == BATCH_OK);
+    assert(batch.ops[3].id == 4);
+    batch_free(&batch);
+
+    assert(book.contact_count == 3);
+    assert(lookup_phone(&book, "9845000002")->id == 1);
+    assert(lookup_phone(&book, "9845000001")->id == 2);
+    assert(lookup_phone(&book, "9845000003") == NULL);
+    assert(book.tail->id == 4);
+
+    // The saved file matches memory exactly.
+    initialize(&on_disk);
+    status = load_contacts_csv(&on_disk, TEST_FILE, NULL);
+    assert(status == 3);
+    const Contact *a = book.head;
+    for (const Contact *b = on_disk.head; b != NULL; a = a->next, b = b->next) {
+        assert(a->id == b->id && strcmp(a->phone, b->phone) == 0 &&
+               strcmp(a->email, b->email) == 0 && strcmp(a->name, b->name) == 0);
+    }
+    assert(on_disk.next_id == book.next_id);
+    free_address_book(&on_disk);
+
+    // A large batch (5,000 adds, then 200 removes and 40 updates) keeps the indexes usable.
+    batch_init(&batch);
+    for (int i = 0; i < 5000; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        snprintf(phone, sizeof(phone), "97%08d", i);
+        snprintf(email, sizeof(email), "bulk%d@corp.com", i);
+        status = batch_add(&batch, "Bulk Person", phone, email);
+        assert(status == 0);
+    }
+    status = batch_commit(&book, &batch, NULL, NULL);
+    assert(status == BATCH_OK);
+    batch_free(&batch);
+    assert(book.contact_count == 5003 && book.indexes != NULL);
+
+    batch_init(&batch);
+    for (int i = 0; i < 200; i++) {
+        status = batch_remove(&batch, 5 + i);
+        assert(status == 0);
+    }
+    for (int i = 0; i < 40; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        snprintf(phone, sizeof(phone), "96%08d", i);
+        status = batch_update(&batch, 1000 + i, "Changed", phone, "x@y.z");
+        assert(status == 0);
+    }
+    status = batch_validate(&book, &batch, &error);
+    assert(status == BATCH_REJECTED);
+    assert(error.status == INVALID_DUPLICATE && error.op_index == 201);
+    for (int i = 0; i < 40; i++) {
+        snprintf(batch.ops[200 + i].email, MAX_EMAIL_LENGTH, "changed%d@y.z", i);
+    }
+    status = batch_commit(&book, &batch, NULL, &error);
+    assert(status == BATCH_OK);
+    batch_free(&batch);
+
+    assert(book.contact_count == 4803);
+    assert(id_index_lookup(&book.indexes->by_id, 5) == NULL);
+    assert(strcmp(id_index_lookup(&book.indexes->by_id, 1039)->phone, "9600000039") == 0);
+    assert(lookup_phone(&book, "9600000039")->id == 1039);
+
+    // 3. CLEANUP
+    free_address_book(&book);
+    remove(TEST_FILE);
+
+    printf("    [PASS] All checks passed for batches.\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+// In test/test_change_feed.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/change_feed.h"
+#include "../include/snapshot.h"
+
+#define LOG_FILE "test_change_feed.log"
+#define MAX_SEEN 16
+
+typedef struct {
+    ChangeRecord records[MAX_SEEN];
+    int count;
+} Seen;
+
+static void remember(const ChangeRecord *change, void *context) {
+    Seen *seen = context;
+    assert(seen->count < MAX_SEEN);
+    seen->records[seen->count++] = *change;
+}
+
+int main() {
+    printf("--> Running test: test_change_feed...\n");
+
+    // 1. ARRANGE: A book with a log and one subscriber. Loaded contacts are not changes.
+    remove(LOG_FILE);
+    AddressBook book;
+    initialize(&book);
+    assert(ab_add(&book, "Loaded Before", "9845000009", "loaded@corp.com", NULL) == VALID);
+    assert(book_enable_change_feed(&book, LOG_FILE) == 0);
+    Seen seen = {.count = 0};
+    int handle = change_feed_subscribe(&book, remember, &seen);
+    assert(handle >= 0);
+
+    // 2. ACT
+    int ravi;
+    int sara;
+    assert(ab_add(&book, "Ravi Kumar", "9845000001", "ravi@corp.com", &ravi) == VALID);
+    assert(ab_add(&book, "Sara Lee", "9845000002", "sara@corp.com", &sara) == VALID);
+    assert(ab_update(&book, ravi, NULL, "9845000011", NULL) == VALID);
+    assert(ab_remove(&book, sara) == VALID);
+
+    // 3. ASSERT: Subscribers see every change in order, with before and after values.
+    assert(seen.count == 4 && change_feed_sequence(&book) == 4);
+    for (int i = 0; i < 4; i++) {
+        assert(seen.records[i].sequence == (unsigned long long)i + 1);
+    }
+    assert(seen.records[0].op == CHANGE_CREATE && seen.records[0].id == ravi);
+    assert(seen.records[0].before.name[0] == '\0');
+    assert(strcmp(seen.records[0].after.email, "ravi@corp.com") == 0);
+    assert(seen.records[2].op == CHANGE_UPDATE);
+    assert(strcmp(seen.records[2].before.phone, "9845000001") == 0);
+    assert(strcmp(seen.records[2].after.phone, "9845000011") == 0);
+    assert(seen.records[3].op == CHANGE_DELETE && seen.records[3].id == sara);
+    assert(strcmp(seen.records[3].before.name, "Sara Lee") == 0);
+    assert(seen.records[3].after.name[0] == '\0');
+
+    // The log holds the same records, and a cursor can resume after any of them.
+    ChangeCursor *cursor = change_cursor_open(LOG_FILE, 2);
+    assert(cursor != NULL);
+    ChangeRecord change;
+    assert(change_cursor_next(cursor, &change) == 1);
+    assert(change.sequence == 3 && change.op == CHANGE_UPDATE && change.id == ravi);
+    assert(strcmp(change.before.phone, "9845000001") == 0);
+    assert(strcmp(change.after.name, "Ravi Kumar") == 0);
+    assert(strcmp(change.after.phone, "9845000011") == 0);
+    assert(change_cursor_next(cursor, &change) == 1 && change.sequence == 4);
+    assert(change_cursor_next(cursor, &change) == 0);
+
+    // An update under an open snapshot copies the contact but is still one change.
+    assert(book_enable_snapshots(&book) == 0);
+    BookSnapshot *snapshot = snapshot_open(&book);
+    assert(ab_update(&book, ravi, "Ravi K", NULL, NULL) == VALID);
+    snapshot_close(snapshot);
+    assert(seen.count == 5 && seen.records[4].op == CHANGE_UPDATE);
+    assert(strcmp(seen.records[4].before.name, "Ravi Kumar") == 0);
+
+    // A tailing cursor picks up records appended after it reached the end.
+    assert(change_cursor_next(cursor, &change) == 1 && change.sequence == 5);
+    assert(strcmp(change.after.name, "Ravi K") == 0);
+
+    // Unsubscribed callbacks stop; reopening the log after a torn write continues the numbering.
+    change_feed_unsubscribe(&book, handle);
+    assert(book_disable_change_feed(&book) == 0);
+    FILE *log = fopen(LOG_FILE, "ab");
+    assert(log != NULL);
+    fputs("6,crea", log);
+    fclose(log);
+    assert(change_cursor_next(cursor, &change) == 0);
+
+    assert(book_enable_change_feed(&book, LOG_FILE) == 0);
+    assert(change_feed_sequence(&book) == 5);
+    assert(ab_add(&book, "Tom Hardy", "9845000003", "tom@corp.com", NULL) == VALID);
+    assert(seen.count == 5 && change_feed_sequence(&book) == 6);
+    assert(change_cursor_next(cursor, &change) == 1);
+    assert(change.sequence == 6 && change.op == CHANGE_CREATE);
+    assert(strcmp(change.after.name, "Tom Hardy") == 0);
+    assert(change_cursor_next(cursor, &change) == 0);
+    change_cursor_close(cursor);
+
+    // Without a log, the feed only numbers changes for subscribers.
+    assert(book_disable_change_feed(&book) == 0);
+    assert(book_enable_change_feed(&book, NULL) == 0 && change_feed_sequence(&book) == 0);
+    assert(change_cursor_open("missing.log", 0) == NULL);
+
+    // 4. CLEANUP
+    free_address_book(&book);
+    remove(LOG_FILE);
+
+    printf("    [PASS] All checks passed for the change feed.\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+// In test/test_compressed_store.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/compressed_store.h"
+
+#define TEST_FILE "test_contacts.abz"
+
+static Contact *new_contact(int id, const char *name, const char *phone, const char *email) {
+    Contact *contact = malloc(sizeof(Contact));
+    assert(contact != NULL);
+    contact->id = id;
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    contact->next = NULL;
+    return contact;
+}
+
+int main() {
+    printf("--> Running test: test_compressed_store...\n");
+
+    // 1. ARRANGE: The LZ codec round-trips repetitive and tiny inputs.
+    const char *text = "ravi kumar ravi kumar ravi kumar sara sara sara sara!";
+    unsigned char *packed = NULL;
+    size_t packed_length = 0;
+    int status = lz_compress((const unsigned char *)text, strlen(text), &packed, &packed_length);
+    assert(status == 0);
+    assert(packed_length < strlen(text));
+    char unpacked[128];
+    status = lz_decompress(packed, packed_length, (unsigned char *)unpacked, strlen(text));
+    assert(status == 0);
+    assert(memcmp(unpacked, text, strlen(text)) == 0);
+    free(packed);
+
+    // A book spanning several blocks, with a few irregular values mixed in.
+    AddressBook book;
+    initialize(&book);
+    int total = COMPRESSED_BLOCK_RECORDS * 2 + 17;
+    for (int i = 0; i < total; i++) {
+        char name[MAX_NAME_LENGTH];
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        snprintf(name, sizeof(name), "Person %c%c", 'A' + i % 26, 'a' + i / 26 % 26);
+        snprintf(phone, sizeof(phone), "98%08d", i * 7);
+        snprintf(email, sizeof(email), "user%d@%s", i, i % 3 == 0 ? "corp.com" : "mail.org");
+        book_append_contact(&book, new_contact(i * 2 + 1, name, phone, email));
+    }
+    book_append_contact(&book, new_contact(5, "Out Of Order", "0012345678", "no-at-sign"));
+    book_append_contact(&book, new_contact(9000000, "Odd Phone", "+91 98450", "x@y.z"));
+    book.next_id = 9000100;
+
+    // 2. ACT
+    int saved = save_contacts_compressed(&book, TEST_FILE);
+    assert(saved == total + 2);
+
+    AddressBook loaded;
+    initialize(&loaded);
+    int count = load_contacts_compressed(&loaded, TEST_FILE);
+    assert(count == total + 2);
+
+    // 3. ASSERT: Every field and the next ID survive the round trip, in order.
+    assert(loaded.contact_count == book.contact_count);
+    assert(loaded.next_id == 9000100);
+    const Contact *a = book.head;
+    const Contact *b = loaded.head;
+    while (a != NULL) {
+        assert(b != NULL);
+        assert(a->id == b->id);
+        assert(strcmp(a->name, b->name) == 0);
+        assert(strcmp(a->phone, b->phone) == 0);
+        assert(strcmp(a->email, b->email) == 0);
+        a = a->next;
+        b = b->next;
+    }
+    assert(b == NULL);
+    free_address_book(&loaded);
+
+    // A truncated file is reported as damaged rather than silently accepted.
+    FILE *file = fopen(TEST_FILE, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    unsigned char *bytes = malloc((size_t)size);
+    assert(bytes != NULL);
+    size_t moved = fread(bytes, 1, (size_t)size, file);
+    assert(moved == (size_t)size);
+    fclose(file);
+
+    file = fopen(TEST_FILE, "wb");
+    assert(file != NULL);
+    moved = fwrite(bytes, 1, (size_t)size / 2, file);
+    assert(moved == (size_t)size / 2);
+    fclose(file);
+    free(bytes);
+
+    initialize(&loaded);
+    count = load_contacts_compressed(&loaded, TEST_FILE);
+    assert(count == -1);
+    free_address_book(&loaded);
+
+    free_address_book(&book);
+    remove(TEST_FILE);
+
+    printf("    [PASS] All checks passed for the compressed store.\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+// In test/test_contact_report.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/batch.h"
+#include "../include/contact_report.h"
+
+#define BULK_CONTACTS 300
+
+static Contact *append_contact(AddressBook *book, int id, const char *name, const char *phone,
+                               const char *email) {
+    Contact *contact = malloc(sizeof(Contact));
+    assert(contact != NULL);
+    contact->id = id;
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    book_append_contact(book, contact);
+    return contact;
+}
+
+/**
+ * @brief Checks the book's maintained report against a fresh full scan of its list.
+ * @return Number of groups in the report.
+ */
+static size_t check_against_scan(const AddressBook *book, ReportOption group) {
+    AddressBook scan;
+    initialize(&scan);
+    scan.head = book->head;
+    scan.contact_count = book->contact_count;
+
+    ReportRow *maintained = NULL;
+    ReportRow *scanned = NULL;
+    size_t count = aggregates_report(book, group, &maintained);
+    size_t expected = aggregates_report(&scan, group, &scanned);
+
+    assert(count == expected);
+    for (size_t i = 0; i < count; i++) {
+        assert(strcmp(maintained[i].key, scanned[i].key) == 0);
+        assert(maintained[i].count == scanned[i].count);
+    }
+
+    // Groups that emptied out are deleted, not kept around with a zero count.
+    const CountTable *table = group == REPORT_BY_EMAIL_DOMAIN ? &book->aggregates->by_domain
+                                                              : &book->aggregates->by_phone_prefix;
+    assert(table->used == count);
+
+    free(maintained);
+    free(scanned);
+    return count;
+}
+
+int main() {
+    printf("--> Running test: test_contact_report...\n");
+
+    // 1. ARRANGE: Three contacts, two sharing a domain and two sharing a phone prefix.
+    AddressBook book;
+    initialize(&book);
+    Contact *ravi = append_contact(&book, 1, "Ravi Kumar", "9845012345", "ravi@corp.com");
+    Contact *sara = append_contact(&book, 2, "Sara", "9845099999", "sara@corp.com");
+    append_contact(&book, 3, "John", "7000012345", "john@mail.org");
+    assert(book.aggregates != NULL);
+
+    // 2. ACT / ASSERT: Appends, edits, and deletes keep the report in step with the list.
+    ReportRow *rows = NULL;
+    size_t count = aggregates_report(&book, REPORT_BY_PHONE_PREFIX, &rows);
+    assert(count == 2);
+    assert(strcmp(rows[0].key, "9845") == 0 && rows[0].count == 2);
+    free(rows);
+    check_against_scan(&book, REPORT_BY_EMAIL_DOMAIN);
+
+    Contact values = *sara;
+    strcpy(values.email, "sara@mail.org");
+    sara = book_update_contact(&book, sara, &values);
+    assert(sara != NULL);
+    int status = book_remove_contact(&book, ravi);
+    assert(status == 0);
+
+    count = aggregates_report(&book, REPORT_BY_EMAIL_DOMAIN, &rows);
+    assert(count == 1);
+    assert(strcmp(rows[0].key, "mail.org") == 0 && rows[0].count == 2);
+    free(rows);
+    check_against_scan(&book, REPORT_BY_EMAIL_DOMAIN);
+    check_against_scan(&book, REPORT_BY_PHONE_PREFIX);
+
+    // Batches: enough distinct groups to grow both tables, then move and delete most of them.
+    Batch batch;
+    batch_init(&batch);
+    for (int i = 0; i < BULK_CONTACTS; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        snprintf(phone, sizeof(phone), "9%03d000000", i);
+        snprintf(email, sizeof(email), "member%d@domain%d.com", i, i);
+        status = batch_add(&batch, "Pack Member", phone, email);
+        assert(status == 0);
+    }
+    status = batch_commit(&book, &batch, NULL, NULL);
+    assert(status == BATCH_OK);
+    int first_id = batch.ops[0].id;
+    batch_free(&batch);
+
+    count = check_against_scan(&book, REPORT_BY_EMAIL_DOMAIN);
+    assert(count == BULK_CONTACTS + 1);
+    check_against_scan(&book, REPORT_BY_PHONE_PREFIX);
+
+    batch_init(&batch);
+    for (int i = 0; i < BULK_CONTACTS / 2; i++) {
+        status = batch_remove(&batch, first_id + i);
+        assert(status == 0);
+    }
+    for (int i = BULK_CONTACTS / 2; i < BULK_CONTACTS / 2 + 50; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        snprintf(phone, sizeof(phone), "7000%06d", i);
+        snprintf(email, sizeof(email), "member%d@mail.org", i);
+        status = batch_update(&batch, first_id + i, "Pack Member", phone, email);
+        assert(status == 0);
+    }
+    status = batch_commit(&book, &batch, NULL, NULL);
+    assert(status == BATCH_OK);
+    batch_free(&batch);
+
+    count = check_against_scan(&book, REPORT_BY_EMAIL_DOMAIN);
+    assert(count == BULK_CONTACTS / 2 - 50 + 1);
+    check_against_scan(&book, REPORT_BY_PHONE_PREFIX);
+
+    batch_init(&batch);
+    for (int i = BULK_CONTACTS / 2; i < BULK_CONTACTS; i++) {
+        status = batch_remove(&batch, first_id + i);
+        assert(status == 0);
+    }
+    status = batch_commit(&book, &batch, NULL, NULL);
+    assert(status == BATCH_OK);
+    batch_free(&batch);
+
+    count = check_against_scan(&book, REPORT_BY_EMAIL_DOMAIN);
+    assert(count == 1);
+    count = check_against_scan(&book, REPORT_BY_PHONE_PREFIX);
+    assert(count == 2);
+
+    // 3. CLEANUP
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for contact reports.\n");
+    return 0;
+}
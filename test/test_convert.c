@@ -0,0 +1,117 @@
+// In test/test_convert.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/compressed_store.h"
+#include "../include/convert.h"
+
+#define INPUT_FILE "test_convert_input.csv"
+#define OUTPUT_FILE "test_convert_output"
+#define BIG_CONTACTS 20000
+
+int main() {
+    printf("--> Running test: test_convert...\n");
+
+    // 1. ARRANGE: A file mixing good records with each kind of bad one.
+    FILE *fptr = fopen(INPUT_FILE, "wb");
+    assert(fptr != NULL);
+    fprintf(fptr, "9\n");
+    fprintf(fptr, "3,Sara Lee,9845000003,sara@corp.com\n");
+    fprintf(fptr, "1,Ravi Kumar,9845000001,ravi@corp.com\r\n");
+    fprintf(fptr, "2,Bad Phone,98450,bad@corp.com\n");
+    fprintf(fptr, "4,Upper Case,9845000004,Upper@corp.com\n");
+    fprintf(fptr, "not a record\n");
+    fprintf(fptr, "5,%s,9845000005,long@corp.com\n",
+            "Averyveryveryveryveryveryveryveryveryveryverylongname");
+    fprintf(fptr, "\n");
+    fprintf(fptr, "6,Tom Hardy,9845000006,tom@mail.org");
+    fclose(fptr);
+
+    ConvertOptions options;
+    convert_default_options(&options);
+    options.report = NULL;
+    ConvertStats stats;
+    int status;
+
+    // 2. ACT / ASSERT: Plain CSV keeps input order and only the valid records.
+    status = convert_contacts(INPUT_FILE, OUTPUT_FILE, &options, &stats);
+    assert(status == 0);
+    assert(stats.records_read == 7 && stats.records_written == 3 && stats.records_invalid == 4);
+
+    AddressBook book;
+    initialize(&book);
+    status = load_contacts_csv(&book, OUTPUT_FILE, NULL);
+    assert(status == 3);
+    assert(book.head->id == 3 && book.head->next->id == 1 && book.tail->id == 6);
+    assert(strcmp(book.head->next->email, "ravi@corp.com") == 0);
+    free_address_book(&book);
+
+    // JSON Lines, sorted by name.
+    options.format = CONVERT_JSONL;
+    options.sort = CONVERT_SORT_NAME;
+    status = convert_contacts(INPUT_FILE, OUTPUT_FILE, &options, &stats);
+    assert(status == 0);
+    fptr = fopen(OUTPUT_FILE, "r");
+    char line[256];
+    char *read = fgets(line, sizeof(line), fptr);
+    assert(read != NULL);
+    assert(strcmp(line, "{\"id\":1,\"name\":\"Ravi Kumar\",\"phone\":\"9845000001\","
+                        "\"email\":\"ravi@corp.com\"}\n") == 0);
+    int lines = 1;
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+        lines++;
+    }
+    assert(lines == 3);
+    fclose(fptr);
+
+    // The compressed format round-trips through the regular loader.
+    options.format = CONVERT_COMPRESSED;
+    options.sort = CONVERT_SORT_ID;
+    status = convert_contacts(INPUT_FILE, OUTPUT_FILE, &options, &stats);
+    assert(status == 0);
+    initialize(&book);
+    status = load_contacts_compressed(&book, OUTPUT_FILE);
+    assert(status == 3);
+    assert(book.head->id == 1 && book.tail->id == 6 && book.next_id == 7);
+    free_address_book(&book);
+
+    // A large input under the smallest memory limit spills and merges many sorted runs.
+    fptr = fopen(INPUT_FILE, "wb");
+    assert(fptr != NULL);
+    for (int i = 0; i < BIG_CONTACTS; i++) {
+        int scrambled = (i * 7919) % BIG_CONTACTS;
+        fprintf(fptr, "%d,Person %c%c%c,97%08d,user%d@corp.com\n", i + 1, 'a' + scrambled % 26,
+                'a' + scrambled / 26 % 26, 'a' + scrambled / 676 % 26, scrambled, i);
+    }
+    fclose(fptr);
+
+    options.format = CONVERT_CSV;
+    options.sort = CONVERT_SORT_PHONE;
+    options.memory_limit = CONVERT_MIN_MEMORY;
+    status = convert_contacts(INPUT_FILE, OUTPUT_FILE, &options, &stats);
+    assert(status == 0);
+    assert(stats.records_written == BIG_CONTACTS && stats.sorted_runs > 64);
+    assert(stats.memory_used <= CONVERT_MIN_MEMORY);
+
+    initialize(&book);
+    status = load_contacts_csv(&book, OUTPUT_FILE, NULL);
+    assert(status == BIG_CONTACTS);
+    for (const Contact *c = book.head; c->next != NULL; c = c->next) {
+        assert(strcmp(c->phone, c->next->phone) < 0);
+    }
+    free_address_book(&book);
+
+    // Limits too small to hold the pipeline are refused.
+    options.memory_limit = CONVERT_MIN_MEMORY - 1;
+    status = convert_contacts(INPUT_FILE, OUTPUT_FILE, &options, &stats);
+    assert(status == -1);
+
+    // 3. CLEANUP
+    remove(INPUT_FILE);
+    remove(OUTPUT_FILE);
+
+    printf("    [PASS] All checks passed for the streaming converter.\n");
+    return 0;
+}
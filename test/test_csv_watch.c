@@ -0,0 +1,83 @@
+// In test/test_csv_watch.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/contact_helper.h"
+#include "../include/csv_watch.h"
+
+#define CSV_FILE "test_csv_watch.csv"
+
+int main() {
+    printf("--> Running test: test_csv_watch...\n");
+
+    // 1. ARRANGE: a saved book being watched, then unsaved local changes to contacts 2 and 5.
+    AddressBook book;
+    initialize(&book);
+    assert(ab_add(&book, "Anil Rao", "9845000001", "anil@corp.com", NULL) == VALID);
+    assert(ab_add(&book, "Bela Sen", "9845000002", "bela@corp.com", NULL) == VALID);
+    assert(ab_add(&book, "Chitra Iyer", "9845000003", "chitra@corp.com", NULL) == VALID);
+    assert(ab_add(&book, "Dev Shah", "9845000004", "dev@corp.com", NULL) == VALID);
+    assert(ab_add(&book, "Esha Das", "9845000005", "esha@corp.com", NULL) == VALID);
+    assert(save_contacts_csv(&book, CSV_FILE) == 5);
+    CsvWatch *watch = csv_watch_open(CSV_FILE);
+    assert(watch != NULL && csv_watch_reset(watch, &book) == 0);
+    CsvWatchStats stats;
+    assert(csv_watch_poll(watch, &book, NULL, &stats) == 0);
+
+    assert(ab_update(&book, 2, "Bela Sen Gupta", NULL, NULL) == VALID);
+    assert(ab_remove(&book, 5) == VALID);
+
+    // 2. ACT: another program rewrites the file.
+    FILE *file = fopen(CSV_FILE, "w");
+    assert(file != NULL);
+    fprintf(file, "6\n");
+    fprintf(file, "1,Anil Rao,9845000011,anil@corp.com\n");     // edited there only
+    fprintf(file, "2,Bela Sen,9845000002,bela@home.com\n");     // edited on both sides
+    fprintf(file, "4,Dev Shah,9845000004,dev@corp.com\n");      // unchanged; 3 deleted
+    fprintf(file, "5,Esha Das,9845000005,esha@home.com\n");     // deleted here, edited there
+    fprintf(file, "9,Farah Khan,9845000009,farah@corp.com\n");  // added there
+    fprintf(file, "10,Bad Phone,12345,bad@corp.com\n");         // invalid
+    fclose(file);
+    int status = csv_watch_poll(watch, &book, NULL, &stats);
+
+    // 3. ASSERT: only the changed records were applied, and both conflicts kept local values.
+    assert(status == 1);
+    assert(stats.examined == 6);
+    assert(stats.updated == 1 && stats.added == 1 && stats.deleted == 1);
+    assert(stats.conflicts == 2 && stats.rejected == 1);
+    assert(book.contact_count == 4);
+
+    Contact *contact = NULL;
+    assert(ab_find(&book, 1, &contact) == VALID && strcmp(contact->phone, "9845000011") == 0);
+    assert(ab_find(&book, 2, &contact) == VALID && strcmp(contact->name, "Bela Sen Gupta") == 0);
+    assert(strcmp(contact->email, "bela@corp.com") == 0);
+    assert(ab_find(&book, 3, NULL) == INVALID_NOT_FOUND);
+    assert(ab_find(&book, 5, NULL) == INVALID_NOT_FOUND);
+    assert(ab_find(&book, 9, &contact) == VALID && strcmp(contact->name, "Farah Khan") == 0);
+
+    // The indexes moved with the changes.
+    assert(is_phone_duplicate("9845000011", &book) == INVALID_DUPLICATE);
+    assert(is_phone_duplicate("9845000001", &book) == VALID);
+    assert(is_email_duplicate("chitra@corp.com", &book) == VALID);
+    assert(is_email_duplicate("farah@corp.com", &book) == INVALID_DUPLICATE);
+
+    // Conflicts are reported once: the file as read is the new base.
+    assert(csv_watch_poll(watch, &book, NULL, &stats) == 0);
+    assert(csv_watch_reload(watch, &book, NULL, &stats) == 0);
+    assert(stats.conflicts == 0 && stats.updated == 0 && stats.added == 0 && stats.deleted == 0);
+
+    // Our own save is not mistaken for someone else's.
+    assert(save_contacts_csv(&book, CSV_FILE) == 4);
+    assert(csv_watch_reset(watch, &book) == 0);
+    assert(csv_watch_poll(watch, &book, NULL, &stats) == 0);
+
+    // 4. CLEANUP
+    csv_watch_close(watch);
+    free_address_book(&book);
+    remove(CSV_FILE);
+
+    printf("    [PASS] All checks passed for csv watch.\n");
+    return 0;
+}
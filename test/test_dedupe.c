@@ -0,0 +1,62 @@
+// In test/test_dedupe.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/dedupe.h"
+
+static void set_contact(Contact *contact, int id, const char *name, const char *phone,
+                        const char *email) {
+    contact->id = id;
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    contact->next = NULL;
+}
+
+int main() {
+    printf("--> Running test: test_dedupe...\n");
+
+    // 1. ARRANGE: Normalization folds case, spacing, and token order.
+    char key[MAX_NAME_LENGTH];
+    normalize_name("Ravi  Kumar", key);
+    assert(strcmp(key, "kumar ravi") == 0);
+    normalize_name("kumar, RAVI", key);
+    assert(strcmp(key, "kumar ravi") == 0);
+    assert(jaro_winkler("martha", "marhta") > 0.95);
+
+    // A small book with one cluster of three spellings, each backed by a phone or email
+    // signal, plus a namesake and a "John Smith" pair that share nothing but their names.
+    Contact contacts[7];
+    set_contact(&contacts[0], 1, "Ravi Kumar", "9845012345", "ravi@corp.com");
+    set_contact(&contacts[1], 2, "Sara Ali", "9000000001", "sara@corp.com");
+    set_contact(&contacts[2], 3, "ravi kumar", "9845099999", "ravi@mail.org");
+    set_contact(&contacts[3], 4, "John Smith", "9000000002", "john@mail.org");
+    set_contact(&contacts[4], 5, "Ravi  Kumar", "8012312345", "r.kumar@mail.org");
+    set_contact(&contacts[5], 6, "Ravi Kumar", "9000000006", "ravikumar@mail.org");
+    set_contact(&contacts[6], 7, "john smith", "9000000007", "jsmith@corp.com");
+    for (int i = 0; i < 6; i++) {
+        contacts[i].next = &contacts[i + 1];
+    }
+
+    AddressBook book;
+    initialize(&book);
+    book.head = &contacts[0];
+    book.contact_count = 7;
+
+    // 2. ACT
+    DedupeReport *report = find_duplicate_clusters(&book, NULL);
+
+    // 3. ASSERT: One proposal keeping the oldest record; namesakes stay apart.
+    assert(report != NULL);
+    assert(report->record_count == 7);
+    assert(report->cluster_count == 1);
+    assert(report->clusters[0].member_count == 3);
+    assert(report->clusters[0].members[0]->id == 1);
+    assert(report->clusters[0].members[1]->id == 3);
+    assert(report->clusters[0].members[2]->id == 5);
+    free_dedupe_report(report);
+
+    printf("    [PASS] All checks passed for find_duplicate_clusters().\n");
+    return 0;
+}
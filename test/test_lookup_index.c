@@ -0,0 +1,91 @@
+// In test/test_lookup_index.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/lookup_index.h"
+
+#define CSV_FILE "test_lookup_index.csv"
+#define INDEX_FILE "test_lookup_index.idx"
+#define BOOK_SIZE 5000
+
+int main() {
+    printf("--> Running test: test_lookup_index...\n");
+
+    // 1. ARRANGE: a saved book, plus two damaged lines the build has to skip.
+    AddressBook book;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "98%08d", (i * 7919) % 100000000);
+        sprintf(email, "look%d@corp.com", i);
+        assert(ab_add(&book, "Look Person", phone, email, NULL) == VALID);
+    }
+    assert(ab_update(&book, 42, "Answer Person", NULL, NULL) == VALID);
+    assert(save_contacts_csv(&book, CSV_FILE) == BOOK_SIZE);
+    FILE *csv = fopen(CSV_FILE, "a");
+    assert(csv != NULL);
+    fprintf(csv, "not a record\n9999,Bad Phone,12,bad@corp.com\n");
+    fclose(csv);
+
+    // 2. ACT
+    int skipped = -1;
+    int built = lookup_index_build(CSV_FILE, INDEX_FILE, &skipped);
+    LookupIndex *index = lookup_index_open(INDEX_FILE);
+
+    // 3. ASSERT
+    assert(built == BOOK_SIZE && skipped == 2);
+    assert(index != NULL && lookup_index_count(index) == BOOK_SIZE);
+    assert(lookup_index_is_current(index, CSV_FILE));
+
+    Contact matches[LOOKUP_MAX_MATCHES];
+    assert(lookup_index_find(index, LOOKUP_BY_ID, "42", matches, LOOKUP_MAX_MATCHES) == 1);
+    assert(matches[0].id == 42 && strcmp(matches[0].name, "Answer Person") == 0);
+    assert(strcmp(matches[0].email, "look42@corp.com") == 0);
+
+    for (int i = 1; i <= BOOK_SIZE; i += 97) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "98%08d", (i * 7919) % 100000000);
+        sprintf(email, "LOOK%d@Corp.com", i);
+        assert(lookup_index_find(index, LOOKUP_BY_PHONE, phone, matches, 1) == 1);
+        assert(matches[0].id == i && strcmp(matches[0].phone, phone) == 0);
+        assert(lookup_index_find(index, LOOKUP_BY_EMAIL, email, matches, 1) == 1);
+        assert(matches[0].id == i);
+    }
+    assert(lookup_index_find(index, LOOKUP_BY_ID, "0", matches, 1) == 0);
+    assert(lookup_index_find(index, LOOKUP_BY_ID, "12x", matches, 1) == 0);
+    assert(lookup_index_find(index, LOOKUP_BY_ID, "9999", matches, 1) == 0);
+    assert(lookup_index_find(index, LOOKUP_BY_PHONE, "9800000000", matches, 1) == 0);
+    assert(lookup_index_find(index, LOOKUP_BY_EMAIL, "nobody@corp.com", matches, 1) == 0);
+
+    // Changing the CSV makes the lookup file stale.
+    csv = fopen(CSV_FILE, "a");
+    assert(csv != NULL);
+    fprintf(csv, "\n");
+    fclose(csv);
+    assert(!lookup_index_is_current(index, CSV_FILE));
+    lookup_index_close(index);
+
+    // A truncated lookup file is refused rather than read past its end.
+    FILE *file = fopen(INDEX_FILE, "rb");
+    assert(file != NULL);
+    char header[64];
+    size_t head = fread(header, 1, sizeof(header), file);
+    fclose(file);
+    file = fopen(INDEX_FILE, "wb");
+    fwrite(header, 1, head, file);
+    fclose(file);
+    assert(lookup_index_open(INDEX_FILE) == NULL);
+    assert(lookup_index_open("test_lookup_index.missing") == NULL);
+
+    // 4. CLEANUP
+    free_address_book(&book);
+    remove(CSV_FILE);
+    remove(INDEX_FILE);
+
+    printf("    [PASS] All checks passed for lookup index.\n");
+    return 0;
+}
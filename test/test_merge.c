@@ -0,0 +1,174 @@
+// In test/test_merge.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/convert.h"
+#include "../include/merge.h"
+
+#define BASE_FILE "test_merge_base.csv"
+#define OURS_FILE "test_merge_ours.csv"
+#define THEIRS_FILE "test_merge_theirs.csv"
+#define OUTPUT_FILE "test_merge_output.csv"
+#define BIG_CONTACTS 20000
+
+static void write_file(const char *path, const char *text) {
+    FILE *fptr = fopen(path, "wb");
+    assert(fptr != NULL);
+    fputs(text, fptr);
+    fclose(fptr);
+}
+
+static const Contact *find(const AddressBook *book, int id) {
+    for (const Contact *c = book->head; c != NULL; c = c->next) {
+        if (c->id == id) {
+            return c;
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    printf("--> Running test: test_merge...\n");
+
+    // 1. ARRANGE: Two branches of one book; ours is saved out of ID order.
+    write_file(BASE_FILE, "5\n"
+                          "1,Ravi Kumar,9845000001,ravi@corp.com\n"
+                          "2,Sara Lee,9845000002,sara@corp.com\n"
+                          "3,Tom Hanks,9845000003,tom@corp.com\n"
+                          "4,Ann Bell,9845000004,ann@corp.com\n"
+                          "5,Joe Root,9845000005,joe@corp.com\n");
+    write_file(OURS_FILE, "6\n"
+                          "2,Sara Lee,9845000022,sara@corp.com\n"
+                          "1,Ravi Kumar,9845000001,ravi@corp.com\n"
+                          "3,Tom Hanks,9845000003,tom@corp.com\n"
+                          "4,Ann Bell,9845000004,ann@ours.com\n"
+                          "6,New Ours,9845000006,new@corp.com\n");
+    write_file(THEIRS_FILE, "6\n"
+                            "1,Ravi K,9845000001,ravi@corp.com\n"
+                            "2,Sara Lee,9845000002,sara@new.com\n"
+                            "4,Ann Bell,9845000004,ann@theirs.com\n"
+                            "5,Joe Root,9845000055,joe@corp.com\n"
+                            "7,Same Phone,9845000006,other@corp.com\n"
+                            "not a record\n");
+
+    MergeOptions options;
+    merge_default_options(&options);
+    options.report = tmpfile();
+    assert(options.report != NULL);
+    MergeStats stats;
+
+    // 2. ACT
+    int status = merge_books(BASE_FILE, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats);
+
+    // ASSERT: Non-conflicting edits from both sides land, even in different fields of one contact.
+    assert(status == 0);
+    AddressBook book;
+    initialize(&book);
+    assert(load_contacts_csv(&book, OUTPUT_FILE, NULL) == 4);
+    const Contact *ravi = find(&book, 1);
+    const Contact *sara = find(&book, 2);
+    const Contact *ann = find(&book, 4);
+    assert(ravi != NULL && sara != NULL && ann != NULL);
+    assert(strcmp(ravi->name, "Ravi K") == 0);
+    assert(strcmp(sara->phone, "9845000022") == 0);
+    assert(strcmp(sara->email, "sara@new.com") == 0);
+    assert(find(&book, 3) == NULL); // deleted in theirs, untouched in ours
+    assert(find(&book, 5) == NULL); // deleted in ours, edited in theirs: conflict, ours wins
+    assert(strcmp(ann->email, "ann@ours.com") == 0);
+    assert(find(&book, 6) != NULL && find(&book, 7) == NULL); // 7 reuses 6's phone
+    free_address_book(&book);
+    assert(stats.records_written == 4 && stats.conflicts == 2 && stats.duplicates == 1);
+    assert(stats.deleted == 2 && stats.invalid == 1);
+
+    // The report names every conflict and the dropped contact.
+    char report[4096];
+    rewind(options.report);
+    size_t length = fread(report, 1, sizeof(report) - 1, options.report);
+    report[length] = '\0';
+    assert(strstr(report, "Conflict on ID 4") != NULL && strstr(report, "Conflict on ID 5") != NULL);
+    assert(strstr(report, "Dropped ID 7: its phone is already used by ID 6") != NULL);
+    fclose(options.report);
+    options.report = NULL;
+
+    // Preferring theirs flips the conflicting fields only.
+    options.prefer = MERGE_PREFER_THEIRS;
+    assert(merge_books(BASE_FILE, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == 0);
+    initialize(&book);
+    assert(load_contacts_csv(&book, OUTPUT_FILE, NULL) == 5);
+    ann = find(&book, 4);
+    const Contact *joe = find(&book, 5);
+    sara = find(&book, 2);
+    assert(ann != NULL && joe != NULL && sara != NULL);
+    assert(strcmp(ann->email, "ann@theirs.com") == 0);
+    assert(strcmp(joe->phone, "9845000055") == 0);
+    assert(strcmp(sara->phone, "9845000022") == 0);
+    free_address_book(&book);
+
+    // Without a base, contacts on one side only are additions.
+    options.prefer = MERGE_PREFER_OURS;
+    assert(merge_books(NULL, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == 0);
+    assert(stats.records_written == 6 && stats.conflicts == 3 && stats.duplicates == 1);
+
+    // Large books merge under the smallest memory limit.
+    FILE *ours = fopen(OURS_FILE, "wb");
+    FILE *theirs = fopen(THEIRS_FILE, "wb");
+    assert(ours != NULL && theirs != NULL);
+    for (int i = BIG_CONTACTS; i > 0; i--) {
+        fprintf(ours, "%d,Person,97%08d,user%d@corp.com\n", i, i, i);
+    }
+    for (int i = 1; i <= BIG_CONTACTS; i += 2) {
+        fprintf(theirs, "%d,Person,97%08d,user%d@corp.com\n", i + BIG_CONTACTS, i + BIG_CONTACTS,
+                i + BIG_CONTACTS);
+    }
+    fclose(ours);
+    fclose(theirs);
+    options.memory_limit = CONVERT_MIN_MEMORY;
+    assert(merge_books(NULL, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == 0);
+    assert(stats.records_written == BIG_CONTACTS + BIG_CONTACTS / 2 && stats.conflicts == 0);
+    initialize(&book);
+    assert(load_contacts_csv(&book, OUTPUT_FILE, NULL) == BIG_CONTACTS + BIG_CONTACTS / 2);
+    assert(book.head->id == 1 && book.tail->id == 2 * BIG_CONTACTS - 1);
+    free_address_book(&book);
+
+    // Too many reused phones to check in memory: the external sorts find them instead.
+    ours = fopen(OURS_FILE, "wb");
+    theirs = fopen(THEIRS_FILE, "wb");
+    assert(ours != NULL && theirs != NULL);
+    for (int i = 1; i <= BIG_CONTACTS / 4; i++) {
+        fprintf(ours, "%d,Person,97%08d,user%d@corp.com\n", i, i, i);
+        fprintf(theirs, "%d,Person,97%08d,other%d@corp.com\n", i + BIG_CONTACTS, i, i);
+    }
+    fclose(ours);
+    fclose(theirs);
+    assert(merge_books(NULL, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == 0);
+    assert(stats.records_written == BIG_CONTACTS / 4 && stats.duplicates == BIG_CONTACTS / 4);
+
+    // With no phone or email reused, the single merge pass is the result.
+    ours = fopen(OURS_FILE, "wb");
+    theirs = fopen(THEIRS_FILE, "wb");
+    assert(ours != NULL && theirs != NULL);
+    fprintf(ours, "1,Ravi Kumar,9845000001,ravi@corp.com\n3,Tom Hardy,9845000003,tom@corp.com\n");
+    fprintf(theirs, "2,Sara Ali,9845000002,sara@corp.com\n");
+    fclose(ours);
+    fclose(theirs);
+    options.memory_limit = CONVERT_DEFAULT_MEMORY;
+    assert(merge_books(NULL, OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == 0);
+    assert(stats.records_written == 3 && stats.duplicates == 0 && stats.conflicts == 0);
+    initialize(&book);
+    assert(load_contacts_csv(&book, OUTPUT_FILE, NULL) == 3);
+    assert(book.head->id == 1 && find(&book, 2) != NULL && book.tail->id == 3);
+    free_address_book(&book);
+
+    // A missing input fails the merge.
+    assert(merge_books("missing.csv", OURS_FILE, THEIRS_FILE, OUTPUT_FILE, &options, &stats) == -1);
+
+    // 3. CLEANUP
+    remove(BASE_FILE);
+    remove(OURS_FILE);
+    remove(THEIRS_FILE);
+    remove(OUTPUT_FILE);
+
+    printf("    [PASS] All checks passed for the streaming merge.\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+// In test/test_page_store.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/page_store.h"
+
+#define STORE_FILE "test_page_store.db"
+#define CSV_FILE "test_page_store.csv"
+#define BIG_CONTACTS 20000
+
+static void make_contact(Contact *contact, int i) {
+    contact->id = i + 1;
+    // Scramble the names so name-index inserts land all over the tree.
+    int scrambled = (i * 7919) % BIG_CONTACTS;
+    sprintf(contact->name, "Person %c%c%c", 'a' + scrambled % 26, 'a' + scrambled / 26 % 26,
+            'a' + scrambled / 676 % 26);
+    sprintf(contact->phone, "97%08d", scrambled);
+    sprintf(contact->email, "user%d@corp.com", i + 1);
+    contact->next = NULL;
+}
+
+typedef struct {
+    int count;
+    int last_id;
+    char last_name[MAX_NAME_LENGTH];
+    int ordered;
+} ScanState;
+
+static int check_id_order(const Contact *contact, void *context) {
+    ScanState *state = context;
+    state->ordered = state->ordered && contact->id > state->last_id;
+    state->last_id = contact->id;
+    state->count++;
+    return 0;
+}
+
+static int check_name_order(const Contact *contact, void *context) {
+    ScanState *state = context;
+    state->ordered = state->ordered && strcmp(contact->name, state->last_name) >= 0;
+    strcpy(state->last_name, contact->name);
+    state->count++;
+    return 0;
+}
+
+int main() {
+    printf("--> Running test: test_page_store...\n");
+
+    // 1. ARRANGE: A store far larger than its buffer pool.
+    remove(STORE_FILE);
+    PageStore *store = page_store_open(STORE_FILE, PAGE_STORE_MIN_POOL);
+    assert(store != NULL);
+
+    Contact contact;
+    for (int i = 0; i < BIG_CONTACTS; i++) {
+        make_contact(&contact, i);
+        assert(page_store_insert(store, &contact) == 0);
+    }
+    make_contact(&contact, 5);
+    assert(page_store_insert(store, &contact) == -1);
+
+    PageStoreStats stats;
+    page_store_stats(store, &stats);
+    assert(stats.contact_count == BIG_CONTACTS);
+    assert(stats.page_count > 20 * stats.pool_pages);
+    assert(stats.evictions > 0 && stats.writes > 0);
+    assert(page_store_close(store) == 0);
+
+    // 2. ACT / ASSERT: Everything is found again after reopening.
+    store = page_store_open(STORE_FILE, PAGE_STORE_MIN_POOL);
+    assert(store != NULL);
+
+    Contact found;
+    make_contact(&contact, 12345);
+    assert(page_store_get(store, 12346, &found) == 1);
+    assert(strcmp(found.name, contact.name) == 0 && strcmp(found.email, contact.email) == 0);
+    assert(page_store_find_phone(store, contact.phone, &found) == 1 && found.id == 12346);
+    assert(page_store_find_email(store, "USER12346@corp.com", &found) == 1 && found.id == 12346);
+    assert(page_store_get(store, BIG_CONTACTS + 1, &found) == 0);
+    assert(page_store_find_phone(store, "1234567890", &found) == 0);
+
+    ScanState state = {0, 0, "", 1};
+    assert(page_store_scan(store, check_id_order, &state) == 0);
+    assert(state.count == BIG_CONTACTS && state.ordered);
+
+    ScanState names = {0, 0, "", 1};
+    assert(page_store_scan_name(store, "person ab", check_name_order, &names) == 0);
+    assert(names.ordered && names.count > 0 && names.count <= 26 * 2);
+
+    // Validated adds, updates that move index keys, and removals.
+    ValidationStatus status;
+    assert(page_store_add(store, "Ravi Kumar", "9845012345", "ravi@corp.com", &status) ==
+           BIG_CONTACTS + 1);
+    assert(page_store_add(store, "Ravi Two", "9845012345", "ravi2@corp.com", &status) == -1);
+    assert(status == INVALID_DUPLICATE);
+    assert(page_store_add(store, "Ravi 3", "9845012346", "ravi3@corp.com", &status) == -1);
+    assert(status == INVALID_CHARACTERS);
+
+    Contact values;
+    strcpy(values.name, "Zed Kumar");
+    strcpy(values.phone, "9845012345");
+    strcpy(values.email, "zed@corp.com");
+    assert(page_store_update(store, BIG_CONTACTS + 1, &values, &status) == 0);
+    assert(page_store_find_email(store, "ravi@corp.com", &found) == 0);
+    assert(page_store_find_email(store, "zed@corp.com", &found) == 1 && found.id == BIG_CONTACTS + 1);
+    strcpy(values.email, "user1@corp.com");
+    assert(page_store_update(store, BIG_CONTACTS + 1, &values, &status) == -1);
+    assert(status == INVALID_DUPLICATE);
+    assert(page_store_update(store, BIG_CONTACTS + 7, &values, &status) == -1);
+    assert(status == INVALID_NOT_FOUND);
+
+    for (int id = 1; id <= BIG_CONTACTS; id += 2) {
+        assert(page_store_remove(store, id) == 0);
+    }
+    assert(page_store_remove(store, 1) == -1);
+    make_contact(&contact, 0);
+    assert(page_store_find_phone(store, contact.phone, &found) == 0);
+    assert(page_store_insert(store, &contact) == 0);
+
+    // CSV round trip through a fresh store.
+    assert(page_store_export_csv(store, CSV_FILE) == BIG_CONTACTS / 2 + 2);
+    assert(page_store_close(store) == 0);
+
+    AddressBook book;
+    initialize(&book);
+    assert(load_contacts_csv(&book, CSV_FILE, NULL) == BIG_CONTACTS / 2 + 2);
+    assert(book.head->id == 1 && book.tail->id == BIG_CONTACTS + 1);
+    free_address_book(&book);
+
+    remove(STORE_FILE);
+    store = page_store_open(STORE_FILE, PAGE_STORE_MIN_POOL);
+    int skipped;
+    assert(page_store_import_csv(store, CSV_FILE, &skipped) == BIG_CONTACTS / 2 + 2);
+    assert(skipped == 0);
+    assert(page_store_import_csv(store, CSV_FILE, &skipped) == 0);
+    assert(skipped == BIG_CONTACTS / 2 + 2);
+    assert(page_store_add(store, "New Person", "9000000001", "new@corp.com", &status) ==
+           BIG_CONTACTS + 2);
+
+    // 3. CLEANUP
+    assert(page_store_close(store) == 0);
+    remove(STORE_FILE);
+    remove(CSV_FILE);
+
+    printf("    [PASS] All checks passed for the paged store.\n");
+    return 0;
+}
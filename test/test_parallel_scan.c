@@ -0,0 +1,129 @@
+// In test/test_parallel_scan.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/parallel_scan.h"
+#include "../include/query.h"
+#include "../include/snapshot.h"
+
+#define BOOK_SIZE 100000
+
+static bool id_divisible(const Contact *contact, void *context) {
+    return contact->id % *(const int *)context == 0;
+}
+
+/**
+ * @brief Matches every contact, but makes the first quarter of the book slow to check so the
+ * other workers run out of work early and have to steal.
+ */
+static bool slow_start(const Contact *contact, void *context) {
+    (void)context;
+    volatile unsigned spin = 0;
+    for (int i = 0; contact->id <= BOOK_SIZE / 4 && i < 2000; i++) {
+        spin += (unsigned)i;
+    }
+    return true;
+}
+
+static bool same_order(Contact **left, Contact **right, int count) {
+    for (int i = 0; i < count; i++) {
+        if (left[i] != right[i] || (i > 0 && left[i - 1]->id >= left[i]->id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    printf("--> Running test: test_parallel_scan...\n");
+
+    // 1. ARRANGE
+    AddressBook book;
+    int status;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "scan%d@corp.com", i);
+        status = ab_add(&book, i % 10 == 0 ? "Scan Tenth" : "Scan Person", phone, email, NULL);
+        assert(status == VALID);
+    }
+    int divisor = 7;
+
+    // 2. ACT / ASSERT: four workers find the same contacts, in list order, as one.
+    ScanStats stats;
+    ScanResult serial;
+    ScanResult parallel;
+    status = parallel_scan(&book, id_divisible, &divisor, 1, &serial, &stats);
+    assert(status == 0 && serial.count == BOOK_SIZE / 7 && stats.threads == 1);
+    assert(serial.scanned == BOOK_SIZE && serial.snapshot == NULL);
+    status = parallel_scan(&book, id_divisible, &divisor, 4, &parallel, &stats);
+    assert(status == 0 && parallel.count == serial.count);
+    assert(same_order(parallel.matches, serial.matches, (int)serial.count));
+    assert(stats.threads == 4);
+    assert(stats.chunks == (BOOK_SIZE + PARALLEL_SCAN_CHUNK - 1) / PARALLEL_SCAN_CHUNK);
+    parallel_scan_free(&parallel);
+
+    // Uneven work is rebalanced by stealing, and every contact is still seen exactly once.
+    status = parallel_scan(&book, slow_start, NULL, 4, &parallel, &stats);
+    assert(status == 0 && parallel.count == BOOK_SIZE && parallel.matches[0]->id == 1);
+    assert(parallel.matches[BOOK_SIZE - 1]->id == BOOK_SIZE && stats.steals > 0);
+    parallel_scan_free(&parallel);
+
+    // With snapshots on, the scan reads a snapshot and keeps it open until its result is freed,
+    // so a contact removed meanwhile stays readable through the result.
+    status = book_enable_snapshots(&book);
+    assert(status == 0);
+    status = ab_remove(&book, 7);
+    assert(status == VALID);
+    status = parallel_scan(&book, id_divisible, &divisor, 3, &parallel, &stats);
+    assert(status == 0 && parallel.count == serial.count - 1 && parallel.snapshot != NULL);
+    assert(same_order(parallel.matches, serial.matches + 1, (int)parallel.count));
+    assert(stats.threads == 3);
+    status = ab_remove(&book, 14);
+    assert(status == VALID);
+    assert(snapshot_retired_count(&book) == 1 && parallel.matches[0]->id == 14);
+    parallel_scan_free(&parallel);
+    assert(snapshot_retired_count(&book) == 0);
+
+    // The calling thread reads the snapshot too.
+    status = parallel_scan(&book, id_divisible, &divisor, 1, &parallel, &stats);
+    assert(status == 0 && parallel.count == serial.count - 2 && parallel.snapshot != NULL);
+    parallel_scan_free(&parallel);
+    parallel_scan_free(&serial);
+
+    // Small books are not worth the threads.
+    assert(parallel_scan_threads(PARALLEL_SCAN_MIN_CONTACTS - 1, 8) == 1);
+    assert(parallel_scan_threads(PARALLEL_SCAN_MIN_CONTACTS, 64) ==
+           PARALLEL_SCAN_MIN_CONTACTS / PARALLEL_SCAN_CHUNK);
+
+    // Unindexed queries go through the parallel scan and keep their ID order.
+    Query *query = query_parse("name ~= 'tenth' AND email ~= '5'", NULL, 0);
+    assert(query != NULL);
+    QueryResult result;
+    status = query_execute(&book, query, &result);
+    assert(status == 0);
+    size_t expected = 0;
+    for (int i = 10; i <= BOOK_SIZE; i += 10) {
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(email, "scan%d@corp.com", i);
+        expected += strchr(email, '5') != NULL;
+    }
+    assert(result.count == expected && result.examined == (size_t)book.contact_count);
+    for (size_t i = 1; i < result.count; i++) {
+        assert(result.contacts[i - 1]->id < result.contacts[i]->id);
+    }
+
+    // 3. CLEANUP
+    query_result_free(&result);
+    query_free(query);
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for parallel scan.\n");
+    return 0;
+}
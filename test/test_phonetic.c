@@ -0,0 +1,88 @@
+// In test/test_phonetic.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/contact_index.h"
+#include "../include/phonetic.h"
+#include "../include/search_cursor.h"
+
+static Contact *add(AddressBook *book, int id, const char *name) {
+    Contact *contact = malloc(sizeof(Contact));
+    assert(contact != NULL);
+    contact->id = id;
+    strcpy(contact->name, name);
+    sprintf(contact->phone, "98450000%02d", id);
+    sprintf(contact->email, "user%d@corp.com", id);
+    book_append_contact(book, contact);
+    return contact;
+}
+
+// Runs a sounds-like search and returns a bitmask of the matching IDs.
+static int search(const AddressBook *book, const char *query) {
+    SearchCursor cursor;
+    SearchCursorStatus opened = search_cursor_open(&cursor, book, SEARCH_SOUNDS_LIKE, query, 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    int mask = 0;
+    for (Contact *match; (match = search_cursor_next(&cursor)) != NULL;) {
+        mask |= 1 << match->id;
+    }
+    return mask;
+}
+
+int main() {
+    printf("--> Running test: test_phonetic...\n");
+
+    // 1. ARRANGE / ASSERT: The reference Soundex codes.
+    const char *words[][2] = {
+        {"Robert", "R163"}, {"Rupert", "R163"},   {"Ashcraft", "A261"}, {"Tymczak", "T522"},
+        {"Pfister", "P236"}, {"Honeyman", "H555"}, {"Lee", "L000"},      {"srinivas", "S651"},
+    };
+    char code[PHONETIC_CODE_LENGTH];
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        assert(soundex_code(words[i][0], code) == 0);
+        assert(strcmp(code, words[i][1]) == 0);
+    }
+    assert(soundex_code(" x", code) == -1);
+
+    char codes[PHONETIC_MAX_TOKENS][PHONETIC_CODE_LENGTH];
+    assert(phonetic_name_codes("  Ravi  Kumar Ravi ", codes) == 2);
+    assert(strcmp(codes[0], "R100") == 0 && strcmp(codes[1], "K560") == 0);
+
+    AddressBook book;
+    initialize(&book);
+    add(&book, 1, "Srinivas Rao");
+    add(&book, 2, "Mohammed Khan");
+    add(&book, 3, "Muhammad Ali");
+    Contact *shrinivas = add(&book, 4, "Shrinivas Reddy");
+    add(&book, 5, "John Smith");
+
+    // 2. ACT / ASSERT: Answered from the phonetic index.
+    assert(book.indexes != NULL);
+    assert(search(&book, "shrinivas") == ((1 << 1) | (1 << 4)));
+    assert(search(&book, "Muhamad") == ((1 << 2) | (1 << 3)));
+    assert(search(&book, "muhammad KAHN") == (1 << 2));
+    assert(search(&book, "Smyth Jon") == (1 << 5));
+    assert(search(&book, "Zed") == 0);
+    assert(search(&book, "  ") == 0);
+
+    // Edits move a contact between phonetic keys.
+    Contact values = *shrinivas;
+    strcpy(values.name, "Jon Smythe");
+    assert(book_update_contact(&book, shrinivas, &values) != NULL);
+    assert(search(&book, "srinivas") == (1 << 1));
+    assert(search(&book, "john smith") == ((1 << 4) | (1 << 5)));
+
+    // Without indexes the same answers come from a scan.
+    book_indexes_free(book.indexes);
+    book.indexes = NULL;
+    assert(search(&book, "srinivas") == (1 << 1));
+    assert(search(&book, "john smith") == ((1 << 4) | (1 << 5)));
+
+    // 3. CLEANUP
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for the phonetic index.\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+// In test/test_query.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/autocomplete.h"
+#include "../include/contact_index.h"
+#include "../include/query.h"
+
+static void set_contact(Contact *contact, int id, const char *name, const char *phone,
+                        const char *email) {
+    contact->id = id;
+    strcpy(contact->name, name);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    contact->next = NULL;
+}
+
+// Runs a query and returns a bitmask of the matching IDs (IDs are 1..4).
+static int run(const AddressBook *book, const char *text) {
+    Query *query = query_parse(text, NULL, 0);
+    assert(query != NULL);
+
+    QueryResult result;
+    int status = query_execute(book, query, &result);
+    assert(status == 0);
+
+    int mask = 0;
+    for (size_t i = 0; i < result.count; i++) {
+        mask |= 1 << result.contacts[i]->id;
+    }
+    query_result_free(&result);
+    query_free(query);
+    return mask;
+}
+
+int main() {
+    printf("--> Running test: test_query...\n");
+
+    // 1. ARRANGE
+    Contact contacts[4];
+    set_contact(&contacts[0], 1, "Sachin", "9845012345", "sachin@corp.com");
+    set_contact(&contacts[1], 2, "Sara", "7000012345", "sara@corp.com");
+    set_contact(&contacts[2], 3, "Samir", "9811111111", "samir@mail.org");
+    set_contact(&contacts[3], 4, "John", "9822222222", "john@corp.com");
+    for (int i = 0; i < 3; i++) {
+        contacts[i].next = &contacts[i + 1];
+    }
+
+    AddressBook book;
+    initialize(&book);
+    book.head = &contacts[0];
+    book.contact_count = 4;
+
+    // Syntax errors are reported, not crashed on.
+    char error[QUERY_ERROR_LENGTH];
+    assert(query_parse("name ^= 'Sa' AND", error, sizeof(error)) == NULL);
+    assert(error[0] != '\0');
+    assert(query_parse("colour = 'red'", error, sizeof(error)) == NULL);
+    assert(query_parse("id = 99999999999999999999", error, sizeof(error)) == NULL);
+    assert(strstr(error, "id") != NULL);
+    assert(query_parse("id = ''", error, sizeof(error)) == NULL);
+
+    // Canonical form folds case and makes OR-under-AND grouping explicit.
+    Query *query = query_parse("(phone ^= 98 or EMAIL = 'X@Y.com') and name prefix = 'SA'", NULL, 0);
+    assert(query != NULL);
+    char text[QUERY_MAX_LENGTH];
+    query_to_string(query, text, sizeof(text));
+    assert(strcmp(text, "(phone ^= '98' OR email = 'x@y.com') AND name ^= 'sa'") == 0);
+    query_free(query);
+
+    // 2. ACT + ASSERT: Same answers with a full scan and with the indexes.
+    for (int pass = 0; pass < 2; pass++) {
+        assert(run(&book, "name ^= 'Sa' AND domain = 'corp.com' AND phone ^= '98'") == (1 << 1));
+        assert(run(&book, "domain = 'corp.com'") == ((1 << 1) | (1 << 2) | (1 << 4)));
+        assert(run(&book, "phone = '9811111111' OR email = 'john@corp.com'") == ((1 << 3) | (1 << 4)));
+        assert(run(&book, "name ~= 'a' AND (id = 2 OR id = 3)") == ((1 << 2) | (1 << 3)));
+        assert(run(&book, "domain = 'nowhere.net'") == 0);
+        int padded = run(&book, "id = 002 OR id = '0003'");
+        assert(padded == ((1 << 2) | (1 << 3)));
+
+        if (pass == 0) {
+            book.indexes = book_indexes_create();
+            for (int i = 0; i < 4; i++) {
+                int added = book_indexes_add(book.indexes, &contacts[i]);
+                assert(added == 0);
+            }
+        }
+    }
+
+    // The planner drives from the most selective index and skips the rest of the book.
+    query = query_parse("domain = 'corp.com' AND phone = '7000012345'", NULL, 0);
+    QueryResult result;
+    int status = query_execute(&book, query, &result);
+    assert(status == 0);
+    assert(result.count == 1 && result.examined == 1);
+    query_result_free(&result);
+    query_free(query);
+
+    // With autocomplete on, a selective prefix walks its sorted range instead of the book.
+    status = book_enable_autocomplete(&book);
+    assert(status == 0);
+    query = query_parse("name ^= 'SAM' OR phone ^= '70'", NULL, 0);
+    status = query_execute(&book, query, &result);
+    assert(status == 0);
+    assert(result.count == 2 && result.examined == 2);
+    assert(result.contacts[0]->id == 2 && result.contacts[1]->id == 3);
+    query_result_free(&result);
+    query_free(query);
+    assert(run(&book, "name ^= 'sa' AND email ^= 'SACHIN@'") == (1 << 1));
+    assert(run(&book, "name ^= 'sa'") == ((1 << 1) | (1 << 2) | (1 << 3)));
+
+    autocomplete_free(book.autocomplete);
+    book_indexes_free(book.indexes);
+
+    printf("    [PASS] All checks passed for the query engine.\n");
+    return 0;
+}
@@ -0,0 +1,93 @@
+// In test/test_query_cache.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/query.h"
+#include "../include/query_cache.h"
+
+#define BOOK_SIZE 200
+
+// Runs a query through the cache; returns 1 on a hit, 0 on a miss, with the match count.
+static int run(QueryCache *cache, const AddressBook *book, const char *text, size_t *count) {
+    Query *query = query_parse(text, NULL, 0);
+    assert(query != NULL);
+    QueryResult result;
+    int cached = query_cache_execute(cache, book, query, &result);
+    assert(cached >= 0);
+    *count = result.count;
+    query_result_free(&result);
+    query_free(query);
+    return cached;
+}
+
+int main() {
+    printf("--> Running test: test_query_cache...\n");
+
+    // 1. ARRANGE: a book with two name groups and a cache following it.
+    AddressBook book;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "%s%08d", i % 2 == 0 ? "98" : "97", i);
+        sprintf(email, "cache%d@%s.com", i, i % 2 == 0 ? "corp" : "mail");
+        assert(ab_add(&book, i % 2 == 0 ? "Ravi Kumar" : "Meena Iyer", phone, email, NULL) ==
+               VALID);
+    }
+    QueryCache *cache = query_cache_create(3, BOOK_SIZE);
+    assert(cache != NULL);
+    assert(query_cache_attach(cache, &book) == 0);
+    assert(query_cache_attach(cache, &book) == -1);
+
+    // 2. ACT / 3. ASSERT: a repeat is a hit, also when written differently.
+    size_t count = 0;
+    assert(run(cache, &book, "phone ^= '98'", &count) == 0 && count == BOOK_SIZE / 2);
+    assert(run(cache, &book, "phone prefix '98'", &count) == 1 && count == BOOK_SIZE / 2);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 0 && count == BOOK_SIZE / 2);
+    assert(run(cache, &book, "NAME ~= 'IYER'", &count) == 1);
+
+    // A change drops only the entries whose results the contact was or would be part of.
+    assert(ab_update(&book, 2, NULL, NULL, "cache2@mail.com") == VALID);
+    assert(run(cache, &book, "phone ^= '98'", &count) == 0 && count == BOOK_SIZE / 2);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 1);
+    assert(ab_add(&book, "Meena Rao", "9600000000", "new@mail.com", NULL) == VALID);
+    assert(run(cache, &book, "phone ^= '98'", &count) == 1);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 1);
+    assert(ab_update(&book, 3, "Meena Rao", NULL, NULL) == VALID);
+    assert(run(cache, &book, "phone ^= '98'", &count) == 1);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 0 && count == BOOK_SIZE / 2 - 1);
+    assert(ab_remove(&book, 4) == VALID);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 1);
+    assert(run(cache, &book, "phone ^= '98'", &count) == 0 && count == BOOK_SIZE / 2 - 1);
+
+    QueryCacheStats stats;
+    query_cache_stats(cache, &stats);
+    assert(stats.lookups == 12 && stats.hits == 7);
+    assert(stats.invalidations == 3 && stats.evictions == 0 && stats.entries == 2);
+
+    // The bounds evict the least recently used entries.
+    assert(run(cache, &book, "id = 1", &count) == 0 && count == 1);
+    assert(run(cache, &book, "id = 5", &count) == 0 && count == 1);
+    query_cache_stats(cache, &stats);
+    assert(stats.entries == 3 && stats.evictions == 1);
+    assert(run(cache, &book, "id = 1", &count) == 1);
+    assert(run(cache, &book, "name ~= 'iyer'", &count) == 0);
+    assert(run(cache, &book, "name ~= 'e'", &count) == 0 && count > BOOK_SIZE / 2);
+    assert(run(cache, &book, "name ~= 'e'", &count) == 1);
+    query_cache_stats(cache, &stats);
+    assert(stats.contacts <= BOOK_SIZE && stats.evictions == 4);
+
+    // A result larger than the contact bound is not cached at all.
+    assert(ab_add(&book, "Last Person", "9500000000", "last@mail.com", NULL) == VALID);
+    assert(run(cache, &book, "email ~= '.com'", &count) == 0 && count == BOOK_SIZE + 1);
+    assert(run(cache, &book, "email ~= '.com'", &count) == 0);
+
+    // 4. CLEANUP
+    query_cache_free(cache);
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for query cache.\n");
+    return 0;
+}
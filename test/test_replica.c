@@ -0,0 +1,120 @@
+// In test/test_replica.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/change_feed.h"
+#include "../include/replica.h"
+#include "../include/search_cursor.h"
+
+#define START_FILE "test_replica_start.csv"
+#define LATER_FILE "test_replica_later.csv"
+#define LOG_FILE "test_replica.log"
+
+// Asserts that the replica holds exactly the primary's contacts.
+static void assert_same(const AddressBook *primary, const AddressBook *replica) {
+    assert(primary->contact_count == replica->contact_count);
+    for (const Contact *contact = primary->head; contact != NULL; contact = contact->next) {
+        Contact *copy = NULL;
+        assert(ab_find(replica, contact->id, &copy) == VALID);
+        assert(strcmp(copy->name, contact->name) == 0);
+        assert(strcmp(copy->phone, contact->phone) == 0);
+        assert(strcmp(copy->email, contact->email) == 0);
+    }
+}
+
+int main() {
+    printf("--> Running test: test_replica...\n");
+
+    // 1. ARRANGE: a primary saved before its log starts, then changed with the log on.
+    remove(LOG_FILE);
+    AddressBook primary;
+    initialize(&primary);
+    assert(ab_add(&primary, "Ravi Kumar", "9845000001", "ravi@corp.com", NULL) == VALID);
+    assert(ab_add(&primary, "Sara Ali", "9845000002", "sara@corp.com", NULL) == VALID);
+    assert(save_contacts_csv(&primary, START_FILE) == 2);
+    assert(book_enable_change_feed(&primary, LOG_FILE) == 0);
+
+    Replica *replica = replica_open(START_FILE, LOG_FILE, 0);
+    assert(replica != NULL);
+    assert(replica_catch_up(replica) == 0);
+
+    int tom = 0;
+    assert(ab_add(&primary, "Tom Hardy", "9845000003", "tom@corp.com", &tom) == VALID);
+    assert(ab_update(&primary, 1, "Ravi K", NULL, NULL) == VALID);
+    assert(save_contacts_csv(&primary, LATER_FILE) == 3);
+    assert(ab_remove(&primary, 2) == VALID);
+    assert(ab_update(&primary, tom, NULL, "9845777003", NULL) == VALID);
+
+    // 2. ACT / 3. ASSERT: the replica sees how far behind it is, then catches up.
+    ReplicaStatus status;
+    replica_status(replica, &status);
+    assert(status.applied_sequence == 0 && status.log_sequence == 4 && status.behind == 4);
+    assert(status.backlog_bytes > 0 && status.contacts == 2);
+
+    assert(replica_catch_up(replica) == 4);
+    assert_same(&primary, replica_book(replica));
+    replica_status(replica, &status);
+    assert(status.applied_sequence == 4 && status.behind == 0 && status.backlog_bytes == 0);
+    assert(status.applied == 4 && status.apply_lag_ms >= 0);
+
+    // Its indexes and queries follow along.
+    SearchCursor cursor;
+    SearchCursorStatus opened = search_cursor_open(&cursor, replica_book(replica),
+                                                   SEARCH_PHONE_ENDS_WITH, "+91 98457 77003", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    Contact *found = search_cursor_next(&cursor);
+    assert(found != NULL && found->id == tom && search_cursor_next(&cursor) == NULL);
+    Query *query = query_parse("name ~= 'ravi'", NULL, 0);
+    assert(query != NULL);
+    QueryResult result;
+    assert(replica_query(replica, query, &result) == 0 && result.count == 1);
+    query_result_free(&result);
+    assert(replica_query(replica, query, &result) == 1);
+    query_result_free(&result);
+    assert(ab_update(&primary, 1, "Meena Iyer", NULL, NULL) == VALID);
+    assert(replica_catch_up(replica) == 1);
+    assert(replica_query(replica, query, &result) == 0 && result.count == 0);
+    query_result_free(&result);
+    query_free(query);
+
+    // A replica started from a later save replays the whole log and still converges.
+    Replica *late = replica_open(LATER_FILE, LOG_FILE, 0);
+    assert(late != NULL);
+    assert(replica_catch_up(late) == 5);
+    assert_same(&primary, replica_book(late));
+
+    // A torn record is left for later, and applied once the primary rewrites it.
+    assert(book_disable_change_feed(&primary) == 0);
+    FILE *log = fopen(LOG_FILE, "ab");
+    assert(log != NULL);
+    fputs("6,crea", log);
+    fclose(log);
+    assert(replica_catch_up(replica) == 0);
+    replica_status(replica, &status);
+    assert(status.behind == 0 && status.backlog_bytes > 0);
+    assert(book_enable_change_feed(&primary, LOG_FILE) == 0);
+    assert(ab_add(&primary, "Anu Rao", "9845000004", "anu@corp.com", NULL) == VALID);
+    assert(replica_catch_up(replica) == 1 && replica_catch_up(late) == 1);
+    assert_same(&primary, replica_book(replica));
+    assert_same(&primary, replica_book(late));
+
+    // A damaged starting file is refused.
+    log = fopen(LATER_FILE, "w");
+    assert(log != NULL);
+    fputs("not,a\ncontacts file\n", log);
+    fclose(log);
+    assert(replica_open(LATER_FILE, LOG_FILE, 0) == NULL);
+
+    // 4. CLEANUP
+    replica_close(late);
+    replica_close(replica);
+    free_address_book(&primary);
+    remove(START_FILE);
+    remove(LATER_FILE);
+    remove(LOG_FILE);
+
+    printf("    [PASS] All checks passed for replica.\n");
+    return 0;
+}
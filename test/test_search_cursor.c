@@ -0,0 +1,141 @@
+// In test/test_search_cursor.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/search_cursor.h"
+
+#define BOOK_SIZE 1000
+#define SHARED_NAME_EVERY 10 // every tenth contact is called "Common Name"
+
+// Drains a cursor and returns how many matches it yielded.
+static int drain(SearchCursor *cursor) {
+    int count = 0;
+    while (search_cursor_next(cursor) != NULL) {
+        count++;
+    }
+    return count;
+}
+
+int main() {
+    printf("--> Running test: test_search_cursor...\n");
+
+    // 1. ARRANGE: a book where one name is shared by many contacts.
+    AddressBook book;
+    initialize(&book);
+    const char *names[] = {"Ravi Kumar", "Meena Iyer", "Srinivas Rao", "Arjun Das"};
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "91%08d", i);
+        sprintf(email, "cursor%d@corp.com", i);
+        const char *name = i % SHARED_NAME_EVERY == 0 ? "Common Name" : names[i % 4];
+        assert(ab_add(&book, name, phone, email, NULL) == VALID);
+    }
+
+    // 2. ACT / 3. ASSERT: exact searches walk only the value's index bucket.
+    SearchCursor cursor;
+    SearchCursorStatus opened;
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_NAME, "Common Name", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    Contact *first = search_cursor_next(&cursor);
+    assert(first != NULL && first->id == SHARED_NAME_EVERY);
+    assert(search_cursor_examined(&cursor) == 1);
+    assert(drain(&cursor) + 1 == BOOK_SIZE / SHARED_NAME_EVERY);
+    assert(search_cursor_examined(&cursor) == BOOK_SIZE / SHARED_NAME_EVERY);
+    assert(search_cursor_next(&cursor) == NULL);
+
+    // The name index folds case, but the search stays exact.
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_NAME, "common name", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(search_cursor_next(&cursor) == NULL);
+
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_PHONE, "9100000500", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    Contact *found = search_cursor_next(&cursor);
+    assert(found != NULL && found->id == 500);
+    assert(search_cursor_next(&cursor) == NULL);
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_EMAIL, "cursor7@corp.com", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    found = search_cursor_next(&cursor);
+    assert(found != NULL && found->id == 7);
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_EMAIL, "nobody@corp.com", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(search_cursor_next(&cursor) == NULL);
+
+    // A limit stops the cursor early.
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_NAME, "Common Name", 3);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(drain(&cursor) == 3);
+    assert(search_cursor_examined(&cursor) == 3);
+
+    // Sounds-like matches every token, from the smallest bucket.
+    opened = search_cursor_open(&cursor, &book, SEARCH_SOUNDS_LIKE, "shrinivas", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    int sounds = drain(&cursor);
+    assert(sounds > 0);
+    opened = search_cursor_open(&cursor, &book, SEARCH_SOUNDS_LIKE, "ravee kumaar", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(drain(&cursor) == sounds);
+    opened = search_cursor_open(&cursor, &book, SEARCH_SOUNDS_LIKE, "123", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(search_cursor_next(&cursor) == NULL);
+    opened = search_cursor_open(&cursor, &book, SEARCH_CANCEL, "x", 0);
+    assert(opened == SEARCH_CURSOR_BAD_FIELD);
+
+    // Menu numbers scripted input relies on: Cancel stays 4, newer searches come after it.
+    assert(SEARCH_CANCEL == 4 && SEARCH_SOUNDS_LIKE == 5 && SEARCH_PHONE_ENDS_WITH == 6);
+
+    // Trailing digits, or a number with a country code, go through the phone suffix index.
+    const char *numbers[] = {"000-0500", "100000500", "+91 91000 00500"};
+    for (int i = 0; i < 3; i++) {
+        opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, numbers[i], 0);
+        assert(opened == SEARCH_CURSOR_OK);
+        found = search_cursor_next(&cursor);
+        assert(found != NULL && found->id == 500);
+        assert(search_cursor_next(&cursor) == NULL);
+        assert(search_cursor_examined(&cursor) == 1);
+    }
+    opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, "9900000500", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(search_cursor_next(&cursor) == NULL);
+    opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, "00500", 0);
+    assert(opened == SEARCH_CURSOR_TOO_FEW_DIGITS);
+
+    // The suffix index follows phone changes.
+    assert(ab_update(&book, 500, NULL, "9155555555", NULL) == VALID);
+    opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, "0000500", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(search_cursor_next(&cursor) == NULL);
+    opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, "555 5555", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    found = search_cursor_next(&cursor);
+    assert(found != NULL && found->id == 500);
+
+    // Without indexes the cursor walks the list, still stopping at the first match.
+    book_suspend_indexing(&book);
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_NAME, "Common Name", 1);
+    assert(opened == SEARCH_CURSOR_OK);
+    first = search_cursor_next(&cursor);
+    assert(first != NULL && first->id == SHARED_NAME_EVERY);
+    assert(search_cursor_next(&cursor) == NULL);
+    assert(search_cursor_examined(&cursor) == SHARED_NAME_EVERY);
+    opened = search_cursor_open(&cursor, &book, SEARCH_BY_NAME, "Common Name", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(drain(&cursor) == BOOK_SIZE / SHARED_NAME_EVERY);
+    opened = search_cursor_open(&cursor, &book, SEARCH_SOUNDS_LIKE, "shrinivas", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    assert(drain(&cursor) == sounds);
+    opened = search_cursor_open(&cursor, &book, SEARCH_PHONE_ENDS_WITH, "+91 9155555555", 0);
+    assert(opened == SEARCH_CURSOR_OK);
+    found = search_cursor_next(&cursor);
+    assert(found != NULL && found->id == 500);
+    book_resume_indexing(&book);
+
+    // 4. CLEANUP
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for search cursor.\n");
+    return 0;
+}
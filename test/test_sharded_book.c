@@ -0,0 +1,153 @@
+// In test/test_sharded_book.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/contact_helper.h"
+#include "../include/contact_index.h"
+#include "../include/query.h"
+#include "../include/sharded_book.h"
+
+#define TEST_PATTERN "test_contacts.shard%d.csv"
+#define TEST_SHARDS 4
+#define TEST_CONTACTS 500
+
+static void assert_matches_single_book(const ShardedBook *sharded, const AddressBook *book,
+                                       const char *text) {
+    Query *query = query_parse(text, NULL, 0);
+    assert(query != NULL);
+
+    QueryResult expected;
+    QueryResult actual;
+    int status = query_execute(book, query, &expected);
+    assert(status == 0);
+    status = sharded_book_query(sharded, query, &actual);
+    assert(status == 0);
+
+    assert(actual.count == expected.count);
+    for (size_t i = 0; i < actual.count; i++) {
+        assert(actual.contacts[i]->id == expected.contacts[i]->id);
+    }
+
+    query_result_free(&expected);
+    query_result_free(&actual);
+    query_free(query);
+}
+
+int main() {
+    printf("--> Running test: test_sharded_book...\n");
+
+    // 1. ARRANGE: The same contacts in one book and spread over four shards.
+    ShardedBook sharded;
+    int result = sharded_book_init(&sharded, TEST_SHARDS, 2);
+    assert(result == 0);
+    AddressBook book;
+    initialize(&book);
+
+    for (int i = 0; i < TEST_CONTACTS; i++) {
+        char name[MAX_NAME_LENGTH];
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        snprintf(name, sizeof(name), "Person %c%c", 'A' + i % 26, 'a' + i / 26 % 26);
+        snprintf(phone, sizeof(phone), "98%08d", i * 13);
+        snprintf(email, sizeof(email), "user%d@%s", i, i % 3 == 0 ? "corp.com" : "mail.org");
+
+        ValidationStatus status;
+        int id = sharded_book_add(&sharded, name, phone, email, &status);
+        assert(id == i + 1 && status == VALID);
+
+        Contact *contact = malloc(sizeof(Contact));
+        assert(contact != NULL);
+        *contact = *sharded_book_find(&sharded, id);
+        contact->next = NULL;
+        book_append_contact(&book, contact);
+    }
+
+    // 2. ASSERT: Every shard got some contacts, each held by the shard owning its phone.
+    assert(sharded_book_count(&sharded) == TEST_CONTACTS);
+    for (int i = 0; i < TEST_SHARDS; i++) {
+        assert(sharded.shards[i].contact_count > 0);
+        for (const Contact *c = sharded.shards[i].head; c != NULL; c = c->next) {
+            assert(shard_for_phone(&sharded, c->phone) == i);
+        }
+    }
+
+    // Phone and email stay unique across shards.
+    ValidationStatus status;
+    result = sharded_book_add(&sharded, "Copy Cat", "9800000013", "new@x.com", &status);
+    assert(result == -1 && status == INVALID_DUPLICATE);
+    result = sharded_book_add(&sharded, "Copy Cat", "9111111111", "user7@mail.org", &status);
+    assert(result == -1 && status == INVALID_DUPLICATE);
+    result = sharded_book_add(&sharded, "Bad 1", "9111111111", "ok@x.com", &status);
+    assert(result == -1 && status != VALID && status != INVALID_DUPLICATE);
+
+    // Fanned-out queries return exactly what a single book returns, in ID order.
+    assert_matches_single_book(&sharded, &book, "domain = 'corp.com'");
+    assert_matches_single_book(&sharded, &book, "name ^= 'person b' AND phone ~= '3'");
+    assert_matches_single_book(&sharded, &book, "email = 'user42@corp.com' OR id = 7");
+    assert_matches_single_book(&sharded, &book, "name = 'nobody'");
+
+    // An update whose new phone hashes elsewhere moves the contact; duplicates are refused.
+    Contact values = *sharded_book_find(&sharded, 10);
+    int moved_from = shard_for_phone(&sharded, values.phone);
+    for (int n = 0; shard_for_phone(&sharded, values.phone) == moved_from; n++) {
+        snprintf(values.phone, sizeof(values.phone), "97%08d", n);
+    }
+    status = sharded_book_update(&sharded, 10, &values);
+    assert(status == VALID);
+    assert(strcmp(sharded_book_find(&sharded, 10)->phone, values.phone) == 0);
+    assert(sharded.shards[moved_from].indexes == NULL ||
+           id_index_lookup(&sharded.shards[moved_from].indexes->by_id, 10) == NULL);
+    strcpy(values.email, "user11@mail.org");
+    status = sharded_book_update(&sharded, 10, &values);
+    assert(status == INVALID_DUPLICATE);
+    status = sharded_book_update(&sharded, 99999, &values);
+    assert(status == INVALID_NOT_FOUND);
+
+    result = sharded_book_remove(&sharded, 12);
+    assert(result == 0);
+    assert(sharded_book_find(&sharded, 12) == NULL);
+    result = sharded_book_remove(&sharded, 12);
+    assert(result == -1);
+    result = sharded_book_add(&sharded, "Reuse Email", "9222222222", "user11@mail.org", &status);
+    assert(result == TEST_CONTACTS + 1);
+
+    // Saving in parallel and reloading with a different shard count rehomes every contact.
+    result = sharded_book_save(&sharded, TEST_PATTERN);
+    assert(result == TEST_CONTACTS);
+    ShardedBook reloaded;
+    result = sharded_book_init(&reloaded, TEST_SHARDS - 1, 0);
+    assert(result == 0);
+    result = sharded_book_load(&reloaded, TEST_PATTERN);
+    assert(result == TEST_CONTACTS);
+    assert(sharded_book_count(&reloaded) == TEST_CONTACTS);
+    assert(reloaded.next_id == sharded.next_id);
+    for (int i = 0; i < reloaded.shard_count; i++) {
+        for (const Contact *c = reloaded.shards[i].head; c != NULL; c = c->next) {
+            assert(shard_for_phone(&reloaded, c->phone) == i);
+            assert(strcmp(sharded_book_find(&sharded, c->id)->email, c->email) == 0);
+        }
+    }
+
+    // Saving with fewer shards removes the file of the shard that went away.
+    result = sharded_book_save(&reloaded, TEST_PATTERN);
+    assert(result == TEST_CONTACTS);
+    char stale[SHARD_PATH_LENGTH];
+    snprintf(stale, sizeof(stale), TEST_PATTERN, TEST_SHARDS - 1);
+    FILE *fptr = fopen(stale, "r");
+    assert(fptr == NULL);
+
+    // 3. CLEANUP
+    for (int i = 0; i < TEST_SHARDS; i++) {
+        char path[SHARD_PATH_LENGTH];
+        snprintf(path, sizeof(path), TEST_PATTERN, i);
+        remove(path);
+    }
+    sharded_book_free(&reloaded);
+    sharded_book_free(&sharded);
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for the sharded book.\n");
+    return 0;
+}
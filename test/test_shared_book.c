@@ -0,0 +1,121 @@
+// In test/test_shared_book.c
+#define _XOPEN_SOURCE 700 // fork, waitpid, getpid
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../include/address_book.h"
+#include "../include/shared_book.h"
+
+#define EXPORT_FILE "test_shared_book.csv"
+#define BOOK_SIZE 1000
+
+static int count_contact(const SharedContact *contact, void *context) {
+    (void)contact;
+    (*(int *)context)++;
+    return 0;
+}
+
+int main() {
+    printf("--> Running test: test_shared_book...\n");
+
+    // 1. ARRANGE: a fresh region, named per process so parallel runs don't collide.
+    char name[64];
+    sprintf(name, "/addressbook_test_%d", (int)getpid());
+    shared_book_destroy(name);
+    assert(shared_book_create(name, 0) == NULL);
+    SharedBook *book = shared_book_create(name, BOOK_SIZE);
+    assert(book != NULL);
+    assert(shared_book_create(name, BOOK_SIZE) == NULL);
+    for (int i = 1; i <= BOOK_SIZE - 1; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        int id = 0;
+        sprintf(phone, "80%08d", i);
+        sprintf(email, "shared%d@corp.com", i);
+        assert(shared_book_add(book, "Shared Person", phone, email, &id) == VALID);
+        assert(id == i);
+    }
+
+    // 2. ACT: another process opens the same book and changes it.
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        SharedBook *other = shared_book_open(name);
+        int id = 0;
+        int ok = other != NULL &&
+                 shared_book_add(other, "Child Person", "8099999999", "child@corp.com", &id) ==
+                     VALID &&
+                 shared_book_update(other, 10, "Renamed Person", NULL, NULL) == VALID &&
+                 shared_book_remove(other, 20) == VALID;
+        shared_book_close(other);
+        _exit(ok ? 0 : 1);
+    }
+    int child_status = 0;
+    assert(waitpid(child, &child_status, 0) == child);
+    assert(WIFEXITED(child_status) && WEXITSTATUS(child_status) == 0);
+
+    // 3. ASSERT: the parent sees the child's changes without reloading anything.
+    Contact contact;
+    assert(shared_book_get(book, BOOK_SIZE, &contact) == 1);
+    assert(strcmp(contact.name, "Child Person") == 0);
+    assert(shared_book_lookup(book, SHARED_BY_EMAIL, "CHILD@corp.com", NULL, NULL) == 1);
+    assert(shared_book_get(book, 10, &contact) == 1);
+    assert(strcmp(contact.name, "Renamed Person") == 0);
+    assert(shared_book_get(book, 20, &contact) == 0);
+    assert(shared_book_lookup(book, SHARED_BY_PHONE, "8000000020", NULL, NULL) == 0);
+
+    // Uniqueness holds across processes.
+    assert(shared_book_add(book, "Copy Person", "8099999999", "copy@corp.com", NULL) ==
+           INVALID_DUPLICATE);
+    assert(shared_book_add(book, "Copy Person", "8088888888", "shared5@corp.com", NULL) ==
+           INVALID_DUPLICATE);
+    assert(shared_book_update(book, 11, NULL, "8000000012", NULL) == INVALID_DUPLICATE);
+    assert(shared_book_add(book, "Bad Name 7", "8088888888", "bad@corp.com", NULL) ==
+           INVALID_CHARACTERS);
+    assert(shared_book_remove(book, 20) == INVALID_NOT_FOUND);
+
+    // A changed phone moves in the index; the removed record is reused once the book is full.
+    assert(shared_book_update(book, 11, NULL, "8077777777", NULL) == VALID);
+    assert(shared_book_lookup(book, SHARED_BY_PHONE, "8000000011", NULL, NULL) == 0);
+    assert(shared_book_lookup(book, SHARED_BY_PHONE, "8077777777", NULL, NULL) == 1);
+    int id = 0;
+    assert(shared_book_add(book, "Last Person", "8066666666", "last@corp.com", &id) == VALID);
+    assert(id == BOOK_SIZE + 1);
+    assert(shared_book_add(book, "Over Person", "8055555555", "over@corp.com", NULL) ==
+           INVALID_NO_MEMORY);
+
+    SharedBookStats stats;
+    shared_book_stats(book, &stats);
+    assert(stats.contacts == BOOK_SIZE && stats.capacity == BOOK_SIZE);
+    assert(stats.next_id == BOOK_SIZE + 2);
+    assert(stats.changes == BOOK_SIZE - 1 + 3 + 2);
+    int counted = 0;
+    assert(shared_book_scan(book, count_contact, &counted) == BOOK_SIZE);
+    assert(counted == BOOK_SIZE);
+
+    // A saved CSV imports into a new region with the same IDs; repeats are skipped.
+    assert(shared_book_export_csv(book, EXPORT_FILE) == BOOK_SIZE);
+    shared_book_close(book);
+    assert(shared_book_destroy(name) == 0);
+    assert(shared_book_open(name) == NULL);
+    book = shared_book_create(name, BOOK_SIZE);
+    assert(book != NULL);
+    int skipped = -1;
+    assert(shared_book_import_csv(book, EXPORT_FILE, &skipped) == BOOK_SIZE);
+    assert(skipped == 0);
+    assert(shared_book_get(book, 10, &contact) == 1);
+    assert(strcmp(contact.name, "Renamed Person") == 0);
+    assert(shared_book_get(book, 20, &contact) == 0);
+    shared_book_close(book);
+
+    // 4. CLEANUP
+    assert(shared_book_destroy(name) == 0);
+    assert(shared_book_destroy(name) == -1);
+    remove(EXPORT_FILE);
+
+    printf("    [PASS] All checks passed for shared book.\n");
+    return 0;
+}
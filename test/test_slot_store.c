@@ -0,0 +1,107 @@
+// In test/test_slot_store.c
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/slot_store.h"
+
+#define SLOT_FILE "test_slot_store.slots"
+#define BOOK_SIZE 1000
+
+static long file_size(const char *path) {
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+int main() {
+    printf("--> Running test: test_slot_store...\n");
+
+    // 1. ARRANGE: a book moved into a new slot file, which then follows it.
+    remove(SLOT_FILE);
+    AddressBook book;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "slot%d@corp.com", i);
+        assert(ab_add(&book, "Slot Person", phone, email, NULL) == VALID);
+    }
+    SlotStore *store = slot_store_open(SLOT_FILE, false);
+    assert(store != NULL);
+    assert(slot_store_rewrite(store, &book) == BOOK_SIZE);
+    assert(slot_store_attach(store, &book) == 0);
+    assert(slot_store_attach(store, &book) == -1);
+    long size = file_size(SLOT_FILE);
+    assert(size == (long)SLOT_SIZE * (BOOK_SIZE + 1));
+
+    // 2. ACT: an edit, a delete, and a create that reuses the deleted contact's slot.
+    int added = 0;
+    assert(ab_update(&book, 500, "Edited Person", NULL, NULL) == VALID);
+    assert(ab_remove(&book, 7) == VALID);
+    assert(ab_add(&book, "New Person", "7099999999", "new@corp.com", &added) == VALID);
+
+    // 3. ASSERT: one record write per change, and the file never grew.
+    SlotStoreStats stats;
+    slot_store_stats(store, &stats);
+    assert(stats.writes == 3 && stats.failed_writes == 0);
+    assert(stats.slots == BOOK_SIZE && stats.contacts == BOOK_SIZE && stats.free_slots == 0);
+    assert(file_size(SLOT_FILE) == size);
+
+    // A delete leaves a free slot that is still free after reopening.
+    assert(ab_remove(&book, 9) == VALID);
+    assert(slot_store_close(store) == 0);
+    free_address_book(&book);
+
+    initialize(&book);
+    store = slot_store_open(SLOT_FILE, true);
+    assert(store != NULL);
+    slot_store_stats(store, &stats);
+    assert(stats.contacts == BOOK_SIZE - 1 && stats.free_slots == 1 && stats.damaged == 0);
+    assert(slot_store_load(store, &book) == BOOK_SIZE - 1);
+    Contact *contact = NULL;
+    assert(ab_find(&book, 500, &contact) == VALID);
+    assert(strcmp(contact->name, "Edited Person") == 0);
+    assert(ab_find(&book, added, &contact) == VALID);
+    assert(strcmp(contact->email, "new@corp.com") == 0);
+    assert(ab_find(&book, 7, &contact) != VALID && ab_find(&book, 9, &contact) != VALID);
+    assert(book.next_id > added);
+    assert(slot_store_delete(store, 9) == -1);
+    assert(slot_store_close(store) == 0);
+    free_address_book(&book);
+
+    // A damaged slot (a torn write) loses only that contact.
+    FILE *file = fopen(SLOT_FILE, "r+b");
+    assert(file != NULL);
+    fseek(file, (long)SLOT_SIZE * 100 + 10, SEEK_SET);
+    fputc('#', file);
+    fclose(file);
+    store = slot_store_open(SLOT_FILE, false);
+    assert(store != NULL);
+    slot_store_stats(store, &stats);
+    assert(stats.damaged == 1 && stats.free_slots == 2 && stats.contacts == BOOK_SIZE - 2);
+    initialize(&book);
+    assert(slot_store_load(store, &book) == BOOK_SIZE - 2);
+    assert(ab_find(&book, 100, &contact) != VALID);
+
+    // Something that is not a slot file is refused.
+    file = fopen("test_slot_store.csv", "w");
+    assert(file != NULL);
+    fprintf(file, "1\n1,Not Slots,7000000001,not@corp.com\n");
+    fclose(file);
+    assert(slot_store_open("test_slot_store.csv", false) == NULL);
+    remove("test_slot_store.csv");
+
+    // 4. CLEANUP
+    assert(slot_store_close(store) == 0);
+    free_address_book(&book);
+    remove(SLOT_FILE);
+
+    printf("    [PASS] All checks passed for slot store.\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+// In test/test_snapshot.c
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "../include/address_book.h"
+#include "../include/batch.h"
+#include "../include/snapshot.h"
+
+#define TEST_CONTACTS 200
+#define WRITER_ROUNDS 20000
+
+static Contact *new_contact(int id, int generation) {
+    Contact *contact = malloc(sizeof(Contact));
+    assert(contact != NULL);
+    contact->id = id;
+    snprintf(contact->name, sizeof(contact->name), "Person %d", id);
+    snprintf(contact->phone, sizeof(contact->phone), "9%09d", generation);
+    snprintf(contact->email, sizeof(contact->email), "g%d@x.com", generation);
+    contact->next = NULL;
+    return contact;
+}
+
+/**
+ * @brief Keeps rewriting contacts so that phone and email always encode the same generation.
+ */
+static void *writer_main(void *arg) {
+    AddressBook *book = arg;
+    for (int round = 1; round <= WRITER_ROUNDS; round++) {
+        int id = round % TEST_CONTACTS + 1;
+        Contact *values = new_contact(id, round * TEST_CONTACTS + id);
+        snapshot_write_begin(book);
+        Contact *target = book->head;
+        while (target != NULL && target->id != id) {
+            target = target->next;
+        }
+        if (target != NULL) {
+            Contact *updated = book_update_contact(book, target, values);
+            assert(updated != NULL);
+        }
+        snapshot_write_end(book);
+        free(values);
+    }
+    return NULL;
+}
+
+static int is_even(const Contact *contact, void *context) {
+    (void)context;
+    return contact->id % 2 == 0;
+}
+
+int main() {
+    printf("--> Running test: test_snapshot...\n");
+
+    // 1. ARRANGE
+    AddressBook book;
+    int status;
+    initialize(&book);
+    BookSnapshot *disabled = snapshot_open(&book);
+    assert(disabled == NULL);
+    status = book_enable_snapshots(&book);
+    assert(status == 0);
+    for (int id = 1; id <= TEST_CONTACTS; id++) {
+        book_append_contact(&book, new_contact(id, id));
+    }
+    unsigned long loaded_version = book_version(&book);
+
+    // 2. ACT / ASSERT: A snapshot keeps its view while the book is updated and trimmed.
+    BookSnapshot *before = snapshot_open(&book);
+    assert(before != NULL && before->count == TEST_CONTACTS);
+    // Snapshots of the same version share one array instead of each copying the list.
+    BookSnapshot *same = snapshot_open(&book);
+    assert(same != NULL && same->contacts == before->contacts);
+    snapshot_close(same);
+    Contact *first = book.head;
+    Contact values = *first;
+    strcpy(values.email, "changed@x.com");
+    Contact *updated = book_update_contact(&book, first, &values);
+    assert(updated != first && book.head == updated);
+    status = book_remove_contact(&book, book.head->next);
+    assert(status == 0);
+
+    assert(strcmp(before->contacts[0]->email, "g1@x.com") == 0);
+    assert(before->contacts[1]->id == 2);
+    assert(book.contact_count == TEST_CONTACTS - 1);
+    assert(snapshot_retired_count(&book) == 2);
+    assert(book_version(&book) == loaded_version + 2);
+
+    // A batch commits as one version; the older snapshot still sees neither change.
+    BookSnapshot *middle = snapshot_open(&book);
+    Batch batch;
+    batch_init(&batch);
+    status = batch_update(&batch, 3, "Person Three", "9111111111", "three@x.com");
+    assert(status == 0);
+    status = batch_remove(&batch, 4);
+    assert(status == 0);
+    status = batch_add(&batch, "New Person", "9222222222", "new@x.com");
+    assert(status == 0);
+    status = batch_commit(&book, &batch, NULL, NULL);
+    assert(status == BATCH_OK);
+    batch_free(&batch);
+    assert(book_version(&book) == loaded_version + 3);
+    assert(middle->count == TEST_CONTACTS - 1 && strcmp(middle->contacts[1]->name, "Person 3") == 0);
+    assert(strcmp(before->contacts[2]->name, "Person 3") == 0);
+    BookSnapshot *after = snapshot_open(&book);
+    assert(after->contacts != middle->contacts && after->count == TEST_CONTACTS - 1);
+    assert(after->contacts[after->count - 1]->id == TEST_CONTACTS + 1);
+    snapshot_close(after);
+
+    // Closing the oldest snapshot frees only what the newer one cannot see.
+    snapshot_close(before);
+    assert(snapshot_retired_count(&book) == 2);
+    snapshot_close(middle);
+    assert(snapshot_retired_count(&book) == 0);
+
+    // Snapshots taken while a writer thread keeps committing are always internally consistent.
+    pthread_t writer;
+    status = pthread_create(&writer, NULL, writer_main, &book);
+    assert(status == 0);
+    for (int pass = 0; pass < 200; pass++) {
+        BookSnapshot *view = snapshot_open(&book);
+        assert(view != NULL && view->count == (size_t)TEST_CONTACTS - 1);
+        for (size_t i = 0; i < view->count; i++) {
+            const Contact *c = view->contacts[i];
+            char email[MAX_EMAIL_LENGTH];
+            if (c->phone[0] == '9' && c->email[0] == 'g') {
+                snprintf(email, sizeof(email), "g%d@x.com", atoi(c->phone + 1));
+                assert(strcmp(email, c->email) == 0);
+            }
+        }
+        snapshot_close(view);
+    }
+    status = pthread_join(writer, NULL);
+    assert(status == 0);
+    assert(snapshot_retired_count(&book) == 0);
+
+    // A bulk extraction is picked up by the next snapshot too.
+    Contact *extracted = book_extract_contacts(&book, is_even, NULL);
+    BookSnapshot *odd = snapshot_open(&book);
+    assert(odd != NULL && odd->count == (size_t)book.contact_count);
+    for (size_t i = 0; i < odd->count; i++) {
+        assert(odd->contacts[i]->id % 2 == 1);
+    }
+    snapshot_close(odd);
+    while (extracted != NULL) {
+        Contact *next = extracted->next;
+        book_release_contact(&book, extracted);
+        extracted = next;
+    }
+
+    // 3. CLEANUP
+    free_address_book(&book);
+
+    printf("    [PASS] All checks passed for snapshots.\n");
+    return 0;
+}
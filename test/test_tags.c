@@ -0,0 +1,225 @@
+// In test/test_tags.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/tag_bitmap.h"
+#include "../include/tags.h"
+
+#define TAGS_FILE "test_tags.tags"
+#define BOOK_SIZE 12000
+#define SPAN 200000 // IDs used by the bitmap checks: several containers, some dense
+
+typedef struct {
+    const bool *expected;
+    size_t visited;
+    uint32_t previous;
+    bool ordered;
+} Walk;
+
+static int check_member(uint32_t value, void *context) {
+    Walk *walk = context;
+    walk->ordered = walk->ordered && (walk->visited == 0 || value > walk->previous) &&
+                    value < SPAN && walk->expected[value];
+    walk->previous = value;
+    walk->visited++;
+    return 0;
+}
+
+/**
+ * @brief Checks a bitmap against a plain array of flags, both through lookups and a walk.
+ */
+static bool matches(const TagBitmap *bitmap, const bool *expected) {
+    size_t count = 0;
+    for (uint32_t i = 0; i < SPAN; i++) {
+        if (tag_bitmap_contains(bitmap, i) != expected[i]) {
+            return false;
+        }
+        count += expected[i];
+    }
+    Walk walk = {expected, 0, 0, true};
+    tag_bitmap_foreach(bitmap, check_member, &walk);
+    return walk.ordered && walk.visited == count && tag_bitmap_cardinality(bitmap) == count;
+}
+
+static void test_bitmap_operations(void) {
+    // 1. ARRANGE: "a" is dense in the first container and sparse elsewhere, "b" the opposite.
+    bool *a = calloc(SPAN, sizeof(bool));
+    bool *b = calloc(SPAN, sizeof(bool));
+    bool *expected = calloc(SPAN, sizeof(bool));
+    assert(a != NULL && b != NULL && expected != NULL);
+    TagBitmap *left = tag_bitmap_create();
+    TagBitmap *right = tag_bitmap_create();
+    for (uint32_t i = 0; i < SPAN; i++) {
+        a[i] = i < 65536 ? i % 3 != 0 : i % 97 == 0;
+        b[i] = i < 65536 ? i % 101 == 0 : i % 2 == 0;
+        if (a[i]) {
+            assert(tag_bitmap_add(left, i) == 0);
+        }
+        if (b[i]) {
+            assert(tag_bitmap_add(right, i) == 0);
+        }
+    }
+
+    // 2. ACT
+    TagBitmap *both = tag_bitmap_and(left, right);
+    TagBitmap *either = tag_bitmap_or(left, right);
+    TagBitmap *only_left = tag_bitmap_andnot(left, right);
+    TagBitmap *only_right = tag_bitmap_andnot(right, left);
+
+    // ASSERT
+    assert(matches(left, a) && matches(right, b));
+    for (uint32_t i = 0; i < SPAN; i++) {
+        expected[i] = a[i] && b[i];
+    }
+    assert(matches(both, expected));
+    for (uint32_t i = 0; i < SPAN; i++) {
+        expected[i] = a[i] || b[i];
+    }
+    assert(matches(either, expected));
+    for (uint32_t i = 0; i < SPAN; i++) {
+        expected[i] = a[i] && !b[i];
+    }
+    assert(matches(only_left, expected));
+    for (uint32_t i = 0; i < SPAN; i++) {
+        expected[i] = b[i] && !a[i];
+    }
+    assert(matches(only_right, expected));
+
+    // Removing most of a dense container turns it back into a sorted array.
+    size_t dense_memory = tag_bitmap_memory(left);
+    for (uint32_t i = 0; i < 65536; i++) {
+        if (i % 64 != 1) {
+            tag_bitmap_remove(left, i);
+        }
+        a[i] = a[i] && i % 64 == 1;
+    }
+    assert(matches(left, a));
+    assert(tag_bitmap_memory(left) < dense_memory);
+
+    // 3. CLEANUP
+    tag_bitmap_free(left);
+    tag_bitmap_free(right);
+    tag_bitmap_free(both);
+    tag_bitmap_free(either);
+    tag_bitmap_free(only_left);
+    tag_bitmap_free(only_right);
+    free(a);
+    free(b);
+    free(expected);
+}
+
+static size_t query_count(const AddressBook *book, const char *expression) {
+    char error[TAG_ERROR_LENGTH];
+    TagBitmap *result = tag_query(book, expression, error, sizeof(error));
+    assert(result != NULL);
+    size_t count = tag_bitmap_cardinality(result);
+    tag_bitmap_free(result);
+    return count;
+}
+
+static void test_book_tags(void) {
+    // 1. ARRANGE: every 2nd contact is a vendor, every 3rd is vip, every 5th is blocked.
+    AddressBook book;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "tag%d@corp.com", i);
+        assert(ab_add(&book, "Tag Person", phone, email, NULL) == VALID);
+        if (i % 2 == 0) {
+            assert(book_tag_contact(&book, i, "Vendors") == VALID);
+        }
+        if (i % 3 == 0) {
+            assert(book_tag_contact(&book, i, "vip") == VALID);
+        }
+        if (i % 5 == 0) {
+            assert(book_tag_contact(&book, i, "blocked") == VALID);
+        }
+    }
+
+    // 2. ACT / ASSERT: tagging rules.
+    assert(book_tag_contact(&book, 2, "vendors") == VALID); // already tagged, any case
+    assert(book_tag_contact(&book, BOOK_SIZE + 1, "vip") == INVALID_NOT_FOUND);
+    assert(book_tag_contact(&book, 1, "") == INVALID_EMPTY);
+    assert(book_tag_contact(&book, 1, "on call") == INVALID_CHARACTERS);
+    assert(book_tag_contact(&book, 1, "a-very-long-tag-name-that-goes-on") == INVALID_LENGTH);
+    assert(book_tag_contact(&book, 7, "on-call") == VALID);
+    assert(book_untag_contact(&book, 7, "ON-CALL") == VALID);
+    assert(book_untag_contact(&book, 7, "on-call") == INVALID_NOT_FOUND);
+    assert(book_tag_members(&book, "on-call") == NULL); // emptied tags disappear
+
+    const char *names[4];
+    size_t counts[4];
+    assert(book_list_tags(&book, names, counts, 4) == 3);
+    assert(strcmp(names[0], "blocked") == 0 && counts[0] == BOOK_SIZE / 5);
+    assert(strcmp(names[1], "vendors") == 0 && counts[1] == BOOK_SIZE / 2);
+    assert(strcmp(names[2], "vip") == 0 && counts[2] == BOOK_SIZE / 3);
+    assert(book_contact_tags(&book, 30, names, 4) == 3);
+    assert(book_contact_tags(&book, 1, names, 4) == 0);
+
+    // Expressions, checked against counting by hand.
+    size_t vendor_vip = 0, vendor_or_vip = 0, grouped = 0, not_blocked = 0;
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        bool vendor = i % 2 == 0, vip = i % 3 == 0, blocked = i % 5 == 0;
+        vendor_vip += vendor && vip;
+        vendor_or_vip += vendor || vip;
+        grouped += (vendor || vip) && !blocked;
+        not_blocked += vendor && !blocked;
+    }
+    assert(query_count(&book, "vendors & vip") == vendor_vip);
+    assert(query_count(&book, "vendors|vip") == vendor_or_vip);
+    assert(query_count(&book, "(vendors | vip) & !blocked") == grouped);
+    assert(query_count(&book, "vendors & !blocked") == not_blocked);
+    assert(query_count(&book, "blocked | vendors & vip") == BOOK_SIZE / 5 + vendor_vip -
+                                                             BOOK_SIZE / 30);
+    assert(query_count(&book, "VIP & nobody") == 0);
+
+    char error[TAG_ERROR_LENGTH];
+    const char *malformed[] = {"", "vip &", "(vip | vendors", "vip blocked", "!vip", "vip | | x"};
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        error[0] = '\0';
+        assert(tag_query(&book, malformed[i], error, sizeof(error)) == NULL);
+        assert(error[0] != '\0');
+    }
+
+    // Deleting a contact takes it out of its tags.
+    assert(ab_remove(&book, 30) == VALID);
+    assert(book_contact_tags(&book, 30, names, 4) == 0);
+    assert(tag_bitmap_cardinality(book_tag_members(&book, "vip")) == BOOK_SIZE / 3 - 1);
+
+    // Saving and loading into a fresh book gives the same tags; unknown IDs are skipped.
+    assert(save_tags(&book, TAGS_FILE) == 3);
+    AddressBook copy;
+    initialize(&copy);
+    for (int i = 1; i <= BOOK_SIZE - 100; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "tag%d@corp.com", i);
+        assert(ab_add(&copy, "Tag Person", phone, email, NULL) == VALID);
+    }
+    int skipped = -1;
+    assert(load_tags(&copy, TAGS_FILE, &skipped) == 3);
+    assert(skipped == 50 + 34 + 20); // the vendors, vip, and blocked among the missing 100
+    assert(query_count(&copy, "vendors & vip") == query_count(&book, "vendors & vip") - 17);
+    assert(book_contact_tags(&copy, 30, names, 4) == 0);
+    assert(book_contact_tags(&copy, 60, names, 4) == 3);
+
+    // 3. CLEANUP
+    free_address_book(&copy);
+    free_address_book(&book);
+    remove(TAGS_FILE);
+}
+
+int main() {
+    printf("--> Running test: test_tags...\n");
+    test_bitmap_operations();
+    test_book_tags();
+    printf("    [PASS] All checks passed for tags.\n");
+    return 0;
+}
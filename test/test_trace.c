@@ -0,0 +1,114 @@
+// In test/test_trace.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "../include/address_book.h"
+#include "../include/ab_api.h"
+#include "../include/query.h"
+#include "../include/trace.h"
+
+#define CSV_FILE "test_trace.csv"
+#define TRACE_FILE "test_trace.json"
+#define BOOK_SIZE 10000
+
+static char *read_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = malloc((size_t)size + 1);
+    assert(text != NULL);
+    size_t read = fread(text, 1, (size_t)size, file);
+    assert(read == (size_t)size);
+    text[size] = '\0';
+    fclose(file);
+    return text;
+}
+
+static int count_spans(const char *text, const char *name) {
+    char needle[64];
+    snprintf(needle, sizeof(needle), "\"name\":\"%s\"", name);
+    int count = 0;
+    for (const char *at = strstr(text, needle); at != NULL; at = strstr(at + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+int main() {
+    printf("--> Running test: test_trace...\n");
+#ifndef ADDRESSBOOK_TRACING
+    printf("    [PASS] Tracing is compiled out; nothing to check.\n");
+    return 0;
+#else
+    // 1. ARRANGE: a saved book, and spans recorded before tracing starts (which are ignored).
+    AddressBook book;
+    int status;
+    initialize(&book);
+    for (int i = 1; i <= BOOK_SIZE; i++) {
+        char phone[MAX_PHONE_LENGTH];
+        char email[MAX_EMAIL_LENGTH];
+        sprintf(phone, "70%08d", i);
+        sprintf(email, "trace%d@corp.com", i);
+        status = ab_add(&book, "Trace Person", phone, email, NULL);
+        assert(status == VALID);
+    }
+    status = save_contacts_csv(&book, CSV_FILE);
+    assert(status == BOOK_SIZE);
+    free_address_book(&book);
+    TraceSpan early = TRACE_BEGIN("early");
+
+    // 2. ACT
+    status = trace_start(TRACE_FILE);
+    assert(status == 0);
+    status = trace_start(TRACE_FILE);
+    assert(status == -1);
+    TRACE_END(early);
+    initialize(&book);
+    status = load_contacts_csv(&book, CSV_FILE, NULL);
+    assert(status == BOOK_SIZE);
+    Query *query = query_parse("email ~= '77'", NULL, 0);
+    QueryResult result;
+    assert(query != NULL);
+    status = query_execute(&book, query, &result);
+    assert(status == 0);
+    status = save_contacts_csv(&book, CSV_FILE);
+    assert(status == BOOK_SIZE);
+    int written = trace_stop();
+    TraceSpan late = TRACE_BEGIN("late");
+    TRACE_END(late);
+
+    // 3. ASSERT: one read/parse/insert span per batch, each carrying its record count.
+    char *text = read_file(TRACE_FILE);
+    status = trace_stop();
+    assert(written > 0 && status == -1);
+    assert(strncmp(text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 38) == 0);
+    assert(strstr(text, "\n]}\n") != NULL);
+    int batches = (BOOK_SIZE + 4095) / 4096;
+    assert(count_spans(text, "load") == 1);
+    assert(count_spans(text, "load.read") == batches);
+    assert(count_spans(text, "load.parse") == batches);
+    assert(count_spans(text, "load.insert") == batches);
+    assert(strstr(text, "\"name\":\"load\",\"cat\":\"addressbook\",\"ph\":\"X\"") != NULL);
+    assert(strstr(text, "\"args\":{\"records\":10000}") != NULL);
+    assert(count_spans(text, "query.plan") == 1 && count_spans(text, "query.execute") == 1);
+    assert(count_spans(text, "scan") == 1 && count_spans(text, "save.csv") == 1);
+    assert(count_spans(text, "early") == 0 && count_spans(text, "late") == 0);
+    assert(count_spans(text, "process_name") == 1);
+    assert(count_spans(text, "index.build") == 1); // the first contact builds the indexes
+    assert(written == 1 + 3 * batches + 1 + 4);
+
+    // 4. CLEANUP
+    free(text);
+    query_result_free(&result);
+    query_free(query);
+    free_address_book(&book);
+    remove(CSV_FILE);
+    remove(TRACE_FILE);
+
+    printf("    [PASS] All checks passed for trace.\n");
+    return 0;
+#endif
+}